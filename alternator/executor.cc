@@ -22,6 +22,7 @@
 #include "cql3/result_set.hh"
 #include "bytes.hh"
 #include "service/pager/query_pagers.hh"
+#include <algorithm>
 #include <functional>
 #include "error.hh"
 #include "serialization.hh"
@@ -123,6 +124,42 @@ json::json_return_type make_streamed(rjson::value&& value) {
     return func;
 }
 
+json::json_return_type make_streamed(rjson::chunked_content&& content) {
+    static constexpr size_t big_size = 100'000;
+    size_t size = 0;
+    for (auto& chunk : content) {
+        size += chunk.size();
+    }
+    if (size <= big_size) {
+        std::string str;
+        str.reserve(size);
+        for (auto& chunk : content) {
+            str.append(chunk.get(), chunk.size());
+        }
+        return json::json_return_type(json_string(std::move(str)));
+    }
+    // As above, the body writer has to be copyable.
+    auto rs = make_shared<rjson::chunked_content>(std::move(content));
+    std::function<future<>(output_stream<char>&&)> func = [rs](output_stream<char>&& os) mutable -> future<> {
+        auto los = std::move(os);
+        auto lrs = std::move(rs);
+        std::exception_ptr ex;
+        try {
+            for (auto& chunk : *lrs) {
+                co_await los.write(std::move(chunk));
+            }
+        } catch (...) {
+            ex = std::current_exception();
+            elogger.error("Exception during streaming HTTP response: {}", ex);
+        }
+        co_await los.close();
+        if (ex) {
+            co_await coroutine::return_exception_ptr(std::move(ex));
+        }
+    };
+    return func;
+}
+
 json_string::json_string(std::string&& value)
     : _value(std::move(value))
 {}
@@ -3606,25 +3643,43 @@ void filter::for_filters_on(const noncopyable_function<void(std::string_view)>&
     }
 }
 
+// Writes the items of a Query or Scan as the rows of the result set are
+// visited, without building the whole array of items first.
+//
+// When the items need neither filtering nor projecting parts of their
+// attributes, they are written straight from the rows. Otherwise, each
+// item is built as a value to be filtered and projected, written, and
+// dropped before the next one.
 class describe_items_visitor {
     typedef std::vector<const column_definition*> columns_t;
+    rjson::chunked_writer& _writer;
     const columns_t& _columns;
     const std::optional<attrs_to_get>& _attrs_to_get;
     std::unordered_set<std::string> _extra_filter_attrs;
     const filter& _filter;
     typename columns_t::const_iterator _column_it;
     rjson::value _item;
-    rjson::value _items;
+    // If false, the items are only counted (a Scan or Query with Select=COUNT).
+    bool _write_items;
+    bool _write_directly;
+    size_t _count;
     size_t _scanned_count;
 
+    bool wanted(const std::string& attr_name) const {
+        return !_attrs_to_get || _attrs_to_get->contains(attr_name) || _extra_filter_attrs.contains(attr_name);
+    }
+
 public:
-    describe_items_visitor(const columns_t& columns, const std::optional<attrs_to_get>& attrs_to_get, filter& filter)
-            : _columns(columns)
+    describe_items_visitor(rjson::chunked_writer& writer, const columns_t& columns, const std::optional<attrs_to_get>& attrs_to_get, filter& filter)
+            : _writer(writer)
+            , _columns(columns)
             , _attrs_to_get(attrs_to_get)
             , _filter(filter)
             , _column_it(columns.begin())
             , _item(rjson::empty_object())
-            , _items(rjson::empty_array())
+            , _write_items(!attrs_to_get || !attrs_to_get->empty())
+            , _write_directly(!filter && (!attrs_to_get || std::ranges::all_of(*attrs_to_get, [] (const auto& attr) { return attr.second.has_value(); })))
+            , _count(0)
             , _scanned_count(0)
     {
         // _filter.check() may need additional attributes not listed in
@@ -3643,17 +3698,28 @@ class describe_items_visitor {
 
     void start_row() {
         _column_it = _columns.begin();
+        if (_write_directly && _write_items) {
+            _writer.StartObject();
+        }
     }
 
     void accept_value(managed_bytes_view_opt result_bytes_view) {
-        if (!result_bytes_view) {
+        if (!result_bytes_view || (_write_directly && !_write_items)) {
             ++_column_it;
             return;
         }
         result_bytes_view->with_linearized([this] (bytes_view bv) {
             std::string column_name = (*_column_it)->name_as_text();
             if (column_name != executor::ATTRS_COLUMN_NAME) {
-                if (!_attrs_to_get || _attrs_to_get->contains(column_name) || _extra_filter_attrs.contains(column_name)) {
+                if (wanted(column_name)) {
+                    if (_write_directly) {
+                        _writer.Key(column_name);
+                        _writer.StartObject();
+                        _writer.Key(type_to_string((*_column_it)->type));
+                        _writer.Value(json_key_column_value(bv, **_column_it));
+                        _writer.EndObject();
+                        return;
+                    }
                     if (!_item.HasMember(column_name.c_str())) {
                         rjson::add_with_string_name(_item, column_name, rjson::empty_object());
                     }
@@ -3665,8 +3731,13 @@ class describe_items_visitor {
                 auto keys_and_values = value_cast<map_type_impl::native_type>(deserialized);
                 for (auto entry : keys_and_values) {
                     std::string attr_name = value_cast<sstring>(entry.first);
-                    if (!_attrs_to_get || _attrs_to_get->contains(attr_name) || _extra_filter_attrs.contains(attr_name)) {
+                    if (wanted(attr_name)) {
                         bytes value = value_cast<bytes>(entry.second);
+                        if (_write_directly) {
+                            _writer.Key(attr_name);
+                            _writer.Value(deserialize_item(value));
+                            continue;
+                        }
                         // Even if _attrs_to_get asked to keep only a part of a
                         // top-level attribute, we keep the entire attribute
                         // at this stage, because the item filter might still
@@ -3682,6 +3753,14 @@ class describe_items_visitor {
     }
 
     void end_row() {
+        ++_scanned_count;
+        if (_write_directly) {
+            if (_write_items) {
+                _writer.EndObject();
+            }
+            ++_count;
+            return;
+        }
         if (_filter.check(_item)) {
             // As noted above, we kept entire top-level attributes listed in
             // _attrs_to_get. We may need to only keep parts of them.
@@ -3703,41 +3782,47 @@ class describe_items_visitor {
                 rjson::remove_member(_item, attr);
             }
 
-            rjson::push_back(_items, std::move(_item));
+            if (_write_items) {
+                _writer.Value(_item);
+            }
+            ++_count;
         }
         _item = rjson::empty_object();
-        ++_scanned_count;
     }
 
-    rjson::value get_items() && {
-        return std::move(_items);
+    size_t get_count() const {
+        return _count;
     }
 
-    size_t get_scanned_count() {
+    size_t get_scanned_count() const {
         return _scanned_count;
     }
 };
 
-static future<std::tuple<rjson::value, size_t>> describe_items(const cql3::selection::selection& selection, std::unique_ptr<cql3::result_set> result_set, std::optional<attrs_to_get>&& attrs_to_get, filter&& filter) {
-    describe_items_visitor visitor(selection.get_columns(), attrs_to_get, filter);
-    co_await result_set->visit_gently(visitor);
-    auto scanned_count = visitor.get_scanned_count();
-    rjson::value items = std::move(visitor).get_items();
-    rjson::value items_descr = rjson::empty_object();
-    auto size = items.Size();
-    rjson::add(items_descr, "Count", rjson::value(size));
-    rjson::add(items_descr, "ScannedCount", rjson::value(scanned_count));
+// Writes the "Items", "Count" and "ScannedCount" members of a Query or Scan
+// response into the object being written by the writer. Returns the number
+// of items.
+static future<size_t> describe_items(rjson::chunked_writer& writer, const cql3::selection::selection& selection, std::unique_ptr<cql3::result_set> result_set, std::optional<attrs_to_get>&& attrs_to_get, filter&& filter) {
     // If attrs_to_get && attrs_to_get->empty(), this means the user asked not
     // to get any attributes (i.e., a Scan or Query with Select=COUNT) and we
-    // shouldn't return "Items" at all.
-    // TODO: consider optimizing the case of Select=COUNT without a filter.
-    // In that case, we currently build a list of empty items and here drop
-    // it. We could just count the items and not bother with the empty items.
-    // (However, remember that when we do have a filter, we need the items).
-    if (!attrs_to_get || !attrs_to_get->empty()) {
-        rjson::add(items_descr, "Items", std::move(items));
+    // shouldn't return "Items" at all. The items are then only counted, and
+    // are only built if they need to be filtered.
+    bool write_items = !attrs_to_get || !attrs_to_get->empty();
+    describe_items_visitor visitor(writer, selection.get_columns(), attrs_to_get, filter);
+    if (write_items) {
+        writer.Key("Items");
+        writer.StartArray();
+    }
+    co_await result_set->visit_gently(visitor);
+    if (write_items) {
+        writer.EndArray();
     }
-    co_return std::tuple<rjson::value, size_t>{std::move(items_descr), size};
+    auto size = visitor.get_count();
+    writer.Key("Count");
+    writer.Uint64(size);
+    writer.Key("ScannedCount");
+    writer.Uint64(visitor.get_scanned_count());
+    co_return size;
 }
 
 static rjson::value encode_paging_state(const schema& schema, const service::pager::paging_state& paging_state) {
@@ -3775,7 +3860,60 @@ static rjson::value encode_paging_state(const schema& schema, const service::pag
     return last_evaluated_key;
 }
 
+std::string paging_state_cache::make_key(std::string_view read, const partition_key& pk, position_in_partition_view pos) {
+    return fmt::format("{} {} {}", read, pk, pos);
+}
+
+std::string paging_state_cache::describe_read(const schema& s, const query::partition_slice& slice,
+        const dht::partition_range_vector& ranges, db::consistency_level cl) {
+    return fmt::format("{} {} {} [{}] {}", s.id(), s.version(), slice, fmt::join(ranges, ", "), cl);
+}
+
+void paging_state_cache::put(std::string_view read, const partition_key& pk, position_in_partition_view pos, const service::pager::paging_state& state) {
+    auto now = lowres_clock::now();
+    if (_entries.size() >= max_entries) {
+        std::erase_if(_entries, [now] (const auto& e) { return e.second.expiry <= now; });
+        if (_entries.size() >= max_entries) {
+            return;
+        }
+    }
+    _entries.insert_or_assign(make_key(read, pk, pos),
+            entry{state.get_query_uuid(), state.get_last_replicas(), state.get_query_read_repair_decision(), now + ttl});
+}
+
+lw_shared_ptr<service::pager::paging_state> paging_state_cache::take(std::string_view read, const partition_key& pk, position_in_partition_view pos) {
+    // Even if the last page is forgotten, a new id lets the replicas save
+    // the readers of this page, for the next one.
+    auto uuid = query_id::create_random_id();
+    service::pager::paging_state::replicas_per_token_range last_replicas;
+    std::optional<db::read_repair_decision> read_repair_decision;
+    auto it = _entries.find(make_key(read, pk, pos));
+    if (it != _entries.end()) {
+        if (it->second.expiry > lowres_clock::now()) {
+            uuid = it->second.query_uuid;
+            last_replicas = std::move(it->second.last_replicas);
+            read_repair_decision = it->second.read_repair_decision;
+        }
+        // Each page's state is used once: the replicas' readers can only
+        // continue one read.
+        _entries.erase(it);
+    }
+    return make_lw_shared<service::pager::paging_state>(pk, pos, query::max_partitions, uuid, std::move(last_replicas), read_repair_decision, 0);
+}
+
+// Where a page starting after the given key, as sent by the client in
+// ExclusiveStartKey, starts.
+static std::pair<partition_key, position_in_partition> start_after_key(const rjson::value& key, const schema_ptr& schema) {
+    partition_key pk = pk_from_json(key, schema);
+    auto pos = position_in_partition::for_partition_start();
+    if (schema->clustering_key_size() > 0) {
+        pos = pos_from_json(key, schema);
+    }
+    return {std::move(pk), std::move(pos)};
+}
+
 static future<executor::request_return_type> do_query(service::storage_proxy& proxy,
+        paging_state_cache& paging_cache,
         schema_ptr schema,
         const rjson::value* exclusive_start_key,
         dht::partition_range_vector partition_ranges,
@@ -3793,15 +3931,6 @@ static future<executor::request_return_type> do_query(service::storage_proxy& pr
 
     tracing::trace(trace_state, "Performing a database query");
 
-    if (exclusive_start_key) {
-        partition_key pk = pk_from_json(*exclusive_start_key, schema);
-        auto pos = position_in_partition::for_partition_start();
-        if (schema->clustering_key_size() > 0) {
-            pos = pos_from_json(*exclusive_start_key, schema);
-        }
-        old_paging_state = make_lw_shared<service::pager::paging_state>(pk, pos, query::max_partitions, query_id::create_null_id(), service::pager::paging_state::replicas_per_token_range{}, std::nullopt, 0);
-    }
-
     auto regular_columns = boost::copy_range<query::column_id_vector>(
             schema->regular_columns() | boost::adaptors::transformed([] (const column_definition& cdef) { return cdef.id; }));
     auto static_columns = boost::copy_range<query::column_id_vector>(
@@ -3810,6 +3939,13 @@ static future<executor::request_return_type> do_query(service::storage_proxy& pr
     query::partition_slice::option_set opts = selection->get_query_options();
     opts.add(custom_opts);
     auto partition_slice = query::partition_slice(std::move(ck_bounds), std::move(static_columns), std::move(regular_columns), opts);
+    // The replicas' readers can only continue the read of a page of the
+    // very same read, so the pages are remembered by the read too.
+    auto read = paging_state_cache::describe_read(*schema, partition_slice, partition_ranges, cl);
+    if (exclusive_start_key) {
+        auto [pk, pos] = start_after_key(*exclusive_start_key, schema);
+        old_paging_state = paging_cache.take(read, pk, pos);
+    }
     auto command = ::make_lw_shared<query::read_command>(schema->id(), schema->version(), partition_slice, proxy.get_max_result_size(partition_slice),
         query::tombstone_limit(proxy.get_tombstone_limit()));
 
@@ -3827,19 +3963,27 @@ static future<executor::request_return_type> do_query(service::storage_proxy& pr
     }
     auto paging_state = rs->get_metadata().paging_state();
     bool has_filter = filter;
-    auto [items, size] = co_await describe_items(*selection, std::move(rs), std::move(attrs_to_get), std::move(filter));
+    // The response is written as the items are read, into chunks which are
+    // then streamed to the client if they are big.
+    rjson::chunked_writer writer;
+    writer.StartObject();
+    auto size = co_await describe_items(writer, *selection, std::move(rs), std::move(attrs_to_get), std::move(filter));
     if (paging_state) {
-        rjson::add(items, "LastEvaluatedKey", encode_paging_state(*schema, *paging_state));
-    }
+        auto last_evaluated_key = encode_paging_state(*schema, *paging_state);
+        // Keyed by the key as it will be parsed from the next request, which
+        // doesn't always give back the exact position the page ended at.
+        auto [pk, pos] = start_after_key(last_evaluated_key, schema);
+        paging_cache.put(read, pk, pos, *paging_state);
+        writer.Key("LastEvaluatedKey");
+        writer.Value(last_evaluated_key);
+    }
+    writer.EndObject();
     if (has_filter){
         cql_stats.filtered_rows_read_total += p->stats().rows_read_total;
         // update our "filtered_row_matched_total" for all the rows matched, despited the filter
         cql_stats.filtered_rows_matched_total += size;
     }
-    if (is_big(items)) {
-        co_return executor::request_return_type(make_streamed(std::move(items)));
-    }
-    co_return executor::request_return_type(make_jsonable(std::move(items)));
+    co_return executor::request_return_type(make_streamed(std::move(writer).release()));
 }
 
 static dht::token token_for_segment(int segment, int total_segments) {
@@ -3941,7 +4085,7 @@ future<executor::request_return_type> executor::scan(client_state& client_state,
     verify_all_are_used(expression_attribute_names, used_attribute_names, "ExpressionAttributeNames", "Scan");
     verify_all_are_used(expression_attribute_values, used_attribute_values, "ExpressionAttributeValues", "Scan");
 
-    return do_query(_proxy, schema, exclusive_start_key, std::move(partition_ranges), std::move(ck_bounds), std::move(attrs_to_get), limit, cl,
+    return do_query(_proxy, _paging_state_cache, schema, exclusive_start_key, std::move(partition_ranges), std::move(ck_bounds), std::move(attrs_to_get), limit, cl,
             std::move(filter), query::partition_slice::option_set(), client_state, _stats.cql_stats, trace_state, std::move(permit));
 }
 
@@ -4421,7 +4565,7 @@ future<executor::request_return_type> executor::query(client_state& client_state
     verify_all_are_used(expression_attribute_values, used_attribute_values, "ExpressionAttributeValues", "Query");
     query::partition_slice::option_set opts;
     opts.set_if<query::partition_slice::option::reversed>(!forward);
-    return do_query(_proxy, schema, exclusive_start_key, std::move(partition_ranges), std::move(ck_bounds), std::move(attrs_to_get), limit, cl,
+    return do_query(_proxy, _paging_state_cache, schema, exclusive_start_key, std::move(partition_ranges), std::move(ck_bounds), std::move(attrs_to_get), limit, cl,
             std::move(filter), opts, client_state, _stats.cql_stats, std::move(trace_state), std::move(permit));
 }
 
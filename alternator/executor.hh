@@ -22,6 +22,10 @@
 #include "stats.hh"
 #include "utils/rjson.hh"
 #include "utils/updateable_value.hh"
+#include "service/pager/paging_state.hh"
+#include "query-request.hh"
+#include "db/consistency_level_type.hh"
+#include <seastar/core/lowres_clock.hh>
 
 namespace db {
     class system_distributed_keyspace;
@@ -70,6 +74,13 @@ struct make_jsonable : public json::jsonable {
  */ 
 json::json_return_type make_streamed(rjson::value&&);
 
+/**
+ * Make return type for JSON already written into chunks, e.g.,
+ * by rjson::chunked_writer. Big ones are streamed chunk by chunk,
+ * small ones are returned as one string.
+ */
+json::json_return_type make_streamed(rjson::chunked_content&&);
+
 struct json_string : public json::jsonable {
     std::string _value;
 public:
@@ -152,6 +163,45 @@ using attrs_to_get_node = attribute_path_map_node<std::monostate>;
 using attrs_to_get = attribute_path_map<std::monostate>;
 
 
+// Remembers for a while, on each shard, the internal paging state of the last
+// pages of Scan and Query requests, by the key the next page starts after.
+// The requests of the next pages only carry that key (ExclusiveStartKey),
+// which is enough to continue the read, but not the rest of the paging state:
+// the id under which the replicas saved the readers of the last page in their
+// querier cache, and which replicas they are. With them, when a client reads
+// the next page through the same shard, like it does when it keeps its
+// connection, the replicas continue reading with the readers they read the
+// last page with, instead of creating new ones for every page.
+class paging_state_cache {
+public:
+    static constexpr size_t max_entries = 1000;
+    // Like the querier cache, which doesn't keep readers for longer either.
+    static constexpr std::chrono::seconds ttl = std::chrono::seconds(10);
+private:
+    struct entry {
+        query_id query_uuid;
+        service::pager::paging_state::replicas_per_token_range last_replicas;
+        std::optional<db::read_repair_decision> read_repair_decision;
+        lowres_clock::time_point expiry;
+    };
+    std::unordered_map<std::string, entry> _entries;
+
+    static std::string make_key(std::string_view read, const partition_key& pk, position_in_partition_view pos);
+public:
+    // Describes everything the replicas read with: the table, the ranges,
+    // the slice and the consistency level. The pages of a read are only
+    // remembered for the next pages of the same read, as the replicas don't
+    // check that a saved reader reads the same ranges and slice.
+    static std::string describe_read(const schema& s, const query::partition_slice& slice,
+            const dht::partition_range_vector& ranges, db::consistency_level cl);
+    // Remembers the paging state of a page of the read which ended with more
+    // to read, at pk and pos, as the key of the next page's request is parsed.
+    void put(std::string_view read, const partition_key& pk, position_in_partition_view pos, const service::pager::paging_state& state);
+    // The paging state to continue the read after pk and pos with, with the
+    // state of the page which ended there if it is still remembered.
+    lw_shared_ptr<service::pager::paging_state> take(std::string_view read, const partition_key& pk, position_in_partition_view pos);
+};
+
 class executor : public peering_sharded_service<executor> {
     gms::gossiper& _gossiper;
     service::storage_proxy& _proxy;
@@ -161,6 +211,7 @@ class executor : public peering_sharded_service<executor> {
     // An smp_service_group to be used for limiting the concurrency when
     // forwarding Alternator request between shards - if necessary for LWT.
     smp_service_group _ssg;
+    paging_state_cache _paging_state_cache;
 
 public:
     using client_state = service::client_state;
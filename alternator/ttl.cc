@@ -239,19 +239,19 @@ static bool is_expired(const rjson::value& expiration_time, gc_clock::time_point
     return n && is_expired(*n, now);
 }
 
-// expire_item() expires an item - i.e., deletes it as appropriate for
-// expiration - with CL=QUORUM and (FIXME!) in a way Alternator Streams
-// understands it is an expiration event - not a user-initiated deletion.
-static future<> expire_item(service::storage_proxy& proxy,
-                            const service::query_state& qs,
-                            const std::vector<managed_bytes_opt>& row,
-                            schema_ptr schema,
-                            api::timestamp_type ts) {
+// add_expired_item() adds the deletion of an expired item, as appropriate
+// for expiration, to the mutations of the expired items of a page. Items of
+// the same partition are deleted in the same mutation, and the mutations are
+// applied together by expire_items(). The rows of a page come partition by
+// partition, so an item's partition, if already there, is the last one.
+static void add_expired_item(std::vector<mutation>& mutations,
+                             const std::vector<managed_bytes_opt>& row,
+                             const schema_ptr& schema,
+                             api::timestamp_type ts) {
     // Prepare the row key to delete
-    // NOTICE: the order of columns is guaranteed by the fact that selection::wildcard
-    // is used, which indicates that columns appear in the order defined by
-    // schema::all_columns_in_select_order() - partition key columns goes first,
-    // immediately followed by clustering key columns
+    // NOTICE: the order of columns is guaranteed by the selection of the
+    // scan, in which the partition key columns go first, immediately
+    // followed by clustering key columns
     std::vector<bytes> exploded_pk;
     const unsigned pk_size = schema->partition_key_size();
     const unsigned ck_size = schema->clustering_key_size();
@@ -261,40 +261,72 @@ static future<> expire_item(service::storage_proxy& proxy,
             // This shouldn't happen - all key columns must have values.
             // But if it ever happens, let's just *not* expire the item.
             // FIXME: log or increment a metric if this happens.
-            return make_ready_future<>();
+            return;
         }
         exploded_pk.push_back(to_bytes(*row_c));
     }
     auto pk = partition_key::from_exploded(exploded_pk);
-    mutation m(schema, pk);
     // If there's no clustering key, a tombstone should be created directly
     // on a partition, not on a clustering row - otherwise it will look like
     // an open-ended range tombstone, which will crash on KA/LA sstable format.
     // See issue #6035
     if (ck_size == 0) {
+        mutation m(schema, std::move(pk));
         m.partition().apply(tombstone(ts, gc_clock::now()));
-    } else {
-        std::vector<bytes> exploded_ck;
-        for (unsigned c = pk_size; c < pk_size + ck_size; ++c) {
-            const auto& row_c = row[c];
-            if (!row_c) {
-                // This shouldn't happen - all key columns must have values.
-                // But if it ever happens, let's just *not* expire the item.
-                // FIXME: log or increment a metric if this happens.
-                return make_ready_future<>();
+        mutations.push_back(std::move(m));
+        return;
+    }
+    std::vector<bytes> exploded_ck;
+    for (unsigned c = pk_size; c < pk_size + ck_size; ++c) {
+        const auto& row_c = row[c];
+        if (!row_c) {
+            // This shouldn't happen - all key columns must have values.
+            // But if it ever happens, let's just *not* expire the item.
+            // FIXME: log or increment a metric if this happens.
+            return;
+        }
+        exploded_ck.push_back(to_bytes(*row_c));
+    }
+    auto ck = clustering_key::from_exploded(exploded_ck);
+    if (mutations.empty() || !mutations.back().key().equal(*schema, pk)) {
+        mutations.emplace_back(schema, std::move(pk));
+    }
+    mutations.back().partition().clustered_row(*schema, ck).apply(tombstone(ts, gc_clock::now()));
+}
+
+// expire_items() applies the deletions of expired items added by
+// add_expired_item(), with CL=QUORUM and (FIXME!) in a way Alternator Streams
+// understands it is an expiration event - not a user-initiated deletion.
+// The mutations are applied in chunks of a bounded number of partitions, so
+// that a page of many small partitions doesn't become one huge batch of
+// writes. A chunk which times out is retried after a small sleep, like the
+// page reads are, without writing the chunks before it again.
+static future<> expire_items(service::storage_proxy& proxy,
+                             const service::query_state& qs,
+                             std::vector<mutation> mutations,
+                             abort_source& abort_source) {
+    static constexpr size_t max_partitions_per_write = 100;
+    for (size_t begin = 0; begin < mutations.size(); begin += max_partitions_per_write) {
+        auto end = std::min(mutations.size(), begin + max_partitions_per_write);
+        std::vector<mutation> chunk(std::make_move_iterator(mutations.begin() + begin), std::make_move_iterator(mutations.begin() + end));
+        for (int retries=0; ; retries++) {
+            try {
+                co_await proxy.mutate(chunk,
+                    db::consistency_level::LOCAL_QUORUM,
+                    executor::default_timeout(), // FIXME - which timeout?
+                    qs.get_trace_state(), qs.get_permit(),
+                    db::allow_per_partition_rate_limit::no);
+                break;
+            } catch(exceptions::mutation_write_timeout_exception&) {
+                tlogger.warn("expiration scanner write timed out, will retry: {}",
+                    std::current_exception());
+            }
+            if (retries >= 10) {
+                throw runtime_exception("scanner thread failed after too many timeouts for the same deletions");
             }
-            exploded_ck.push_back(to_bytes(*row_c));
+            co_await sleep_abortable(std::chrono::seconds(1), abort_source);
         }
-        auto ck = clustering_key::from_exploded(exploded_ck);
-        m.partition().clustered_row(*schema, ck).apply(tombstone(ts, gc_clock::now()));
-    }
-    std::vector<mutation> mutations;
-    mutations.push_back(std::move(m));
-    return proxy.mutate(std::move(mutations),
-        db::consistency_level::LOCAL_QUORUM,
-        executor::default_timeout(), // FIXME - which timeout?
-        qs.get_trace_state(), qs.get_permit(),
-        db::allow_per_partition_rate_limit::no);
+    }
 }
 
 static size_t random_offset(size_t min, size_t max) {
@@ -508,16 +540,27 @@ struct scan_ranges_context {
         , column_name(column_name)
         , member(member)
     {
-        // FIXME: don't read the entire items - read only parts of it.
-        // We must read the key columns (to be able to delete) and also
-        // the requested attribute. If the requested attribute is a map's
-        // member we may be forced to read the entire map - but it would
-        // be good if we can read only the single item of the map - it
-        // should be possible (and a must for issue #7751!).
+        // Only read the key columns (to be able to delete) and the column
+        // of the requested attribute, if it isn't a key column.
+        // FIXME: If the requested attribute is a map's member we are forced
+        // to read the entire map - but it would be good if we can read only
+        // the single item of the map - it should be possible (and a must
+        // for issue #7751!).
         lw_shared_ptr<service::pager::paging_state> paging_state = nullptr;
-        auto regular_columns = boost::copy_range<query::column_id_vector>(
-            s->regular_columns() | boost::adaptors::transformed([] (const column_definition& cdef) { return cdef.id; }));
-        selection = cql3::selection::selection::wildcard(s);
+        std::vector<const column_definition*> columns;
+        for (const column_definition& cdef : s->partition_key_columns()) {
+            columns.push_back(&cdef);
+        }
+        for (const column_definition& cdef : s->clustering_key_columns()) {
+            columns.push_back(&cdef);
+        }
+        query::column_id_vector regular_columns;
+        const column_definition* cd = s->get_column_definition(column_name);
+        if (cd && cd->is_regular()) {
+            columns.push_back(cd);
+            regular_columns.push_back(cd->id);
+        }
+        selection = cql3::selection::selection::for_columns(s, std::move(columns));
         query::partition_slice::option_set opts = selection->get_query_options();
         opts.set<query::partition_slice::option::allow_short_read>();
         // It is important that the scan bypass cache to avoid polluting it:
@@ -600,6 +643,7 @@ static future<> scan_table_ranges(
         if (!expiration_column) {
             continue;
         }
+        std::vector<mutation> expired_items;
         for (const auto& row : rows) {
             const managed_bytes_opt& cell = row[*expiration_column];
             if (!cell) {
@@ -639,11 +683,11 @@ static future<> scan_table_ranges(
             if (expired) {
                 expiration_stats.items_deleted++;
                 // FIXME: maybe don't recalculate new_timestamp() all the time
-                // FIXME: if expire_item() throws on timeout, we need to retry it.
                 auto ts = api::new_timestamp();
-                co_await expire_item(proxy, *scan_ctx.query_state_ptr, row, s, ts);
+                add_expired_item(expired_items, row, s, ts);
             }
         }
+        co_await expire_items(proxy, *scan_ctx.query_state_ptr, std::move(expired_items), abort_source);
         // FIXME: once in a while, persist p->state(), so on reboot
         // we don't start from scratch.
     }
@@ -35,6 +35,7 @@
 #include "db/system_keyspace.hh"
 #include <seastar/http/exception.hh>
 #include <seastar/core/coroutine.hh>
+#include <seastar/coroutine/maybe_yield.hh>
 #include <seastar/coroutine/parallel_for_each.hh>
 #include "repair/row_level.hh"
 #include "locator/snitch_base.hh"
@@ -1171,6 +1172,41 @@ void set_storage_service(http_context& ctx, routes& r, sharded<service::storage_
         return res;
     });
 
+    ss::get_latency_breakdowns.set(r, [](std::unique_ptr<http::request> req) -> future<json::json_return_type> {
+        const auto threshold = req_param<long>(*req, "threshold", 0).value;
+        using breakdowns = std::vector<std::pair<unsigned, tracing::latency_breakdown>>;
+        auto res = co_await tracing::tracing::tracing_instance().map_reduce0([threshold] (const tracing::tracing& local_tracing) {
+            breakdowns res;
+            local_tracing.latency_breakdowns().for_each([&] (const tracing::latency_breakdown& b) {
+                if (b.duration_us >= threshold) {
+                    res.emplace_back(this_shard_id(), b);
+                }
+            });
+            return res;
+        }, breakdowns(), [] (breakdowns a, breakdowns b) {
+            std::move(b.begin(), b.end(), std::back_inserter(a));
+            return a;
+        });
+        std::vector<ss::latency_breakdown> ret;
+        ret.reserve(res.size());
+        for (auto& [shard, b] : res) {
+            ss::latency_breakdown lb;
+            lb.session_id = fmt::to_string(b.session_id);
+            lb.shard = shard;
+            lb.started_at = std::chrono::duration_cast<std::chrono::microseconds>(b.started_at.time_since_epoch()).count();
+            lb.duration = b.duration_us;
+            for (uint8_t i = 0; i < b.size; ++i) {
+                ss::request_stage_offset so;
+                so.stage = fmt::to_string(b.stages[i].stage);
+                so.offset = b.stages[i].offset_us;
+                lb.stages.push(std::move(so));
+            }
+            ret.push_back(std::move(lb));
+            co_await coroutine::maybe_yield();
+        }
+        co_return json::json_return_type(std::move(ret));
+    });
+
     ss::set_slow_query.set(r, [](std::unique_ptr<http::request> req) {
         auto enable = req->get_query_param("enable");
         auto ttl = req->get_query_param("ttl");
@@ -1610,6 +1646,7 @@ void unset_storage_service(http_context& ctx, routes& r) {
     ss::set_trace_probability.unset(r);
     ss::get_trace_probability.unset(r);
     ss::get_slow_query_info.unset(r);
+    ss::get_latency_breakdowns.unset(r);
     ss::set_slow_query.unset(r);
     ss::deliver_hints.unset(r);
     ss::get_cluster_name.unset(r);
@@ -10,6 +10,7 @@
 
 #include "auth/password_authenticator.hh"
 
+#include <limits>
 #include <random>
 #include <string_view>
 #include <optional>
@@ -17,10 +18,12 @@
 #include <boost/algorithm/cxx11/all_of.hpp>
 #include <seastar/core/seastar.hh>
 #include <seastar/core/sleep.hh>
+#include <seastar/coroutine/as_future.hh>
 
 #include "auth/authenticated_user.hh"
 #include "auth/common.hh"
 #include "auth/passwords.hh"
+#include "auth/password_hashing_thread_pool.hh"
 #include "auth/roles-metadata.hh"
 #include "cql3/untyped_result_set.hh"
 #include "log.hh"
@@ -29,6 +32,7 @@
 #include "replica/database.hh"
 #include "cql3/query_processor.hh"
 #include "db/config.hh"
+#include "utils/hashers.hh"
 
 namespace auth {
 
@@ -51,6 +55,15 @@ static const class_registrator<
 
 static thread_local auto rng_for_salt = std::default_random_engine(std::random_device{}());
 
+// Password checks a shard may have on the hashing thread pool at a time.
+static constexpr size_t max_concurrent_checks = 8;
+// Password checks a shard lets wait for the hashing thread pool before it
+// starts rejecting logins, rather than queueing them for longer than clients
+// would wait.
+static constexpr size_t max_queued_checks = 1000;
+// Successful password checks a shard remembers at a time.
+static constexpr size_t max_verified_credentials = 1000;
+
 static std::string_view get_config_value(std::string_view value, std::string_view def) {
     return value.empty() ? def : value;
 }
@@ -68,7 +81,18 @@ password_authenticator::password_authenticator(cql3::query_processor& qp, ::serv
     , _migration_manager(mm)
     , _stopped(make_ready_future<>()) 
     , _superuser(default_superuser(qp.db().get_config()))
-{}
+    , _hashing_pool(qp.db().get_config().password_hashing_threads()
+            ? passwords::hashing_thread_pool::get(qp.db().get_config().password_hashing_threads())
+            : nullptr)
+    , _digest_key(bytes::initialized_later(), 32)
+    , _checks_sem(max_concurrent_checks)
+{
+    std::random_device rd;
+    std::uniform_int_distribution<int> dist(std::numeric_limits<int8_t>::min(), std::numeric_limits<int8_t>::max());
+    for (auto& b : _digest_key) {
+        b = dist(rd);
+    }
+}
 
 static bool has_salted_hash(const cql3::untyped_result_set_row& row) {
     return !row.get_or<sstring>(SALTED_HASH, "").empty();
@@ -178,7 +202,9 @@ future<> password_authenticator::start() {
 
 future<> password_authenticator::stop() {
     _as.request_abort();
-    return _stopped.handle_exception_type([] (const sleep_aborted&) { }).handle_exception_type([](const abort_requested_exception&) {});
+    return _checks_gate.close().then([this] {
+        return _stopped.handle_exception_type([] (const sleep_aborted&) { }).handle_exception_type([](const abort_requested_exception&) {});
+    });
 }
 
 db::consistency_level password_authenticator::consistency_for_user(std::string_view role_name) {
@@ -240,7 +266,7 @@ future<authenticated_user> password_authenticator::authenticate(
         if (!res->empty()) {
             salted_hash = res->one().get_opt<sstring>(SALTED_HASH);
         }
-        if (!salted_hash || !passwords::check(password, *salted_hash)) {
+        if (!salted_hash || !co_await check_password(password, *salted_hash)) {
             throw exceptions::authentication_exception("Username and/or password are incorrect");
         }
         co_return username;
@@ -257,6 +283,77 @@ future<authenticated_user> password_authenticator::authenticate(
     }
 }
 
+password_authenticator::credentials_digest
+password_authenticator::digest_credentials(const sstring& password, const sstring& salted_hash) const {
+    sha256_hasher h;
+    h.update(reinterpret_cast<const char*>(_digest_key.data()), _digest_key.size());
+    // Both are prefixed with their length, so that no other pair of strings
+    // hashes the same.
+    for (const auto& s : {std::cref(salted_hash), std::cref(password)}) {
+        const uint64_t size = s.get().size();
+        h.update(reinterpret_cast<const char*>(&size), sizeof(size));
+        h.update(s.get().data(), s.get().size());
+    }
+    return h.finalize_array();
+}
+
+future<bool> password_authenticator::check_password(const sstring& password, const sstring& salted_hash) const {
+    const auto digest = digest_credentials(password, salted_hash);
+    if (auto it = _verified_credentials.find(salted_hash); it != _verified_credentials.end()) {
+        if (it->second.expiry > lowres_clock::now() && it->second.digest == digest) {
+            co_return true;
+        }
+    }
+
+    // Wait for a check of the same credentials which is already running,
+    // instead of hashing the password once more.
+    if (auto it = _pending_checks.find(salted_hash); it != _pending_checks.end() && it->second.digest == digest) {
+        co_return co_await it->second.result.get_future();
+    }
+
+    if (_checks_sem.waiters() >= max_queued_checks) {
+        throw exceptions::authentication_exception("Too many concurrent authentication attempts, try again later");
+    }
+
+    // Only one check per salted hash is shared at a time: the others, with a
+    // different password, are not expected to be common.
+    shared_future<bool> result(do_check_password(password, salted_hash));
+    const bool shared = _pending_checks.try_emplace(salted_hash, pending_check{digest, result}).second;
+    auto f = co_await coroutine::as_future(result.get_future());
+    if (shared) {
+        _pending_checks.erase(salted_hash);
+    }
+    const bool ok = co_await std::move(f);
+    if (ok) {
+        remember_verified_credentials(salted_hash, digest);
+    }
+    co_return ok;
+}
+
+future<bool> password_authenticator::do_check_password(sstring password, sstring salted_hash) const {
+    if (!_hashing_pool) {
+        co_return passwords::check(password, salted_hash);
+    }
+    auto holder = _checks_gate.hold();
+    auto units = co_await get_units(_checks_sem, 1);
+    co_return co_await _hashing_pool->check(std::move(password), std::move(salted_hash));
+}
+
+void password_authenticator::remember_verified_credentials(const sstring& salted_hash, const credentials_digest& digest) const {
+    const auto validity = std::chrono::milliseconds(_qp.db().get_config().credentials_validity_in_ms());
+    if (validity == std::chrono::milliseconds::zero()) {
+        return;
+    }
+    const auto now = lowres_clock::now();
+    if (_verified_credentials.size() >= max_verified_credentials && !_verified_credentials.contains(salted_hash)) {
+        std::erase_if(_verified_credentials, [now] (const auto& x) { return x.second.expiry <= now; });
+        if (_verified_credentials.size() >= max_verified_credentials) {
+            _verified_credentials.erase(_verified_credentials.begin());
+        }
+    }
+    _verified_credentials.insert_or_assign(salted_hash, verified_credentials{digest, now + validity});
+}
+
 future<> password_authenticator::create(std::string_view role_name, const authentication_options& options, ::service::group0_batch& mc) {
     if (!options.password) {
         co_return;
@@ -10,8 +10,15 @@
 
 #pragma once
 
+#include <array>
+
 #include <seastar/core/abort_source.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/semaphore.hh>
+#include <seastar/core/shared_future.hh>
 
+#include "bytes.hh"
 #include "db/consistency_level_type.hh"
 #include "auth/authenticator.hh"
 #include "service/raft/raft_group0_client.hh"
@@ -32,6 +39,10 @@ class migration_manager;
 
 namespace auth {
 
+namespace passwords {
+class hashing_thread_pool;
+}
+
 extern const std::string_view password_authenticator_name;
 
 class password_authenticator : public authenticator {
@@ -42,6 +53,35 @@ class password_authenticator : public authenticator {
     abort_source _as;
     std::string _superuser;
 
+    // Passwords are checked by hashing them, which is expensive by design, so
+    // it's done on a thread pool (unless password_hashing_threads is 0), and
+    // successful checks are remembered for a while
+    // (credentials_validity_in_ms), either way. Clients tend to open many
+    // connections at once with the same credentials, which are then checked
+    // only once.
+    //
+    // Neither the passwords nor anything which could be used to find them
+    // faster than by hashing candidates with the stored salted hash are kept:
+    // a check is identified by a digest of the password and the salted hash,
+    // keyed with a secret of the shard.
+    using credentials_digest = std::array<uint8_t, 32>;
+    struct verified_credentials {
+        credentials_digest digest;
+        lowres_clock::time_point expiry;
+    };
+    struct pending_check {
+        credentials_digest digest;
+        shared_future<bool> result;
+    };
+    std::shared_ptr<passwords::hashing_thread_pool> _hashing_pool;
+    bytes _digest_key;
+    // Bounds the checks each shard has on the thread pool at a time.
+    mutable semaphore _checks_sem;
+    mutable gate _checks_gate;
+    // Keyed by the salted hash.
+    mutable std::unordered_map<sstring, verified_credentials> _verified_credentials;
+    mutable std::unordered_map<sstring, pending_check> _pending_checks;
+
 public:
     static db::consistency_level consistency_for_user(std::string_view role_name);
     static std::string default_superuser(const db::config&);
@@ -84,6 +124,14 @@ class password_authenticator : public authenticator {
     future<> create_default_if_missing();
 
     sstring update_row_query() const;
+
+    credentials_digest digest_credentials(const sstring& password, const sstring& salted_hash) const;
+
+    future<bool> check_password(const sstring& password, const sstring& salted_hash) const;
+
+    future<bool> do_check_password(sstring password, sstring salted_hash) const;
+
+    void remember_verified_credentials(const sstring& salted_hash, const credentials_digest& digest) const;
 };
 
 }
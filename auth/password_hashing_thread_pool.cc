@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include "auth/password_hashing_thread_pool.hh"
+
+#include <mutex>
+
+#include <seastar/core/alien.hh>
+#include <seastar/core/reactor.hh>
+
+#include "auth/passwords.hh"
+#include "log.hh"
+
+namespace auth::passwords {
+
+static logging::logger hlogger("password_hashing");
+
+hashing_thread_pool::hashing_thread_pool(unsigned nr_threads)
+    : _worker(nr_threads, hlogger, "password hashing")
+{ }
+
+std::shared_ptr<hashing_thread_pool> hashing_thread_pool::get(unsigned nr_threads) {
+    static std::mutex mut;
+    static std::weak_ptr<hashing_thread_pool> instance;
+
+    std::unique_lock lock(mut);
+    auto pool = instance.lock();
+    if (!pool) {
+        pool = std::make_shared<hashing_thread_pool>(nr_threads);
+        instance = pool;
+    }
+    return pool;
+}
+
+future<bool> hashing_thread_pool::check(sstring pass, sstring salted_hash) {
+    auto p = std::make_unique<promise<bool>>();
+    auto f = p->get_future();
+    _worker.submit([pass = std::move(pass), salted_hash = std::move(salted_hash), p = std::move(p),
+            &alien = engine().alien(), shard = this_shard_id()] () mutable {
+        // The strings and the promise belong to the shard, so they are
+        // handed back to it to be destroyed there.
+        try {
+            bool ok = passwords::check(pass, salted_hash);
+            alien::run_on(alien, shard, [pass = std::move(pass), salted_hash = std::move(salted_hash), p = std::move(p), ok] () mutable noexcept {
+                p->set_value(ok);
+            });
+        } catch (...) {
+            alien::run_on(alien, shard, [pass = std::move(pass), salted_hash = std::move(salted_hash), p = std::move(p), eptr = std::current_exception()] () mutable noexcept {
+                p->set_exception(std::move(eptr));
+            });
+        }
+    });
+    return f;
+}
+
+} // namespace auth::passwords
@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <memory>
+
+#include <seastar/core/future.hh>
+#include <seastar/core/sstring.hh>
+
+#include "seastarx.hh"
+#include "utils/alien_worker.hh"
+
+namespace auth::passwords {
+
+///
+/// A few OS threads, outside of the reactor, to check passwords on.
+///
+/// Checking a password hashes it with the scheme of the stored salted hash, which is made to be expensive (bcrypt and
+/// sha-512 crypt take milliseconds). Doing it on the reactor stalls every request of the shard, and a storm of
+/// (re)connections can keep a shard stalled for seconds.
+///
+/// The pool is shared by all shards. Checks are run in the order they were submitted, and their results are sent
+/// back to the shard which submitted them. The threads are niced, so that they don't compete with the reactors.
+///
+class hashing_thread_pool {
+    utils::alien_worker _worker;
+
+public:
+    explicit hashing_thread_pool(unsigned nr_threads);
+    hashing_thread_pool(const hashing_thread_pool&) = delete;
+    hashing_thread_pool& operator=(const hashing_thread_pool&) = delete;
+
+    ///
+    /// Returns the pool of the process, starting it with `nr_threads` threads if it isn't running yet.
+    ///
+    /// The pool is stopped once all the pointers to it are gone, which must happen only after all the checks it was
+    /// given have completed.
+    ///
+    static std::shared_ptr<hashing_thread_pool> get(unsigned nr_threads);
+
+    ///
+    /// Does what \ref check does, on one of the threads of the pool.
+    ///
+    future<bool> check(sstring pass, sstring salted_hash);
+};
+
+} // namespace auth::passwords
@@ -574,9 +574,22 @@ class compaction {
         cfg.run_identifier = _run_identifier;
         cfg.replay_position = _rp;
         cfg.sstable_level = _sstable_level;
+        cfg.repaired_at = repaired_at();
         return cfg;
     }
 
+    // The output is repaired only if all of the input is, and only as of the
+    // least recent of the repairs.
+    uint64_t repaired_at() const {
+        if (_sstables.empty()) {
+            return 0;
+        }
+        auto m = std::min_element(_sstables.begin(), _sstables.end(), [] (const shared_sstable& sst1, const shared_sstable& sst2) {
+            return sst1->get_repaired_at() < sst2->get_repaired_at();
+        });
+        return (*m)->get_repaired_at();
+    }
+
     api::timestamp_type maximum_timestamp() const {
         auto m = std::max_element(_sstables.begin(), _sstables.end(), [] (const shared_sstable& sst1, const shared_sstable& sst2) {
             return sst1->get_stats_metadata().max_timestamp < sst2->get_stats_metadata().max_timestamp;
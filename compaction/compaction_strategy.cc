@@ -10,6 +10,7 @@
  */
 
 #include <vector>
+#include <algorithm>
 #include <chrono>
 #include <fmt/ranges.h>
 #include <seastar/core/shared_ptr.hh>
@@ -695,8 +696,58 @@ compaction_strategy_type compaction_strategy::type() const {
     return _compaction_strategy_impl->type();
 }
 
+namespace {
+
+// Offers only the repaired, or only the unrepaired, candidates to a strategy,
+// so that repaired and unrepaired data are never compacted together and
+// incremental repair can keep skipping the former.
+class repaired_filtering_strategy_control : public strategy_control {
+    strategy_control& _control;
+    bool _repaired;
+public:
+    repaired_filtering_strategy_control(strategy_control& control, bool repaired)
+        : _control(control)
+        , _repaired(repaired)
+    {}
+
+    virtual bool has_ongoing_compaction(table_state& table_s) const noexcept override {
+        return _control.has_ongoing_compaction(table_s);
+    }
+
+    virtual std::vector<sstables::shared_sstable> candidates(table_state& table_s) const override {
+        auto candidates = _control.candidates(table_s);
+        std::erase_if(candidates, [this] (const shared_sstable& sst) {
+            return sst->is_repaired() != _repaired;
+        });
+        return candidates;
+    }
+
+    virtual std::vector<sstables::frozen_sstable_run> candidates_as_runs(table_state& table_s) const override {
+        auto runs = _control.candidates_as_runs(table_s);
+        std::erase_if(runs, [this] (const sstables::frozen_sstable_run& run) {
+            return std::ranges::any_of(run->all(), [this] (const shared_sstable& sst) {
+                return sst->is_repaired() != _repaired;
+            });
+        });
+        return runs;
+    }
+};
+
+}
+
 compaction_descriptor compaction_strategy::get_sstables_for_compaction(table_state& table_s, strategy_control& control) {
-    return _compaction_strategy_impl->get_sstables_for_compaction(table_s, control);
+    if (std::ranges::none_of(*table_s.main_sstable_set().all(), std::mem_fn(&sstable::is_repaired))) {
+        return _compaction_strategy_impl->get_sstables_for_compaction(table_s, control);
+    }
+    // Unrepaired sstables first, as that is where new writes land.
+    for (bool repaired : {false, true}) {
+        repaired_filtering_strategy_control filtering_control(control, repaired);
+        auto desc = _compaction_strategy_impl->get_sstables_for_compaction(table_s, filtering_control);
+        if (!desc.sstables.empty()) {
+            return desc;
+        }
+    }
+    return compaction_descriptor();
 }
 
 compaction_descriptor compaction_strategy::get_major_compaction_job(table_state& table_s, std::vector<sstables::shared_sstable> candidates) {
@@ -729,6 +780,18 @@ compaction_backlog_tracker compaction_strategy::make_backlog_tracker() const {
 
 sstables::compaction_descriptor
 compaction_strategy::get_reshaping_job(std::vector<shared_sstable> input, schema_ptr schema, reshape_config cfg) const {
+    // Like regular compaction, reshape doesn't mix repaired and unrepaired
+    // sstables. Once the unrepaired ones are reshaped, the caller asks again
+    // with what remains.
+    auto unrepaired_begin = std::ranges::partition(input, std::mem_fn(&sstable::is_repaired)).begin();
+    if (unrepaired_begin != input.begin() && unrepaired_begin != input.end()) {
+        std::vector<shared_sstable> unrepaired(std::make_move_iterator(unrepaired_begin), std::make_move_iterator(input.end()));
+        input.erase(unrepaired_begin, input.end());
+        auto desc = _compaction_strategy_impl->get_reshaping_job(std::move(unrepaired), schema, cfg);
+        if (!desc.sstables.empty()) {
+            return desc;
+        }
+    }
     return _compaction_strategy_impl->get_reshaping_job(std::move(input), schema, cfg);
 }
 
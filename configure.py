@@ -505,6 +505,8 @@ scylla_tests = set([
     'test/boost/linearizing_input_stream_test',
     'test/boost/loading_cache_test',
     'test/boost/log_heap_test',
+    'test/boost/iblt_test',
+    'test/boost/tournament_tree_test',
     'test/boost/estimated_histogram_test',
     'test/boost/summary_test',
     'test/boost/logalloc_test',
@@ -563,6 +565,7 @@ scylla_tests = set([
     'test/boost/sstable_move_test',
     'test/boost/statement_restrictions_test',
     'test/boost/storage_proxy_test',
+    'test/boost/stream_blob_test',
     'test/boost/top_k_test',
     'test/boost/transport_test',
     'test/boost/types_test',
@@ -622,6 +625,7 @@ scylla_tests = set([
     'test/perf/perf_mutation',
     'test/perf/perf_collection',
     'test/perf/perf_row_cache_reads',
+    'test/perf/perf_sstable_set',
     'test/perf/logalloc',
     'test/perf/perf_s3_client',
     'test/unit/lsa_async_eviction_test',
@@ -823,6 +827,7 @@ scylla_core = (['message/messaging_service.cc',
                 'utils/limiting_data_source.cc',
                 'utils/updateable_value.cc',
                 'utils/directories.cc',
+                'utils/alien_worker.cc',
                 'gms/generation-number.cc',
                 'utils/rjson.cc',
                 'utils/human_readable.cc',
@@ -997,6 +1002,7 @@ scylla_core = (['message/messaging_service.cc',
                 'db/commitlog/commitlog_replayer.cc',
                 'db/commitlog/commitlog_entry.cc',
                 'db/data_listeners.cc',
+                'db/heavy_hitters.cc',
                 'db/functions/function.cc',
                 'db/hints/internal/hint_endpoint_manager.cc',
                 'db/hints/internal/hint_sender.cc',
@@ -1019,6 +1025,7 @@ scylla_core = (['message/messaging_service.cc',
                 'db/snapshot-ctl.cc',
                 'db/rate_limiter.cc',
                 'db/per_partition_rate_limit_options.cc',
+                'db/sstable_index_options.cc',
                 'index/secondary_index_manager.cc',
                 'index/secondary_index.cc',
                 'utils/UUID_gen.cc',
@@ -1092,6 +1099,7 @@ scylla_core = (['message/messaging_service.cc',
                 'streaming/session_info.cc',
                 'streaming/stream_coordinator.cc',
                 'streaming/stream_manager.cc',
+                'streaming/stream_blob.cc',
                 'streaming/stream_result_future.cc',
                 'streaming/stream_session_state.cc',
                 'streaming/consumer.cc',
@@ -1099,6 +1107,7 @@ scylla_core = (['message/messaging_service.cc',
                 'partition_slice_builder.cc',
                 'init.cc',
                 'utils/lister.cc',
+                'repair/background_repair.cc',
                 'repair/repair.cc',
                 'repair/row_level.cc',
                 'repair/table_check.cc',
@@ -1113,6 +1122,7 @@ scylla_core = (['message/messaging_service.cc',
                 'auth/roles-metadata.cc',
                 'auth/passwords.cc',
                 'auth/password_authenticator.cc',
+                'auth/password_hashing_thread_pool.cc',
                 'auth/permission.cc',
                 'auth/permissions_cache.cc',
                 'auth/service.cc',
@@ -1374,6 +1384,8 @@ pure_boost_tests = set([
     'test/boost/serialization_test',
     'test/boost/small_vector_test',
     'test/boost/top_k_test',
+    'test/boost/iblt_test',
+    'test/boost/tournament_tree_test',
     'test/boost/vint_serialization_test',
     'test/boost/bptree_test',
     'test/boost/utf8_test',
@@ -1450,6 +1462,8 @@ deps['test/boost/UUID_test'] = ['utils/UUID_gen.cc', 'test/boost/UUID_test.cc',
 deps['test/boost/murmur_hash_test'] = ['bytes.cc', 'utils/murmur_hash.cc', 'test/boost/murmur_hash_test.cc']
 deps['test/boost/allocation_strategy_test'] = ['test/boost/allocation_strategy_test.cc', 'utils/logalloc.cc', 'utils/dynamic_bitset.cc']
 deps['test/boost/log_heap_test'] = ['test/boost/log_heap_test.cc']
+deps['test/boost/tournament_tree_test'] = ['test/boost/tournament_tree_test.cc']
+deps['test/boost/iblt_test'] = ['test/boost/iblt_test.cc']
 deps['test/boost/estimated_histogram_test'] = ['test/boost/estimated_histogram_test.cc']
 deps['test/boost/summary_test'] = ['test/boost/summary_test.cc']
 deps['test/boost/anchorless_list_test'] = ['test/boost/anchorless_list_test.cc']
@@ -10,6 +10,8 @@
 #include "seastarx.hh"
 #include "cql3/statements/create_service_level_statement.hh"
 #include "service/qos/service_level_controller.hh"
+#include "gms/feature_service.hh"
+#include "data_dictionary/data_dictionary.hh"
 #include "service/client_state.hh"
 #include "service/query_state.hh"
 
@@ -26,6 +28,9 @@ create_service_level_statement::create_service_level_statement(sstring service_l
 std::unique_ptr<cql3::statements::prepared_statement>
 cql3::statements::create_service_level_statement::prepare(
         data_dictionary::database db, cql_stats &stats) {
+    if (qos::get_shares(_slo) && !db.features().workload_prioritization) {
+        throw exceptions::invalid_request_exception("Service level shares are not supported until all nodes are upgraded");
+    }
     return std::make_unique<prepared_statement>(::make_shared<create_service_level_statement>(*this));
 }
 
@@ -30,6 +30,7 @@
 #include "service/migration_manager.hh"
 #include "service/storage_proxy.hh"
 #include "db/config.hh"
+#include "db/sstable_index_options.hh"
 #include "compaction/time_window_compaction_strategy.hh"
 
 namespace cql3 {
@@ -104,7 +105,9 @@ create_table_statement::prepare_schema_mutations(query_processor& qp, const quer
 schema_ptr create_table_statement::get_cf_meta_data(const data_dictionary::database db) const {
     schema_builder builder{keyspace(), column_family(), _id};
     apply_properties_to(builder, db);
-    return builder.build(_use_compact_storage ? schema_builder::compact_storage::yes : schema_builder::compact_storage::no);
+    auto s = builder.build(_use_compact_storage ? schema_builder::compact_storage::yes : schema_builder::compact_storage::no);
+    db::validate_sstable_index_options(*s);
+    return s;
 }
 
 void create_table_statement::apply_properties_to(schema_builder& builder, const data_dictionary::database db) const {
@@ -85,6 +85,13 @@ list_effective_service_level_statement::execute(query_processor& qp, service::qu
         utf8_type->decompose(slo->effective_names->timeout),
         decompose_timeout(slo->timeout)
     });
+    if (auto shares = qos::get_shares(*slo)) {
+        rs->add_row({
+            utf8_type->decompose("shares"),
+            utf8_type->decompose(slo->effective_names->shares),
+            utf8_type->decompose(fmt::to_string(*shares))
+        });
+    }
 
     auto rows = ::make_shared<cql_transport::messages::result_message::rows>(result(std::move(std::move(rs))));
     co_return ::static_pointer_cast<cql_transport::messages::result_message>(rows);    
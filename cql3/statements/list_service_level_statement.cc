@@ -49,7 +49,8 @@ list_service_level_statement::execute(query_processor& qp,
 
     static thread_local const std::vector<lw_shared_ptr<column_specification>> metadata({make_column("service_level", utf8_type),
         make_column("timeout", duration_type),
-        make_column("workload_type", utf8_type)
+        make_column("workload_type", utf8_type),
+        make_column("shares", int32_type)
     });
 
     return make_ready_future().then([this, &state] () {
@@ -79,10 +80,12 @@ list_service_level_statement::execute(query_processor& qp,
                     bytes_opt workload = slo.workload == qos::service_level_options::workload_type::unspecified
                             ? bytes_opt()
                             : utf8_type->decompose(qos::service_level_options::to_string(slo.workload));
+                    auto shares = qos::get_shares(slo);
                     rs->add_row(std::vector<bytes_opt>{
                             utf8_type->decompose(sl_name),
                             d(slo.timeout),
-                            workload});
+                            workload,
+                            shares ? int32_type->decompose(*shares) : bytes_opt()});
                 }
 
                 auto rows = ::make_shared<cql_transport::messages::result_message::rows>(result(std::move(std::move(rs))));
@@ -17,7 +17,7 @@ namespace statements {
 
 void sl_prop_defs::validate() {
     static std::set<sstring> timeout_props {
-        "timeout", "workload_type"
+        "timeout", "workload_type", "shares"
     };
     auto get_duration = [&] (const std::optional<sstring>& repr) -> qos::service_level_options::timeout_type {
         if (!repr) {
@@ -55,6 +55,19 @@ void sl_prop_defs::validate() {
             _slo.workload = qos::service_level_options::workload_type::delete_marker;
         }
     }
+    auto shares_string_opt = get_simple("shares");
+    if (shares_string_opt) {
+        if (boost::algorithm::iequals(*shares_string_opt, "null")) {
+            _slo.shares = qos::service_level_options::delete_marker{};
+        } else {
+            auto shares = to_int("shares", shares_string_opt, 0);
+            if (shares < qos::service_level_options::min_shares || shares > qos::service_level_options::max_shares) {
+                throw exceptions::invalid_request_exception(format("Shares must be between {} and {}, got {}",
+                        qos::service_level_options::min_shares, qos::service_level_options::max_shares, shares));
+            }
+            _slo.shares = shares;
+        }
+    }
 }
 
 qos::service_level_options sl_prop_defs::get_service_level_options() const {
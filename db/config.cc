@@ -27,6 +27,7 @@
 #include "cdc/cdc_extension.hh"
 #include "tombstone_gc_extension.hh"
 #include "db/per_partition_rate_limit_extension.hh"
+#include "db/sstable_index_extension.hh"
 #include "db/tags/extension.hh"
 #include "config.hh"
 #include "extensions.hh"
@@ -886,6 +887,10 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Refresh interval for permissions cache (if enabled). After this interval, cache entries become eligible for refresh. An async reload is scheduled every permissions_update_interval_in_ms time period and the old value is returned until it completes. If permissions_validity_in_ms has a non-zero value, then this property must also have a non-zero value. It's recommended to set this value to be at least 3 times smaller than the permissions_validity_in_ms.")
     , permissions_cache_max_entries(this, "permissions_cache_max_entries", liveness::LiveUpdate, value_status::Used, 1000,
         "Maximum cached permission entries. Must have a non-zero value if permissions caching is enabled (see a permissions_validity_in_ms description).")
+    , credentials_validity_in_ms(this, "credentials_validity_in_ms", liveness::LiveUpdate, value_status::Used, 2000,
+        "How long a successfully checked password is remembered by PasswordAuthenticator, so that clients opening many connections at once with the same credentials don't have the password hashed for each of them. Changing the password of a role forgets it right away. Set to 0 to check the password on every login.")
+    , password_hashing_threads(this, "password_hashing_threads", value_status::Used, 2,
+        "The number of threads, shared by all shards, on which PasswordAuthenticator checks passwords, so that hashing them doesn't stall the shards. Set to 0 to check passwords on the shards themselves.")
     , server_encryption_options(this, "server_encryption_options", value_status::Used, {/*none*/},
         "Enable or disable inter-node encryption. You must also generate keys and provide the appropriate key and trust store locations and passwords. The available options are:\n"
         "* internode_encryption: (Default: none) Enable or disable encryption of inter-node communication using the TLS_RSA_WITH_AES_128_CBC_SHA cipher suite for authentication, key exchange, and encryption of data transfers. The available inter-node options are:\n"
@@ -930,6 +935,8 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "The SSL port for encrypted communication. Unused unless enabled in encryption_options.")
     , enable_in_memory_data_store(this, "enable_in_memory_data_store", value_status::Used, false, "Enable in memory mode (system tables are always persisted).")
     , enable_cache(this, "enable_cache", value_status::Used, true, "Enable cache.")
+    , heavy_hitters_sample_every(this, "heavy_hitters_sample_every", liveness::LiveUpdate, value_status::Used, 0,
+        "Count one in this many reads and writes, on average, to find the partitions of each table which get the most of them, listed in system.heavy_hitters. 0 (the default) disables it.")
     , enable_commitlog(this, "enable_commitlog", value_status::Used, true, "Enable commitlog.")
     , volatile_system_keyspace_for_testing(this, "volatile_system_keyspace_for_testing", value_status::Used, false, "Don't persist system keyspace - testing only!")
     , api_port(this, "api_port", value_status::Used, 10000, "Http Rest API port.")
@@ -950,6 +957,12 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , enable_compacting_data_for_streaming_and_repair(this, "enable_compacting_data_for_streaming_and_repair", liveness::LiveUpdate, value_status::Used, true, "Enable the compacting reader, which compacts the data for streaming and repair (load'n'stream included) before sending it to, or synchronizing it with peers. Can reduce the amount of data to be processed by removing dead data, but adds CPU overhead.")
     , repair_partition_count_estimation_ratio(this, "repair_partition_count_estimation_ratio", liveness::LiveUpdate, value_status::Used, 0.1,
         "Specify the fraction of partitions written by repair out of the total partitions. The value is currently only used for bloom filter estimation. Value is between 0 and 1.")
+    , enable_incremental_repair(this, "enable_incremental_repair", liveness::LiveUpdate, value_status::Used, false,
+        "Repair only the data written since the previous repair of tables using tablets: sstables are marked as repaired once their range is repaired on all replicas, and are skipped by later repairs. Should be set on all nodes alike. Repair with this disabled to repair all of the data.")
+    , enable_background_repair(this, "enable_background_repair", liveness::LiveUpdate, value_status::Used, false,
+        "Continuously repair, in the background, the tablets this node is the primary replica of, so that each is repaired at least once every half of its table's gc_grace_seconds. Progress is kept in system.repair_history, so it carries on where it stopped after a restart.")
+    , background_repair_latency_target_in_ms(this, "background_repair_latency_target_in_ms", liveness::LiveUpdate, value_status::Used, 10,
+        "The 99th percentile latency of reads and writes coordinated by this node which background repair slows down to stay under, unless a tablet is getting close to gc_grace_seconds without a repair. Set to 0 to repair at full speed.")
     , ring_delay_ms(this, "ring_delay_ms", value_status::Used, 30 * 1000, "Time a node waits to hear from other nodes before joining the ring in milliseconds. Same as -Dcassandra.ring_delay_ms in cassandra.")
     , shadow_round_ms(this, "shadow_round_ms", value_status::Used, 300 * 1000, "The maximum gossip shadow round time. Can be used to reduce the gossip feature check time during node boot up.")
     , fd_max_interval_ms(this, "fd_max_interval_ms", value_status::Used, 2 * 1000, "The maximum failure_detector interval time in milliseconds. Interval larger than the maximum will be ignored. Larger cluster may need to increase the default.")
@@ -980,6 +993,8 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         " Performance is affected to some extent as a result. Useful to help debugging problems that may arise at another layers.")
     , cpu_scheduler(this, "cpu_scheduler", value_status::Used, true, "Enable cpu scheduling.")
     , view_building(this, "view_building", value_status::Used, true, "Enable view building; should only be set to false when the node is experience issues due to view building.")
+    , view_update_coalescing_window_in_ms(this, "view_update_coalescing_window_in_ms", liveness::LiveUpdate, value_status::Used, 0,
+        "How long asynchronous updates of a remote view replica are held back, so that the ones of the same view partition are merged into a single write. 0 (the default) sends every update right away.")
     , enable_sstables_mc_format(this, "enable_sstables_mc_format", value_status::Unused, true, "Enable SSTables 'mc' format to be used as the default file format.  Deprecated, please use \"sstable_format\" instead.")
     , enable_sstables_md_format(this, "enable_sstables_md_format", value_status::Unused, true, "Enable SSTables 'md' format to be used as the default file format.  Deprecated, please use \"sstable_format\" instead.")
     , sstable_format(this, "sstable_format", value_status::Used, "me", "Default sstable file format", {"md", "me"})
@@ -1132,12 +1147,22 @@ db::config::config(std::shared_ptr<db::extensions> exts)
          "Allows target tablet size to be configured. Defaults to 5G (in bytes). Maintaining tablets at reasonable sizes is important to be able to " \
          "redistribute load. A higher value means tablet migration throughput can be reduced. A lower value may cause number of tablets to increase significantly, " \
          "potentially resulting in performance drawbacks.")
+    , target_tablet_request_rate(this, "target_tablet_request_rate", liveness::LiveUpdate, value_status::Used, 5000,
+         "Target rate of requests served by a tablet replica, in requests per second, where each 4KiB of data transferred counts as a request. " \
+         "Tables whose tablets serve twice this rate on average are split, as long as they have less tablet replicas than there are shards, " \
+         "so that their traffic can be spread over more shards. Tables are not merged unless their tablets serve less than a quarter of it. " \
+         "Set to 0 to resize tables by size only.")
+    , tablet_request_rate_resize_delay_in_seconds(this, "tablet_request_rate_resize_delay_in_seconds", liveness::LiveUpdate, value_status::Used, 300,
+         "For how long the request rate of a table's tablets must stay above (or below) the thresholds derived from target_tablet_request_rate " \
+         "before the table is split (or merged) on account of it.")
     , replication_strategy_warn_list(this, "replication_strategy_warn_list", liveness::LiveUpdate, value_status::Used, {locator::replication_strategy_type::simple}, "Controls which replication strategies to warn about when creating/altering a keyspace. Doesn't affect the pre-existing keyspaces.")
     , replication_strategy_fail_list(this, "replication_strategy_fail_list", liveness::LiveUpdate, value_status::Used, {}, "Controls which replication strategies are disallowed to be used when creating/altering a keyspace. Doesn't affect the pre-existing keyspaces.")
     , service_levels_interval(this, "service_levels_interval_ms", liveness::LiveUpdate, value_status::Used, 10000, "Controls how often service levels module polls configuration table")
     , error_injections_at_startup(this, "error_injections_at_startup", error_injection_value_status, {}, "List of error injections that should be enabled on startup.")
     , topology_barrier_stall_detector_threshold_seconds(this, "topology_barrier_stall_detector_threshold_seconds", value_status::Used, 2, "Report sites blocking topology barrier if it takes longer than this.")
     , enable_tablets(this, "enable_tablets", value_status::Used, false, "Enable tablets for newly created keyspaces")
+    , enable_file_stream(this, "enable_file_stream", liveness::LiveUpdate, value_status::Used, true,
+        "Stream the sstables of a migrating tablet as whole files, instead of as mutations, whenever the sstables belong to the tablet alone.")
     , default_log_level(this, "default_log_level", value_status::Used)
     , logger_log_level(this, "logger_log_level", value_status::Used)
     , log_to_stdout(this, "log_to_stdout", value_status::Used)
@@ -1162,6 +1187,10 @@ void db::config::add_per_partition_rate_limit_extension() {
     _extensions->add_schema_extension<db::per_partition_rate_limit_extension>(db::per_partition_rate_limit_extension::NAME);
 }
 
+void db::config::add_sstable_index_extension() {
+    _extensions->add_schema_extension<db::sstable_index_extension>(db::sstable_index_extension::NAME);
+}
+
 void db::config::add_tags_extension() {
     _extensions->add_schema_extension<db::tags_extension>(db::tags_extension::NAME);
 }
@@ -1324,6 +1353,7 @@ std::map<sstring, db::experimental_features_t::feature> db::experimental_feature
         {"broadcast-tables", feature::BROADCAST_TABLES},
         {"keyspace-storage-options", feature::KEYSPACE_STORAGE_OPTIONS},
         {"tablets", feature::UNUSED},
+        {"sstable-index", feature::SSTABLE_INDEX},
     };
 }
 
@@ -109,6 +109,7 @@ struct experimental_features_t {
         ALTERNATOR_STREAMS,
         BROADCAST_TABLES,
         KEYSPACE_STORAGE_OPTIONS,
+        SSTABLE_INDEX,
     };
     static std::map<sstring, feature> map(); // See enum_option.
     static std::vector<enum_option<experimental_features_t>> all();
@@ -138,6 +139,7 @@ class config final : public utils::config_file {
     // For testing only
     void add_cdc_extension();
     void add_per_partition_rate_limit_extension();
+    void add_sstable_index_extension();
     void add_tags_extension();
     void add_tombstone_gc_extension();
 
@@ -313,12 +315,15 @@ class config final : public utils::config_file {
     named_value<uint32_t> permissions_validity_in_ms;
     named_value<uint32_t> permissions_update_interval_in_ms;
     named_value<uint32_t> permissions_cache_max_entries;
+    named_value<uint32_t> credentials_validity_in_ms;
+    named_value<uint32_t> password_hashing_threads;
     named_value<string_map> server_encryption_options;
     named_value<string_map> client_encryption_options;
     named_value<string_map> alternator_encryption_options;
     named_value<uint32_t> ssl_storage_port;
     named_value<bool> enable_in_memory_data_store;
     named_value<bool> enable_cache;
+    named_value<uint32_t> heavy_hitters_sample_every;
     named_value<bool> enable_commitlog;
     named_value<bool> volatile_system_keyspace_for_testing;
     named_value<uint16_t> api_port;
@@ -338,6 +343,9 @@ class config final : public utils::config_file {
     named_value<sstring> allowed_repair_based_node_ops;
     named_value<bool> enable_compacting_data_for_streaming_and_repair;
     named_value<double> repair_partition_count_estimation_ratio;
+    named_value<bool> enable_incremental_repair;
+    named_value<bool> enable_background_repair;
+    named_value<uint32_t> background_repair_latency_target_in_ms;
     named_value<uint32_t> ring_delay_ms;
     named_value<uint32_t> shadow_round_ms;
     named_value<uint32_t> fd_max_interval_ms;
@@ -365,6 +373,7 @@ class config final : public utils::config_file {
     named_value<bool> enable_sstable_key_validation;
     named_value<bool> cpu_scheduler;
     named_value<bool> view_building;
+    named_value<uint32_t> view_update_coalescing_window_in_ms;
     named_value<bool> enable_sstables_mc_format;
     named_value<bool> enable_sstables_md_format;
     named_value<sstring> sstable_format;
@@ -472,6 +481,8 @@ class config final : public utils::config_file {
 
     named_value<int> tablets_initial_scale_factor;
     named_value<uint64_t> target_tablet_size_in_bytes;
+    named_value<uint64_t> target_tablet_request_rate;
+    named_value<uint32_t> tablet_request_rate_resize_delay_in_seconds;
 
     named_value<std::vector<enum_option<replication_strategy_restriction_t>>> replication_strategy_warn_list;
     named_value<std::vector<enum_option<replication_strategy_restriction_t>>> replication_strategy_fail_list;
@@ -487,6 +498,7 @@ class config final : public utils::config_file {
     named_value<std::vector<error_injection_at_startup>> error_injections_at_startup;
     named_value<double> topology_barrier_stall_detector_threshold_seconds;
     named_value<bool> enable_tablets;
+    named_value<bool> enable_file_stream;
 
     static const sstring default_tls_priority;
 private:
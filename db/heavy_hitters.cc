@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <algorithm>
+#include <limits>
+
+#include <seastar/core/metrics.hh>
+
+#include "db/heavy_hitters.hh"
+#include "mutation/frozen_mutation.hh"
+#include "replica/database.hh"
+
+extern logging::logger dblog;
+
+namespace db {
+
+std::string_view to_string(heavy_hitters::operation op) noexcept {
+    switch (op) {
+    case heavy_hitters::operation::reads: return "reads";
+    case heavy_hitters::operation::writes: return "writes";
+    case heavy_hitters::operation::written_kib: return "written_kib";
+    }
+    abort();
+}
+
+heavy_hitters::heavy_hitters(replica::database& db, utils::updateable_value<uint32_t> sample_every)
+        : _db(db)
+        , _sample_every(std::move(sample_every))
+        , _sample_every_observer(_sample_every.observe([this] (const uint32_t& n) { set_enabled(n); }))
+        , _rnd(std::random_device{}())
+        , _window_timer([this] { roll_window(); }) {
+    set_enabled(_sample_every());
+    register_metrics();
+}
+
+heavy_hitters::~heavy_hitters() {
+    _db.data_listeners().uninstall(this);
+}
+
+void heavy_hitters::set_enabled(bool enabled) {
+    if (enabled == _enabled) {
+        return;
+    }
+    if (enabled) {
+        _db.data_listeners().install(this);
+        _window_timer.arm_periodic(window);
+    } else {
+        _db.data_listeners().uninstall(this);
+        _window_timer.cancel();
+        // Don't keep listing what was hot before it was disabled.
+        _tables.clear();
+        for (auto& counts : _top_counts) {
+            counts.fill(0);
+        }
+    }
+    _enabled = enabled;
+}
+
+void heavy_hitters::register_metrics() {
+    namespace sm = seastar::metrics;
+    auto op_label = sm::label("operation");
+    auto rank_label = sm::label("rank");
+    std::vector<sm::metric_definition> defs;
+    for (size_t op = 0; op < nr_operations; ++op) {
+        for (size_t rank = 0; rank < max_metrics_ranks; ++rank) {
+            defs.emplace_back(sm::make_gauge("top_partition_count", [this, op, rank] { return _top_counts[op][rank]; },
+                    sm::description("Estimated count of the operations on the partitions of this shard which got the most of them in the last window, by rank. "
+                                    "The partitions are listed in system.heavy_hitters."),
+                    {op_label(sstring(to_string(operation(op)))), rank_label(rank + 1)}));
+        }
+    }
+    defs.emplace_back(sm::make_counter("sampled_operations", _sampled,
+            sm::description("Number of operations counted by the heavy hitters sketches.")));
+    _metrics.add_group("heavy_hitters", defs);
+}
+
+bool heavy_hitters::sample() noexcept {
+    if (--_countdown) {
+        return false;
+    }
+    // Pick the next sample at random, one in _sample_every on average, so
+    // that regular patterns of operations aren't missed.
+    auto n = _sample_every();
+    _countdown = n > 1 ? std::uniform_int_distribution<uint32_t>(1, 2 * n - 1)(_rnd) : 1;
+    return true;
+}
+
+void heavy_hitters::account(const schema_ptr& s, const dht::decorated_key& dk, operation op, uint64_t count) noexcept {
+    if (is_internal_keyspace(s->ks_name())) {
+        return;
+    }
+    ++_sampled;
+    try {
+        auto& t = _tables[s->id()];
+        t.schema = s;
+        t.current[size_t(op)].append(dk, unsigned(std::min<uint64_t>(count, std::numeric_limits<unsigned>::max())));
+    } catch (...) {
+        // Losing a sample is better than failing the operation. The sketch
+        // is reset at the end of the window if it was left invalid.
+        dblog.debug("heavy_hitters: failed to account an operation on {}.{}: {}", s->ks_name(), s->cf_name(), std::current_exception());
+    }
+}
+
+flat_mutation_reader_v2 heavy_hitters::on_read(const schema_ptr& s, const dht::partition_range& range,
+        const query::partition_slice& slice, flat_mutation_reader_v2&& rd) {
+    auto sample_every = _sample_every();
+    if (sample_every && range.is_singular() && range.start()->value().has_key() && sample()) {
+        account(s, range.start()->value().as_decorated_key(), operation::reads, sample_every);
+    }
+    return std::move(rd);
+}
+
+void heavy_hitters::on_write(const schema_ptr& s, const frozen_mutation& m) {
+    auto sample_every = _sample_every();
+    if (sample_every && sample()) {
+        auto dk = m.decorated_key(*s);
+        account(s, dk, operation::writes, sample_every);
+        auto kib = (m.representation().size() + 1023) / 1024;
+        account(s, dk, operation::written_kib, kib * sample_every);
+    }
+}
+
+void heavy_hitters::roll_window() {
+    std::array<std::vector<uint64_t>, nr_operations> counts;
+    for (auto it = _tables.begin(); it != _tables.end();) {
+        auto& t = it->second;
+        bool idle = true;
+        for (size_t op = 0; op < nr_operations; ++op) {
+            auto& sketch = t.current[op];
+            try {
+                t.last[op] = sketch.valid() ? sketch.top(max_results) : top_k::results();
+            } catch (...) {
+                t.last[op] = {};
+            }
+            idle &= t.last[op].empty();
+            for (auto& r : t.last[op]) {
+                counts[op].push_back(r.count);
+            }
+            sketch = top_k(capacity);
+        }
+        // Forget the tables which had nothing in the window, including
+        // the dropped ones.
+        if (idle) {
+            it = _tables.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    for (size_t op = 0; op < nr_operations; ++op) {
+        auto& c = counts[op];
+        auto n = std::min(c.size(), max_metrics_ranks);
+        std::partial_sort(c.begin(), c.begin() + n, c.end(), std::greater<uint64_t>());
+        _top_counts[op].fill(0);
+        std::copy_n(c.begin(), n, _top_counts[op].begin());
+    }
+}
+
+std::vector<heavy_hitters::table_results> heavy_hitters::get_results(std::string_view ks_name) const {
+    std::vector<table_results> ret;
+    for (auto& [id, t] : _tables) {
+        if (t.schema->ks_name() != ks_name) {
+            continue;
+        }
+        for (size_t op = 0; op < nr_operations; ++op) {
+            if (t.last[op].empty()) {
+                continue;
+            }
+            table_results tr{id, t.schema->ks_name(), t.schema->cf_name(), operation(op), {}};
+            tr.items.reserve(t.last[op].size());
+            for (auto& r : t.last[op]) {
+                tr.items.push_back(item{fmt::to_string(r.item.key().with_schema(*t.schema)), r.count, r.error});
+            }
+            ret.push_back(std::move(tr));
+        }
+    }
+    return ret;
+}
+
+} // namespace db
@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <array>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/metrics_registration.hh>
+#include <seastar/core/timer.hh>
+
+#include "db/data_listeners.hh"
+#include "dht/decorated_key.hh"
+#include "utils/top_k.hh"
+#include "utils/updateable_value.hh"
+
+namespace replica {
+class database;
+}
+
+namespace db {
+
+// Keeps track, all the time, of the partitions of each table which get the
+// most reads, writes and written bytes, unlike the toppartitions API which
+// only does it for the duration it is asked for.
+//
+// Operations are sampled, one in heavy_hitters_sample_every on average, and
+// the sampled ones are counted in a space-saving sketch per table and kind
+// of operation, which keeps the counts of a bounded number of partitions.
+// The sketches are reset every window, after the top partitions of the
+// window are taken out of them.
+//
+// Only single partition reads are counted; scans have no hot partition.
+// Internal keyspaces aren't tracked.
+//
+// The listener is only installed while heavy_hitters_sample_every isn't 0,
+// so that disabling it takes the reads and writes off it entirely.
+//
+// Each shard has its own, for the partitions it owns.
+class heavy_hitters : public data_listener {
+public:
+    enum class operation : uint8_t {
+        reads,
+        writes,
+        written_kib,
+    };
+    static constexpr size_t nr_operations = 3;
+
+    // The partitions tracked per table and operation.
+    static constexpr size_t capacity = 64;
+    // The top partitions kept of each window, per table and operation.
+    static constexpr size_t max_results = 10;
+    // The top partitions of a shard, across tables, exported as metrics.
+    static constexpr size_t max_metrics_ranks = 5;
+    static constexpr std::chrono::seconds window = std::chrono::seconds(60);
+
+    struct item {
+        sstring key;
+        // Estimated, may be over by up to error.
+        uint64_t count;
+        uint64_t error;
+    };
+
+    // The top partitions of a table for an operation, in the last window,
+    // hottest first.
+    struct table_results {
+        table_id id;
+        sstring ks_name;
+        sstring cf_name;
+        operation op;
+        std::vector<item> items;
+    };
+private:
+    struct key_hash {
+        size_t operator()(const dht::decorated_key& k) const noexcept {
+            return std::hash<dht::token>()(k.token());
+        }
+    };
+
+    // A table's partition key can't change, so neither can the
+    // representation of a partition key.
+    struct key_equal {
+        bool operator()(const dht::decorated_key& k1, const dht::decorated_key& k2) const noexcept {
+            return k1.token() == k2.token() && k1.key().representation() == k2.key().representation();
+        }
+    };
+
+    using top_k = utils::space_saving_top_k<dht::decorated_key, key_hash, key_equal>;
+
+    struct table_sketches {
+        // The latest one seen, to print the partition keys with.
+        schema_ptr schema;
+        std::array<top_k, nr_operations> current{top_k(capacity), top_k(capacity), top_k(capacity)};
+        std::array<top_k::results, nr_operations> last;
+    };
+
+    replica::database& _db;
+    utils::updateable_value<uint32_t> _sample_every;
+    utils::observer<uint32_t> _sample_every_observer;
+    // Whether the listener is installed.
+    bool _enabled = false;
+    uint32_t _countdown = 1;
+    std::minstd_rand _rnd;
+    std::unordered_map<table_id, table_sketches> _tables;
+    timer<lowres_clock> _window_timer;
+    std::array<std::array<uint64_t, max_metrics_ranks>, nr_operations> _top_counts = {};
+    uint64_t _sampled = 0;
+    seastar::metrics::metric_groups _metrics;
+private:
+    void set_enabled(bool enabled);
+    bool sample() noexcept;
+    void account(const schema_ptr& s, const dht::decorated_key& dk, operation op, uint64_t count) noexcept;
+    void register_metrics();
+public:
+    heavy_hitters(replica::database& db, utils::updateable_value<uint32_t> sample_every);
+    ~heavy_hitters();
+
+    virtual flat_mutation_reader_v2 on_read(const schema_ptr& s, const dht::partition_range& range,
+            const query::partition_slice& slice, flat_mutation_reader_v2&& rd) override;
+    virtual void on_write(const schema_ptr& s, const frozen_mutation& m) override;
+
+    bool enabled() const noexcept {
+        return _enabled;
+    }
+
+    // Ends the current window. Called every window.
+    void roll_window();
+
+    // The top partitions of the last window, of the tables of the keyspace.
+    std::vector<table_results> get_results(std::string_view ks_name) const;
+};
+
+std::string_view to_string(heavy_hitters::operation op) noexcept;
+
+} // namespace db
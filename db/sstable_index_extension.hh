@@ -0,0 +1,42 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "db/sstable_index_options.hh"
+#include "schema/schema.hh"
+#include "serializer.hh"
+
+namespace db {
+
+class sstable_index_extension : public schema_extension {
+    sstable_index_options _options;
+public:
+    static constexpr auto NAME = "sstable_index";
+
+    sstable_index_extension() = default;
+    sstable_index_extension(const sstable_index_options& opts) : _options(opts) {}
+
+    explicit sstable_index_extension(const std::map<sstring, sstring>& tags) : _options(tags) {}
+    explicit sstable_index_extension(const bytes& b) : _options(deserialize(b)) {}
+    explicit sstable_index_extension(const sstring& s) {
+        throw std::logic_error("Cannot create sstable index info from string");
+    }
+
+    bytes serialize() const override {
+        return ser::serialize_to_buffer<bytes>(_options.to_map());
+    }
+    static std::map<sstring, sstring> deserialize(const bytes_view& buffer) {
+        return ser::deserialize_from_buffer(buffer, boost::type<std::map<sstring, sstring>>());
+    }
+    const sstable_index_options& get_options() const {
+        return _options;
+    }
+};
+
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <boost/algorithm/string.hpp>
+#include <boost/range/adaptor/map.hpp>
+#include "db/sstable_index_options.hh"
+#include "db/sstable_index_extension.hh"
+#include "exceptions/exceptions.hh"
+#include "schema/schema.hh"
+
+namespace db {
+
+const char* sstable_index_options::columns_key = "columns";
+
+sstable_index_options::sstable_index_options(std::map<sstring, sstring> map) {
+    if (auto it = map.find(columns_key); it != map.end()) {
+        std::vector<std::string> names;
+        boost::split(names, it->second, boost::is_any_of(","));
+        for (auto& name : names) {
+            boost::trim(name);
+            if (name.empty()) {
+                continue;
+            }
+            if (std::find(_columns.begin(), _columns.end(), name) != _columns.end()) {
+                throw exceptions::configuration_exception(format("Duplicate column {} in sstable_index", name));
+            }
+            _columns.emplace_back(name);
+        }
+        map.erase(it);
+    }
+
+    if (!map.empty()) {
+        throw exceptions::configuration_exception(format(
+                "Unknown keys in map for sstable_index extension: {}",
+                fmt::join(map | boost::adaptors::map_keys, ", ")));
+    }
+}
+
+std::map<sstring, sstring> sstable_index_options::to_map() const {
+    std::map<sstring, sstring> ret;
+    if (!_columns.empty()) {
+        ret.emplace(columns_key, fmt::to_string(fmt::join(_columns, ",")));
+    }
+    return ret;
+}
+
+static const sstable_index_options* find_sstable_index_options(const schema& s) {
+    auto it = s.extensions().find(sstable_index_extension::NAME);
+    if (it == s.extensions().end()) {
+        return nullptr;
+    }
+    return &dynamic_pointer_cast<sstable_index_extension>(it->second)->get_options();
+}
+
+static bool can_be_indexed(const column_definition& cdef) {
+    return cdef.is_regular() && !cdef.type->is_multi_cell() && !cdef.type->is_counter() && !cdef.type->references_duration();
+}
+
+std::vector<const column_definition*> get_sstable_indexed_columns(const schema& s) {
+    std::vector<const column_definition*> ret;
+    if (auto opts = find_sstable_index_options(s)) {
+        for (auto& name : opts->columns()) {
+            // Columns may have been dropped since the index was defined.
+            auto cdef = s.get_column_definition(to_bytes(name));
+            if (cdef && can_be_indexed(*cdef)) {
+                ret.push_back(cdef);
+            }
+        }
+    }
+    return ret;
+}
+
+void validate_sstable_index_options(const schema& s) {
+    auto opts = find_sstable_index_options(s);
+    if (!opts) {
+        return;
+    }
+    for (auto& name : opts->columns()) {
+        auto cdef = s.get_column_definition(to_bytes(name));
+        if (!cdef) {
+            throw exceptions::invalid_request_exception(format("No column definition found for column {} of sstable_index", name));
+        }
+        if (!can_be_indexed(*cdef)) {
+            throw exceptions::invalid_request_exception(format("sstable_index only supports regular columns which aren't counters, durations "
+                    "or non-frozen collections and UDTs, but got {}", name));
+        }
+    }
+}
+
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <map>
+#include <vector>
+
+#include <seastar/core/sstring.hh>
+
+#include "schema/schema_fwd.hh"
+
+using namespace seastar;
+
+class column_definition;
+
+namespace db {
+
+// The columns of a table whose values are indexed by every sstable of the
+// table, in the sstable's ColumnIndex component, rather than by a
+// materialized view. Set with the sstable_index table option, e.g.
+//
+//   CREATE TABLE ks.t (...) WITH sstable_index = {'columns': 'v1, v2'}
+class sstable_index_options final {
+private:
+    static const char* columns_key;
+
+private:
+    std::vector<sstring> _columns;
+
+public:
+    sstable_index_options() = default;
+    sstable_index_options(std::map<sstring, sstring> map);
+
+    std::map<sstring, sstring> to_map() const;
+
+    const std::vector<sstring>& columns() const {
+        return _columns;
+    }
+};
+
+// Returns the columns of the table which are indexed by its sstables.
+std::vector<const column_definition*> get_sstable_indexed_columns(const schema& s);
+
+// Throws if the sstable index of the table names a column which it doesn't
+// have, or which cannot be indexed.
+void validate_sstable_index_options(const schema& s);
+
+}
@@ -22,6 +22,7 @@
 #include "service/storage_proxy.hh"
 #include "service/migration_manager.hh"
 #include "locator/host_id.hh"
+#include "gms/feature_service.hh"
 
 #include <seastar/core/seastar.hh>
 #include <seastar/core/shared_ptr.hh>
@@ -210,7 +211,8 @@ system_distributed_keyspace::system_distributed_keyspace(cql3::query_processor&
 
 static thread_local std::pair<std::string_view, data_type> new_columns[] {
     {"timeout", duration_type},
-    {"workload_type", utf8_type}
+    {"workload_type", utf8_type},
+    {"shares", int32_type}
 };
 
 static schema_ptr get_current_service_levels(data_dictionary::database db) {
@@ -792,6 +794,15 @@ future<> system_distributed_keyspace::set_service_level(sstring service_level_na
                     workload,
                     service_level_name},
                 cql3::query_processor::cache_internal::no);
+    // Nodes which don't know about shares don't have the column.
+    if (_sp.features().workload_prioritization) {
+        auto shares = qos::get_shares(slo);
+        co_await _qp.execute_internal(format("UPDATE {}.{} SET shares = ? WHERE service_level = ?;", NAME, SERVICE_LEVELS),
+                db::consistency_level::ONE,
+                internal_distributed_query_state(),
+                {shares ? data_value(*shares) : data_value::make_null(int32_type), service_level_name},
+                cql3::query_processor::cache_internal::no);
+    }
 }
 
 future<> system_distributed_keyspace::drop_service_level(sstring service_level_name) const {
@@ -1139,7 +1139,8 @@ schema_ptr system_keyspace::service_levels_v2() {
                 .with_column("service_level", utf8_type, column_kind::partition_key)
                 .with_column("timeout", duration_type)
                 .with_column("workload_type", utf8_type)
-                .with_version(db::system_keyspace::generate_schema_version(id))
+                .with_column("shares", int32_type)
+                .with_version(db::system_keyspace::generate_schema_version(id, 1))
                 .build();
     }();
     return schema;
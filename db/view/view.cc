@@ -11,6 +11,7 @@
 #include <boost/range/adaptor/transformed.hpp>
 #include <deque>
 #include <functional>
+#include <ranges>
 #include <optional>
 #include <unordered_set>
 #include <vector>
@@ -27,6 +28,8 @@
 
 #include <seastar/core/future-util.hh>
 #include <seastar/core/coroutine.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/coroutine/as_future.hh>
 #include <seastar/coroutine/maybe_yield.hh>
 
 #include "replica/database.hh"
@@ -66,6 +69,7 @@
 #include "delete_ghost_rows_visitor.hh"
 #include "locator/host_id.hh"
 #include "cartesian_product.hh"
+#include "db/view/view_update_coalescer.hh"
 
 using namespace std::chrono_literals;
 
@@ -267,6 +271,8 @@ void stats::register_stats() {
                     {_cf_label, _ks_label}),
             ms::make_total_operations("view_updates_failed_remote", view_updates_failed_remote, ms::description("Number of updates (mutations) that failed to be pushed to remote view replicas"),
                     {_cf_label, _ks_label}),
+            ms::make_total_operations("view_updates_coalesced", view_updates_coalesced, ms::description("Number of updates (mutations) merged into another update of the same view partition before being pushed to remote view replicas"),
+                    {_cf_label, _ks_label}),
             ms::make_total_operations("view_updates_pushed_local", view_updates_pushed_local, ms::description("Number of updates (mutations) pushed to local view replicas"),
                     {_cf_label, _ks_label}),
             ms::make_total_operations("view_updates_failed_local", view_updates_failed_local, ms::description("Number of updates (mutations) that failed to be pushed to local view replicas"),
@@ -1770,7 +1776,9 @@ future<> view_update_generator::mutate_MV(
         }
 
         future<> local_view_update = make_ready_future<>();
+        bool applied_locally = false;
         if (target_endpoint && *target_endpoint == my_address) {
+            applied_locally = true;
             ++stats.view_updates_pushed_local;
             ++cf_stats.total_view_updates_pushed_local;
             ++stats.writes;
@@ -1811,46 +1819,126 @@ future<> view_update_generator::mutate_MV(
         // is not local, or the local update was already applied but we still
         // have pending endpoints to send to.
         if (target_endpoint) {
-            size_t updates_pushed_remote = remote_endpoints.size() + 1;
-            stats.view_updates_pushed_remote += updates_pushed_remote;
-            cf_stats.total_view_updates_pushed_remote += updates_pushed_remote;
-            schema_ptr s = mut.s;
-            future<> remote_view_update = apply_to_remote_endpoints(_proxy.local(), std::move(view_ermp), *target_endpoint, std::move(remote_endpoints), std::move(mut), base_token, view_token, allow_hints, tr_state).then_wrapped(
-                [s = std::move(s), &stats, &cf_stats, tr_state, base_token, view_token, target_endpoint, updates_pushed_remote,
-                 sem_units, apply_update_synchronously, this] (future<>&& f) mutable {
-                sem_units = nullptr;
-                _proxy.local().update_view_update_backlog();
-                if (f.failed()) {
-                    stats.view_updates_failed_remote += updates_pushed_remote;
-                    cf_stats.total_view_updates_failed_remote += updates_pushed_remote;
-                    auto ep = f.get_exception();
-                    tracing::trace(tr_state, "Failed to apply view update for {} and {} remote endpoints",
-                        *target_endpoint, updates_pushed_remote);
-
-                    // Printing an error on every failed view mutation would cause log spam, so a rate limit is needed.
-                    static thread_local logger::rate_limit view_update_error_rate_limit(std::chrono::seconds(4));
-                    vlogger.log(log_level::warn, view_update_error_rate_limit,
-                        "Error applying view update to {} (view: {}.{}, base token: {}, view token: {}): {}",
-                        *target_endpoint, s->ks_name(), s->cf_name(), base_token, view_token, ep);
-                    return apply_update_synchronously ? make_exception_future<>(std::move(ep)) : make_ready_future<>();
+            remote_view_update u{std::move(mut), std::move(view_ermp), *target_endpoint, std::move(remote_endpoints), base_token, view_token,
+                    allow_hints, tr_state, std::move(sem_units), &stats, &cf_stats};
+            const auto coalescing_window = std::chrono::milliseconds(_db.get_config().view_update_coalescing_window_in_ms());
+            // Updates which are waited for aren't held back, and neither are
+            // the ones also applied locally, which share their units with the
+            // local write.
+            if (!apply_update_synchronously && !applied_locally && coalescing_window.count()) {
+                tracing::trace(tr_state, "Holding back view update for {}.{} to {} to coalesce it; base token = {}; view token = {}",
+                        u.mut.s->ks_name(), u.mut.s->cf_name(), u.target, base_token, view_token);
+                if (auto ready = _coalescer->add(std::move(u))) {
+                    (void)send_to_remote_view_replicas(std::move(*ready), false);
                 }
-                tracing::trace(tr_state, "Successfully applied view update for {} and {} remote endpoints",
-                    *target_endpoint, updates_pushed_remote);
-                return make_ready_future<>();
-            });
+                if (!_coalescer->empty() && !_coalesce_timer.armed()) {
+                    _coalesce_timer.arm(coalescing_window);
+                }
+                co_return;
+            }
+            future<> remote_update = send_to_remote_view_replicas(std::move(u), apply_update_synchronously);
             if (apply_update_synchronously) {
                 co_return co_await when_all_succeed(
-                    std::move(local_view_update), std::move(remote_view_update)).discard_result();
+                    std::move(local_view_update), std::move(remote_update)).discard_result();
             } else {
                 // The update is sent to background in order to preserve availability,
                 // its parallelism is limited by view_update_concurrency_semaphore
-                (void)remote_view_update;
+                (void)remote_update;
             }
         }
         co_return co_await std::move(local_view_update);
     });
 }
 
+future<> view_update_generator::send_to_remote_view_replicas(remote_view_update u, bool apply_update_synchronously) {
+    auto& stats = *u.stats;
+    auto& cf_stats = *u.cf_stats;
+    size_t updates_pushed_remote = u.pending_endpoints.size() + 1;
+    stats.view_updates_pushed_remote += updates_pushed_remote;
+    cf_stats.total_view_updates_pushed_remote += updates_pushed_remote;
+    stats.view_updates_coalesced += u.count - 1;
+    schema_ptr s = u.mut.s;
+    return apply_to_remote_endpoints(_proxy.local(), std::move(u.ermp), u.target, std::move(u.pending_endpoints), std::move(u.mut), u.base_token, u.view_token, u.allow_hints, u.tr_state).then_wrapped(
+        [s = std::move(s), &stats, &cf_stats, tr_state = u.tr_state, base_token = u.base_token, view_token = u.view_token, target_endpoint = u.target, updates_pushed_remote,
+         sem_units = std::move(u.units), apply_update_synchronously, this] (future<>&& f) mutable {
+        sem_units = nullptr;
+        _proxy.local().update_view_update_backlog();
+        if (f.failed()) {
+            stats.view_updates_failed_remote += updates_pushed_remote;
+            cf_stats.total_view_updates_failed_remote += updates_pushed_remote;
+            auto ep = f.get_exception();
+            tracing::trace(tr_state, "Failed to apply view update for {} and {} remote endpoints",
+                target_endpoint, updates_pushed_remote);
+
+            // Printing an error on every failed view mutation would cause log spam, so a rate limit is needed.
+            static thread_local logger::rate_limit view_update_error_rate_limit(std::chrono::seconds(4));
+            vlogger.log(log_level::warn, view_update_error_rate_limit,
+                "Error applying view update to {} (view: {}.{}, base token: {}, view token: {}): {}",
+                target_endpoint, s->ks_name(), s->cf_name(), base_token, view_token, ep);
+            return apply_update_synchronously ? make_exception_future<>(std::move(ep)) : make_ready_future<>();
+        }
+        tracing::trace(tr_state, "Successfully applied view update for {} and {} remote endpoints",
+            target_endpoint, updates_pushed_remote);
+        return make_ready_future<>();
+    });
+}
+
+void view_update_generator::send_coalesced_view_updates() {
+    for (auto& u : _coalescer->take_all()) {
+        // Coalesced updates aren't waited for, so sending them cannot fail.
+        (void)send_to_remote_view_replicas(std::move(u), false);
+    }
+}
+
+remote_view_update view_update_coalescer::finish(pending_update p) {
+    if (p.merged) {
+        p.update.mut.fm = freeze(*p.merged);
+    }
+    return std::move(p.update);
+}
+
+std::optional<remote_view_update> view_update_coalescer::add(remote_view_update u) {
+    const auto& s = *u.mut.s;
+    auto& pending = _pending.try_emplace(s.id(), 16, partition_key::hashing(s), partition_key::equality(s)).first->second;
+    auto key = u.mut.fm.key();
+    const auto size = u.mut.fm.representation().size();
+    auto [begin, end] = pending.equal_range(key);
+    auto it = std::find_if(begin, end, [&u] (const auto& x) { return x.second.update.target == u.target; });
+    if (it == end) {
+        pending.emplace(std::move(key), pending_update{std::move(u), std::nullopt, size});
+        ++_count;
+        return std::nullopt;
+    }
+    auto& p = it->second;
+    // The pending endpoints of both updates are the same as long as the
+    // replication map is.
+    if (p.update.mut.s != u.mut.s || p.update.ermp != u.ermp || p.update.allow_hints != u.allow_hints || p.size + size > max_update_size) {
+        return finish(std::exchange(p, pending_update{std::move(u), std::nullopt, size}));
+    }
+    tracing::trace(u.tr_state, "Coalescing view update for {}.{} with {} other ones to {}", s.ks_name(), s.cf_name(), p.update.count, u.target);
+    if (!p.merged) {
+        p.merged = p.update.mut.fm.unfreeze(p.update.mut.s);
+    }
+    p.merged->apply(u.mut.fm.unfreeze(u.mut.s));
+    p.update.units->adopt(std::move(*u.units));
+    p.update.count += u.count;
+    p.size += size;
+    return std::nullopt;
+}
+
+std::vector<remote_view_update> view_update_coalescer::take_all() {
+    std::vector<remote_view_update> updates;
+    updates.reserve(_count);
+    for (auto& pending : _pending | std::views::values) {
+        for (auto& p : pending | std::views::values) {
+            updates.push_back(finish(std::move(p)));
+        }
+    }
+    _pending.clear();
+    _count = 0;
+    return updates;
+}
+
 view_builder::view_builder(replica::database& db, db::system_keyspace& sys_ks, db::system_distributed_keyspace& sys_dist_ks, service::migration_notifier& mn, view_update_generator& vug)
         : _db(db)
         , _sys_ks(sys_ks)
@@ -2328,6 +2416,56 @@ future<> view_builder::do_build_step() {
     });
 }
 
+// The batches of base rows read by a build step whose view updates are
+// still being generated and propagated.
+class view_builder::batches_in_flight {
+    seastar::semaphore _sem{max_batches_in_flight};
+    seastar::gate _gate;
+    std::exception_ptr _ex;
+
+    static future<> populate_views(shared_ptr<view_update_generator> gen, lw_shared_ptr<replica::column_family> base, std::vector<view_and_base> views,
+            dht::token base_token, flat_mutation_reader_v2 reader, gc_clock::time_point now) {
+        auto f = co_await coroutine::as_future(futurize_invoke([&] {
+            inject_failure("view_builder_populate_views");
+            return gen->populate_views(*base, std::move(views), base_token, std::move(reader), now);
+        }));
+        if (f.failed()) {
+            co_await reader.close();
+            co_await std::move(f);
+        }
+    }
+public:
+    // Must be called in a seastar thread. Waits for a batch to complete if
+    // too many are in flight already, and fails if any batch did.
+    void add(shared_ptr<view_update_generator> gen, lw_shared_ptr<replica::column_family> base, std::vector<view_and_base> views,
+            dht::token base_token, flat_mutation_reader_v2 reader, gc_clock::time_point now) {
+        auto units = seastar::get_units(_sem, 1).get();
+        if (_ex) {
+            reader.close().get();
+            std::rethrow_exception(_ex);
+        }
+        (void)seastar::with_gate(_gate, [this, gen = std::move(gen), base = std::move(base), views = std::move(views), base_token,
+                reader = std::move(reader), now, units = std::move(units)] () mutable {
+            return populate_views(std::move(gen), std::move(base), std::move(views), base_token, std::move(reader), now).handle_exception([this] (std::exception_ptr ex) {
+                if (!_ex) {
+                    _ex = std::move(ex);
+                }
+            }).finally([units = std::move(units)] {});
+        });
+    }
+
+    // Must be called in a seastar thread. Waits for all batches to complete,
+    // and fails if any did.
+    void wait() {
+        if (!_gate.is_closed()) {
+            _gate.close().get();
+        }
+        if (_ex) {
+            std::rethrow_exception(_ex);
+        }
+    }
+};
+
 // Called in the context of a seastar::thread.
 class view_builder::consumer {
 public:
@@ -2360,6 +2498,7 @@ class view_builder::consumer {
     view_builder& _builder;
     shared_ptr<view_update_generator> _gen;
     build_step& _step;
+    batches_in_flight& _batches;
     built_views _built_views;
     gc_clock::time_point _now;
     std::vector<view_ptr> _views_to_build;
@@ -2375,10 +2514,11 @@ class view_builder::consumer {
     // beyond our limit on mutation size (by default 32 MB).
     size_t _fragments_memory_usage = 0;
 public:
-    consumer(view_builder& builder, shared_ptr<view_update_generator> gen, build_step& step, gc_clock::time_point now)
+    consumer(view_builder& builder, shared_ptr<view_update_generator> gen, build_step& step, batches_in_flight& batches, gc_clock::time_point now)
             : _builder(builder)
             , _gen(std::move(gen))
             , _step(step)
+            , _batches(batches)
             , _built_views{step}
             , _now(now) {
         if (!step.current_key.key().is_empty(*_step.reader.schema())) {
@@ -2486,13 +2626,8 @@ class view_builder::consumer {
             auto reader = make_flat_mutation_reader_from_fragments(_step.reader.schema(), _builder._permit, std::move(_fragments));
             auto close_reader = defer([&reader] { reader.close().get(); });
             reader.upgrade_schema(base_schema);
-            _gen->populate_views(
-                    *_step.base,
-                    std::move(views),
-                    _step.current_token(),
-                    std::move(reader),
-                    _now).get();
             close_reader.cancel();
+            _batches.add(_gen, _step.base, std::move(views), _step.current_token(), std::move(reader), _now);
             _fragments.clear();
             _fragments_memory_usage = 0;
         }
@@ -2544,8 +2679,30 @@ void view_builder::execute(build_step& step, exponential_backoff_retry r) {
             step.pslice,
             batch_size,
             query::max_partitions);
-    auto consumer = compact_for_query_v2<view_builder::consumer>(compaction_state, view_builder::consumer{*this, _vug.shared_from_this(), step, now});
-    auto built = step.reader.consume_in_thread(std::move(consumer));
+    // The progress of the step is only recorded once the view updates of all
+    // the rows it read went through. If any of them failed, the step is
+    // rolled back to where it started, and retried from there.
+    auto start_key = step.current_key;
+    auto start_build_status = step.build_status;
+    batches_in_flight batches;
+    std::optional<consumer::built_views> built;
+    try {
+        auto consumer = compact_for_query_v2<view_builder::consumer>(compaction_state, view_builder::consumer{*this, _vug.shared_from_this(), step, batches, now});
+        built.emplace(step.reader.consume_in_thread(std::move(consumer)));
+        batches.wait();
+    } catch (...) {
+        try {
+            batches.wait();
+        } catch (...) {
+            // Already failing
+        }
+        if (built) {
+            built->release();
+        }
+        step.current_key = std::move(start_key);
+        step.build_status = std::move(start_build_status);
+        throw;
+    }
     if (auto ds = std::move(*compaction_state).detach_state()) {
         if (ds->current_tombstone) {
             step.reader.unpop_mutation_fragment(mutation_fragment_v2(*step.reader.schema(), step.reader.permit(), std::move(*ds->current_tombstone)));
@@ -2556,11 +2713,11 @@ void view_builder::execute(build_step& step, exponential_backoff_retry r) {
     _as.check();
 
     std::vector<future<>> bookkeeping_ops;
-    bookkeeping_ops.reserve(built.views.size() + step.build_status.size());
-    for (auto& [view, first_token, _] : built.views) {
+    bookkeeping_ops.reserve(built->views.size() + step.build_status.size());
+    for (auto& [view, first_token, _] : built->views) {
         bookkeeping_ops.push_back(maybe_mark_view_as_built(view, first_token));
     }
-    built.release();
+    built->release();
     for (auto& [view, _, next_token] : step.build_status) {
         if (next_token) {
             bookkeeping_ops.push_back(
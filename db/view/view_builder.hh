@@ -186,6 +186,9 @@ class view_builder final : public service::migration_listener::only_view_notific
     // collected batch_memory_max bytes, we can process the rows read so far.
     static constexpr size_t batch_size = 128;
     static constexpr size_t batch_memory_max = 1024*1024;
+    // The view updates of the rows read so far are generated and propagated
+    // while the next rows are read, for up to this many batches at once.
+    static constexpr size_t max_batches_in_flight = 16;
 
     replica::database& get_db() noexcept { return _db; }
 
@@ -239,6 +242,7 @@ class view_builder final : public service::migration_listener::only_view_notific
     void setup_metrics();
 
     struct consumer;
+    class batches_in_flight;
 };
 
 }
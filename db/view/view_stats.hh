@@ -19,6 +19,7 @@ struct stats : public service::storage_proxy_stats::write_stats {
     int64_t view_updates_pushed_remote = 0;
     int64_t view_updates_failed_local = 0;
     int64_t view_updates_failed_remote = 0;
+    int64_t view_updates_coalesced = 0;
     using label_instance = seastar::metrics::label_instance;
     stats(const sstring& category, label_instance ks_label, label_instance cf_label);
     void register_stats();
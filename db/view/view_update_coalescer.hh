@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include "db/timeout_clock.hh"
+#include "dht/token.hh"
+#include "gms/inet_address.hh"
+#include "keys.hh"
+#include "locator/abstract_replication_strategy.hh"
+#include "mutation/frozen_mutation.hh"
+#include "mutation/mutation.hh"
+#include "tracing/trace_state.hh"
+
+namespace replica {
+struct cf_stats;
+}
+
+namespace service {
+struct allow_hints_tag;
+using allow_hints = bool_class<allow_hints_tag>;
+}
+
+namespace db::view {
+
+class stats;
+
+// A view update bound for its paired view replica, and for the pending
+// replicas of its view token, none of which is the local node.
+struct remote_view_update {
+    frozen_mutation_and_schema mut;
+    locator::effective_replication_map_ptr ermp;
+    gms::inet_address target;
+    inet_address_vector_topology_change pending_endpoints;
+    dht::token base_token;
+    dht::token view_token;
+    service::allow_hints allow_hints;
+    tracing::trace_state_ptr tr_state;
+    // Accounts for the update in the view update backlog until it's done.
+    lw_shared_ptr<db::timeout_semaphore_units> units;
+    db::view::stats* stats;
+    replica::cf_stats* cf_stats;
+    // The number of view updates merged into this one.
+    size_t count = 1;
+};
+
+// Merges the remote view updates which nobody waits for and which are bound
+// for the same partition of the same view on the same view replica, so that
+// each view replica gets a single write for all of them. Updates are merged
+// until take_all() is called, typically a short while after the first one
+// was added. Merging a sequence of mutations of a partition and applying the
+// result has the same effect as applying them one by one, so only the number
+// of writes changes.
+class view_update_coalescer {
+public:
+    // Updates aren't merged past this size, to bound the latency of the
+    // writes and the memory needed to merge them.
+    static constexpr size_t max_update_size = 128 * 1024;
+private:
+    struct pending_update {
+        remote_view_update update;
+        // Engaged once another update is merged into this one.
+        std::optional<mutation> merged;
+        size_t size;
+    };
+    using pending_updates = std::unordered_multimap<partition_key, pending_update, partition_key::hashing, partition_key::equality>;
+    std::unordered_map<table_id, pending_updates> _pending;
+    size_t _count = 0;
+private:
+    static remote_view_update finish(pending_update p);
+public:
+    // Keeps the update to be merged with the following ones. Returns the
+    // pending update it cannot be merged with, if any, which has to be sent
+    // right away; that's when merging would make it too large, or when the
+    // view schema or replication map changed in the meantime.
+    std::optional<remote_view_update> add(remote_view_update u);
+
+    // Returns the updates kept since the previous call, merged.
+    std::vector<remote_view_update> take_all();
+
+    bool empty() const noexcept {
+        return _count == 0;
+    }
+};
+
+}
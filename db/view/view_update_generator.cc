@@ -13,6 +13,7 @@
 #include <boost/range/adaptor/map.hpp>
 #include "replica/database.hh"
 #include "view_update_generator.hh"
+#include "db/view/view_update_coalescer.hh"
 #include "utils/error_injection.hh"
 #include "db/view/view_updating_consumer.hh"
 #include "sstables/sstables.hh"
@@ -100,6 +101,8 @@ view_update_generator::view_update_generator(replica::database& db, sharded<serv
         , _proxy(proxy)
         , _progress_tracker(std::make_unique<progress_tracker>())
         , _early_abort_subscription(as.subscribe([this] () noexcept { do_abort(); }))
+        , _coalescer(std::make_unique<view_update_coalescer>())
+        , _coalesce_timer(_db.get_statement_scheduling_group(), [this] { send_coalesced_view_updates(); })
 {
     setup_metrics();
     discover_staging_sstables();
@@ -243,12 +246,17 @@ void view_update_generator::do_abort() noexcept {
 }
 
 future<> view_update_generator::drain() {
+    _coalesce_timer.cancel();
+    send_coalesced_view_updates();
     return _proxy.local().abort_view_writes();
 }
 
 future<> view_update_generator::stop() {
     _db.unplug_view_update_generator();
     do_abort();
+    _coalesce_timer.cancel();
+    // Drops the updates left over after drain(), releasing their units.
+    _coalescer->take_all();
     return std::move(_started).then([this] {
         _registration_sem.broken();
     });
@@ -19,6 +19,7 @@
 #include <seastar/core/abort_source.hh>
 #include <seastar/core/condition-variable.hh>
 #include <seastar/core/semaphore.hh>
+#include <seastar/core/timer.hh>
 
 using namespace seastar;
 
@@ -52,6 +53,8 @@ namespace db::view {
 
 class stats;
 struct view_and_base;
+struct remote_view_update;
+class view_update_coalescer;
 struct wait_for_all_updates_tag {};
 using wait_for_all_updates = bool_class<wait_for_all_updates_tag>;
 
@@ -72,6 +75,8 @@ class view_update_generator : public async_sharded_service<view_update_generator
     class progress_tracker;
     std::unique_ptr<progress_tracker> _progress_tracker;
     optimized_optional<abort_source::subscription> _early_abort_subscription;
+    std::unique_ptr<view_update_coalescer> _coalescer;
+    timer<> _coalesce_timer;
     void do_abort() noexcept;
 public:
     view_update_generator(replica::database& db, sharded<service::storage_proxy>& proxy, abort_source& as);
@@ -97,6 +102,8 @@ class view_update_generator : public async_sharded_service<view_update_generator
             db::timeout_semaphore_units pending_view_updates,
             service::allow_hints allow_hints,
             wait_for_all_updates wait_for_all);
+    future<> send_to_remote_view_replicas(remote_view_update u, bool apply_update_synchronously);
+    void send_coalesced_view_updates();
 
 public:
     ssize_t available_register_units() const { return _registration_sem.available_units(); }
@@ -15,6 +15,7 @@
 #include <seastar/core/reactor.hh>
 
 #include "db/config.hh"
+#include "db/heavy_hitters.hh"
 #include "db/system_keyspace.hh"
 #include "db/virtual_table.hh"
 #include "db/virtual_tables.hh"
@@ -338,6 +339,104 @@ class snapshots_table : public streaming_virtual_table {
     }
 };
 
+class heavy_hitters_table : public streaming_virtual_table {
+    distributed<replica::database>& _db;
+public:
+    explicit heavy_hitters_table(distributed<replica::database>& db)
+            : streaming_virtual_table(build_schema())
+            , _db(db)
+    {
+        _shard_aware = true;
+    }
+
+    static schema_ptr build_schema() {
+        auto id = generate_legacy_id(system_keyspace::NAME, "heavy_hitters");
+        return schema_builder(system_keyspace::NAME, "heavy_hitters", std::make_optional(id))
+            .with_column("keyspace_name", utf8_type, column_kind::partition_key)
+            .with_column("table_name", utf8_type, column_kind::clustering_key)
+            .with_column("operation", utf8_type, column_kind::clustering_key)
+            .with_column("rank", int32_type, column_kind::clustering_key)
+            .with_column("partition_key", utf8_type)
+            .with_column("count", long_type)
+            .with_column("error", long_type)
+            .set_comment("Lists the partitions of each table which got the most reads, writes and written KiB on this node in the last window, "
+                    "with their estimated count, which may be over by up to error.")
+            .with_version(system_keyspace::generate_schema_version(id))
+            .build();
+    }
+
+    dht::decorated_key make_partition_key(const sstring& name) {
+        return dht::decorate_key(*_s, partition_key::from_single_value(*_s, data_value(name).serialize_nonnull()));
+    }
+
+    clustering_key make_clustering_key(sstring table_name, sstring operation, int32_t rank) {
+        return clustering_key::from_exploded(*_s, {
+            data_value(std::move(table_name)).serialize_nonnull(),
+            data_value(std::move(operation)).serialize_nonnull(),
+            data_value(rank).serialize_nonnull()
+        });
+    }
+
+    future<> execute(reader_permit permit, result_collector& result, const query_restrictions& qr) override {
+        struct decorated_keyspace_name {
+            sstring name;
+            dht::decorated_key key;
+        };
+        std::vector<decorated_keyspace_name> keyspace_names;
+
+        for (const auto& [name, _] : _db.local().get_keyspaces()) {
+            auto dk = make_partition_key(name);
+            if (!this_shard_owns(dk) || !contains_key(qr.partition_range(), dk)) {
+                continue;
+            }
+            keyspace_names.push_back({std::move(name), std::move(dk)});
+        }
+
+        boost::sort(keyspace_names, [less = dht::ring_position_less_comparator(*_s)]
+                (const decorated_keyspace_name& l, const decorated_keyspace_name& r) {
+            return less(l.key, r.key);
+        });
+
+        using results_vector = std::vector<db::heavy_hitters::table_results>;
+
+        for (auto& ks_data : keyspace_names) {
+            // Each shard tracks the partitions it owns, so the top
+            // partitions of the node are the top ones of all shards.
+            auto results = co_await _db.map_reduce0([ks_name = ks_data.name] (replica::database& db) {
+                return db.heavy_hitters().get_results(ks_name);
+            }, results_vector(), [] (results_vector acc, results_vector shard_results) {
+                std::move(shard_results.begin(), shard_results.end(), std::back_inserter(acc));
+                return acc;
+            });
+
+            std::map<std::pair<sstring, sstring>, std::vector<db::heavy_hitters::item>> items;
+            for (auto& tr : results) {
+                auto& v = items[{tr.cf_name, sstring(to_string(tr.op))}];
+                std::move(tr.items.begin(), tr.items.end(), std::back_inserter(v));
+            }
+
+            co_await result.emit_partition_start(ks_data.key);
+            for (auto& [table_and_op, v] : items) {
+                boost::sort(v, [] (const db::heavy_hitters::item& a, const db::heavy_hitters::item& b) {
+                    return a.count > b.count;
+                });
+                if (v.size() > db::heavy_hitters::max_results) {
+                    v.erase(v.begin() + db::heavy_hitters::max_results, v.end());
+                }
+                int32_t rank = 0;
+                for (auto& item : v) {
+                    clustering_row cr(make_clustering_key(table_and_op.first, table_and_op.second, ++rank));
+                    set_cell(cr.cells(), "partition_key", item.key);
+                    set_cell(cr.cells(), "count", int64_t(item.count));
+                    set_cell(cr.cells(), "error", int64_t(item.error));
+                    co_await result.emit_row(std::move(cr));
+                }
+            }
+            co_await result.emit_partition_end();
+        }
+    }
+};
+
 class protocol_servers_table : public memtable_filling_virtual_table {
 private:
     service::storage_service& _ss;
@@ -1039,6 +1138,7 @@ future<> initialize_virtual_tables(
     co_await add_table(std::make_unique<cluster_status_table>(dist_ss, dist_gossiper));
     co_await add_table(std::make_unique<token_ring_table>(db, ss));
     co_await add_table(std::make_unique<snapshots_table>(dist_db));
+    co_await add_table(std::make_unique<heavy_hitters_table>(dist_db));
     co_await add_table(std::make_unique<protocol_servers_table>(ss));
     co_await add_table(std::make_unique<runtime_info_table>(dist_db, ss));
     co_await add_table(std::make_unique<versions_table>());
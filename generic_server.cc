@@ -9,6 +9,8 @@
 #include "generic_server.hh"
 
 
+#include <algorithm>
+
 #include <fmt/ranges.h>
 #include <seastar/core/when_all.hh>
 #include <seastar/core/loop.hh>
@@ -71,6 +73,7 @@ future<> connection::process()
         return do_until([this] {
             return _read_buf.eof();
         }, [this] {
+            ++_server._requests_processed;
             return process_request();
         }).then_wrapped([this] (future<> f) {
             handle_error(std::move(f));
@@ -108,7 +111,9 @@ future<> connection::shutdown()
 server::server(const sstring& server_name, logging::logger& logger)
     : _server_name{server_name}
     , _logger{logger}
+    , _load_timer([this] { update_load(); })
 {
+    _load_timer.arm_periodic(load_update_interval);
 }
 
 server::~server()
@@ -232,6 +237,41 @@ server::unadvertise_connection(shared_ptr<generic_server::connection> raw_conn)
     return make_ready_future<>();
 }
 
+void server::update_load() noexcept {
+    // An exponential moving average, which mostly forgets what happened more
+    // than a few intervals ago.
+    static constexpr double alpha = 0.5;
+    auto rate = double(_requests_processed - _requests_processed_at_last_update) / load_update_interval.count();
+    _requests_processed_at_last_update = _requests_processed;
+    _request_rate = alpha * rate + (1 - alpha) * _request_rate;
+}
+
+std::optional<unsigned> pick_less_loaded_shard(const std::vector<shard_load>& loads, unsigned this_shard) {
+    // Below this rate, a shard isn't busy, whatever the other shards do.
+    static constexpr double min_busy_rate = 100;
+    // How much more loaded than the least loaded shard this one has to be,
+    // so that shards of about the same load don't keep pointing to each other.
+    static constexpr double imbalance_factor = 1.5;
+
+    if (this_shard >= loads.size()) {
+        return std::nullopt;
+    }
+    bool busy = std::any_of(loads.begin(), loads.end(), [] (const shard_load& l) { return l.request_rate >= min_busy_rate; });
+    auto weight = [busy] (const shard_load& l) {
+        return busy ? l.request_rate : double(l.connections);
+    };
+    auto least = std::min_element(loads.begin(), loads.end(), [&] (const shard_load& a, const shard_load& b) {
+        return weight(a) < weight(b);
+    });
+    auto least_shard = unsigned(least - loads.begin());
+    auto this_weight = weight(loads[this_shard]);
+    // With connections, one more than the least loaded shard is no imbalance.
+    if (least_shard == this_shard || this_weight <= weight(*least) * imbalance_factor || (!busy && this_weight <= weight(*least) + 1)) {
+        return std::nullopt;
+    }
+    return least_shard;
+}
+
 // Signal that all connections are stopped if the server is stopping and can be stopped.
 void server::maybe_stop() {
     if (_stopping && !_connections_being_accepted && !_current_connections) {
@@ -13,10 +13,14 @@
 #include "seastarx.hh"
 
 #include <list>
+#include <optional>
+#include <vector>
 
 #include <seastar/core/file-types.hh>
 #include <seastar/core/future.hh>
 #include <seastar/core/gate.hh>
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/timer.hh>
 #include <seastar/net/api.hh>
 #include <seastar/net/tls.hh>
 
@@ -26,6 +30,20 @@ namespace generic_server {
 
 class server;
 
+// How loaded the server of a shard is, to spread connections across shards.
+struct shard_load {
+    uint64_t connections = 0;
+    // Requests per second, smoothed over the last few seconds.
+    double request_rate = 0;
+};
+
+// The shard which new connections should rather go to, if this shard is
+// noticeably more loaded than it. `loads` is indexed by shard.
+//
+// Shards are compared by request rate, or by connections when they all
+// serve so few requests that their rates say nothing.
+std::optional<unsigned> pick_less_loaded_shard(const std::vector<shard_load>& loads, unsigned this_shard);
+
 // A generic TCP connection.
 //
 // This class is used in tandem with the `server`class to implement a protocol
@@ -93,8 +111,14 @@ class server {
     };
     std::list<gentle_iterator> _gentle_iterators;
     std::vector<server_socket> _listeners;
+    uint64_t _requests_processed = 0;
+    uint64_t _requests_processed_at_last_update = 0;
+    double _request_rate = 0;
+    timer<lowres_clock> _load_timer;
 
 public:
+    static constexpr std::chrono::seconds load_update_interval = std::chrono::seconds(1);
+
     server(const sstring& server_name, logging::logger& logger);
 
     virtual ~server();
@@ -112,6 +136,11 @@ class server {
 
     future<> do_accepts(int which, bool keepalive, socket_address server_addr);
 
+    // The load of this shard's server.
+    shard_load load() const noexcept {
+        return shard_load{_current_connections, _request_rate};
+    }
+
 protected:
     virtual seastar::shared_ptr<connection> make_connection(socket_address server_addr, connected_socket&& fd, socket_address addr) = 0;
 
@@ -122,6 +151,9 @@ class server {
     future<> for_each_gently(noncopyable_function<void(connection&)>);
 
     void maybe_stop();
+
+private:
+    void update_load() noexcept;
 };
 
 }
@@ -78,6 +78,9 @@ feature_config feature_config_from_db_config(const db::config& cfg, std::set<sst
     if (!cfg.check_experimental(db::experimental_features_t::feature::KEYSPACE_STORAGE_OPTIONS)) {
         fcfg._disabled_features.insert("KEYSPACE_STORAGE_OPTIONS"s);
     }
+    if (!cfg.check_experimental(db::experimental_features_t::feature::SSTABLE_INDEX)) {
+        fcfg._disabled_features.insert("SSTABLE_INDEX"s);
+    }
     if (!cfg.enable_tablets()) {
         fcfg._disabled_features.insert("TABLETS"s);
     }
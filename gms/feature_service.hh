@@ -126,6 +126,9 @@ class feature_service final : public peering_sharded_service<feature_service> {
     gms::feature group0_schema_versioning { *this, "GROUP0_SCHEMA_VERSIONING"sv };
     gms::feature supports_consistent_topology_changes { *this, "SUPPORTS_CONSISTENT_TOPOLOGY_CHANGES"sv };
     gms::feature host_id_based_hinted_handoff { *this, "HOST_ID_BASED_HINTED_HANDOFF"sv };
+    gms::feature file_stream { *this, "FILE_STREAM"sv };
+    gms::feature sstable_index { *this, "SSTABLE_INDEX"sv };
+    gms::feature workload_prioritization { *this, "WORKLOAD_PRIORITIZATION"sv };
 
     // A feature just for use in tests. It must not be advertised unless
     // the "features_enable_test_feature" injection is enabled.
@@ -41,6 +41,7 @@ struct get_sync_boundary_response {
 enum class row_level_diff_detect_algorithm : uint8_t {
     send_full_set,
     send_full_set_rpc_stream,
+    send_set_sketch_rpc_stream,
 };
 
 enum class repair_stream_cmd : uint8_t {
@@ -147,5 +148,20 @@ struct repair_flush_hints_batchlog_request {
 struct repair_flush_hints_batchlog_response {
 };
 
+namespace utils {
+
+struct iblt_cell {
+    int32_t count;
+    uint64_t key_sum;
+    uint64_t hash_sum;
+};
+
+}
+
+struct repair_row_hashes_sketch {
+    std::vector<utils::iblt_cell> cells;
+};
+
 verb [[with_client_info]] repair_update_system_table (repair_update_system_table_request req [[ref]]) -> repair_update_system_table_response;
 verb [[with_client_info]] repair_flush_hints_batchlog (repair_flush_hints_batchlog_request req [[ref]]) -> repair_flush_hints_batchlog_response;
+verb [[with_client_info]] repair_get_row_hashes_sketch (uint32_t repair_meta_id, uint32_t nr_cells, uint32_t dst_shard_id) -> repair_row_hashes_sketch;
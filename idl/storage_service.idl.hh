@@ -17,9 +17,17 @@ struct global_tablet_id final {
     locator::tablet_id tablet;
 };
 
+struct tablet_load_stats final {
+    double reads;
+    double writes;
+    double read_bytes;
+    double write_bytes;
+};
+
 struct table_load_stats final {
     uint64_t size_in_bytes;
     int64_t split_ready_seq_number;
+    std::unordered_map<locator::tablet_id, locator::tablet_load_stats> tablets [[version 6.1]];
 };
 
 struct load_stats final {
@@ -11,6 +11,16 @@
 #include "idl/uuid.idl.hh"
 
 #include "streaming/stream_fwd.hh"
+#include "streaming/stream_blob.hh"
+#include "service/session.hh"
+
+namespace service {
+
+class session_id final {
+    utils::UUID uuid();
+};
+
+}
 
 namespace streaming {
 
@@ -55,4 +65,42 @@ enum class stream_mutation_fragments_cmd : uint8_t {
     end_of_stream,
 };
 
+enum class stream_blob_cmd : uint8_t {
+    ok,
+    error,
+    data,
+    end_of_stream,
+};
+
+class stream_blob_cmd_data {
+    streaming::stream_blob_cmd cmd;
+    std::optional<streaming::stream_blob_data> data;
+    std::optional<uint32_t> checksum;
+};
+
+struct stream_blob_meta {
+    streaming::plan_id ops_id;
+    table_id table;
+    sstring filename;
+    uint32_t dst_shard_id;
+    service::frozen_topology_guard topo_guard;
+};
+
+struct stream_files_request {
+    streaming::plan_id ops_id;
+    table_id table;
+    dht::token_range range;
+    uint32_t src_shard_id;
+    uint32_t dst_shard_id;
+    service::frozen_topology_guard topo_guard;
+};
+
+struct stream_files_response {
+    bool streamed;
+    uint64_t sstables;
+    uint64_t stream_bytes;
+};
+
+verb [[with_client_info]] tablet_stream_files (streaming::stream_files_request req [[ref]]) -> streaming::stream_files_response;
+
 }
@@ -432,9 +432,28 @@ resize_decision::seq_number_t resize_decision::next_sequence_number() const {
     return (sequence_number == std::numeric_limits<seq_number_t>::max()) ? 0 : sequence_number + 1;
 }
 
+tablet_load_stats& tablet_load_stats::operator+=(const tablet_load_stats& s) noexcept {
+    reads += s.reads;
+    writes += s.writes;
+    read_bytes += s.read_bytes;
+    write_bytes += s.write_bytes;
+    return *this;
+}
+
+tablet_load_stats& tablet_load_stats::operator/=(double d) noexcept {
+    reads /= d;
+    writes /= d;
+    read_bytes /= d;
+    write_bytes /= d;
+    return *this;
+}
+
 table_load_stats& table_load_stats::operator+=(const table_load_stats& s) noexcept {
     size_in_bytes = size_in_bytes + s.size_in_bytes;
     split_ready_seq_number = std::min(split_ready_seq_number, s.split_ready_seq_number);
+    for (auto& [id, stats] : s.tablets) {
+        tablets[id] += stats;
+    }
     return *this;
 }
 
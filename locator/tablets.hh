@@ -275,12 +275,29 @@ struct resize_decision {
     seq_number_t next_sequence_number() const;
 };
 
+// Rates of requests served by replicas of a tablet, per second.
+struct tablet_load_stats {
+    double reads = 0;
+    double writes = 0;
+    double read_bytes = 0;
+    double write_bytes = 0;
+
+    tablet_load_stats& operator+=(const tablet_load_stats& s) noexcept;
+    tablet_load_stats& operator/=(double d) noexcept;
+    friend tablet_load_stats operator+(tablet_load_stats a, const tablet_load_stats& b) {
+        return a += b;
+    }
+};
+
 struct table_load_stats {
     uint64_t size_in_bytes = 0;
     // Stores the minimum seq number among all replicas, as coordinator wants to know if
     // all replicas have completed splitting, which happens when they all store the
     // seq number of the current split decision.
     resize_decision::seq_number_t split_ready_seq_number = std::numeric_limits<resize_decision::seq_number_t>::max();
+    // Request rates of tablets which served any requests recently.
+    // Reported as a sum over replicas, and averaged into a per-replica rate by the coordinator.
+    std::unordered_map<tablet_id, tablet_load_stats> tablets;
 
     table_load_stats& operator+=(const table_load_stats& s) noexcept;
     friend table_load_stats operator+(table_load_stats a, const table_load_stats& b) {
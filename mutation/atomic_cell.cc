@@ -133,6 +133,16 @@ atomic_cell_or_collection::atomic_cell_or_collection(const abstract_type& type,
 {
 }
 
+void atomic_cell_or_collection::set_timestamp(const column_definition& cdef, api::timestamp_type ts) {
+    auto cell = as_mutable_atomic_cell(cdef);
+    if (cell.can_set_timestamp(ts)) {
+        cell.set_timestamp(ts);
+        return;
+    }
+    // Only live cells without a TTL use the compact layout.
+    *this = atomic_cell::make_live(*cdef.type, ts, managed_bytes_view(cell.value()));
+}
+
 bool atomic_cell_or_collection::equals(const abstract_type& type, const atomic_cell_or_collection& other) const
 {
     if (_data.empty() || other._data.empty()) {
@@ -66,14 +66,24 @@ static T get_field(Input in, unsigned offset = 0) {
  *
  * Layout:
  *
- *  <live>  := <int8_t:flags><int64_t:timestamp>(<int64_t:expiry><int32_t:ttl>)?<value>
- *  <dead>  := <int8_t:    0><int64_t:timestamp><int64_t:deletion_time>
+ *  <live>    := <int8_t:flags><int64_t:timestamp>(<int64_t:expiry><int32_t:ttl>)?<value>
+ *  <dead>    := <int8_t:    0><int64_t:timestamp><int64_t:deletion_time>
+ *  <compact> := <int8_t:flags|timestamp[50:48]><uint16_t:timestamp[47:32]><uint32_t:timestamp[31:0]><value>
+ *
+ * The compact layout is used for live, non-expiring cells with small (fixed-width)
+ * values and a non-negative timestamp below 2^51. It saves two bytes, which lets
+ * 8-byte values (bigint, double, timestamp, ...) fit in managed_bytes' inline storage
+ * instead of requiring an external allocation. It is only an in-memory representation,
+ * cells are always serialized field by field.
  */
 class atomic_cell_type final {
 private:
     static constexpr int8_t LIVE_FLAG = 0x01;
     static constexpr int8_t EXPIRY_FLAG = 0x02; // When present, expiry field is present. Set only for live cells
     static constexpr int8_t COUNTER_UPDATE_FLAG = 0x08; // Cell is a counter update.
+    static constexpr int8_t COMPACT_FLAG = int8_t(0x80); // Cell uses the compact layout.
+    static constexpr unsigned compact_timestamp_high_shift = 4; // Position of timestamp[50:48] in flags.
+    static constexpr uint8_t compact_timestamp_high_mask = 0x70;
     static constexpr unsigned flags_size = 1;
     static constexpr unsigned timestamp_offset = flags_size;
     static constexpr unsigned timestamp_size = 8;
@@ -83,8 +93,30 @@ class atomic_cell_type final {
     static constexpr unsigned deletion_time_size = 8;
     static constexpr unsigned ttl_offset = expiry_offset + expiry_size;
     static constexpr unsigned ttl_size = 4;
+    static constexpr unsigned compact_timestamp_size = 6;
+    static constexpr unsigned compact_timestamp_bits = 51;
+    static constexpr size_t compact_max_value_size = 8;
     friend class counter_cell_builder;
 private:
+    static bool is_compact(atomic_cell_value_view cell) {
+        return cell.front() & COMPACT_FLAG;
+    }
+    static bool compact_timestamp_fits(api::timestamp_type ts) {
+        return ts >= 0 && ts < (api::timestamp_type(1) << compact_timestamp_bits);
+    }
+    static api::timestamp_type get_compact_timestamp(atomic_cell_value_view cell) {
+        uint64_t high = (uint8_t(cell.front()) & compact_timestamp_high_mask) >> compact_timestamp_high_shift;
+        uint64_t mid = get_field<uint16_t>(cell, timestamp_offset);
+        uint64_t low = get_field<uint32_t>(cell, timestamp_offset + sizeof(uint16_t));
+        return api::timestamp_type((high << 48) | (mid << 32) | low);
+    }
+    static void set_compact_timestamp(atomic_cell_value_mutable_view& cell, api::timestamp_type ts) {
+        auto flags = uint8_t(cell.front()) & ~compact_timestamp_high_mask;
+        flags |= (uint64_t(ts) >> 48 << compact_timestamp_high_shift) & compact_timestamp_high_mask;
+        set_field(cell, 0, int8_t(flags));
+        set_field(cell, timestamp_offset, uint16_t(uint64_t(ts) >> 32));
+        set_field(cell, timestamp_offset + sizeof(uint16_t), uint32_t(ts));
+    }
     static bool is_counter_update(atomic_cell_value_view cell) {
         return cell.front() & COUNTER_UPDATE_FLAG;
     }
@@ -99,17 +131,32 @@ class atomic_cell_type final {
     }
     // Can be called on live and dead cells
     static api::timestamp_type timestamp(atomic_cell_value_view cell) {
+        if (is_compact(cell)) {
+            return get_compact_timestamp(cell);
+        }
         return get_field<api::timestamp_type>(cell, timestamp_offset);
     }
+    // Compact cells cannot be resized in place, so they only take timestamps
+    // which fit the compact layout.
+    static bool can_set_timestamp(atomic_cell_value_view cell, api::timestamp_type ts) {
+        return !is_compact(cell) || compact_timestamp_fits(ts);
+    }
     static void set_timestamp(atomic_cell_value_mutable_view& cell, api::timestamp_type ts) {
+        if (is_compact(cell)) {
+            assert(compact_timestamp_fits(ts));
+            set_compact_timestamp(cell, ts);
+            return;
+        }
         set_field(cell, timestamp_offset, ts);
     }
     // Can be called on live cells only
 private:
     template <mutable_view is_mutable>
     static managed_bytes_basic_view<is_mutable> do_get_value(managed_bytes_basic_view<is_mutable> cell) {
-        auto expiry_field_size = bool(cell.front() & EXPIRY_FLAG) * (expiry_size + ttl_size);
-        auto value_offset = flags_size + timestamp_size + expiry_field_size;
+        auto flags = cell.front();
+        auto expiry_field_size = bool(flags & EXPIRY_FLAG) * (expiry_size + ttl_size);
+        auto ts_size = (flags & COMPACT_FLAG) ? compact_timestamp_size : timestamp_size;
+        auto value_offset = flags_size + ts_size + expiry_field_size;
         cell.remove_prefix(value_offset);
         return cell;
     }
@@ -149,6 +196,17 @@ class atomic_cell_type final {
     }
     template <FragmentRange Buffer>
     static managed_bytes make_live(api::timestamp_type timestamp, const Buffer& value) {
+        // Empty values, which include counter cells without shards, keep the
+        // regular layout, so that their timestamp can always be set in place.
+        if (value.size_bytes() && value.size_bytes() <= compact_max_value_size && compact_timestamp_fits(timestamp)) {
+            auto value_offset = flags_size + compact_timestamp_size;
+            managed_bytes b(managed_bytes::initialized_later(), value_offset + value.size_bytes());
+            b[0] = LIVE_FLAG | COMPACT_FLAG;
+            auto view = atomic_cell_value_mutable_view(b);
+            set_compact_timestamp(view, timestamp);
+            set_value(b, value_offset, value);
+            return b;
+        }
         auto value_offset = flags_size + timestamp_size;
         managed_bytes b(managed_bytes::initialized_later(), value_offset + value.size_bytes());
         b[0] = LIVE_FLAG;
@@ -230,6 +288,11 @@ class basic_atomic_cell_view {
     api::timestamp_type timestamp() const {
         return atomic_cell_type::timestamp(_view);
     }
+    bool can_set_timestamp(api::timestamp_type ts) const {
+        return atomic_cell_type::can_set_timestamp(_view, ts);
+    }
+    // Can be called only when can_set_timestamp(ts) is true.
+    // atomic_cell_or_collection::set_timestamp() re-encodes the cell otherwise.
     void set_timestamp(api::timestamp_type ts) {
         atomic_cell_type::set_timestamp(_view, ts);
     }
@@ -172,6 +172,10 @@ class reader_permit::impl
     size_t _requested_memory = 0;
     uint64_t _oom_kills = 0;
     tracing::trace_state_ptr _trace_ptr;
+    reader_concurrency_semaphore::admission_class _admission_class = reader_concurrency_semaphore::admission_class::normal;
+    reader_concurrency_semaphore::cost_estimator _cost_estimator;
+    db::timeout_clock::time_point _queued_at;
+    uint64_t _queue_seq = 0;
 
     // Not strictly related to the permit.
     // Used by the semaphore to to manage the permit.
@@ -322,6 +326,43 @@ class reader_permit::impl
         return _aux_data;
     }
 
+    reader_concurrency_semaphore::admission_class get_admission_class() const noexcept {
+        return _admission_class;
+    }
+
+    void set_admission_class(reader_concurrency_semaphore::admission_class c, reader_concurrency_semaphore::cost_estimator cost) noexcept {
+        _admission_class = c;
+        _cost_estimator = std::move(cost);
+    }
+
+    // Refines the admission class with the cost estimate, the first time the
+    // permit has to wait for admission. Estimating the cost of reads which
+    // are admitted immediately would be wasted work.
+    void classify_for_admission() noexcept {
+        if (!_cost_estimator) {
+            return;
+        }
+        auto estimator = std::exchange(_cost_estimator, {});
+        try {
+            _admission_class = reader_concurrency_semaphore::classify_read(estimator(), _base_resources.memory);
+        } catch (...) {
+            rcslog.warn("Failed to estimate the cost of read {}: {}", description(), std::current_exception());
+        }
+    }
+
+    db::timeout_clock::time_point queued_at() const noexcept {
+        return _queued_at;
+    }
+
+    uint64_t queue_seq() const noexcept {
+        return _queue_seq;
+    }
+
+    void on_queued_for_admission(uint64_t seq) noexcept {
+        _queued_at = db::timeout_clock::now();
+        _queue_seq = seq;
+    }
+
     void on_waiting_for_admission() {
         on_permit_inactive(reader_permit::state::waiting_for_admission);
     }
@@ -889,7 +930,8 @@ reader_concurrency_semaphore::inactive_read_handle::operator=(inactive_read_hand
 
 void reader_concurrency_semaphore::wait_queue::push_to_admission_queue(reader_permit::impl& p) {
     p.unlink();
-    _admission_queue.push_back(p);
+    p.on_queued_for_admission(_next_seq++);
+    _admission_queues[static_cast<size_t>(p.get_admission_class())].push_back(p);
 }
 
 void reader_concurrency_semaphore::wait_queue::push_to_memory_queue(reader_permit::impl& p) {
@@ -898,11 +940,29 @@ void reader_concurrency_semaphore::wait_queue::push_to_memory_queue(reader_permi
 }
 
 reader_permit::impl& reader_concurrency_semaphore::wait_queue::front() {
-    if (_memory_queue.empty()) {
-        return _admission_queue.front();
-    } else {
+    if (!_memory_queue.empty()) {
         return _memory_queue.front();
     }
+    // Queues are FIFO, so only their heads are candidates. The head with the
+    // lowest class, after promoting it for the time it spent waiting, wins.
+    // Ties are broken in favour of the permit which was queued first.
+    const auto now = db::timeout_clock::now();
+    reader_permit::impl* best = nullptr;
+    size_t best_rank = 0;
+    for (size_t c = 0; c < admission_class_count; ++c) {
+        if (_admission_queues[c].empty()) {
+            continue;
+        }
+        auto& head = _admission_queues[c].front();
+        const auto periods_waited = _aging_period.count() > 0 ? size_t((now - head.queued_at()) / _aging_period) : c;
+        const auto rank = c - std::min(c, periods_waited);
+        if (!best || rank < best_rank || (rank == best_rank && head.queue_seq() < best->queue_seq())) {
+            best = &head;
+            best_rank = rank;
+        }
+    }
+    assert(best);
+    return *best;
 }
 
 const reader_permit::impl& reader_concurrency_semaphore::wait_queue::front() const {
@@ -931,6 +991,7 @@ future<> reader_concurrency_semaphore::execution_loop() noexcept {
             auto e = std::move(permit.aux_data());
 
             tracing::trace(permit.trace_state(), "[reader concurrency semaphore {}] executing read", _name);
+            tracing::mark(permit.trace_state(), tracing::request_stage::read_admitted);
 
             try {
                 e.func(reader_permit(permit.shared_from_this())).forward_to(std::move(e.pr));
@@ -982,6 +1043,14 @@ void reader_concurrency_semaphore::signal(const resources& r) noexcept {
 
 namespace sm = seastar::metrics;
 static const sm::label class_label("class");
+static const sm::label admission_class_label("admission_class");
+
+static const char* admission_class_names[] = {
+    "cheap",
+    "normal",
+    "expensive",
+};
+static_assert(std::size(admission_class_names) == reader_concurrency_semaphore::admission_class_count);
 
 reader_concurrency_semaphore::reader_concurrency_semaphore(utils::updateable_value<int> count, ssize_t memory, sstring name, size_t max_queue_length,
             utils::updateable_value<uint32_t> serialize_limit_multiplier, utils::updateable_value<uint32_t> kill_limit_multiplier, register_metrics metrics)
@@ -1045,6 +1114,18 @@ reader_concurrency_semaphore::reader_concurrency_semaphore(utils::updateable_val
                                                "Add the total_reads to this value to get the total amount of reads issued on this shard."),
                                {class_label(_name)}),
                 });
+        for (size_t c = 0; c < admission_class_count; ++c) {
+            _metrics->add_group("database", {
+                    sm::make_counter("reads_admitted_from_queue", _stats.reads_admitted_from_queue[c],
+                                   sm::description("Counts the reads admitted after waiting in the admission queue, per admission class."),
+                                   {class_label(_name), admission_class_label(admission_class_names[c])}),
+
+                    sm::make_counter("reads_admission_queue_time", _stats.admission_queue_time_us[c],
+                                   sm::description("Total time (in microseconds) reads spent waiting in the admission queue, per admission class. "
+                                                   "Divide by reads_admitted_from_queue to get the mean queue time."),
+                                   {class_label(_name), admission_class_label(admission_class_names[c])}),
+                    });
+        }
     }
 }
 
@@ -1401,6 +1482,7 @@ future<> reader_concurrency_semaphore::do_wait_admission(reader_permit::impl& pe
     ++(_stats.*stats_table[static_cast<int>(why)]);
     tracing::trace(permit.trace_state(), "[reader concurrency semaphore {}] {}", _name, result_as_string[static_cast<int>(why)]);
     if (admit != can_admit::yes || !_wait_list.empty()) {
+        permit.classify_for_admission();
         auto fut = enqueue_waiter(permit, wait_on::admission);
         if (admit == can_admit::yes && !_wait_list.empty()) {
             // This is a contradiction: the semaphore could admit waiters yet it has waiters.
@@ -1435,6 +1517,9 @@ void reader_concurrency_semaphore::maybe_admit_waiters() noexcept {
                 _blessed_permit = &permit;
                 permit.on_granted_memory();
             } else {
+                const auto c = static_cast<size_t>(permit.get_admission_class());
+                ++_stats.reads_admitted_from_queue[c];
+                _stats.admission_queue_time_us[c] += std::chrono::duration_cast<std::chrono::microseconds>(db::timeout_clock::now() - permit.queued_at()).count();
                 permit.on_admission();
                 ++_stats.reads_admitted;
             }
@@ -1539,17 +1624,31 @@ void reader_concurrency_semaphore::on_permit_not_awaits() noexcept {
     --_stats.awaits_permits;
 }
 
+reader_concurrency_semaphore::admission_class
+reader_concurrency_semaphore::classify_read(const reader_cost_estimate& cost, ssize_t memory) noexcept {
+    memory = std::max(memory, ssize_t(cost.memory));
+    if (cost.kind == reader_cost_estimate::read_kind::range_scan || memory >= min_expensive_read_memory) {
+        return admission_class::expensive;
+    }
+    if (cost.kind == reader_cost_estimate::read_kind::single_partition && cost.sstables <= max_cheap_read_sstables && memory <= max_cheap_read_memory) {
+        return admission_class::cheap;
+    }
+    return admission_class::normal;
+}
+
 future<reader_permit> reader_concurrency_semaphore::obtain_permit(schema_ptr schema, const char* const op_name, size_t memory,
-        db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr) {
+        db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr, cost_estimator cost) {
     auto permit = reader_permit(*this, std::move(schema), std::string_view(op_name), {1, static_cast<ssize_t>(memory)}, timeout, std::move(trace_ptr));
+    permit->set_admission_class(classify_read({}, memory), std::move(cost));
     return do_wait_admission(*permit).then([permit] () mutable {
         return std::move(permit);
     });
 }
 
 future<reader_permit> reader_concurrency_semaphore::obtain_permit(schema_ptr schema, sstring&& op_name, size_t memory,
-        db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr) {
+        db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr, cost_estimator cost) {
     auto permit = reader_permit(*this, std::move(schema), std::move(op_name), {1, static_cast<ssize_t>(memory)}, timeout, std::move(trace_ptr));
+    permit->set_admission_class(classify_read({}, memory), std::move(cost));
     return do_wait_admission(*permit).then([permit] () mutable {
         return std::move(permit);
     });
@@ -1566,8 +1665,9 @@ reader_permit reader_concurrency_semaphore::make_tracking_only_permit(schema_ptr
 }
 
 future<> reader_concurrency_semaphore::with_permit(schema_ptr schema, const char* const op_name, size_t memory,
-        db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr, read_func func) {
+        db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr, read_func func, cost_estimator cost) {
     auto permit = reader_permit(*this, std::move(schema), std::string_view(op_name), {1, static_cast<ssize_t>(memory)}, timeout, std::move(trace_ptr));
+    permit->set_admission_class(classify_read({}, memory), std::move(cost));
     permit->aux_data().func = std::move(func);
     permit->aux_data().permit_keepalive = permit;
     return do_wait_admission(*permit);
@@ -1619,7 +1719,9 @@ std::string reader_concurrency_semaphore::dump_diagnostics(unsigned max_lines) c
 
 void reader_concurrency_semaphore::foreach_permit(noncopyable_function<void(const reader_permit::impl&)> func) const {
     boost::for_each(_permit_list, std::ref(func));
-    boost::for_each(_wait_list._admission_queue, std::ref(func));
+    for (auto& queue : _wait_list._admission_queues) {
+        boost::for_each(queue, std::ref(func));
+    }
     boost::for_each(_wait_list._memory_queue, std::ref(func));
     boost::for_each(_ready_list, std::ref(func));
 }
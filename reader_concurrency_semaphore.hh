@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <boost/intrusive/list.hpp>
 #include <seastar/core/future.hh>
 #include <seastar/core/gate.hh>
@@ -32,8 +34,14 @@ using flat_mutation_reader_v2_opt = optimized_optional<flat_mutation_reader_v2>;
 /// Reader concurrency is dual limited by count and memory.
 /// The semaphore can be configured with the desired limits on
 /// construction. New readers will only be admitted when there is both
-/// enough count and memory units available. Readers are admitted in
-/// FIFO order.
+/// enough count and memory units available.
+/// Reads waiting for admission are sorted into admission classes (cheap,
+/// normal and expensive), based on the cost estimate passed to
+/// `obtain_permit()` or `with_permit()`. Reads of the same class are admitted
+/// in FIFO order, cheaper classes are admitted first. To avoid starving
+/// expensive reads, a waiting read is promoted by one class for each
+/// admission aging period (see `set_admission_aging_period()`) it spent in
+/// the queue.
 /// Semaphore's `name` must be provided in ctor and its only purpose is
 /// to increase readability of exceptions: both timeout exceptions and
 /// queue overflow exceptions (read below) include this `name` in messages.
@@ -77,6 +85,20 @@ class reader_concurrency_semaphore {
 
     using eviction_notify_handler = noncopyable_function<void(evict_reason)>;
 
+    enum class admission_class {
+        cheap,
+        normal,
+        expensive,
+    };
+    static constexpr size_t admission_class_count = 3;
+
+    // Single-partition reads touching at most this many sstables are cheap.
+    static constexpr size_t max_cheap_read_sstables = 8;
+    // Reads requiring at most this much memory upfront can be cheap.
+    static constexpr ssize_t max_cheap_read_memory = 128 * 1024;
+    // Reads requiring at least this much memory upfront are expensive.
+    static constexpr ssize_t min_expensive_read_memory = 1024 * 1024;
+
     struct stats {
         // The number of inactive reads evicted to free up permits.
         uint64_t permit_based_evictions = 0;
@@ -124,6 +146,10 @@ class reader_concurrency_semaphore {
         uint64_t sstables_read = 0;
         // Permits waiting on something: admission, memory or execution
         uint64_t waiters = 0;
+        // Total number of reads admitted after waiting in the admission queue, per admission class.
+        std::array<uint64_t, admission_class_count> reads_admitted_from_queue = {};
+        // Total time (in microseconds) reads spent in the admission queue, per admission class.
+        std::array<uint64_t, admission_class_count> admission_queue_time_us = {};
     };
 
     using permit_list_type = bi::list<
@@ -132,6 +158,10 @@ class reader_concurrency_semaphore {
             bi::constant_time_size<false>>;
 
     using read_func = noncopyable_function<future<>(reader_permit)>;
+    // Computes the cost estimate of a read. Only invoked if the read has to
+    // wait for admission, and at most once, synchronously from the call
+    // which created the permit.
+    using cost_estimator = noncopyable_function<reader_cost_estimate()>;
 
 private:
     struct inactive_read;
@@ -164,13 +194,17 @@ class reader_concurrency_semaphore {
     utils::observer<int> _count_observer;
 
     struct wait_queue {
-        // Stores entries for permits waiting to be admitted.
-        permit_list_type _admission_queue;
+        // Stores entries for permits waiting to be admitted, one queue per admission class.
+        std::array<permit_list_type, admission_class_count> _admission_queues;
         // Stores entries for serialized permits waiting to obtain memory.
         permit_list_type _memory_queue;
+        // Waiting for this long promotes a permit by one admission class.
+        db::timeout_clock::duration _aging_period = std::chrono::milliseconds(100);
+        // Orders permits queued for admission, across all classes.
+        uint64_t _next_seq = 0;
     public:
         bool empty() const {
-            return _admission_queue.empty() && _memory_queue.empty();
+            return _memory_queue.empty() && std::ranges::all_of(_admission_queues, [] (const permit_list_type& q) { return q.empty(); });
         }
         void push_to_admission_queue(reader_permit::impl& p);
         void push_to_memory_queue(reader_permit::impl& p);
@@ -415,8 +449,14 @@ class reader_concurrency_semaphore {
     ///
     /// Some permits cannot be associated with any table, so passing nullptr as
     /// the schema parameter is allowed.
-    future<reader_permit> obtain_permit(schema_ptr schema, const char* const op_name, size_t memory, db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr);
-    future<reader_permit> obtain_permit(schema_ptr schema, sstring&& op_name, size_t memory, db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr);
+    ///
+    /// The cost estimate determines the admission class of the read, see
+    /// \ref classify_read(). It is only computed if the read cannot be
+    /// admitted immediately.
+    future<reader_permit> obtain_permit(schema_ptr schema, const char* const op_name, size_t memory, db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr,
+            cost_estimator cost = {});
+    future<reader_permit> obtain_permit(schema_ptr schema, sstring&& op_name, size_t memory, db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr,
+            cost_estimator cost = {});
 
     /// Make a tracking only permit
     ///
@@ -453,7 +493,8 @@ class reader_concurrency_semaphore {
     ///
     /// Some permits cannot be associated with any table, so passing nullptr as
     /// the schema parameter is allowed.
-    future<> with_permit(schema_ptr schema, const char* const op_name, size_t memory, db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr, read_func func);
+    future<> with_permit(schema_ptr schema, const char* const op_name, size_t memory, db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr, read_func func,
+            cost_estimator cost = {});
 
     /// Run the function through the semaphore's execution stage with a pre-admitted permit
     ///
@@ -498,6 +539,17 @@ class reader_concurrency_semaphore {
         _max_queue_length = size;
     }
 
+    /// Set how long a read has to wait for admission to be promoted by one admission class.
+    ///
+    /// A zero period disables admission classes: reads are admitted in FIFO order.
+    void set_admission_aging_period(db::timeout_clock::duration period) {
+        _wait_list._aging_period = period;
+    }
+
+    /// Determine the admission class of a read from its cost estimate and the
+    /// memory it requires upfront, or the memory of the estimate if larger.
+    static admission_class classify_read(const reader_cost_estimate& cost, ssize_t memory) noexcept;
+
     uint64_t active_reads() const noexcept {
         return _stats.current_permits - _stats.inactive_reads - _stats.waiters;
     }
@@ -67,6 +67,24 @@ inline bool operator==(const reader_resources& a, const reader_resources& b) {
     return a.count == b.count && a.memory == b.memory;
 }
 
+/// Estimated cost of a read, known before the read is started.
+///
+/// Used by the semaphore to let cheap reads overtake expensive ones while
+/// they wait for admission. A default constructed estimate means the cost
+/// is not known, such reads are treated as regular ones.
+struct reader_cost_estimate {
+    enum class read_kind {
+        unknown,
+        single_partition,
+        range_scan,
+    };
+    read_kind kind = read_kind::unknown;
+    // Upper bound of the number of sstables the read may touch, 0 if unknown.
+    size_t sstables = 0;
+    // Memory the readers of those sstables are expected to need, 0 if unknown.
+    size_t memory = 0;
+};
+
 class reader_concurrency_semaphore;
 
 /// A permit for a specific read.
@@ -13,6 +13,7 @@
 #include "readers/clustering_combined.hh"
 #include "readers/range_tombstone_change_merger.hh"
 #include "readers/combined.hh"
+#include "utils/tournament_tree.hh"
 
 extern logging::logger mrlog;
 
@@ -179,7 +180,18 @@ class mutation_reader_merger {
     static constexpr int gallop_mode_entering_threshold = 3;
 private:
     struct reader_heap_compare;
-    struct fragment_heap_compare;
+
+    struct fragment_tri_compare {
+        position_in_partition::tri_compare cmp;
+
+        explicit fragment_tri_compare(const schema& s)
+            : cmp(s) {
+        }
+
+        std::strong_ordering operator()(const reader_and_fragment& a, const reader_and_fragment& b) const {
+            return cmp(a.fragment.position(), b.fragment.position());
+        }
+    };
 
     struct needs_merge_tag { };
     using needs_merge = bool_class<needs_merge_tag>;
@@ -202,8 +214,10 @@ class mutation_reader_merger {
     // always partition_start. Used to pick the next partition.
     merger_vector<reader_and_fragment> _reader_heap;
     // Readers and their current fragments, belonging to the current
-    // partition.
-    merger_vector<reader_and_fragment> _fragment_heap;
+    // partition. A tournament tree needs a single comparison per level
+    // to replace the winning fragment with the next one from the same
+    // reader, which matters when merging many sstables.
+    utils::tournament_tree<reader_and_fragment, fragment_tri_compare> _fragment_tree;
     merger_vector<reader_and_last_fragment_kind> _next;
     // Readers that reached EOS.
     merger_vector<reader_and_last_fragment_kind> _halted_readers;
@@ -236,7 +250,7 @@ class mutation_reader_merger {
     future<needs_merge> advance_galloping_reader();
     future<> prepare_next();
     // Collect all forwardable readers into _next, and remove them from
-    // their previous containers (_halted_readers and _fragment_heap).
+    // their previous containers (_halted_readers and _fragment_tree).
     void prepare_forwardable_readers();
 public:
     mutation_reader_merger(schema_ptr schema,
@@ -333,19 +347,6 @@ struct mutation_reader_merger::reader_heap_compare {
     }
 };
 
-struct mutation_reader_merger::fragment_heap_compare {
-    position_in_partition::less_compare cmp;
-
-    explicit fragment_heap_compare(const schema& s)
-        : cmp(s) {
-    }
-
-    bool operator()(const mutation_reader_merger::reader_and_fragment& a, const mutation_reader_merger::reader_and_fragment& b) {
-        // Invert comparison as this is a max-heap.
-        return cmp(b.fragment.position(), a.fragment.position());
-    }
-};
-
 bool mutation_reader_merger::in_gallop_mode() const {
     return _gallop_mode_hits >= gallop_mode_entering_threshold;
 }
@@ -354,7 +355,7 @@ void mutation_reader_merger::maybe_add_readers_at_partition_boundary() {
     // We are either crossing partition boundary or ran out of
     // readers. If there are halted readers then we are just
     // waiting for a fast-forward so there is nothing to do.
-    if (_fragment_heap.empty() && _halted_readers.empty()) {
+    if (_fragment_tree.empty() && _halted_readers.empty()) {
         if (_reader_heap.empty()) {
             maybe_add_readers(std::nullopt);
         } else {
@@ -388,9 +389,9 @@ future<mutation_reader_merger::needs_merge> mutation_reader_merger::prepare_one(
                 boost::push_heap(_reader_heap, reader_heap_compare(*_schema));
             } else {
                 if (reader_galloping) {
-                    // Optimization: assume that galloping reader will keep winning, and compare directly with the heap front.
-                    // If this assumption is correct, we do one key comparison instead of pushing to/popping from the heap.
-                    if (_fragment_heap.empty() || position_in_partition::less_compare(*_schema)(mfo->position(), _fragment_heap.front().fragment.position())) {
+                    // Optimization: assume that galloping reader will keep winning, and compare directly with the tree top.
+                    // If this assumption is correct, we do one key comparison instead of pushing to/popping from the tree.
+                    if (_fragment_tree.empty() || position_in_partition::less_compare(*_schema)(mfo->position(), _fragment_tree.top().fragment.position())) {
                         _current.clear();
                         _current.emplace_back(std::move(*mfo), &*_galloping_reader.reader);
                         _galloping_reader.last_kind = _current.back().fragment.mutation_fragment_kind();
@@ -400,8 +401,7 @@ future<mutation_reader_merger::needs_merge> mutation_reader_merger::prepare_one(
                     _gallop_mode_hits = 0;
                 }
 
-                _fragment_heap.emplace_back(rk.reader, std::move(*mfo));
-                boost::range::push_heap(_fragment_heap, fragment_heap_compare(*_schema));
+                _fragment_tree.push(reader_and_fragment(rk.reader, std::move(*mfo)));
             }
         } else if (_fwd_sm == streamed_mutation::forwarding::yes && rk.last_kind != mutation_fragment_v2::kind::partition_end) {
             // When in streamed_mutation::forwarding mode we need
@@ -443,7 +443,7 @@ future<mutation_reader_merger::needs_merge> mutation_reader_merger::prepare_one(
 void mutation_reader_merger::prepare_forwardable_readers() {
     auto prepare_single_reader = _single_reader.reader != reader_iterator{};
 
-    _next.reserve(_halted_readers.size() + _fragment_heap.size() + _next.size() +
+    _next.reserve(_halted_readers.size() + _fragment_tree.size() + _next.size() +
         prepare_single_reader + in_gallop_mode());
 
     std::move(_halted_readers.begin(), _halted_readers.end(), std::back_inserter(_next));
@@ -454,12 +454,12 @@ void mutation_reader_merger::prepare_forwardable_readers() {
         _next.emplace_back(_galloping_reader);
         _gallop_mode_hits = 0;
     }
-    for (auto& df : _fragment_heap) {
+    _fragment_tree.for_each([this] (reader_and_fragment& df) {
         _next.emplace_back(df.reader, df.fragment.mutation_fragment_kind());
-    }
+    });
 
     _halted_readers.clear();
-    _fragment_heap.clear();
+    _fragment_tree.clear();
 }
 
 mutation_reader_merger::mutation_reader_merger(schema_ptr schema,
@@ -467,6 +467,7 @@ mutation_reader_merger::mutation_reader_merger(schema_ptr schema,
         streamed_mutation::forwarding fwd_sm,
         mutation_reader::forwarding fwd_mr)
     : _selector(std::move(selector))
+    , _fragment_tree(fragment_tri_compare(*schema))
     , _schema(std::move(schema))
     , _fwd_sm(fwd_sm)
     , _fwd_mr(fwd_mr) {
@@ -518,42 +519,45 @@ future<mutation_fragment_batch_opt> mutation_reader_merger::maybe_produce_batch(
 
     // If we ran out of fragments for the current partition, select the
     // readers for the next one.
-    if (_fragment_heap.empty()) {
+    if (_fragment_tree.empty()) {
         if (!_halted_readers.empty() || _reader_heap.empty()) {
             return make_ready_future<mutation_fragment_batch_opt>(_current);
         }
 
-        auto key = [] (const merger_vector<reader_and_fragment>& heap) -> const dht::decorated_key& {
-            return heap.front().fragment.as_partition_start().key();
+        auto key = [] (const reader_and_fragment& rf) -> const dht::decorated_key& {
+            return rf.fragment.as_partition_start().key();
         };
 
         do {
             boost::range::pop_heap(_reader_heap, reader_heap_compare(*_schema));
-            // All fragments here are partition_start so no need to
-            // heap-sort them.
-            _fragment_heap.emplace_back(std::move(_reader_heap.back()));
+            // All fragments here are partition_start so comparing
+            // them in the tree is trivial.
+            _fragment_tree.push(std::move(_reader_heap.back()));
             _reader_heap.pop_back();
         }
-        while (!_reader_heap.empty() && key(_fragment_heap).equal(*_schema, key(_reader_heap)));
-        if (_fragment_heap.size() == 1) {
-            _single_reader = { _fragment_heap.back().reader, mutation_fragment_v2::kind::partition_start };
-            _current.emplace_back(std::move(_fragment_heap.back().fragment), &*_single_reader.reader);
-            _fragment_heap.clear();
+        while (!_reader_heap.empty() && key(_fragment_tree.top()).equal(*_schema, key(_reader_heap.front())));
+        if (_fragment_tree.size() == 1) {
+            auto rf = _fragment_tree.pop();
+            _single_reader = { rf.reader, mutation_fragment_v2::kind::partition_start };
+            _current.emplace_back(std::move(rf.fragment), &*_single_reader.reader);
             _gallop_mode_hits = 0;
             return make_ready_future<mutation_fragment_batch_opt>(_current);
         }
     }
 
     const auto equal = position_in_partition::equal_compare(*_schema);
+    bool may_have_equal;
     do {
-        boost::range::pop_heap(_fragment_heap, fragment_heap_compare(*_schema));
-        auto& n = _fragment_heap.back();
+        // The tree remembers ties, so in the common case of a single
+        // reader having the smallest position, no further comparison
+        // is needed to tell that the batch is complete.
+        may_have_equal = _fragment_tree.top_may_have_equal();
+        auto n = _fragment_tree.pop();
         const auto kind = n.fragment.mutation_fragment_kind();
         _current.emplace_back(std::move(n.fragment), &*n.reader);
         _next.emplace_back(n.reader, kind);
-        _fragment_heap.pop_back();
     }
-    while (!_fragment_heap.empty() && equal(_current.back().fragment.position(), _fragment_heap.front().fragment.position()));
+    while (may_have_equal && !_fragment_tree.empty() && equal(_current.back().fragment.position(), _fragment_tree.top().fragment.position()));
 
     if (_next.size() == 1 && _next.front().reader == _galloping_reader.reader) {
         ++_gallop_mode_hits;
@@ -576,7 +580,7 @@ future<> mutation_reader_merger::next_partition() {
     //
     // The readers in _next are those which returned the last batch of fragments, thus they are
     // currently positioned either inside P or at the end of P, hence we need to forward them.
-    // Readers in _fragment_heap (or the _galloping_reader, if we're currently galloping) are obviously still in P,
+    // Readers in _fragment_tree (or the _galloping_reader, if we're currently galloping) are obviously still in P,
     // so we also need to forward those. Finally, _halted_readers must have been halted after returning
     // a fragment from P, hence must be forwarded.
     //
@@ -594,7 +598,7 @@ future<> mutation_reader_merger::fast_forward_to(const dht::partition_range& pr)
     _gallop_mode_hits = 0;
     _next.clear();
     _halted_readers.clear();
-    _fragment_heap.clear();
+    _fragment_tree.clear();
     _reader_heap.clear();
 
     for (auto it = _all_readers.begin(); it != _all_readers.end(); ++it) {
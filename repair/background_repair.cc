@@ -0,0 +1,216 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/metrics.hh>
+#include <seastar/core/sleep.hh>
+#include <seastar/core/with_scheduling_group.hh>
+#include <seastar/coroutine/as_future.hh>
+#include <seastar/coroutine/maybe_yield.hh>
+
+#include "repair/background_repair.hh"
+#include "repair/row_level.hh"
+#include "repair/task_manager_module.hh"
+#include "db/config.hh"
+#include "locator/tablets.hh"
+#include "replica/database.hh"
+#include "service/storage_proxy.hh"
+#include "compaction/compaction_manager.hh"
+
+extern logging::logger rlogger;
+
+namespace repair {
+
+// How long to wait before looking for work again when there is none, or after
+// an error. Also bounds how long it takes to notice config changes.
+static constexpr auto idle_pause = std::chrono::seconds(60);
+
+// How long a tablet whose repair failed is left alone, so that it doesn't hold
+// up the others.
+static constexpr auto retry_delay = std::chrono::minutes(10);
+
+// The duty cycle never goes below this, so that repair keeps making progress
+// under a sustained foreground latency above the target.
+static constexpr double min_duty_cycle = 0.02;
+static constexpr double duty_cycle_increment = 0.05;
+
+background_repair_scheduler::background_repair_scheduler(repair_service& rs, sharded<replica::database>& db, sharded<service::storage_proxy>& sp)
+    : _rs(rs)
+    , _db(db)
+    , _sp(sp)
+{
+    namespace sm = seastar::metrics;
+    _metrics.add_group("repair", {
+        sm::make_counter("background_repair_tablets", _tablets_repaired,
+                sm::description("Number of tablets repaired by the background repair scheduler.")),
+        sm::make_counter("background_repair_errors", _errors,
+                sm::description("Number of failed rounds of the background repair scheduler.")),
+        sm::make_gauge("background_repair_duty_cycle", [this] { return _duty_cycle; },
+                sm::description("Fraction of the time the background repair scheduler keeps repair busy.")),
+    });
+}
+
+void background_repair_scheduler::start() {
+    _done = run();
+}
+
+future<> background_repair_scheduler::stop() {
+    _as.request_abort();
+    if (_current_task) {
+        _current_task->abort();
+    }
+    co_await std::move(_done);
+}
+
+bool background_repair_scheduler::enabled() const {
+    return _db.local().get_config().enable_background_repair();
+}
+
+future<> background_repair_scheduler::run() {
+    // Until the repair history is loaded, every tablet looks never repaired.
+    co_await _rs.wait_for_history_loaded();
+    while (!_as.abort_requested()) {
+        std::chrono::milliseconds pause = idle_pause;
+        try {
+            if (enabled()) {
+                auto now = gc_clock::now();
+                auto c = co_await pick_tablet(now);
+                if (c && c->due <= now) {
+                    auto start = lowres_clock::now();
+                    co_await repair_tablet(*c);
+                    auto took = lowres_clock::now() - start;
+                    adjust_duty_cycle(co_await get_foreground_latency(), c->urgent);
+                    pause = std::chrono::duration_cast<std::chrono::milliseconds>(took * ((1 - _duty_cycle) / _duty_cycle));
+                } else if (c) {
+                    pause = std::min(pause, std::chrono::duration_cast<std::chrono::milliseconds>(c->due - now));
+                }
+            }
+        } catch (...) {
+            if (_as.abort_requested()) {
+                break;
+            }
+            ++_errors;
+            rlogger.warn("Background repair failed: {}", std::current_exception());
+        }
+        try {
+            co_await sleep_abortable(pause, _as);
+        } catch (const sleep_aborted&) {
+            // Stopping
+        }
+    }
+}
+
+future<std::optional<background_repair_scheduler::candidate>> background_repair_scheduler::pick_tablet(gc_clock::time_point now) {
+    std::vector<lw_shared_ptr<replica::table>> tables;
+    _db.local().get_tables_metadata().for_each_table([&] (table_id, lw_shared_ptr<replica::table> t) {
+        if (t->uses_tablets()) {
+            tables.push_back(std::move(t));
+        }
+    });
+
+    for (auto& [_, ranges] : _retry_after) {
+        std::erase_if(ranges, [now] (const auto& x) { return x.second <= now; });
+    }
+    std::erase_if(_retry_after, [] (const auto& x) { return x.second.empty(); });
+
+    std::optional<candidate> best;
+    const auto& gc_state = _db.local().get_compaction_manager().get_tombstone_gc_state();
+    for (auto& t : tables) {
+        auto s = t->schema();
+        const auto gc_grace = s->gc_grace_seconds();
+        if (gc_grace == gc_clock::duration::zero()) {
+            continue;
+        }
+        auto erm = t->get_effective_replication_map();
+        auto tmptr = erm->get_token_metadata_ptr();
+        auto& tmap = tmptr->tablets().get_tablet_map(s->id());
+        auto my_id = tmptr->get_my_id();
+        const auto& retry_after = _retry_after[s->id()];
+        co_await tmap.for_each_tablet([&] (locator::tablet_id id, const locator::tablet_info&) -> future<> {
+            if (tmap.get_primary_replica(id).host != my_id) {
+                return make_ready_future<>();
+            }
+            auto range = tmap.get_token_range(id);
+            auto repair_time = gc_state.get_repair_time_for_range(s->id(), range);
+            std::optional<gc_clock::time_point> retry;
+            if (auto it = retry_after.find(range); it != retry_after.end()) {
+                retry = it->second;
+            }
+            auto sched = schedule_tablet(repair_time, gc_grace, now, retry);
+            if (!best || sched.due < best->due) {
+                best = candidate{s->id(), std::move(range), sched.due, sched.urgent};
+            }
+            return make_ready_future<>();
+        });
+        co_await coroutine::maybe_yield();
+    }
+    co_return best;
+}
+
+future<> background_repair_scheduler::repair_tablet(const candidate& c) {
+    auto s = _db.local().find_column_family(c.table).schema();
+    auto id = _rs.get_repair_module().new_repair_uniq_id();
+    rlogger.info("repair[{}]: starting background repair of table {}.{} range {}, urgent={}, duty_cycle={}",
+            id.uuid(), s->ks_name(), s->cf_name(), c.range, c.urgent, _duty_cycle);
+    _current_task = co_await _rs.repair_tablets(id, s->ks_name(), {s->cf_name()}, _rs.get_host2ip(), false, {c.range});
+    auto task = _current_task;
+    if (_as.abort_requested()) {
+        task->abort();
+    }
+    auto f = co_await coroutine::as_future(task->done());
+    _current_task = nullptr;
+    if (f.failed()) {
+        _retry_after[c.table][c.range] = gc_clock::now() + retry_delay;
+        co_await std::move(f);
+    }
+    ++_tablets_repaired;
+}
+
+// The 99th percentile latency of the reads and writes this node coordinated
+// lately, whichever is higher.
+future<std::chrono::microseconds> background_repair_scheduler::get_foreground_latency() const {
+    return with_scheduling_group(_db.local().get_statement_scheduling_group(), [this] {
+        auto& stats = _sp.local().get_stats();
+        auto p99 = [] (const utils::summary_calculator& summary) {
+            return summary.summary().empty() ? 0.0 : summary.summary().back();
+        };
+        return std::chrono::microseconds(int64_t(std::max(p99(stats.read.summary()), p99(stats.write.summary()))));
+    });
+}
+
+background_repair_scheduler::tablet_schedule background_repair_scheduler::schedule_tablet(std::optional<gc_clock::time_point> repair_time,
+        gc_clock::duration gc_grace, gc_clock::time_point now, std::optional<gc_clock::time_point> retry_after) {
+    // Tablets which were never repaired are due right away, but come
+    // after the ones which are overdue already.
+    auto due = repair_time ? *repair_time + gc_grace / 2 : now;
+    if (retry_after) {
+        due = std::max(due, *retry_after);
+    }
+    return tablet_schedule{
+        .due = due,
+        .urgent = repair_time && now - *repair_time > gc_grace * 3 / 4,
+    };
+}
+
+double background_repair_scheduler::next_duty_cycle(double duty_cycle, std::chrono::microseconds latency, std::chrono::milliseconds target, bool urgent) {
+    if (urgent || target == std::chrono::milliseconds::zero()) {
+        return 1;
+    } else if (latency > target) {
+        return std::max(duty_cycle / 2, min_duty_cycle);
+    } else {
+        return std::min(duty_cycle + duty_cycle_increment, 1.0);
+    }
+}
+
+void background_repair_scheduler::adjust_duty_cycle(std::chrono::microseconds latency, bool urgent) {
+    const auto target = std::chrono::milliseconds(_db.local().get_config().background_repair_latency_target_in_ms());
+    _duty_cycle = next_duty_cycle(_duty_cycle, latency, target, urgent);
+    rlogger.debug("Background repair: foreground latency={}us, target={}ms, duty_cycle={}", latency.count(), target.count(), _duty_cycle);
+}
+
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <seastar/core/abort_source.hh>
+#include <seastar/core/future.hh>
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/metrics_registration.hh>
+#include <seastar/core/sharded.hh>
+
+#include "dht/token.hh"
+#include "gc_clock.hh"
+#include "schema/schema_fwd.hh"
+#include "tasks/task_manager.hh"
+
+using namespace seastar;
+
+class repair_service;
+
+namespace replica {
+class database;
+}
+
+namespace service {
+class storage_proxy;
+}
+
+namespace repair {
+
+// Repairs the tablets this node is the primary replica of, one at a time and
+// least recently repaired first, so that each tablet is repaired at least once
+// every half of its table's gc_grace_seconds without the operator having to
+// schedule it.
+//
+// The repair of a tablet runs at full speed, but is followed by a pause
+// long enough to only keep repair busy for a fraction of the time, the duty
+// cycle. The duty cycle is halved whenever the latency of the reads and writes
+// coordinated by this node goes above background_repair_latency_target_in_ms,
+// and grows back slowly while it stays below it. Tablets getting close to
+// gc_grace_seconds without a repair are repaired at full speed regardless.
+//
+// Repair times are taken from the repair history, which every repair keeps in
+// system.repair_history, so the scheduler picks up where it left off after a
+// restart, and takes repairs started by the operator into account.
+//
+// Runs on shard 0.
+class background_repair_scheduler {
+    repair_service& _rs;
+    sharded<replica::database>& _db;
+    sharded<service::storage_proxy>& _sp;
+    abort_source _as;
+    future<> _done = make_ready_future<>();
+    // The repair of the current tablet, aborted on stop.
+    tasks::task_manager::task_ptr _current_task;
+    // Fraction of the time spent repairing.
+    double _duty_cycle = 0.5;
+    uint64_t _tablets_repaired = 0;
+    uint64_t _errors = 0;
+    // Tablets whose repair failed, with when to try them again.
+    std::unordered_map<table_id, std::unordered_map<dht::token_range, gc_clock::time_point>> _retry_after;
+    seastar::metrics::metric_groups _metrics;
+
+    struct candidate {
+        table_id table;
+        dht::token_range range;
+        // When the tablet has to be repaired next, to keep within half of
+        // gc_grace_seconds.
+        gc_clock::time_point due;
+        // The tablet is getting close to gc_grace_seconds without a repair.
+        bool urgent;
+    };
+public:
+    background_repair_scheduler(repair_service& rs, sharded<replica::database>& db, sharded<service::storage_proxy>& sp);
+
+    void start();
+    future<> stop();
+
+    struct tablet_schedule {
+        gc_clock::time_point due;
+        bool urgent;
+    };
+    // When a tablet has to be repaired next, given when it was last repaired,
+    // if ever, and when it may be retried after a failed repair, if it failed.
+    static tablet_schedule schedule_tablet(std::optional<gc_clock::time_point> repair_time, gc_clock::duration gc_grace,
+            gc_clock::time_point now, std::optional<gc_clock::time_point> retry_after);
+    // The duty cycle to use after a tablet repair, given the one used for it
+    // and the foreground latency seen after it.
+    static double next_duty_cycle(double duty_cycle, std::chrono::microseconds latency, std::chrono::milliseconds target, bool urgent);
+private:
+    future<> run();
+    bool enabled() const;
+    future<std::optional<candidate>> pick_tablet(gc_clock::time_point now);
+    future<> repair_tablet(const candidate& c);
+    future<std::chrono::microseconds> get_foreground_latency() const;
+    void adjust_duty_cycle(std::chrono::microseconds latency, bool urgent);
+};
+
+}
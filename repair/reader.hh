@@ -8,6 +8,10 @@
 #include "readers/mutation_fragment_v1_stream.hh"
 #include <fmt/core.h>
 
+namespace sstables {
+class sstable_set;
+}
+
 class repair_reader {
 public:
     enum class read_strategy {
@@ -42,7 +46,8 @@ class repair_reader {
         read_strategy strategy,
         const dht::sharder& remote_sharder,
         unsigned remote_shard,
-        gc_clock::time_point compaction_time);
+        gc_clock::time_point compaction_time,
+        lw_shared_ptr<sstables::sstable_set> sstables);
 
 public:
     repair_reader(
@@ -55,7 +60,9 @@ class repair_reader {
         unsigned remote_shard,
         uint64_t seed,
         read_strategy strategy,
-        gc_clock::time_point compaction_time);
+        gc_clock::time_point compaction_time,
+        // When engaged, the local strategy reads only from these sstables.
+        lw_shared_ptr<sstables::sstable_set> sstables = {});
 
     future<mutation_fragment_opt>
     read_mutation_fragment();
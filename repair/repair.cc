@@ -131,6 +131,8 @@ std::string_view format_as(row_level_diff_detect_algorithm algo) {
         return "send_full_set";
     case send_full_set_rpc_stream:
         return "send_full_set_rpc_stream";
+    case send_set_sketch_rpc_stream:
+        return "send_set_sketch_rpc_stream";
     };
     return "unknown";
 }
@@ -1180,15 +1182,6 @@ future<int> repair_service::do_repair_start(sstring keyspace, std::unordered_map
                 throw std::invalid_argument("Cannot combine ignore_nodes and hosts options.");
             }
 
-            auto host2ip = [&addr_map = _addr_map] (locator::host_id host) -> future<gms::inet_address> {
-                auto ip = addr_map.local().find(raft::server_id(host.uuid()));
-                if (!ip) {
-                    throw std::runtime_error(format("Could not get ip address for host {} from raft_address_map", host));
-                }
-                co_return *ip;
-            };
-
-
             std::unordered_set<gms::inet_address> hosts;
             for (const auto& n : options.hosts) {
                 try {
@@ -1212,7 +1205,7 @@ future<int> repair_service::do_repair_start(sstring keyspace, std::unordered_map
 
             bool primary_replica_only = options.primary_range;
             auto ranges_parallelism = options.ranges_parallelism == -1 ? std::nullopt : std::optional<int>(options.ranges_parallelism);
-            co_await repair_tablets(id, keyspace, cfs, host2ip, primary_replica_only, options.ranges, options.data_centers, hosts, ignore_nodes, ranges_parallelism);
+            co_await repair_tablets(id, keyspace, cfs, get_host2ip(), primary_replica_only, options.ranges, options.data_centers, hosts, ignore_nodes, ranges_parallelism);
             co_return id.id;
         }
     }
@@ -2086,7 +2079,7 @@ static std::unordered_set<gms::inet_address> get_nodes_in_dcs(std::vector<sstrin
 }
 
 // Repair all tablets belong to this node for the given table
-future<> repair_service::repair_tablets(repair_uniq_id rid, sstring keyspace_name, std::vector<sstring> table_names, host2ip_t host2ip, bool primary_replica_only, dht::token_range_vector ranges_specified, std::vector<sstring> data_centers, std::unordered_set<gms::inet_address> hosts, std::unordered_set<gms::inet_address> ignore_nodes, std::optional<int> ranges_parallelism) {
+future<tasks::task_manager::task_ptr> repair_service::repair_tablets(repair_uniq_id rid, sstring keyspace_name, std::vector<sstring> table_names, host2ip_t host2ip, bool primary_replica_only, dht::token_range_vector ranges_specified, std::vector<sstring> data_centers, std::unordered_set<gms::inet_address> hosts, std::unordered_set<gms::inet_address> ignore_nodes, std::optional<int> ranges_parallelism) {
     std::vector<tablet_repair_task_meta> task_metas;
     for (auto& table_name : table_names) {
         lw_shared_ptr<replica::table> t;
@@ -2255,7 +2248,7 @@ future<> repair_service::repair_tablets(repair_uniq_id rid, sstring keyspace_nam
             }
         }
     }
-    auto task = co_await _repair_module->make_and_start_task<repair::tablet_repair_task_impl>({}, rid, keyspace_name, table_names, streaming::stream_reason::repair, std::move(task_metas), ranges_parallelism);
+    co_return co_await _repair_module->make_and_start_task<repair::tablet_repair_task_impl>({}, rid, keyspace_name, table_names, streaming::stream_reason::repair, std::move(task_metas), ranges_parallelism);
 }
 
 future<> repair::tablet_repair_task_impl::run() {
@@ -24,6 +24,7 @@
 #include "replica/database_fwd.hh"
 #include "mutation/frozen_mutation.hh"
 #include "utils/hash.hh"
+#include "utils/iblt.hh"
 #include "repair/hash.hh"
 #include "repair/sync_boundary.hh"
 #include "tasks/types.hh"
@@ -234,11 +235,22 @@ struct repair_row_on_wire_with_cmd {
 enum class row_level_diff_detect_algorithm : uint8_t {
     send_full_set,
     send_full_set_rpc_stream,
+    // Like send_full_set_rpc_stream, but the repair master reconciles its
+    // row hashes with those of a follower using a sketch of the latter (see
+    // repair_row_hashes_sketch) when it can, instead of fetching all of them.
+    send_set_sketch_rpc_stream,
 };
 
 std::ostream& operator<<(std::ostream& out, row_level_diff_detect_algorithm algo);
 std::string_view format_as(row_level_diff_detect_algorithm);
 
+// An invertible Bloom lookup table of the row hashes in the working row buf of
+// a repair follower, from which the repair master, which knows its own hashes,
+// can tell the ones that differ when they are few.
+struct repair_row_hashes_sketch {
+    std::vector<utils::iblt_cell> cells;
+};
+
 struct repair_update_system_table_request {
     tasks::task_id repair_uuid;
     table_id table_uuid;
@@ -38,6 +38,7 @@
 #include "gms/i_endpoint_state_change_subscriber.hh"
 #include "gms/gossiper.hh"
 #include "repair/row_level.hh"
+#include "repair/background_repair.hh"
 #include "utils/stall_free.hh"
 #include "utils/to_string.hh"
 #include "service/migration_manager.hh"
@@ -97,6 +98,8 @@ enum class repair_state : uint16_t {
     get_full_row_hashes_with_rpc_stream_finished,
     get_full_row_hashes_started,
     get_full_row_hashes_finished,
+    get_row_hashes_sketch_started,
+    get_row_hashes_sketch_finished,
     get_row_diff_started,
     get_row_diff_finished,
     put_row_diff_with_rpc_stream_started,
@@ -224,6 +227,7 @@ static const std::vector<row_level_diff_detect_algorithm>& suportted_diff_detect
     static std::vector<row_level_diff_detect_algorithm> _algorithms = {
         row_level_diff_detect_algorithm::send_full_set,
         row_level_diff_detect_algorithm::send_full_set_rpc_stream,
+        row_level_diff_detect_algorithm::send_set_sketch_rpc_stream,
     };
     return _algorithms;
 };
@@ -280,10 +284,11 @@ flat_mutation_reader_v2 repair_reader::make_reader(
     read_strategy strategy,
     const dht::sharder& remote_sharder,
     unsigned remote_shard,
-    gc_clock::time_point compaction_time) {
+    gc_clock::time_point compaction_time,
+    lw_shared_ptr<sstables::sstable_set> sstables) {
     switch (strategy) {
         case read_strategy::local: {
-            auto ms = mutation_source([&cf, compaction_time] (
+            auto ms = mutation_source([&cf, compaction_time, sstables = std::move(sstables)] (
                 schema_ptr s,
                 reader_permit permit,
                 const dht::partition_range& pr,
@@ -291,6 +296,11 @@ flat_mutation_reader_v2 repair_reader::make_reader(
                 tracing::trace_state_ptr,
                 streamed_mutation::forwarding,
                 mutation_reader::forwarding fwd_mr) {
+                if (sstables) {
+                    // The evictable reader reads with the full slice and without
+                    // forwarding, which is what this overload does.
+                    return cf.make_streaming_reader(std::move(s), std::move(permit), pr, sstables, compaction_time);
+                }
                 return cf.make_streaming_reader(std::move(s), std::move(permit), pr, ps, fwd_mr, compaction_time);
             });
             flat_mutation_reader_v2 rd(nullptr);
@@ -343,14 +353,15 @@ repair_reader::repair_reader(
     unsigned remote_shard,
     uint64_t seed,
     read_strategy strategy,
-    gc_clock::time_point compaction_time)
+    gc_clock::time_point compaction_time,
+    lw_shared_ptr<sstables::sstable_set> sstables)
     : _schema(s)
     , _permit(std::move(permit))
     , _range(dht::to_partition_range(range))
     , _sharder(remote_sharder, range, remote_shard)
     , _seed(seed)
     , _local_read_op(strategy == read_strategy::local ? std::optional(cf.read_in_progress()) : std::nullopt)
-    , _reader(make_reader(db, cf, strategy, remote_sharder, remote_shard, compaction_time))
+    , _reader(make_reader(db, cf, strategy, remote_sharder, remote_shard, compaction_time, std::move(sstables)))
 { }
 
 future<mutation_fragment_opt>
@@ -421,6 +432,7 @@ class repair_writer_impl : public repair_writer::impl {
     sharded<db::view::view_builder>& _view_builder;
     streaming::stream_reason _reason;
     flat_mutation_reader_v2 _queue_reader;
+    std::function<future<>(sstables::shared_sstable)> _on_sstable_added;
 public:
     repair_writer_impl(
         schema_ptr schema,
@@ -429,7 +441,8 @@ class repair_writer_impl : public repair_writer::impl {
         sharded<db::view::view_builder>& view_builder,
         streaming::stream_reason reason,
         mutation_fragment_queue queue,
-        flat_mutation_reader_v2 queue_reader)
+        flat_mutation_reader_v2 queue_reader,
+        std::function<future<>(sstables::shared_sstable)> on_sstable_added)
         : _schema(std::move(schema))
         , _permit(std::move(permit))
         , _mq(std::move(queue))
@@ -437,6 +450,7 @@ class repair_writer_impl : public repair_writer::impl {
         , _view_builder(view_builder)
         , _reason(reason)
         , _queue_reader(std::move(queue_reader))
+        , _on_sstable_added(std::move(on_sstable_added))
     {}
 
     virtual void create_writer(lw_shared_ptr<repair_writer> writer) override;
@@ -511,7 +525,7 @@ void repair_writer_impl::create_writer(lw_shared_ptr<repair_writer> w) {
     auto erm = t.get_effective_replication_map();
     auto& sharder = erm->get_sharder(*(w->schema()));
     _writer_done = mutation_writer::distribute_reader_and_consume_on_shards(_schema, sharder, std::move(_queue_reader),
-            streaming::make_streaming_consumer(sstables::repair_origin, _db, _view_builder, w->get_estimated_partitions(), _reason, is_offstrategy_supported(_reason), topo_guard),
+            streaming::make_streaming_consumer(sstables::repair_origin, _db, _view_builder, w->get_estimated_partitions(), _reason, is_offstrategy_supported(_reason), topo_guard, _on_sstable_added),
     t.stream_in_progress()).then([w, erm] (uint64_t partitions) {
         rlogger.debug("repair_writer: keyspace={}, table={}, managed to write partitions={} to sstable",
             w->schema()->ks_name(), w->schema()->cf_name(), partitions);
@@ -528,10 +542,11 @@ lw_shared_ptr<repair_writer> make_repair_writer(
             reader_permit permit,
             streaming::stream_reason reason,
             sharded<replica::database>& db,
-            sharded<db::view::view_builder>& view_builder) {
+            sharded<db::view::view_builder>& view_builder,
+            std::function<future<>(sstables::shared_sstable)> on_sstable_added) {
     auto [queue_reader, queue_handle] = make_queue_reader_v2(schema, permit);
     auto queue = make_mutation_fragment_queue(schema, permit, std::move(queue_handle));
-    auto i = std::make_unique<repair_writer_impl>(schema, permit, db, view_builder, reason, std::move(queue), std::move(queue_reader));
+    auto i = std::make_unique<repair_writer_impl>(schema, permit, db, view_builder, reason, std::move(queue), std::move(queue_reader), std::move(on_sstable_added));
     return make_lw_shared<repair_writer>(schema, permit, std::move(i));
 }
 
@@ -785,6 +800,19 @@ class repair_meta {
     repair_hasher _repair_hasher;
     gc_clock::time_point _compaction_time;
     bool _is_tablet;
+    // Incremental repair reads only the unrepaired sstables, whose generations
+    // are remembered so they can be marked as repaired once the range is.
+    // So are the ones written from the rows received from peers, otherwise
+    // the next repair would send them back to the peers.
+    bool _incremental;
+    std::unordered_set<sstables::generation_type> _unrepaired_generations;
+    // Set by the master when the repair fails, so that none of the above is
+    // marked. Followers aren't told, but theirs are only marked when the
+    // master reports the range as repaired, which it then doesn't.
+    bool _failed = false;
+    // Set once a peer's row hashes could not be reconciled from its sketch,
+    // after which the full row hashes are fetched straight away.
+    bool _row_hashes_sketch_failed = false;
     reader_concurrency_semaphore::inactive_read_handle _fake_inactive_read_handle;
 public:
     std::vector<repair_node_state>& all_nodes() {
@@ -801,6 +829,9 @@ class repair_meta {
         // The first node is the local node
         all_nodes().front().state = state;
     }
+    void set_failed() {
+        _failed = true;
+    }
     repair_stats& stats() {
         return _stats;
     }
@@ -822,6 +853,26 @@ class repair_meta {
     bool use_rpc_stream() const {
         return is_rpc_stream_supported(_algo);
     }
+    bool use_row_hashes_sketch() const {
+        return _algo == row_level_diff_detect_algorithm::send_set_sketch_rpc_stream && !_row_hashes_sketch_failed;
+    }
+
+private:
+    bool is_incremental(const replica::column_family& cf, streaming::stream_reason reason) const {
+        // Only tablets keep the sstables of a range apart from the others, so
+        // that they can be repaired as a whole.
+        return cf.uses_tablets() && reason == streaming::stream_reason::repair && _db.local().get_config().enable_incremental_repair();
+    }
+
+    // The sstables are written by the shards owning their data, which are
+    // called back once each of them is part of the table.
+    std::function<future<>(sstables::shared_sstable)> remember_sstables_written() {
+        return [this, shard = this_shard_id()] (sstables::shared_sstable sst) {
+            return smp::submit_to(shard, [this, generation = sst->generation()] {
+                _unrepaired_generations.insert(generation);
+            });
+        };
+    }
 
 public:
     // master constructor
@@ -860,7 +911,8 @@ class repair_meta {
             , _remote_sharder(make_remote_sharder())
             , _same_sharding_config(is_same_sharding_config(cf))
             , _nr_peer_nodes(nr_peer_nodes)
-            , _repair_writer(make_repair_writer(_schema, _permit, _reason, _db, rs.get_view_builder()))
+            , _repair_writer(make_repair_writer(_schema, _permit, _reason, _db, rs.get_view_builder(),
+                    is_incremental(cf, reason) ? remember_sstables_written() : nullptr))
             , _sink_source_for_get_full_row_hashes(_repair_meta_id, _nr_peer_nodes,
                     [&rs] (uint32_t repair_meta_id, std::optional<shard_id> dst_cpu_id_opt, netw::messaging_service::msg_addr addr) {
                         auto dst_cpu_id = dst_cpu_id_opt.value_or(repair_unspecified_shard);
@@ -883,6 +935,7 @@ class repair_meta {
             , _repair_hasher(_seed, _schema)
             , _compaction_time(compaction_time)
             , _is_tablet(cf.uses_tablets())
+            , _incremental(is_incremental(cf, reason))
             {
             if (master) {
                 add_to_repair_meta_for_masters(*this);
@@ -951,7 +1004,13 @@ class repair_meta {
         rlogger.debug("repair_meta::stop");
         // move to background.  waited on via _stopped->get_future.
         when_all_succeed(std::move(gate_future), std::move(f1), std::move(f2), std::move(f3)).discard_result().finally([this] {
-            return _repair_writer->wait_for_writer_done().finally([this] {
+            return _repair_writer->wait_for_writer_done().then([this] {
+                // All the sstables written from received rows are known only
+                // once the writer is done.
+                if (!_failed && !_unrepaired_generations.empty()) {
+                    _rs.add_unrepaired_sstables_read(_schema->id(), _range, std::move(_unrepaired_generations));
+                }
+            }).finally([this] {
                 return close().then([this] {
                     return clear_gently();
                 });
@@ -1140,6 +1199,14 @@ class repair_meta {
         std::list<repair_row> cur_rows;
         std::exception_ptr ex;
         if (!_repair_reader) {
+            lw_shared_ptr<sstables::sstable_set> unrepaired_sstables;
+            if (_incremental) {
+                unrepaired_sstables = co_await _db.local().find_column_family(_schema->id()).take_unrepaired_sstable_set(_range);
+                unrepaired_sstables->for_each_sstable([this] (const sstables::shared_sstable& sst) {
+                    _unrepaired_generations.insert(sst->generation());
+                });
+                rlogger.debug("repair_reader: meta_id={}, reading {} unrepaired sstables", _repair_meta_id, _unrepaired_generations.size());
+            }
             // We are about to create a real evictable reader, so drop the fake
             // reader (evicted or not), we don't need it anymore.
             _db.local().get_reader_concurrency_semaphore().unregister_inactive_read(std::move(_fake_inactive_read_handle));
@@ -1198,7 +1265,8 @@ class repair_meta {
                         read_strategy);
                     return read_strategy;
                 }),
-                _compaction_time);
+                _compaction_time,
+                std::move(unrepaired_sstables));
         }
         try {
             while (cur_size < _max_row_buf_size) {
@@ -1554,6 +1622,87 @@ class repair_meta {
         });
     }
 
+private:
+    // Below this many rows in the working row buf, sending the full row
+    // hashes is cheap enough.
+    static constexpr size_t row_hashes_sketch_min_rows = 4096;
+    static constexpr size_t row_hashes_sketch_min_cells = 384;
+    static constexpr size_t row_hashes_sketch_max_cells = 1 << 20;
+
+    future<utils::iblt> make_row_hashes_sketch(const repair_hash_set& hashes, size_t nr_cells) {
+        utils::iblt sketch(nr_cells);
+        for (auto& h : hashes) {
+            sketch.insert(h.hash);
+            co_await coroutine::maybe_yield();
+        }
+        co_return sketch;
+    }
+
+public:
+    // RPC API
+    // Return the hashes of the rows in the peer's _working_row_buf, rebuilt
+    // from the local ones and a sketch of the peer's, which is a lot smaller
+    // than the full list when the two differ in few rows. Returns std::nullopt
+    // if the working row buf is too small to bother or if the hashes differ
+    // too much to be rebuilt, in which case the full hashes have to be fetched.
+    future<std::optional<repair_hash_set>>
+    get_row_hashes_with_sketch(gms::inet_address remote_node, shard_id dst_cpu_id, repair_hash remote_combined_hash) {
+        auto hashes = co_await working_row_hashes();
+        if (hashes.size() < row_hashes_sketch_min_rows) {
+            co_return std::nullopt;
+        }
+        const auto nr_cells = std::min(std::max(row_hashes_sketch_min_cells, hashes.size() / 16), row_hashes_sketch_max_cells);
+        auto resp = co_await ser::partition_checksum_rpc_verbs::send_repair_get_row_hashes_sketch(&_messaging, msg_addr(remote_node),
+                _repair_meta_id, uint32_t(nr_cells), uint32_t(dst_cpu_id));
+        stats().rpc_call_nr++;
+        stats().rx_hashes_nr += resp.cells.size();
+        _metrics.rx_hashes_nr += resp.cells.size();
+
+        utils::iblt sketch(std::move(resp.cells));
+        sketch.subtract(co_await make_row_hashes_sketch(hashes, sketch.size()));
+        auto diff = std::move(sketch).decode();
+        if (!diff) {
+            rlogger.debug("Failed to decode row hashes sketch from peer={}, nr_hashes={}, nr_cells={}, falling back to full hashes",
+                    remote_node, hashes.size(), nr_cells);
+            _row_hashes_sketch_failed = true;
+            co_return std::nullopt;
+        }
+        for (auto h : diff->removed) {
+            hashes.erase(repair_hash(h));
+        }
+        for (auto h : diff->added) {
+            hashes.insert(repair_hash(h));
+        }
+        // A sketch decodes to a wrong difference only with a tiny probability,
+        // but a wrong set of hashes would go unnoticed, so check it against
+        // the combined hash the peer sent.
+        repair_hash combined;
+        for (auto& h : hashes) {
+            combined.add(h);
+            co_await coroutine::maybe_yield();
+        }
+        if (combined != remote_combined_hash) {
+            rlogger.debug("Row hashes rebuilt from sketch of peer={} do not match its combined hash, falling back to full hashes", remote_node);
+            _row_hashes_sketch_failed = true;
+            co_return std::nullopt;
+        }
+        rlogger.debug("Got row hashes sketch from peer={}, nr_hashes={}, nr_cells={}, added={}, removed={}",
+                remote_node, hashes.size(), nr_cells, diff->added.size(), diff->removed.size());
+        co_return std::move(hashes);
+    }
+
+    // RPC handler
+    future<repair_row_hashes_sketch>
+    get_row_hashes_sketch_handler(uint32_t nr_cells) {
+        if (nr_cells > row_hashes_sketch_max_cells) {
+            throw std::runtime_error(format("Row hashes sketch of {} cells requested, the maximum is {}", nr_cells, row_hashes_sketch_max_cells));
+        }
+        auto gh = _gate.hold();
+        auto hashes = co_await working_row_hashes();
+        auto sketch = co_await make_row_hashes_sketch(hashes, nr_cells);
+        co_return repair_row_hashes_sketch{std::move(sketch).release()};
+    }
+
     // RPC API
     // Return the combined hashes of the current working row buf
     future<get_combined_row_hash_response>
@@ -2254,6 +2403,67 @@ static future<> repair_get_full_row_hashes_with_rpc_stream_handler(
     });
 }
 
+void repair_service::add_unrepaired_sstables_read(table_id table, dht::token_range range, std::unordered_set<sstables::generation_type> generations) {
+    // Followers aren't told when a repair fails after they are done, so
+    // their entries are dropped once too old to be reported as repaired.
+    const auto now = lowres_clock::now();
+    _unrepaired_sstables_read.remove_if([now] (const unrepaired_sstables_read& e) {
+        return now - e.added > unrepaired_sstables_read_ttl;
+    });
+    auto it = std::ranges::find_if(_unrepaired_sstables_read, [&] (const unrepaired_sstables_read& e) {
+        return e.table == table && e.range == range;
+    });
+    if (it != _unrepaired_sstables_read.end()) {
+        it->generations = std::move(generations);
+        it->added = now;
+    } else {
+        _unrepaired_sstables_read.push_back(unrepaired_sstables_read{table, std::move(range), std::move(generations), now});
+    }
+}
+
+std::unordered_set<sstables::generation_type> repair_service::take_unrepaired_sstables_read(table_id table, const dht::token_range& range) {
+    auto it = std::ranges::find_if(_unrepaired_sstables_read, [&] (const unrepaired_sstables_read& e) {
+        return e.table == table && e.range == range;
+    });
+    if (it == _unrepaired_sstables_read.end()) {
+        return {};
+    }
+    if (lowres_clock::now() - it->added > unrepaired_sstables_read_ttl) {
+        _unrepaired_sstables_read.erase(it);
+        return {};
+    }
+    auto generations = std::move(it->generations);
+    _unrepaired_sstables_read.erase(it);
+    return generations;
+}
+
+void repair_service::drop_unrepaired_sstables_read(table_id table, const dht::token_range& range) {
+    _unrepaired_sstables_read.remove_if([&] (const unrepaired_sstables_read& e) {
+        return e.table == table && e.range == range;
+    });
+}
+
+future<> repair_service::mark_sstables_as_repaired(table_id table, dht::token_range range, gc_clock::time_point repair_time) {
+    // The sstables written from received rows belong to the shards owning
+    // their data, which need not be the one that repaired the range.
+    auto generations = co_await container().map_reduce0([&] (repair_service& rs) {
+        return rs.take_unrepaired_sstables_read(table, range);
+    }, std::unordered_set<sstables::generation_type>(), [] (std::unordered_set<sstables::generation_type> a, std::unordered_set<sstables::generation_type> b) {
+        a.merge(b);
+        return a;
+    });
+    if (generations.empty()) {
+        co_return;
+    }
+    co_await container().invoke_on_all([&] (repair_service& rs) -> future<> {
+        try {
+            co_await rs._db.local().find_column_family(table).mark_sstables_as_repaired(range, generations, repair_time);
+        } catch (replica::no_such_column_family&) {
+            rlogger.debug("Table {} was dropped before its sstables in range {} were marked as repaired", table, range);
+        }
+    });
+}
+
 future<repair_update_system_table_response> repair_service::repair_update_system_table_handler(gms::inet_address from, repair_update_system_table_request req) {
     rlogger.debug("repair[{}]: Got repair_update_system_table_request from node={}, range={}, repair_time={}", req.repair_uuid, from, req.range, req.repair_time);
     auto& db = this->get_db();
@@ -2286,6 +2496,7 @@ future<repair_update_system_table_response> repair_service::repair_update_system
     auto range_end = req.range.end() ? req.range.end()->value() : dht::maximum_token();
     ent.range_end = dht::token::to_int64(range_end);
     co_await _sys_ks.local().update_repair_history(std::move(ent));
+    co_await mark_sstables_as_repaired(req.table_uuid, req.range, req.repair_time);
     co_return repair_update_system_table_response();
 }
 
@@ -2371,6 +2582,20 @@ future<> repair_service::init_ms_handlers() {
             });
         }) ;
     });
+    ser::partition_checksum_rpc_verbs::register_repair_get_row_hashes_sketch(&ms, [this] (const rpc::client_info& cinfo, uint32_t repair_meta_id, uint32_t nr_cells, uint32_t dst_cpu_id) {
+        auto src_cpu_id = cinfo.retrieve_auxiliary<uint32_t>("src_cpu_id");
+        auto from = cinfo.retrieve_auxiliary<gms::inet_address>("baddr");
+        auto shard = get_dst_shard_id(src_cpu_id, dst_cpu_id);
+        return container().invoke_on(shard, [from, repair_meta_id, nr_cells] (repair_service& local_repair) {
+            auto rm = local_repair.get_repair_meta(from, repair_meta_id);
+            rm->set_repair_state_for_local_node(repair_state::get_row_hashes_sketch_started);
+            return rm->get_row_hashes_sketch_handler(nr_cells).then([rm] (repair_row_hashes_sketch sketch) {
+                rm->set_repair_state_for_local_node(repair_state::get_row_hashes_sketch_finished);
+                _metrics.tx_hashes_nr += sketch.cells.size();
+                return sketch;
+            });
+        });
+    });
     ms.register_repair_get_combined_row_hash([this] (const rpc::client_info& cinfo, uint32_t repair_meta_id,
             std::optional<repair_sync_boundary> common_sync_boundary, rpc::optional<shard_id> dst_cpu_id_opt) {
         auto src_cpu_id = cinfo.retrieve_auxiliary<uint32_t>("src_cpu_id");
@@ -2526,7 +2751,8 @@ future<> repair_service::uninit_ms_handlers() {
         ms.unregister_repair_set_estimated_partitions(),
         ms.unregister_repair_get_diff_algorithms(),
         ser::partition_checksum_rpc_verbs::unregister_repair_update_system_table(&ms),
-        ser::partition_checksum_rpc_verbs::unregister_repair_flush_hints_batchlog(&ms)
+        ser::partition_checksum_rpc_verbs::unregister_repair_flush_hints_batchlog(&ms),
+        ser::partition_checksum_rpc_verbs::unregister_repair_get_row_hashes_sketch(&ms)
         ).discard_result();
 }
 
@@ -2816,8 +3042,18 @@ class row_level_repair {
 
             rlogger.debug("Before master.get_full_row_hashes for node {}, hash_sets={}",
                 node, master.peer_row_hash_sets(node_idx).size());
+            // Try to rebuild the peer's hashes from a sketch of them first,
+            // which is much smaller than the full list when few rows differ.
+            std::optional<repair_hash_set> peer_hashes;
+            if (master.use_row_hashes_sketch()) {
+                ns.state = repair_state::get_row_hashes_sketch_started;
+                peer_hashes = master.get_row_hashes_with_sketch(node, dst_cpu_id, combined_hashes[node_idx + 1]).get();
+                ns.state = repair_state::get_row_hashes_sketch_finished;
+            }
             // Ask the peer to send the full list hashes in the working row buf.
-            if (master.use_rpc_stream()) {
+            if (peer_hashes) {
+                master.peer_row_hash_sets(node_idx) = std::move(*peer_hashes);
+            } else if (master.use_rpc_stream()) {
                 ns.state = repair_state::get_full_row_hashes_with_rpc_stream_started;
                 master.peer_row_hash_sets(node_idx) = master.get_full_row_hashes_with_rpc_stream(node, node_idx, dst_cpu_id).get();
                 ns.state = repair_state::get_full_row_hashes_with_rpc_stream_finished;
@@ -3076,11 +3312,13 @@ class row_level_repair {
                 rlogger.warn("repair[{}]: shard={}, keyspace={}, cf={}, range={}, got error in row level repair: {}",
                         _shard_task.global_repair_id.uuid(), this_shard_id(), _shard_task.get_keyspace(), _cf_name, _range, e);
                 _failed = true;
+                master.set_failed();
             } catch (std::exception& e) {
                 rlogger.warn("repair[{}]: shard={}, keyspace={}, cf={}, range={}, got error in row level repair: {}",
                         _shard_task.global_repair_id.uuid(), this_shard_id(), _shard_task.get_keyspace(), _cf_name, _range, e);
                 // In case the repair process fail, we need to call repair_row_level_stop to clean up repair followers
                 _failed = true;
+                master.set_failed();
                 ex = std::current_exception();
             }
 
@@ -3094,6 +3332,11 @@ class row_level_repair {
 
             _shard_task.update_statistics(master.stats());
             if (_failed) {
+                // Whatever a previous repair of the range recorded can't be
+                // trusted to be repaired anymore.
+                _shard_task.rs.container().invoke_on_all([this] (repair_service& rs) {
+                    rs.drop_unrepaired_sstables_read(_table_id, _range);
+                }).get();
                 if (table_dropped) {
                     throw replica::no_such_column_family(_shard_task.get_keyspace(),  _cf_name);
                 } else {
@@ -3101,6 +3344,10 @@ class row_level_repair {
                                             _cf_name, _range))), std::move(ex));
                 }
             } else {
+                // Stopping the master records the unrepaired sstables it read
+                // and wrote, which have to be known before the master itself
+                // is told that the range is repaired.
+                master.stop().get();
                 update_system_repair_table().get();
             }
             rlogger.debug("<<< Finished Row Level Repair (Master): local={}, peers={}, repair_meta_id={}, keyspace={}, cf={}, range={}, tx_hashes_nr={}, rx_hashes_nr={}, tx_row_nr={}, rx_row_nr={}, row_from_disk_bytes={}, row_from_disk_nr={}",
@@ -3205,12 +3452,22 @@ repair_service::repair_service(sharded<service::topology_state_machine>& tsm,
 }
 
 future<> repair_service::start() {
-    _load_history_done = load_history();
+    _load_history_done = load_history().finally([this] {
+        _history_loaded.set_value();
+    });
     co_await init_ms_handlers();
+    if (this_shard_id() == 0) {
+        _background_repair = std::make_unique<repair::background_repair_scheduler>(*this, _db, _sp);
+        _background_repair->start();
+    }
 }
 
 future<> repair_service::stop() {
   try {
+    if (_background_repair) {
+        rlogger.debug("Stopping background repair scheduler");
+        co_await _background_repair->stop();
+    }
     rlogger.debug("Stopping repair task module");
     co_await _repair_module->stop();
     rlogger.debug("Waiting on load_history_done");
@@ -3267,6 +3524,12 @@ future<> repair_service::cleanup_history(tasks::task_id repair_id) {
     });
 }
 
+future<> repair_service::wait_for_history_loaded() {
+    return container().invoke_on_all([] (repair_service& rs) {
+        return rs._history_loaded.get_shared_future();
+    });
+}
+
 future<> repair_service::load_history() {
   try {
     co_await get_db().local().get_tables_metadata().parallel_for_each_table(coroutine::lambda([&] (table_id table_uuid, lw_shared_ptr<replica::table> table) -> future<> {
@@ -3447,3 +3710,13 @@ future<uint32_t> repair_service::get_next_repair_meta_id() {
 gms::inet_address repair_service::my_address() const noexcept {
     return _sp.local().my_address();
 }
+
+host2ip_t repair_service::get_host2ip() const {
+    return [&addr_map = _addr_map] (locator::host_id host) -> future<gms::inet_address> {
+        auto ip = addr_map.local().find(raft::server_id(host.uuid()));
+        if (!ip) {
+            throw std::runtime_error(format("Could not get ip address for host {} from raft_address_map", host));
+        }
+        co_return *ip;
+    };
+}
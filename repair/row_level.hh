@@ -8,13 +8,17 @@
 
 #pragma once
 
+#include <list>
+#include <unordered_set>
 #include <vector>
 #include "gms/inet_address.hh"
 #include "repair/repair.hh"
 #include "repair/task_manager_module.hh"
 #include "tasks/task_manager.hh"
 #include "locator/abstract_replication_strategy.hh"
+#include "sstables/generation_type.hh"
 #include <seastar/core/distributed.hh>
+#include <seastar/core/shared_future.hh>
 #include <seastar/util/bool_class.hh>
 #include "service/raft/raft_address_map.hh"
 
@@ -41,6 +45,10 @@ namespace gms {
 
 class repair_meta;
 
+namespace repair {
+class background_repair_scheduler;
+}
+
 using repair_meta_ptr = shared_ptr<repair_meta>;
 
 struct shard_config {
@@ -103,7 +111,23 @@ class repair_service : public seastar::peering_sharded_service<repair_service> {
 
     std::unordered_map<tasks::task_id, repair_history> _finished_ranges_history;
 
+    // Generations of the unrepaired sstables read by incremental repair, and of
+    // the ones it wrote from received rows, per table and range, kept until
+    // the range is repaired on all replicas.
+    struct unrepaired_sstables_read {
+        table_id table;
+        dht::token_range range;
+        std::unordered_set<sstables::generation_type> generations;
+        lowres_clock::time_point added;
+    };
+    // The range is reported as repaired right after the replicas are done
+    // with it, so entries older than this are left by failed repairs.
+    static constexpr std::chrono::minutes unrepaired_sstables_read_ttl{10};
+    std::list<unrepaired_sstables_read> _unrepaired_sstables_read;
+
     shared_ptr<row_level_repair_gossip_helper> _gossip_helper;
+    // Only on shard 0
+    std::unique_ptr<repair::background_repair_scheduler> _background_repair;
     bool _stopped = false;
 
     size_t _max_repair_memory;
@@ -111,6 +135,7 @@ class repair_service : public seastar::peering_sharded_service<repair_service> {
     seastar::named_semaphore _load_parallelism_semaphore = {16, named_semaphore_exception_factory{"Load repair history parallelism"}};
 
     future<> _load_history_done = make_ready_future<>();
+    shared_promise<> _history_loaded;
 
     future<> init_ms_handlers();
     future<> uninit_ms_handlers();
@@ -141,6 +166,8 @@ class repair_service : public seastar::peering_sharded_service<repair_service> {
     future<std::optional<gc_clock::time_point>> update_history(tasks::task_id repair_id, table_id table_id, dht::token_range range, gc_clock::time_point repair_time, bool is_tablet);
     future<> cleanup_history(tasks::task_id repair_id);
     future<> load_history();
+    // Resolves once the repair history has been loaded on all shards.
+    future<> wait_for_history_loaded();
 
     future<int> do_repair_start(sstring keyspace, std::unordered_map<sstring, sstring> options_map);
 
@@ -164,9 +191,22 @@ class repair_service : public seastar::peering_sharded_service<repair_service> {
             shared_ptr<node_ops_info> ops_info);
 
 public:
-    future<> repair_tablets(repair_uniq_id id, sstring keyspace_name, std::vector<sstring> table_names, host2ip_t host2ip, bool primary_replica_only = true, dht::token_range_vector ranges_specified = {}, std::vector<sstring> dcs = {}, std::unordered_set<gms::inet_address> hosts = {}, std::unordered_set<gms::inet_address> ignore_nodes = {}, std::optional<int> ranges_parallelism = std::nullopt);
+    // Returns the task repairing the tablets, once started.
+    future<tasks::task_manager::task_ptr> repair_tablets(repair_uniq_id id, sstring keyspace_name, std::vector<sstring> table_names, host2ip_t host2ip, bool primary_replica_only = true, dht::token_range_vector ranges_specified = {}, std::vector<sstring> dcs = {}, std::unordered_set<gms::inet_address> hosts = {}, std::unordered_set<gms::inet_address> ignore_nodes = {}, std::optional<int> ranges_parallelism = std::nullopt);
+
+    // Remembers the unrepaired sstables read and written by a successful
+    // incremental repair of the range, replacing the ones of any previous
+    // repair of it. They are marked as repaired when the repair master
+    // reports the range as repaired.
+    void add_unrepaired_sstables_read(table_id table, dht::token_range range, std::unordered_set<sstables::generation_type> generations);
+    // Forgets the unrepaired sstables remembered for the range, after a
+    // failed repair of it.
+    void drop_unrepaired_sstables_read(table_id table, const dht::token_range& range);
 
 private:
+    std::unordered_set<sstables::generation_type> take_unrepaired_sstables_read(table_id table, const dht::token_range& range);
+    // Marks the sstables remembered for the range on all shards as repaired.
+    future<> mark_sstables_as_repaired(table_id table, dht::token_range range, gc_clock::time_point repair_time);
 
     future<repair_update_system_table_response> repair_update_system_table_handler(
             gms::inet_address from,
@@ -185,6 +225,8 @@ class repair_service : public seastar::peering_sharded_service<repair_service> {
     size_t max_repair_memory() const { return _max_repair_memory; }
     seastar::semaphore& memory_sem() { return _memory_sem; }
     gms::inet_address my_address() const noexcept;
+    // Translates host ids using the raft address map.
+    host2ip_t get_host2ip() const;
 
     repair::task_manager_module& get_repair_module() noexcept {
         return *_repair_module;
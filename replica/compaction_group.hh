@@ -17,6 +17,7 @@
 #include "locator/tablets.hh"
 #include "sstables/sstable_set.hh"
 #include "utils/chunked_vector.hh"
+#include "utils/histogram.hh"
 #include <boost/intrusive/list.hpp>
 #include <absl/container/flat_hash_map.h>
 
@@ -30,6 +31,40 @@ namespace replica {
 
 using enable_backlog_tracker = bool_class<class enable_backlog_tracker_tag>;
 
+// Tracks the rate of requests served by a compaction group, which is reported
+// to the tablet load balancer, so it can spread hot tablets across shards.
+// update() must be called every utils::meter_timer::tick_interval().
+class traffic_meter {
+    static constexpr auto window = std::chrono::minutes(1);
+    utils::moving_average _reads{window, utils::meter_timer::tick_interval()};
+    utils::moving_average _writes{window, utils::meter_timer::tick_interval()};
+    utils::moving_average _read_bytes{window, utils::meter_timer::tick_interval()};
+    utils::moving_average _write_bytes{window, utils::meter_timer::tick_interval()};
+public:
+    void mark_read(uint64_t bytes) noexcept {
+        _reads.add();
+        _read_bytes.add(bytes);
+    }
+    void mark_write(uint64_t bytes) noexcept {
+        _writes.add();
+        _write_bytes.add(bytes);
+    }
+    void update() noexcept {
+        _reads.update();
+        _writes.update();
+        _read_bytes.update();
+        _write_bytes.update();
+    }
+    locator::tablet_load_stats rates() const noexcept {
+        return locator::tablet_load_stats{
+            .reads = _reads.rate(),
+            .writes = _writes.rate(),
+            .read_bytes = _read_bytes.rate(),
+            .write_bytes = _write_bytes.rate(),
+        };
+    }
+};
+
 // Compaction group is a set of SSTables which are eligible to be compacted together.
 // By this definition, we can say:
 //      - A group contains SSTables that are owned by the same shard.
@@ -59,6 +94,7 @@ class compaction_group {
     seastar::condition_variable _staging_done_condition;
     // Gates async operations confined to a single group.
     seastar::gate _async_gate;
+    traffic_meter _traffic;
     using list_hook_t = boost::intrusive::list_member_hook<boost::intrusive::link_mode<boost::intrusive::auto_unlink>>;
     list_hook_t _list_hook;
 private:
@@ -171,6 +207,13 @@ class compaction_group {
         return _async_gate;
     }
 
+    traffic_meter& traffic() noexcept {
+        return _traffic;
+    }
+    const traffic_meter& traffic() const noexcept {
+        return _traffic;
+    }
+
     compaction_manager& get_compaction_manager() noexcept;
 
     friend class storage_group;
@@ -205,6 +248,8 @@ class storage_group {
     compaction_group_ptr& select_compaction_group(locator::tablet_range_side) noexcept;
 
     uint64_t live_disk_space_used() const noexcept;
+    // Request rates served by all compaction groups of this storage group.
+    locator::tablet_load_stats traffic() const noexcept;
 
     utils::small_vector<compaction_group*, 3> compaction_groups() noexcept;
 
@@ -269,6 +314,8 @@ class storage_group_manager {
 
     virtual compaction_group& compaction_group_for_token(dht::token token) const noexcept = 0;
     virtual utils::chunked_vector<compaction_group*> compaction_groups_for_token_range(dht::token_range tr) const = 0;
+    // Like compaction_groups_for_token_range(), without collecting the groups.
+    virtual void for_each_compaction_group_for_token_range(dht::token_range tr, noncopyable_function<void(compaction_group&)> func) const = 0;
     virtual compaction_group& compaction_group_for_key(partition_key_view key, const schema_ptr& s) const noexcept = 0;
     virtual compaction_group& compaction_group_for_sstable(const sstables::shared_sstable& sst) const noexcept = 0;
 
@@ -41,6 +41,7 @@
 #include "mutation/async_utils.hh"
 #include <seastar/core/do_with.hh>
 #include "service/migration_listener.hh"
+#include "service/qos/qos_common.hh"
 #include "cell_locking.hh"
 #include "view_info.hh"
 #include "db/schema_tables.hh"
@@ -59,6 +60,7 @@
 #include "db/timeout_clock.hh"
 #include "db/large_data_handler.hh"
 #include "db/data_listeners.hh"
+#include "db/heavy_hitters.hh"
 
 #include "data_dictionary/user_types_metadata.hh"
 #include <seastar/core/shared_ptr_incomplete.hh>
@@ -377,6 +379,7 @@ database::database(const db::config& cfg, database_config dbcfg, service::migrat
     , _system_sstables_manager(std::make_unique<sstables::sstables_manager>("system", *_nop_large_data_handler, _cfg, feat, _row_cache_tracker, dbcfg.available_memory, sst_dir_sem, [&stm]{ return stm.get()->get_my_id(); }, dbcfg.streaming_scheduling_group))
     , _result_memory_limiter(dbcfg.available_memory / 10)
     , _data_listeners(std::make_unique<db::data_listeners>())
+    , _heavy_hitters(std::make_unique<db::heavy_hitters>(*this, _cfg.heavy_hitters_sample_every))
     , _mnotifier(mn)
     , _feat(feat)
     , _shared_token_metadata(stm)
@@ -1566,7 +1569,8 @@ database::query(schema_ptr s, const query::read_command& cmd, query::result_opti
             querier_opt->permit().set_trace_state(trace_state);
             f = co_await coroutine::as_future(semaphore.with_ready_permit(querier_opt->permit(), read_func));
         } else {
-            f = co_await coroutine::as_future(semaphore.with_permit(s, "data-query", cf.estimate_read_memory_cost(), timeout, trace_state, read_func));
+            f = co_await coroutine::as_future(semaphore.with_permit(s, "data-query", cf.estimate_read_memory_cost(), timeout, trace_state, read_func,
+                    [&cf, &ranges] { return cf.estimate_read_cost(ranges); }));
         }
 
         if (!f.failed()) {
@@ -1633,7 +1637,8 @@ database::query_mutations(schema_ptr s, const query::read_command& cmd, const dh
             querier_opt->permit().set_trace_state(trace_state);
             f = co_await coroutine::as_future(semaphore.with_ready_permit(querier_opt->permit(), read_func));
         } else {
-            f = co_await coroutine::as_future(semaphore.with_permit(s, "mutation-query", cf.estimate_read_memory_cost(), timeout, trace_state, read_func));
+            f = co_await coroutine::as_future(semaphore.with_permit(s, "mutation-query", cf.estimate_read_memory_cost(), timeout, trace_state, read_func,
+                    [&cf, &range] { return cf.estimate_read_cost({&range, 1}); }));
         }
 
         if (!f.failed()) {
@@ -1677,13 +1682,47 @@ query::max_result_size database::get_query_max_result_size() const {
 
 reader_concurrency_semaphore& database::get_reader_concurrency_semaphore() {
     switch (classify_request(_dbcfg)) {
-        case request_class::user: return _read_concurrency_sem;
+        case request_class::user: return get_user_reader_concurrency_semaphore(current_scheduling_group());
         case request_class::system: return _system_read_concurrency_sem;
         case request_class::maintenance: return _streaming_concurrency_sem;
     }
     std::abort();
 }
 
+reader_concurrency_semaphore& database::get_user_reader_concurrency_semaphore(scheduling_group sg) {
+    if (!sg.name().starts_with(qos::scheduling_group_name_prefix)) {
+        return _read_concurrency_sem;
+    }
+    auto it = _service_level_read_concurrency_sems.find(sg);
+    if (it == _service_level_read_concurrency_sems.end()) {
+        // Each service level gets a semaphore of its own, so that the reads
+        // of one can't queue the reads of another. The groups are few,
+        // seastar has a fixed number of them.
+        it = _service_level_read_concurrency_sems.emplace(sg, std::make_unique<reader_concurrency_semaphore>(max_count_concurrent_reads,
+                max_memory_concurrent_reads(),
+                sg.name(),
+                max_inactive_queue_length(),
+                _cfg.reader_concurrency_semaphore_serialize_limit_multiplier,
+                _cfg.reader_concurrency_semaphore_kill_limit_multiplier,
+                reader_concurrency_semaphore::register_metrics::yes)).first;
+        split_user_read_memory();
+    }
+    return *it->second;
+}
+
+void database::split_user_read_memory() {
+    // The user semaphores share the memory of the user reads, so that adding
+    // service levels doesn't add to the memory reads may take.
+    const auto memory = ssize_t(max_memory_concurrent_reads() / (1 + _service_level_read_concurrency_sems.size()));
+    auto set_memory = [memory] (reader_concurrency_semaphore& sem) {
+        sem.set_resources({sem.initial_resources().count, memory});
+    };
+    set_memory(_read_concurrency_sem);
+    for (auto& [_, sem] : _service_level_read_concurrency_sems) {
+        set_memory(*sem);
+    }
+}
+
 future<reader_permit> database::obtain_reader_permit(table& tbl, const char* const op_name, db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr) {
     return get_reader_concurrency_semaphore().obtain_permit(tbl.schema(), op_name, tbl.estimate_read_memory_cost(), timeout, std::move(trace_ptr));
 }
@@ -1709,6 +1748,9 @@ future<> database::foreach_reader_concurrency_semaphore(std::function<future<>(r
     for (auto* sem : {&_read_concurrency_sem, &_streaming_concurrency_sem, &_compaction_concurrency_sem, &_system_read_concurrency_sem}) {
         co_await func(*sem);
     }
+    for (auto& [_, sem] : _service_level_read_concurrency_sems) {
+        co_await func(*sem);
+    }
 }
 
 std::ostream& operator<<(std::ostream& out, const column_family& cf) {
@@ -2328,6 +2370,9 @@ future<> database::stop() {
     co_await _streaming_concurrency_sem.stop();
     co_await _compaction_concurrency_sem.stop();
     co_await _system_read_concurrency_sem.stop();
+    for (auto& [_, sem] : _service_level_read_concurrency_sems) {
+        co_await sem->stop();
+    }
     dblog.info("Joining memtable update action");
     co_await _update_memtable_flush_static_shares_action.join();
 }
@@ -22,6 +22,7 @@
 #include <functional>
 #include <unordered_map>
 #include <set>
+#include <span>
 #include <boost/functional/hash.hpp>
 #include <boost/range/algorithm/find.hpp>
 #include <optional>
@@ -126,6 +127,7 @@ class config;
 class extensions;
 class rp_handle;
 class data_listeners;
+class heavy_hitters;
 class large_data_handler;
 class system_keyspace;
 class table_selector;
@@ -630,11 +632,12 @@ class table : public enable_lw_shared_from_this<table>
     // update the sstable generation, making sure (in calculate_generation_for_new_table)
     // that new new sstables don't overwrite this one.
     void update_sstables_known_generation(sstables::generation_type generation);
-
-    sstables::generation_type calculate_generation_for_new_table();
 private:
     void rebuild_statistics();
     void subtract_compaction_group_from_stats(const compaction_group& cg) noexcept;
+    // Refreshes _stats.pending_compactions, which the dirty memory manager
+    // takes into account when picking a memtable to flush.
+    void update_pending_compactions_stat() noexcept;
 private:
     mutation_source_opt _virtual_reader;
     std::optional<noncopyable_function<future<>(const frozen_mutation&)>> _virtual_writer;
@@ -851,6 +854,13 @@ class table : public enable_lw_shared_from_this<table>
     future<> cleanup_tablet_without_deallocation(database& db, db::system_keyspace& sys_ks, locator::tablet_id tid);
     future<const_mutation_partition_ptr> find_partition(schema_ptr, reader_permit permit, const dht::decorated_key& key) const;
     future<const_row_ptr> find_row(schema_ptr, reader_permit permit, const dht::decorated_key& partition_key, clustering_key clustering_key) const;
+    // Returns the clustering keys of the live rows of the partition whose cell
+    // in the column is equal to the value, using the ColumnIndex component of
+    // the sstables to only read the candidate rows from them. Returns
+    // std::nullopt if one of the sstables of the partition doesn't index the
+    // column.
+    future<std::optional<std::vector<clustering_key_prefix>>> find_rows_by_column_value(reader_permit permit,
+            const dht::decorated_key& dk, const column_definition& cdef, bytes value) const;
     shard_id shard_for_reads(dht::token t) const;
     dht::shard_replica_set shard_for_writes(dht::token t) const;
     // Applies given mutation to this column family
@@ -1157,8 +1167,15 @@ class table : public enable_lw_shared_from_this<table>
     }
 
     size_t estimate_read_memory_cost() const;
+    // Estimate the cost of reading the ranges, for admission ordering.
+    // Selects the sstables of the range and probes their bloom filters, so
+    // only worth calling for reads which have to wait for admission.
+    reader_cost_estimate estimate_read_cost(std::span<const dht::partition_range> ranges) const;
 
 private:
+    // Accounts a read of the ranges, which returned the given amount of bytes, to the
+    // request rates of the tablets it touched.
+    void account_read(std::span<const dht::partition_range> ranges, uint64_t bytes);
     future<row_locker::lock_holder> do_push_view_replica_updates(shared_ptr<db::view::view_update_generator> gen, schema_ptr s, mutation m, db::timeout_clock::time_point timeout, mutation_source source,
             tracing::trace_state_ptr tr_state, reader_concurrency_semaphore& sem, query::partition_slice::option_set custom_opts) const;
     std::vector<view_ptr> affected_views(shared_ptr<db::view::view_update_generator> gen, const schema_ptr& base, const mutation& update) const;
@@ -1232,6 +1249,19 @@ class table : public enable_lw_shared_from_this<table>
     // a list of SSTables that represent the snapshot.
     future<utils::chunked_vector<sstables::sstable_files_snapshot>> take_storage_snapshot(dht::token_range tr);
 
+    // Flushes the compaction groups that overlap with a given token range and
+    // returns the set of their unrepaired sstables which overlap with it.
+    // Incremental repair reads only from those.
+    future<lw_shared_ptr<sstables::sstable_set>> take_unrepaired_sstable_set(dht::token_range tr);
+
+    // Marks the sstables with the given generations as repaired at repair_time,
+    // among the ones which are still part of the table and whose data lies
+    // entirely within the token range.
+    future<> mark_sstables_as_repaired(dht::token_range tr, std::unordered_set<sstables::generation_type> generations, gc_clock::time_point repair_time);
+
+    // Returns a generation for a new sstable of this table, which is not used by any other sstable.
+    sstables::generation_type calculate_generation_for_new_table();
+
     // Clones storage of a given tablet. Memtable is flushed first to guarantee that the
     // snapshot (list of sstables) will include all the data written up to the time it was taken.
     future<utils::chunked_vector<sstables::entry_descriptor>> clone_tablet_storage(locator::tablet_id tid);
@@ -1464,6 +1494,10 @@ class database : public peering_sharded_service<database> {
     reader_concurrency_semaphore _streaming_concurrency_sem;
     reader_concurrency_semaphore _compaction_concurrency_sem;
     reader_concurrency_semaphore _system_read_concurrency_sem;
+    // The user reads of the service levels with their own scheduling group,
+    // by scheduling group. Created on the first read of each group.
+    std::unordered_map<scheduling_group, std::unique_ptr<reader_concurrency_semaphore>> _service_level_read_concurrency_sems;
+    void split_user_read_memory();
 
     db::timeout_semaphore _view_update_concurrency_sem{max_memory_pending_view_updates()};
 
@@ -1504,6 +1538,8 @@ class database : public peering_sharded_service<database> {
 
     friend db::data_listeners;
     std::unique_ptr<db::data_listeners> _data_listeners;
+    // Installed in _data_listeners, so must be destroyed before it.
+    std::unique_ptr<db::heavy_hitters> _heavy_hitters;
 
     service::migration_notifier& _mnotifier;
     gms::feature_service& _feat;
@@ -1608,6 +1644,7 @@ class database : public peering_sharded_service<database> {
     }
 
     seastar::scheduling_group get_streaming_scheduling_group() const { return _dbcfg.streaming_scheduling_group; }
+    seastar::scheduling_group get_statement_scheduling_group() const { return _dbcfg.statement_scheduling_group; }
 
     compaction_manager& get_compaction_manager() {
         return _compaction_manager;
@@ -1852,6 +1889,10 @@ class database : public peering_sharded_service<database> {
         return *_data_listeners;
     }
 
+    db::heavy_hitters& heavy_hitters() const {
+        return *_heavy_hitters;
+    }
+
     // Get the maximum result size for a query, appropriate for the
     // query class, which is deduced from the current scheduling group.
     query::max_result_size get_query_max_result_size() const;
@@ -1859,6 +1900,8 @@ class database : public peering_sharded_service<database> {
     // Get the reader concurrency semaphore, appropriate for the query class,
     // which is deduced from the current scheduling group.
     reader_concurrency_semaphore& get_reader_concurrency_semaphore();
+    // The semaphore for user reads running in the given scheduling group.
+    reader_concurrency_semaphore& get_user_reader_concurrency_semaphore(scheduling_group sg);
 
     // Convenience method to obtain an admitted permit. See reader_concurrency_semaphore::obtain_permit().
     future<reader_permit> obtain_reader_permit(table& tbl, const char* const op_name, db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr);
@@ -230,9 +230,103 @@ dirty_memory_manager::setup_collectd(sstring namestr) {
 
         sm::make_gauge(namestr +"_unspooled_dirty_bytes", [this] { return unspooled_dirty_memory(); },
                        sm::description("Holds the size of used memory in bytes. Compare it to \"dirty_bytes\" to see how many memory is wasted (neither used nor available).")),
+
+        sm::make_counter(namestr + "_pressure_flushes", _stats.pressure_flushes,
+                       sm::description("Counts memtable flushes started because dirty memory crossed the soft limit.")),
+
+        sm::make_counter(namestr + "_pressure_flushes_not_largest", _stats.pressure_flushes_not_largest,
+                       sm::description("Counts pressure flushes which picked a memtable other than the largest one, "
+                                       "because the largest one was young (still filling quickly) or its table had a compaction backlog.")),
+
+        sm::make_counter(namestr + "_pressure_flushed_bytes", _stats.pressure_flushed_bytes,
+                       sm::description("Counts memtable bytes selected for flushing by pressure flushes. "
+                                       "Divide by pressure_flushes to get the average size of sstables created by pressure flushes.")),
+
+        sm::make_gauge(namestr + "_pressure_flush_interval_seconds", [this] { return _pressure_flush_interval.count(); },
+                       sm::description("Holds the moving average of the interval between pressure flushes, used as the growth horizon when picking memtables to flush.")),
+
+        sm::make_gauge(namestr + "_last_pressure_flush_score", [this] { return _stats.last_pressure_flush_score; },
+                       sm::description("Holds the score of the memtable picked by the last pressure flush.")),
     });
 }
 
+// Picking the largest memtable releases the most memory per flush, but a
+// memtable which is large only because its table is written to heavily will
+// keep growing if left alone, and flushing it early just creates more (and
+// smaller) sstables over time. A memtable which has been filling slowly for a
+// long time, on the other hand, holds memory which will not be amortized any
+// further.
+//
+// We estimate the fill rate of a memtable as size/age, so that by the time the
+// flush serializer comes back to us (horizon), the memtable is expected to
+// have grown by size*horizon/age. Scoring each candidate by
+//
+//     size / (1 + horizon/age) = size * age / (age + horizon)
+//
+// prefers large memtables, but discounts the ones that are still filling up
+// quickly relative to their size. The score is further boosted (by at most
+// twice) for tables with a compaction backlog: their new sstable is folded into
+// compactions which are already due, and flushing them early keeps their
+// memtable, which reads have to merge with all the uncompacted sstables, small.
+double dirty_memory_manager::flush_candidate_score(const flush_candidate& c, std::chrono::duration<double> horizon) noexcept {
+    constexpr int64_t max_debt = 16;
+    auto age = std::max(c.age.count(), 0.001);
+    auto growth_discount = age / (age + std::max(horizon.count(), 0.0));
+    auto debt_boost = 1.0 + double(std::clamp<int64_t>(c.pending_compactions, 0, max_debt)) / max_debt;
+    return double(c.size) * growth_discount * debt_boost;
+}
+
+dirty_memory_manager::pressure_flush_pick dirty_memory_manager::pick_memtable_to_flush() noexcept {
+    auto* largest = _region_group.get_largest_region();
+    if (!largest) {
+        return {};
+    }
+    // Past the hard limit, writes are blocked until memory is released, so
+    // whatever releases the most of it goes first.
+    if (_region_group.under_unspooled_pressure()) {
+        auto& mt = memtable::from_region(*largest);
+        auto size = mt.region().evictable_occupancy().total_space();
+        if (!size) {
+            return {};
+        }
+        return {&mt, double(size), true};
+    }
+    auto now = lowres_clock::now();
+    pressure_flush_pick best;
+    _region_group.for_each_region([&] (dirty_memory_manager_logalloc::size_tracked_region* r) {
+        auto& mt = memtable::from_region(*r);
+        auto size = mt.region().evictable_occupancy().total_space();
+        if (!size) {
+            return;
+        }
+        auto score = flush_candidate_score({
+            .size = size,
+            .age = now - mt.creation_time(),
+            .pending_compactions = mt.get_table_stats().pending_compactions,
+        }, _pressure_flush_interval);
+        if (!best.memtable || score > best.score) {
+            best = {&mt, score, r == largest};
+        }
+    });
+    return best;
+}
+
+void dirty_memory_manager::account_pressure_flush(const pressure_flush_pick& pick) noexcept {
+    constexpr double alpha = 0.2;
+    constexpr std::chrono::duration<double> min_interval = 10ms;
+    constexpr std::chrono::duration<double> max_interval = 60s;
+
+    auto now = lowres_clock::now();
+    std::chrono::duration<double> interval = now - std::exchange(_last_pressure_flush, now);
+    interval = std::clamp(interval, min_interval, max_interval);
+    _pressure_flush_interval = alpha * interval + (1 - alpha) * _pressure_flush_interval;
+
+    ++_stats.pressure_flushes;
+    _stats.pressure_flushes_not_largest += !pick.largest;
+    _stats.pressure_flushed_bytes += pick.memtable->region().evictable_occupancy().total_space();
+    _stats.last_pressure_flush_score = pick.score;
+}
+
 future<> dirty_memory_manager::shutdown() {
     _db_shutdown_requested = true;
     _should_flush.signal();
@@ -271,19 +365,21 @@ future<> dirty_memory_manager::flush_when_needed() {
                 // flush. Most of the time we want some coordination with the commitlog to allow us to
                 // release commitlog segments as early as we can.
                 //
-                // But during pressure condition, we'll just pick the CF that holds the largest
-                // memtable. The advantage of doing this is that this is objectively the one that will
-                // release the biggest amount of memory and is less likely to be generating tiny
-                // SSTables.
-                memtable& candidate_memtable = memtable::from_region(*(this->_region_group.get_largest_region()));
-                memtable_list& mtlist = *(candidate_memtable.get_memtable_list());
-
-                if (!candidate_memtable.region().evictable_occupancy()) {
+                // But during pressure condition, we pick the memtable which releases the most memory
+                // while being least likely to generate tiny SSTables, taking into account how fast
+                // each memtable is growing and the compaction backlog of its table.
+                // See flush_candidate_score(). Past the hard limit, we just pick the largest one.
+                auto pick = this->pick_memtable_to_flush();
+                memtable* candidate_memtable = pick.memtable;
+
+                if (!candidate_memtable) {
                     // Soft pressure, but nothing to flush. It could be due to fsync, memtable_to_cache lagging,
                     // or candidate_memtable failed to flush.
                     // Back off to avoid OOMing with flush continuations.
                     return sleep(1ms);
                 }
+                memtable_list& mtlist = *(candidate_memtable->get_memtable_list());
+                this->account_pressure_flush(pick);
 
                 // Do not wait. The semaphore will protect us against a concurrent flush. But we
                 // want to start a new one as soon as the permits are destroyed and the semaphore is
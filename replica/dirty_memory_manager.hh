@@ -12,6 +12,7 @@
 #include <boost/heap/binomial_heap.hpp>
 #include <seastar/core/condition-variable.hh>
 #include <seastar/core/future.hh>
+#include <seastar/core/lowres_clock.hh>
 #include <seastar/core/metrics_registration.hh>
 #include <seastar/core/semaphore.hh>
 #include "replica/database_fwd.hh"
@@ -318,6 +319,15 @@ class region_group : public logalloc::region_listener {
     // children.
     size_tracked_region* get_largest_region() noexcept;
 
+    // Invokes func on every region tracked by this region group, in no particular order.
+    // func must not add or remove regions.
+    template <typename Func>
+    void for_each_region(Func&& func) const {
+        for (auto* r : _regions) {
+            func(r);
+        }
+    }
+
     // Shutdown is mandatory for every user who has set a threshold
     // Can be called at most once.
     future<> shutdown() noexcept;
@@ -424,8 +434,46 @@ class dirty_memory_manager {
 
     unsigned _extraneous_flushes = 0;
 
+    struct stats {
+        uint64_t pressure_flushes = 0;
+        // Pressure flushes which picked a memtable other than the largest one.
+        uint64_t pressure_flushes_not_largest = 0;
+        uint64_t pressure_flushed_bytes = 0;
+        double last_pressure_flush_score = 0;
+    } _stats;
+
+    // Exponentially weighted average of the interval between consecutive
+    // pressure flushes. Used as the horizon over which memtables are expected
+    // to keep growing if they are not picked for flushing now.
+    std::chrono::duration<double> _pressure_flush_interval = std::chrono::seconds(1);
+    lowres_clock::time_point _last_pressure_flush = lowres_clock::now();
+
+    struct pressure_flush_pick {
+        replica::memtable* memtable = nullptr;
+        double score = 0;
+        // Whether the memtable is the largest one in the region group.
+        bool largest = false;
+    };
+    pressure_flush_pick pick_memtable_to_flush() noexcept;
+    // Called when the flush of the picked memtable is issued.
+    void account_pressure_flush(const pressure_flush_pick& pick) noexcept;
+
     seastar::metrics::metric_groups _metrics;
 public:
+    // The inputs of the flush selection model for a single memtable.
+    struct flush_candidate {
+        // Evictable memory held by the memtable, in bytes.
+        size_t size;
+        // Time since the memtable became active.
+        std::chrono::duration<double> age;
+        // Compaction backlog of the table owning the memtable.
+        int64_t pending_compactions;
+    };
+
+    // Returns how desirable it is to flush the given memtable under memory
+    // pressure; higher is better. See the definition for the model.
+    static double flush_candidate_score(const flush_candidate& c, std::chrono::duration<double> horizon) noexcept;
+
     void setup_collectd(sstring namestr);
 
     future<> shutdown();
@@ -9,6 +9,7 @@
 #pragma once
 
 #include <fmt/core.h>
+#include <seastar/core/lowres_clock.hh>
 #include "replica/database_fwd.hh"
 #include "dht/decorated_key.hh"
 #include "dht/ring_position.hh"
@@ -129,6 +130,9 @@ class memtable final : public enable_lw_shared_from_this<memtable>, private dirt
     uint64_t _flushed_memory = 0;
     bool _merged_into_cache = false;
     replica::table_stats& _table_stats;
+    // Used by the dirty_memory_manager to estimate the rate at which this
+    // memtable is being filled.
+    lowres_clock::time_point _creation_time = lowres_clock::now();
 
     class memtable_encoding_stats_collector : public encoding_stats_collector {
     private:
@@ -227,6 +231,14 @@ class memtable final : public enable_lw_shared_from_this<memtable>, private dirt
         return _memtable_list;
     }
 
+    const replica::table_stats& get_table_stats() const noexcept {
+        return _table_stats;
+    }
+
+    lowres_clock::time_point creation_time() const noexcept {
+        return _creation_time;
+    }
+
     size_t partition_count() const noexcept { return nr_partitions; }
     logalloc::occupancy_stats occupancy() const noexcept;
 
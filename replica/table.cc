@@ -58,6 +58,7 @@
 #include "readers/empty_v2.hh"
 #include "readers/multi_range.hh"
 #include "readers/combined.hh"
+#include "partition_slice_builder.hh"
 #include "readers/compacting.hh"
 
 namespace replica {
@@ -169,6 +170,71 @@ table::find_row(schema_ptr s, reader_permit permit, const dht::decorated_key& pa
     });
 }
 
+future<std::optional<std::vector<clustering_key_prefix>>>
+table::find_rows_by_column_value(reader_permit permit, const dht::decorated_key& dk, const column_definition& cdef, bytes value) const {
+    auto s = _schema;
+    auto range = dht::partition_range::make_singular(dk);
+
+    // Memtables aren't indexed, so all of their rows are candidates.
+    std::vector<clustering_key_prefix> candidates;
+    {
+        std::vector<flat_mutation_reader_v2> readers;
+        add_memtables_to_reader_list(readers, s, permit, range, s->full_slice(), nullptr,
+                streamed_mutation::forwarding::no, mutation_reader::forwarding::no, [&] (size_t memtable_count) {
+            readers.reserve(memtable_count);
+        });
+        auto rd = make_combined_reader(s, permit, std::move(readers));
+        auto f = co_await coroutine::as_future(read_mutation_from_flat_mutation_reader(rd));
+        co_await rd.close();
+        if (auto mo = f.get()) {
+            for (const auto& e : mo->partition().clustered_rows()) {
+                candidates.push_back(e.key());
+            }
+        }
+    }
+
+    auto key = sstables::sstable::make_hashed_key(*s, dk.key());
+    for (auto& sst : _sstables->select(range)) {
+        if (!sst->filter_has_key(key)) {
+            continue;
+        }
+        auto rows = co_await sst->find_rows_by_column_value(dk, cdef, value);
+        if (!rows) {
+            co_return std::nullopt;
+        }
+        std::move(rows->begin(), rows->end(), std::back_inserter(candidates));
+    }
+    if (candidates.empty()) {
+        co_return candidates;
+    }
+    std::sort(candidates.begin(), candidates.end(), clustering_key_prefix::less_compare(*s));
+    candidates.erase(std::unique(candidates.begin(), candidates.end(), clustering_key_prefix::equality(*s)), candidates.end());
+
+    // The index of an sstable doesn't know about newer writes to its rows,
+    // so the candidates are read back to drop the ones which no longer have
+    // the value.
+    std::vector<query::clustering_range> ranges;
+    ranges.reserve(candidates.size());
+    for (auto& ck : candidates) {
+        ranges.push_back(query::clustering_range::make_singular(std::move(ck)));
+    }
+    auto slice = partition_slice_builder(*s).with_ranges(ranges).build();
+    auto rd = make_reader_v2(s, std::move(permit), range, slice);
+    auto f = co_await coroutine::as_future(read_mutation_from_flat_mutation_reader(rd));
+    co_await rd.close();
+    std::vector<clustering_key_prefix> rows;
+    if (auto mo = f.get()) {
+        mo->partition().compact_for_query(*s, dk, gc_clock::now(), ranges, false, false, query::max_rows);
+        for (const auto& e : mo->partition().clustered_rows()) {
+            auto cell = e.row().cells().find_cell(cdef.id);
+            if (cell && to_bytes(cell->as_atomic_cell(cdef).value()) == value) {
+                rows.push_back(e.key());
+            }
+        }
+    }
+    co_return rows;
+}
+
 void
 table::add_memtables_to_reader_list(std::vector<flat_mutation_reader_v2>& readers,
         const schema_ptr& s,
@@ -608,6 +674,9 @@ class single_storage_group_manager final : public storage_group_manager {
         ret.push_back(&get_compaction_group());
         return ret;
     }
+    void for_each_compaction_group_for_token_range(dht::token_range tr, noncopyable_function<void(compaction_group&)> func) const override {
+        func(get_compaction_group());
+    }
     compaction_group& compaction_group_for_key(partition_key_view key, const schema_ptr& s) const noexcept override {
         return get_compaction_group();
     }
@@ -645,6 +714,8 @@ class tablet_storage_group_manager final : public storage_group_manager {
     // current split, and not a previously revoked (stale) decision.
     // The minimum value, which is a negative number, is not used by coordinator for first decision.
     locator::resize_decision::seq_number_t _split_ready_seq_number = std::numeric_limits<locator::resize_decision::seq_number_t>::min();
+    // Periodically updates the request rates of compaction groups, reported in table_load_stats().
+    utils::meter_timer _traffic_timer;
 private:
     const schema_ptr& schema() const {
         return _t.schema();
@@ -694,6 +765,11 @@ class tablet_storage_group_manager final : public storage_group_manager {
         : _t(t)
         , _my_host_id(erm.get_token_metadata().get_my_id())
         , _tablet_map(&erm.get_token_metadata().tablets().get_tablet_map(schema()->id()))
+        , _traffic_timer([this] {
+            for (auto& cg : _compaction_groups) {
+                cg.traffic().update();
+            }
+        })
     {
         storage_group_map ret;
 
@@ -716,6 +792,7 @@ class tablet_storage_group_manager final : public storage_group_manager {
 
     compaction_group& compaction_group_for_token(dht::token token) const noexcept override;
     utils::chunked_vector<compaction_group*> compaction_groups_for_token_range(dht::token_range tr) const override;
+    void for_each_compaction_group_for_token_range(dht::token_range tr, noncopyable_function<void(compaction_group&)> func) const override;
     compaction_group& compaction_group_for_key(partition_key_view key, const schema_ptr& s) const noexcept override;
     compaction_group& compaction_group_for_sstable(const sstables::shared_sstable& sst) const noexcept override;
 
@@ -919,6 +996,13 @@ compaction_group& table::compaction_group_for_token(dht::token token) const noex
 
 utils::chunked_vector<compaction_group*> tablet_storage_group_manager::compaction_groups_for_token_range(dht::token_range tr) const {
     utils::chunked_vector<compaction_group*> ret;
+    for_each_compaction_group_for_token_range(std::move(tr), [&ret] (compaction_group& cg) {
+        ret.push_back(&cg);
+    });
+    return ret;
+}
+
+void tablet_storage_group_manager::for_each_compaction_group_for_token_range(dht::token_range tr, noncopyable_function<void(compaction_group&)> func) const {
     auto cmp = dht::token_comparator();
 
     size_t candidate_start = tr.start() ? tablet_id_for_token(tr.start()->value()) : size_t(0);
@@ -932,12 +1016,10 @@ utils::chunked_vector<compaction_group*> tablet_storage_group_manager::compactio
         auto& sg = it->second;
         for (auto& cg : sg->compaction_groups()) {
             if (cg && tr.overlaps(cg->token_range(), cmp)) {
-                ret.push_back(cg);
+                func(*cg);
             }
         }
     }
-
-    return ret;
 }
 
 utils::chunked_vector<compaction_group*> table::compaction_groups_for_token_range(dht::token_range tr) const {
@@ -1018,6 +1100,58 @@ future<utils::chunked_vector<sstables::sstable_files_snapshot>> table::take_stor
     co_return std::move(ret);
 }
 
+future<lw_shared_ptr<sstables::sstable_set>> table::take_unrepaired_sstable_set(dht::token_range tr) {
+    auto holder = async_gate().hold();
+    auto ret = make_lw_shared<sstables::sstable_set>(sstables::make_partitioned_sstable_set(_schema));
+    auto pr = dht::to_partition_range(tr);
+
+    for (auto& cg : compaction_groups_for_token_range(tr)) {
+        // Flush, so that the set contains all the data written before the
+        // repair started. Later writes are left for the next repair.
+        co_await cg->flush();
+
+        for (auto& sst : cg->make_sstable_set()->select(pr)) {
+            if (!sst->is_repaired()) {
+                ret->insert(sst);
+            }
+        }
+    }
+
+    co_return ret;
+}
+
+future<> table::mark_sstables_as_repaired(dht::token_range tr, std::unordered_set<sstables::generation_type> generations, gc_clock::time_point repair_time) {
+    auto holder = async_gate().hold();
+    const auto repaired_at = uint64_t(repair_time.time_since_epoch().count());
+
+    for (auto& cg : compaction_groups_for_token_range(tr)) {
+        auto to_mark = [&] {
+            std::vector<sstables::shared_sstable> ret;
+            cg->make_sstable_set()->for_each_sstable([&] (const sstables::shared_sstable& sst) {
+                // An sstable which also holds data outside of the range wasn't
+                // fully repaired.
+                auto sst_range = dht::token_range::make(sst->get_first_decorated_key().token(), sst->get_last_decorated_key().token());
+                if (generations.contains(sst->generation()) && !sst->is_repaired() && tr.contains(sst_range, dht::token_comparator())) {
+                    ret.push_back(sst);
+                }
+            });
+            return ret;
+        };
+        if (to_mark().empty()) {
+            continue;
+        }
+        // Stop compaction of the group while the sstables are mutated, so
+        // none of them is compacted away, and deleted, under our feet.
+        co_await get_compaction_manager().run_with_compaction_disabled(cg->as_table_state(), [&] () -> future<> {
+            auto ssts = to_mark();
+            for (auto& sst : ssts) {
+                co_await sst->mutate_repaired_at(repaired_at);
+            }
+            tlogger.debug("Marked {} sstables of {}.{} in range {} as repaired at {}", ssts.size(), _schema->ks_name(), _schema->cf_name(), tr, repaired_at);
+        });
+    }
+}
+
 future<utils::chunked_vector<sstables::entry_descriptor>>
 table::clone_tablet_storage(locator::tablet_id tid) {
     utils::chunked_vector<sstables::entry_descriptor> ret;
@@ -1547,6 +1681,14 @@ uint64_t storage_group::live_disk_space_used() const noexcept {
     return boost::accumulate(cgs | boost::adaptors::transformed(std::mem_fn(&compaction_group::live_disk_space_used)), uint64_t(0));
 }
 
+locator::tablet_load_stats storage_group::traffic() const noexcept {
+    locator::tablet_load_stats stats;
+    for (auto* cg : const_cast<storage_group&>(*this).compaction_groups()) {
+        stats += cg->traffic().rates();
+    }
+    return stats;
+}
+
 uint64_t compaction_group::total_disk_space_used() const noexcept {
     return live_disk_space_used() + boost::accumulate(_sstables_compacted_but_not_deleted | boost::adaptors::transformed(std::mem_fn(&sstables::sstable::bytes_on_disk)), uint64_t(0));
 }
@@ -1561,6 +1703,7 @@ void table::rebuild_statistics() {
         _stats.total_disk_space_used += cg.total_disk_space_used();
         _stats.live_sstable_count += cg.live_sstable_count();
     }
+    update_pending_compactions_stat();
 }
 
 void table::subtract_compaction_group_from_stats(const compaction_group& cg) noexcept {
@@ -1776,12 +1919,14 @@ void table::start_compaction() {
 }
 
 void table::trigger_compaction() {
+    update_pending_compactions_stat();
     for (compaction_group& cg : compaction_groups()) {
         cg.trigger_compaction();
     }
 }
 
 void table::try_trigger_compaction(compaction_group& cg) noexcept {
+    update_pending_compactions_stat();
     try {
         cg.trigger_compaction();
     } catch (...) {
@@ -1840,6 +1985,14 @@ unsigned table::estimate_pending_compactions() const {
     }), unsigned(0));
 }
 
+void table::update_pending_compactions_stat() noexcept {
+    try {
+        _stats.pending_compactions = estimate_pending_compactions();
+    } catch (...) {
+        tlogger.warn("Failed to estimate pending compactions of {}.{}: {}", _schema->ks_name(), _schema->cf_name(), std::current_exception());
+    }
+}
+
 void compaction_group::set_compaction_strategy_state(compaction::compaction_strategy_state compaction_strategy_state) noexcept {
     _compaction_strategy_state = std::move(compaction_strategy_state);
 }
@@ -2069,6 +2222,10 @@ locator::table_load_stats tablet_storage_group_manager::table_load_stats(std::fu
         locator::global_tablet_id gid { _t.schema()->id(), locator::tablet_id(id) };
         if (tablet_filter(*_tablet_map, gid)) {
             stats.size_in_bytes += sg.live_disk_space_used();
+            auto traffic = sg.traffic();
+            if (traffic.reads || traffic.writes) {
+                stats.tablets.emplace(gid.tablet, traffic);
+            }
         }
     });
     return stats;
@@ -2797,6 +2954,56 @@ size_t table::estimate_read_memory_cost() const {
     return new_reader_base_cost;
 }
 
+reader_cost_estimate table::estimate_read_cost(std::span<const dht::partition_range> ranges) const {
+    if (ranges.size() != 1 || !ranges.front().is_singular()) {
+        return reader_cost_estimate{
+            .kind = reader_cost_estimate::read_kind::range_scan,
+            .sstables = sstables_count(),
+        };
+    }
+    const auto& pos = ranges.front().start()->value();
+    auto sstables = _sstables->select(ranges.front());
+    auto count = sstables.size();
+    // Readers skip the sstables whose bloom filter rules the partition out.
+    if (pos.has_key()) {
+        auto hk = sstables::sstable::make_hashed_key(*_schema, *pos.key());
+        count = std::ranges::count_if(sstables, [&] (const sstables::shared_sstable& sst) {
+            return sst->filter_has_key(hk);
+        });
+    }
+    return reader_cost_estimate{
+        .kind = reader_cost_estimate::read_kind::single_partition,
+        .sstables = count,
+        .memory = count * new_reader_base_cost,
+    };
+}
+
+void table::account_read(std::span<const dht::partition_range> ranges, uint64_t bytes) {
+    // Traffic is only reported to the tablet load balancer.
+    if (ranges.empty() || !uses_tablets()) {
+        return;
+    }
+    // Bytes are split evenly between the ranges, and then between the groups of each range.
+    const auto range_bytes = bytes / ranges.size();
+    for (auto& range : ranges) {
+        if (range.is_singular() && range.start()->value().has_key()) {
+            compaction_group_for_token(range.start()->value().token()).traffic().mark_read(range_bytes);
+            continue;
+        }
+        auto token_range = range.transform(std::mem_fn(&dht::ring_position::token));
+        size_t groups = 0;
+        _sg_manager->for_each_compaction_group_for_token_range(token_range, [&groups] (compaction_group&) {
+            ++groups;
+        });
+        if (!groups) {
+            continue;
+        }
+        _sg_manager->for_each_compaction_group_for_token_range(std::move(token_range), [group_bytes = range_bytes / groups] (compaction_group& cg) {
+            cg.traffic().mark_read(group_bytes);
+        });
+    }
+}
+
 void table::set_hit_rate(gms::inet_address addr, cache_temperature rate) {
     auto& e = _cluster_cache_hit_rates[addr];
     e.rate = rate;
@@ -2875,6 +3082,9 @@ void table::do_apply(compaction_group& cg, db::rp_handle&& h, Args&&... args) {
 future<> table::apply(const mutation& m, db::rp_handle&& h, db::timeout_clock::time_point timeout) {
     auto& cg = compaction_group_for_token(m.token());
     auto holder = cg.async_gate().hold();
+    if (uses_tablets()) {
+        cg.traffic().mark_write(m.memory_usage(*m.schema()));
+    }
     return dirty_memory_region_group().run_when_memory_available([this, &m, h = std::move(h), &cg, holder = std::move(holder)] () mutable {
         do_apply(cg, std::move(h), m);
     }, timeout);
@@ -2889,6 +3099,9 @@ future<> table::apply(const frozen_mutation& m, schema_ptr m_schema, db::rp_hand
 
     auto& cg = compaction_group_for_key(m.key(), m_schema);
     auto holder = cg.async_gate().hold();
+    if (uses_tablets()) {
+        cg.traffic().mark_write(m.representation().size());
+    }
 
     return dirty_memory_region_group().run_when_memory_available([this, &m, m_schema = std::move(m_schema), h = std::move(h), &cg, holder = std::move(holder)]() mutable {
         do_apply(cg, std::move(h), m, m_schema);
@@ -3003,7 +3216,9 @@ table::query(schema_ptr s,
         *saved_querier = std::move(querier_opt);
     }
 
-    co_return make_lw_shared<query::result>(qs.builder.build(std::move(last_pos)));
+    auto result = make_lw_shared<query::result>(qs.builder.build(std::move(last_pos)));
+    account_read(partition_ranges, result->buf().size());
+    co_return result;
 }
 
 future<reconcilable_result>
@@ -3045,6 +3260,7 @@ table::mutation_query(schema_ptr s,
         *saved_querier = std::move(querier_opt);
     }
 
+    account_read({&range, 1}, r.memory_usage());
     co_return r;
   } catch (...) {
     ex = std::current_exception();
@@ -571,6 +571,7 @@ class range_populating_reader {
                     });
                 }
                 _cache.on_partition_miss();
+                tracing::account_row_cache_read(_read_context.trace_state(), false);
                 const partition_start& ps = mfopt->as_partition_start();
                 const dht::decorated_key& key = ps.key();
                 if (_reader.creation_phase() == _cache.phase_of(key)) {
@@ -622,6 +623,7 @@ class scanning_and_populating_reader final : public flat_mutation_reader_v2::imp
     flat_mutation_reader_v2 read_from_entry(cache_entry& ce) {
         _cache.upgrade_entry(ce);
         _cache.on_partition_hit();
+        tracing::account_row_cache_read(_read_context->trace_state(), true);
         return ce.read(_cache, *_read_context);
     }
 
@@ -793,11 +795,15 @@ row_cache::make_reader_opt(schema_ptr s,
                 cache_entry& e = *i;
                 upgrade_entry(e);
                 on_partition_hit();
+                tracing::mark(trace_state, tracing::request_stage::cache_read);
+                tracing::account_row_cache_read(trace_state, true);
                 return e.read(*this, make_context());
             } else if (i->continuous()) {
                 return {};
             } else {
                 tracing::trace(trace_state, "Range {} not found in cache", range);
+                tracing::mark(trace_state, tracing::request_stage::cache_miss);
+                tracing::account_row_cache_read(trace_state, false);
                 on_partition_miss();
                 return make_flat_mutation_reader_v2<single_partition_populating_reader>(*this, make_context());
             }
@@ -812,6 +818,7 @@ row_cache::make_reader_opt(schema_ptr s,
 
     tracing::trace(trace_state, "Scanning cache for range {} and slice {}",
                    range, seastar::value_of([&slice] { return slice.get_all_ranges(); }));
+    tracing::mark(trace_state, tracing::request_stage::cache_read);
     auto mr = make_scanning_reader(range, make_context());
     if (fwd == streamed_mutation::forwarding::yes) {
         return make_forwardable(std::move(mr));
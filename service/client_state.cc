@@ -241,7 +241,8 @@ future<> service::client_state::maybe_update_per_service_level_params() {
     if (_sl_controller && _user && _user->name) {
         auto& role_manager = _auth_service->underlying_role_manager();
         auto role_set = co_await role_manager.query_granted(_user->name.value(), auth::recursive_role_query::yes);
-        auto slo_opt = co_await _sl_controller->find_service_level(role_set);
+        auto slo_opt = co_await _sl_controller->find_service_level(role_set, qos::include_effective_names::yes);
+        _scheduling_service_level = std::nullopt;
         if (!slo_opt) {
             co_return;
         }
@@ -267,5 +268,15 @@ future<> service::client_state::maybe_update_per_service_level_params() {
         _timeout_config.other_timeout = slo_timeout_or(_default_timeout_config.other_timeout);
 
         _workload_type = slo_opt->workload;
+        if (qos::get_shares(*slo_opt)) {
+            _scheduling_service_level = slo_opt->effective_names->shares;
+        }
+    }
+}
+
+std::optional<scheduling_group> service::client_state::get_scheduling_group() const {
+    if (!_sl_controller || !_scheduling_service_level) {
+        return std::nullopt;
     }
+    return _sl_controller->get_scheduling_group(*_scheduling_service_level);
 }
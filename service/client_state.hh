@@ -126,6 +126,9 @@ class client_state {
 
     workload_type _workload_type = workload_type::unspecified;
 
+    // The service level whose scheduling group the statements run in.
+    std::optional<sstring> _scheduling_service_level;
+
 public:
     struct internal_tag {};
     struct external_tag {};
@@ -134,6 +137,10 @@ class client_state {
         return _workload_type;
     }
 
+    // Returns the scheduling group of the service level of the user, if it
+    // has one of its own.
+    std::optional<scheduling_group> get_scheduling_group() const;
+
     auth_state get_auth_state() const noexcept {
         return _auth_state;
     }
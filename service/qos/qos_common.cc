@@ -31,6 +31,16 @@ service_level_options service_level_options::replace_defaults(const service_leve
             // leave the value as is
         },
     }, ret.timeout);
+    std::visit(overloaded_functor {
+        [&] (const unset_marker& um) {
+            ret.shares = default_values.shares;
+        },
+        [&] (const delete_marker& dm) {
+            ret.shares = unset_marker{};
+        },
+        [&] (int32_t) {
+        },
+    }, ret.shares);
     switch (ret.workload) {
     case workload_type::unspecified:
         ret.workload = default_values.workload;
@@ -57,6 +67,12 @@ service_level_options service_level_options::merge_with(const service_level_opti
         }
     };
 
+    auto maybe_update_shares_name = [] (service_level_options& slo, const service_level_options& other) {
+        if (slo.effective_names && other.effective_names) {
+            slo.effective_names->shares = other.effective_names->shares;
+        }
+    };
+
     service_level_options ret = *this;
     std::visit(overloaded_functor {
         [&] (const unset_marker& um) {
@@ -90,6 +106,15 @@ service_level_options service_level_options::merge_with(const service_level_opti
         maybe_update_workload_name(ret, other);
     }
 
+    // The service level with the lowest shares wins, so that granting a role
+    // doesn't let a user escape the isolation of another one.
+    auto shares = get_shares(ret);
+    auto other_shares = get_shares(other);
+    if (other_shares && (!shares || *other_shares < *shares)) {
+        ret.shares = *other_shares;
+        maybe_update_shares_name(ret, other);
+    }
+
     return ret;
 }
 
@@ -121,10 +146,18 @@ std::optional<service_level_options::workload_type> service_level_options::parse
 void service_level_options::init_effective_names(sstring& service_level_name) {
     effective_names = service_level_options::slo_effective_names {
         .timeout = service_level_name,
-        .workload = service_level_name
+        .workload = service_level_name,
+        .shares = service_level_name
     };
 }
 
+std::optional<int32_t> get_shares(const service_level_options& slo) {
+    if (auto* shares = std::get_if<int32_t>(&slo.shares)) {
+        return *shares;
+    }
+    return std::nullopt;
+}
+
 service::query_state& qos_query_state() {
     using namespace std::chrono_literals;
     const auto t = 10s;
@@ -142,6 +175,14 @@ static service_level_options::timeout_type get_duration(const cql3::untyped_resu
     return std::chrono::duration_cast<lowres_clock::duration>(std::chrono::nanoseconds(dur_opt->nanoseconds));
 };
 
+static service_level_options::shares_type get_shares(const cql3::untyped_result_set_row& row, std::string_view col_name) {
+    auto shares_opt = row.get_opt<int32_t>(col_name);
+    if (!shares_opt) {
+        return qos::service_level_options::unset_marker{};
+    }
+    return *shares_opt;
+}
+
 future<qos::service_levels_info> get_service_levels(cql3::query_processor& qp, std::string_view ks_name, std::string_view cf_name, db::consistency_level cl) {
     sstring prepared_query = format("SELECT * FROM {}.{};", ks_name, cf_name);
     auto result_set = co_await qp.execute_internal(prepared_query, cl, qos_query_state(), cql3::query_processor::cache_internal::yes);
@@ -154,6 +195,7 @@ future<qos::service_levels_info> get_service_levels(cql3::query_processor& qp, s
             qos::service_level_options slo{
                 .timeout = get_duration(row, "timeout"),
                 .workload = workload.value_or(qos::service_level_options::workload_type::unspecified),
+                .shares = get_shares(row, "shares"),
             };
             service_levels.emplace(service_level_name, slo);
         } catch (...) {
@@ -176,6 +218,7 @@ future<service_levels_info> get_service_level(cql3::query_processor& qp, std::st
             qos::service_level_options slo{
                 .timeout = get_duration(row, "timeout"),
                 .workload = workload.value_or(qos::service_level_options::workload_type::unspecified),
+                .shares = get_shares(row, "shares"),
             };
             service_levels.emplace(service_level_name, slo);
         } catch (...) {
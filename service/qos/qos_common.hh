@@ -49,6 +49,14 @@ struct service_level_options {
     timeout_type timeout = unset_marker{};
     workload_type workload = workload_type::unspecified;
 
+    // The CPU and I/O shares of the scheduling group the statements of the
+    // service level run in. Service levels without shares run in the
+    // statement scheduling group, shared with everybody else.
+    using shares_type = std::variant<unset_marker, delete_marker, int32_t>;
+    shares_type shares = unset_marker{};
+    static constexpr int32_t min_shares = 1;
+    static constexpr int32_t max_shares = 1000;
+
     service_level_options replace_defaults(const service_level_options& other) const;
     // Merges the values of two service level options. The semantics depends
     // on the type of the parameter - e.g. for timeouts, a min value is preferred.
@@ -62,6 +70,7 @@ struct service_level_options {
     struct slo_effective_names {
         sstring timeout;
         sstring workload;
+        sstring shares;
 
         bool operator==(const slo_effective_names& other) const = default;
         bool operator!=(const slo_effective_names& other) const = default;
@@ -75,6 +84,13 @@ std::ostream& operator<<(std::ostream& os, const service_level_options::workload
 
 using service_levels_info = std::map<sstring, service_level_options>;
 
+// The scheduling groups of service levels are named after them, with this
+// prefix.
+constexpr std::string_view scheduling_group_name_prefix = "sl:";
+
+// Returns the shares of the service level, if it has any.
+std::optional<int32_t> get_shares(const service_level_options& slo);
+
 ///
 /// A logical argument error for a service_level statement operation.
 ///
@@ -14,6 +14,8 @@
 #include "service/raft/raft_group0_client.hh"
 #include "db/system_keyspace.hh"
 #include "types/types.hh"
+#include "service/storage_proxy.hh"
+#include "gms/feature_service.hh"
 
 namespace qos {
 
@@ -66,6 +68,15 @@ future<> raft_service_level_distributed_data_accessor::set_service_level(sstring
 
     auto muts = co_await _qp.get_mutations_internal(insert_query, qos_query_state(), mc.write_timestamp(), {service_level_name, timeout_to_data_value(slo.timeout), workload});
     mc.add_mutations(std::move(muts), format("service levels internal statement: {}", insert_query));
+
+    // Nodes which don't know about shares can't apply mutations of the column.
+    if (_qp.proxy().features().workload_prioritization) {
+        static sstring shares_query = format("UPDATE {}.{} SET shares = ? WHERE service_level = ?;", db::system_keyspace::NAME, db::system_keyspace::SERVICE_LEVELS_V2);
+        auto shares = get_shares(slo);
+        auto shares_muts = co_await _qp.get_mutations_internal(shares_query, qos_query_state(), mc.write_timestamp(),
+                {shares ? data_value(*shares) : data_value::make_null(int32_type), service_level_name});
+        mc.add_mutations(std::move(shares_muts), format("service levels internal statement: {}", shares_query));
+    }
 }
 
 future<> raft_service_level_distributed_data_accessor::drop_service_level(sstring service_level_name, service::group0_batch& mc) const {
@@ -237,10 +237,11 @@ future<std::optional<service_level_options>> service_level_controller::find_serv
                     return std::nullopt;
                 }
 
+                auto slo = sl_it->second.slo;
                 if (include_names == include_effective_names::yes) {
-                    sl_it->second.slo.init_effective_names(*sl_name);
+                    slo.init_effective_names(*sl_name);
                 }
-                return sl_it->second.slo;
+                return slo;
             } catch (...) { // when we fail, we act as if the attribute does not exist so the node
                            // will not be brought down.
                 return std::nullopt;
@@ -258,6 +259,9 @@ future<std::optional<service_level_options>> service_level_controller::find_serv
 }
 
 future<>  service_level_controller::notify_service_level_added(sstring name, service_level sl_data) {
+    if (auto sg = sl_data.sg) {
+        sg->set_shares(*get_shares(sl_data.slo));
+    }
     return seastar::async( [this, name, sl_data] {
         _subscribers.thread_for_each([name, sl_data] (qos_configuration_change_subscriber* subscriber) {
             try {
@@ -271,11 +275,15 @@ future<>  service_level_controller::notify_service_level_added(sstring name, ser
 
 }
 
-future<> service_level_controller::notify_service_level_updated(sstring name, service_level_options slo) {
+future<> service_level_controller::notify_service_level_updated(sstring name, service_level_options slo, std::optional<scheduling_group> sg) {
     auto sl_it = _service_levels_db.find(name);
     future<> f = make_ready_future();
     if (sl_it != _service_levels_db.end()) {
         service_level_options slo_before = sl_it->second.slo;
+        if (sg) {
+            sg->set_shares(*get_shares(slo));
+        }
+        sl_it->second.sg = sg;
         return seastar::async( [this,sl_it, name, slo_before, slo] {
             _subscribers.thread_for_each([name, slo_before, slo] (qos_configuration_change_subscriber* subscriber) {
                 try {
@@ -426,19 +434,45 @@ future<> service_level_controller::do_add_service_level(sstring name, service_le
            if ((service_level_it->second.is_static) && (!is_static)) {
                service_level_it->second.is_static = false;
            }
-           return container().invoke_on_all(&service_level_controller::notify_service_level_updated, name, slo);
+           auto sg = co_await update_scheduling_group(name, slo, service_level_it->second.sg);
+           co_await container().invoke_on_all(&service_level_controller::notify_service_level_updated, name, slo, sg);
         } else {
             // this means we set static layer when the the service level
             // is running of the non static configuration. so we have nothing
             // else to do since we already saved the static configuration.
-            return make_ready_future();
         }
     } else {
-        return do_with(service_level{.slo = slo, .is_static = is_static}, std::move(name), [this] (service_level& sl, sstring& name) {
-            return container().invoke_on_all(&service_level_controller::notify_service_level_added, name, sl);
-        });
+        auto sg = co_await update_scheduling_group(name, slo, std::nullopt);
+        service_level sl{.slo = slo, .is_static = is_static, .sg = sg};
+        co_await container().invoke_on_all(&service_level_controller::notify_service_level_added, name, sl);
+    }
+}
+
+future<std::optional<scheduling_group>> service_level_controller::update_scheduling_group(const sstring& name, const service_level_options& slo, std::optional<scheduling_group> sg) {
+    auto& retired = _global_controller_db->retired_scheduling_groups;
+    if (!get_shares(slo)) {
+        if (sg) {
+            retired.push_back(*sg);
+        }
+        co_return std::nullopt;
+    }
+    if (sg) {
+        co_return sg;
+    }
+    auto sg_name = format("{}{}", scheduling_group_name_prefix, name);
+    if (!retired.empty()) {
+        auto reused = retired.back();
+        retired.pop_back();
+        co_await rename_scheduling_group(reused, sg_name);
+        co_return reused;
+    }
+    try {
+        co_return co_await create_scheduling_group(sg_name, *get_shares(slo));
+    } catch (...) {
+        sl_logger.warn("Failed to create a scheduling group for service level {}, its statements will run in the statement scheduling group: {}",
+                name, std::current_exception());
     }
-    return make_ready_future();
+    co_return std::nullopt;
 }
 
 bool service_level_controller::is_v2() const {
@@ -546,17 +580,20 @@ future<> service_level_controller::do_remove_service_level(sstring name, bool re
             static_exists = static_conf_it != _global_controller_db->static_configurations.end();
         }
         if (remove_static && service_level_it->second.is_static) {
-            return container().invoke_on_all(&service_level_controller::notify_service_level_removed, name);
+            co_await update_scheduling_group(name, service_level_options{}, service_level_it->second.sg);
+            co_await container().invoke_on_all(&service_level_controller::notify_service_level_removed, name);
         } else if (!remove_static && !service_level_it->second.is_static) {
             if (static_exists) {
                 service_level_it->second.is_static = true;
-                return container().invoke_on_all(&service_level_controller::notify_service_level_updated, name, static_conf_it->second);
+                auto slo = static_conf_it->second;
+                auto sg = co_await update_scheduling_group(name, slo, service_level_it->second.sg);
+                co_await container().invoke_on_all(&service_level_controller::notify_service_level_updated, name, slo, sg);
             } else {
-                return container().invoke_on_all(&service_level_controller::notify_service_level_removed, name);
+                co_await update_scheduling_group(name, service_level_options{}, service_level_it->second.sg);
+                co_await container().invoke_on_all(&service_level_controller::notify_service_level_removed, name);
             }
         }
     }
-    return make_ready_future();
 }
 
 void service_level_controller::on_join_cluster(const gms::inet_address& endpoint) { }
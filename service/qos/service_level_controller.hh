@@ -9,6 +9,7 @@
 #pragma once
 
 #include <seastar/core/timer.hh>
+#include <seastar/core/scheduling.hh>
 #include "seastar/core/future.hh"
 #include "seastarx.hh"
 #include "auth/role_manager.hh"
@@ -40,6 +41,9 @@ struct service_level {
      service_level_options slo;
      bool marked_for_deletion;
      bool is_static;
+     // The scheduling group the statements of the service level run in,
+     // if it has shares.
+     std::optional<scheduling_group> sg;
 };
 
 /**
@@ -81,6 +85,10 @@ class service_level_controller : public peering_sharded_service<service_level_co
         future<> distributed_data_update = make_ready_future();
         abort_source dist_data_update_aborter;
         abort_source group0_aborter;
+        // Scheduling groups of removed service levels. Seastar has a fixed
+        // number of scheduling groups, so they are reused rather than
+        // destroyed.
+        std::vector<scheduling_group> retired_scheduling_groups;
     };
 
     std::unique_ptr<global_controller_data> _global_controller_db;
@@ -175,6 +183,18 @@ class service_level_controller : public peering_sharded_service<service_level_co
      */
     future<std::optional<service_level_options>> find_service_level(auth::role_set roles, include_effective_names include_names = include_effective_names::no);
 
+    /**
+     * Returns the scheduling group the statements of the service level run
+     * in, or std::nullopt if it doesn't have one of its own.
+     */
+    std::optional<scheduling_group> get_scheduling_group(const sstring& service_level_name) const {
+        auto sl_it = _service_levels_db.find(service_level_name);
+        if (sl_it == _service_levels_db.end() || sl_it->second.marked_for_deletion) {
+            return std::nullopt;
+        }
+        return sl_it->second.sg;
+    }
+
     /**
      * Gets the service level data by name.
      * @param service_level_name - the name of the requested service level
@@ -235,9 +255,18 @@ class service_level_controller : public peering_sharded_service<service_level_co
      * change due to execution reordering.
      */
     future<> notify_service_level_added(sstring name, service_level sl_data);
-    future<> notify_service_level_updated(sstring name, service_level_options slo);
+    future<> notify_service_level_updated(sstring name, service_level_options slo, std::optional<scheduling_group> sg);
     future<> notify_service_level_removed(sstring name);
 
+    /**
+     * Returns the scheduling group of a service level with the given options,
+     * given the one it has now, if any: the same one if it still needs one,
+     * a new or reused one if it didn't have one, none if it no longer has
+     * shares. Only called on the global controller. The shares are set by
+     * the notify functions, on every shard.
+     */
+    future<std::optional<scheduling_group>> update_scheduling_group(const sstring& name, const service_level_options& slo, std::optional<scheduling_group> sg);
+
     enum class  set_service_level_op_type {
         add_if_not_exists,
         add,
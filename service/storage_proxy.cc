@@ -320,12 +320,14 @@ class storage_proxy::remote {
             const query::read_command& cmd, const dht::partition_range& pr,
             fencing_token fence) {
         tracing::trace(tr_state, "read_mutation_data: sending a message to /{}", addr.addr);
+        tracing::mark(tr_state, tracing::request_stage::replica_request_sent);
         auto&& [result, hit_rate, opt_exception] = co_await ser::storage_proxy_rpc_verbs::send_read_mutation_data(&_ms, addr, timeout, cmd, pr, fence);
         if (opt_exception.has_value() && *opt_exception) {
             co_await coroutine::return_exception_ptr((*opt_exception).into_exception_ptr());
         }
 
         tracing::trace(tr_state, "read_mutation_data: got response from /{}", addr.addr);
+        tracing::mark(tr_state, tracing::request_stage::replica_response_received);
         co_return rpc::tuple{make_foreign(::make_lw_shared<reconcilable_result>(std::move(result))), hit_rate.value_or(cache_temperature::invalid())};
     }
 
@@ -336,6 +338,7 @@ class storage_proxy::remote {
             query::digest_algorithm digest_algo, db::per_partition_rate_limit::info rate_limit_info,
             fencing_token fence) {
         tracing::trace(tr_state, "read_data: sending a message to /{}", addr.addr);
+        tracing::mark(tr_state, tracing::request_stage::replica_request_sent);
         auto&& [result, hit_rate, opt_exception] =
             co_await ser::storage_proxy_rpc_verbs::send_read_data(&_ms, addr, timeout, cmd, pr, digest_algo, rate_limit_info, fence);
         if (opt_exception.has_value() && *opt_exception) {
@@ -343,6 +346,7 @@ class storage_proxy::remote {
         }
 
         tracing::trace(tr_state, "read_data: got response from /{}", addr.addr);
+        tracing::mark(tr_state, tracing::request_stage::replica_response_received);
         co_return rpc::tuple{make_foreign(::make_lw_shared<query::result>(std::move(result))), hit_rate.value_or(cache_temperature::invalid())};
     }
 
@@ -353,6 +357,7 @@ class storage_proxy::remote {
             query::digest_algorithm digest_algo, db::per_partition_rate_limit::info rate_limit_info,
             fencing_token fence) {
         tracing::trace(tr_state, "read_digest: sending a message to /{}", addr.addr);
+        tracing::mark(tr_state, tracing::request_stage::replica_request_sent);
         auto&& [d, t, hit_rate, opt_exception, opt_last_pos] =
             co_await ser::storage_proxy_rpc_verbs::send_read_digest(&_ms, addr, timeout, cmd, pr, digest_algo, rate_limit_info, fence);
         if (opt_exception.has_value() && *opt_exception) {
@@ -360,6 +365,7 @@ class storage_proxy::remote {
         }
 
         tracing::trace(tr_state, "read_digest: got response from /{}", addr.addr);
+        tracing::mark(tr_state, tracing::request_stage::replica_response_received);
         co_return rpc::tuple{d, t ? t.value() : api::missing_timestamp, hit_rate.value_or(cache_temperature::invalid()), opt_last_pos ? std::move(*opt_last_pos) : std::nullopt};
     }
 
@@ -1077,6 +1083,7 @@ class per_destination_mutation : public mutation_holder {
         auto m = _mutations[my_ip];
         if (m) {
             tracing::trace(tr_state, "Executing a mutation locally");
+            tracing::mark(tr_state, tracing::request_stage::local_write);
             return sp.apply_fence(sp.mutate_locally(_schema, *m, std::move(tr_state), db::commitlog::force_sync::no, timeout, rate_limit_info), fence, my_ip);
         }
         return make_ready_future<>();
@@ -1087,6 +1094,7 @@ class per_destination_mutation : public mutation_holder {
         auto m = _mutations[ep];
         if (m) {
             tracing::trace(tr_state, "Sending a mutation to /{}", ep);
+            tracing::mark(tr_state, tracing::request_stage::replica_request_sent);
             return sp.remote().send_mutation(netw::messaging_service::msg_addr{ep, 0}, timeout, tracing::make_trace_info(tr_state),
                     *m, forward, sp.my_address(), this_shard_id(),
                     response_id, rate_limit_info, fence);
@@ -1130,6 +1138,7 @@ class shared_mutation : public mutation_holder {
             tracing::trace_state_ptr tr_state, db::per_partition_rate_limit::info rate_limit_info,
             fencing_token fence) override {
         tracing::trace(tr_state, "Executing a mutation locally");
+        tracing::mark(tr_state, tracing::request_stage::local_write);
         return sp.apply_fence(sp.mutate_locally(_schema, *_mutation, std::move(tr_state), db::commitlog::force_sync::no, timeout, rate_limit_info), fence, sp.my_address());
     }
     virtual future<> apply_remotely(storage_proxy& sp, gms::inet_address ep, const inet_address_vector_replica_set& forward,
@@ -1137,6 +1146,7 @@ class shared_mutation : public mutation_holder {
             tracing::trace_state_ptr tr_state, db::per_partition_rate_limit::info rate_limit_info,
             fencing_token fence) override {
         tracing::trace(tr_state, "Sending a mutation to /{}", ep);
+        tracing::mark(tr_state, tracing::request_stage::replica_request_sent);
         return sp.remote().send_mutation(netw::messaging_service::msg_addr{ep, 0}, timeout, tracing::make_trace_info(tr_state),
                 *_mutation, forward, sp.my_address(), this_shard_id(),
                 response_id, rate_limit_info, fence);
@@ -2421,6 +2431,7 @@ void storage_proxy::got_response(storage_proxy::response_id_type id, gms::inet_a
     auto it = _response_handlers.find(id);
     if (it != _response_handlers.end()) {
         tracing::trace(it->second->get_trace_state(), "Got a response from /{}", from);
+        tracing::mark(it->second->get_trace_state(), tracing::request_stage::replica_response_received);
         if (it->second->response(from)) {
             remove_response_handler_entry(std::move(it)); // last one, remove entry. Will cancel expiration timer too.
         } else {
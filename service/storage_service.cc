@@ -92,6 +92,8 @@
 #include "utils/error_injection.hh"
 #include "locator/util.hh"
 #include "idl/storage_service.dist.hh"
+#include "idl/streaming.dist.hh"
+#include "streaming/stream_manager.hh"
 #include "service/storage_proxy.hh"
 #include "service/raft/raft_address_map.hh"
 #include "service/raft/join_node.hh"
@@ -5751,6 +5753,38 @@ future<> storage_service::clone_locally_tablet_storage(locator::global_tablet_id
     rtlogger.debug("Successfully loaded storage of tablet {} into pending replica {}", tablet, pending);
 }
 
+future<bool> storage_service::stream_tablet_files(locator::global_tablet_id tablet, locator::tablet_replica leaving, locator::tablet_replica pending,
+                                                  dht::token_range range, service::session_id session) {
+    auto ops_id = streaming::plan_id{utils::make_random_uuid()};
+    auto req = streaming::stream_files_request{
+        .ops_id = ops_id,
+        .table = tablet.table,
+        .range = std::move(range),
+        .src_shard_id = leaving.shard,
+        .dst_shard_id = pending.shard,
+        .topo_guard = session,
+    };
+    std::exception_ptr ex;
+    try {
+        auto resp = co_await ser::streaming_rpc_verbs::send_tablet_stream_files(&_messaging.local(), netw::msg_addr(host2ip(leaving.host)), req);
+        if (!resp.streamed) {
+            rtlogger.info("Leaving replica {} of tablet {} cannot stream files, streaming mutations", leaving, tablet);
+            co_return false;
+        }
+        co_await _stream_manager.invoke_on(pending.shard, [ops_id] (streaming::stream_manager& sm) {
+            return sm.attach_received_sstables(ops_id);
+        });
+        rtlogger.info("Streamed files of tablet {} from {}: {} sstables, {} bytes", tablet, leaving, resp.sstables, resp.stream_bytes);
+        co_return true;
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    co_await _stream_manager.invoke_on(pending.shard, [ops_id] (streaming::stream_manager& sm) {
+        return sm.discard_received_sstables(ops_id);
+    });
+    std::rethrow_exception(std::move(ex));
+}
+
 // Streams data to the pending tablet replica of a given tablet on this node.
 // The source tablet replica is determined from the current transition info of the tablet.
 future<> storage_service::stream_tablet(locator::global_tablet_id tablet) {
@@ -5809,25 +5843,34 @@ future<> storage_service::stream_tablet(locator::global_tablet_id tablet) {
                                                      tablet, leaving_replica->shard, trinfo->pending_replica->shard));
             }
             auto& table = _db.local().find_column_family(tablet.table);
-            std::vector<sstring> tables = {table.schema()->cf_name()};
-            auto my_id = tm->get_my_id();
-            auto streamer = make_lw_shared<dht::range_streamer>(_db, _stream_manager, std::move(tm),
-                                                                guard.get_abort_source(),
-                                                                my_id, _snitch.local()->get_location(),
-                                                                format("Tablet {}", trinfo->transition),
-                                                                reason,
-                                                                topo_guard,
-                                                                std::move(tables));
-            tm = nullptr;
-            streamer->add_source_filter(std::make_unique<dht::range_streamer::failure_detector_source_filter>(
-                    _gossiper.get_unreachable_members()));
-
-            std::unordered_map<inet_address, dht::token_range_vector> ranges_per_endpoint;
-            for (auto r: streaming_info.read_from) {
-                ranges_per_endpoint[host2ip(r.host)].emplace_back(range);
+            // A migrating tablet has a single source, whose sstables can be attached here as they are.
+            // Views are built from the streamed mutations, so tables with views always stream mutations.
+            bool file_stream = trinfo->transition == locator::tablet_transition_kind::migration
+                    && leaving_replica && streaming_info.read_from.size() == 1
+                    && _feature_service.file_stream && _db.local().get_config().enable_file_stream()
+                    && table.views().empty() && table.get_storage_options().is_local_type();
+            bool streamed = file_stream && co_await stream_tablet_files(tablet, *leaving_replica, *pending_replica, range, topo_guard);
+            if (!streamed) {
+                std::vector<sstring> tables = {table.schema()->cf_name()};
+                auto my_id = tm->get_my_id();
+                auto streamer = make_lw_shared<dht::range_streamer>(_db, _stream_manager, std::move(tm),
+                                                                    guard.get_abort_source(),
+                                                                    my_id, _snitch.local()->get_location(),
+                                                                    format("Tablet {}", trinfo->transition),
+                                                                    reason,
+                                                                    topo_guard,
+                                                                    std::move(tables));
+                tm = nullptr;
+                streamer->add_source_filter(std::make_unique<dht::range_streamer::failure_detector_source_filter>(
+                        _gossiper.get_unreachable_members()));
+
+                std::unordered_map<inet_address, dht::token_range_vector> ranges_per_endpoint;
+                for (auto r: streaming_info.read_from) {
+                    ranges_per_endpoint[host2ip(r.host)].emplace_back(range);
+                }
+                streamer->add_rx_ranges(table.schema()->ks_name(), std::move(ranges_per_endpoint));
+                co_await streamer->stream_async();
             }
-            streamer->add_rx_ranges(table.schema()->ks_name(), std::move(ranges_per_endpoint));
-            co_await streamer->stream_async();
         }
 
         // If new pending tablet replica needs splitting, streaming waits for it to complete.
@@ -185,6 +185,10 @@ class storage_service : public service::migration_listener, public gms::i_endpoi
     // Clones storage of leaving tablet into pending one. Done in the context of intra-node migration,
     // when both of which sit on the same node. So all the movement is local.
     future<> clone_locally_tablet_storage(locator::global_tablet_id, locator::tablet_replica leaving, locator::tablet_replica pending);
+    // Streams the sstables of the leaving tablet replica on another node to the pending one on this node,
+    // as whole files. Returns false, having streamed nothing, if the leaving replica cannot send them so.
+    future<bool> stream_tablet_files(locator::global_tablet_id, locator::tablet_replica leaving, locator::tablet_replica pending,
+                                     dht::token_range range, service::session_id session);
     future<> cleanup_tablet(locator::global_tablet_id);
     inet_address host2ip(locator::host_id) const;
     // Handler for table load stats RPC.
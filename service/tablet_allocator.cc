@@ -26,6 +26,15 @@ namespace service {
 
 seastar::logger lblogger("load_balancer");
 
+// Tracks, across load balancer invocations, since when the traffic of each table calls
+// for a resize, so that tables are resized only on account of sustained traffic.
+struct table_traffic_state {
+    enum class kind { normal, hot, cold };
+    kind state;
+    lowres_clock::time_point since;
+};
+using table_traffic_history = std::unordered_map<table_id, table_traffic_state>;
+
 struct load_balancer_dc_stats {
     uint64_t calls = 0;
     uint64_t migrations_produced = 0;
@@ -218,6 +227,9 @@ class load_balancer {
         // Number of tablets which are streamed to this shard.
         size_t streaming_write_load = 0;
 
+        // Sum of tablet_traffic() of tablets on this shard.
+        load_type traffic = 0;
+
         // Tablets which still have a replica on this shard which are candidates for migrating away from this shard.
         // Grouped by table. Used when _use_table_aware_balancing == true.
         // The set of candidates per table may be empty.
@@ -300,6 +312,14 @@ class load_balancer {
             };
         }
 
+        load_type traffic() const {
+            load_type result = 0;
+            for (auto&& shard_info : shards) {
+                result += shard_info.traffic;
+            }
+            return result;
+        }
+
         future<> clear_gently() {
             return utils::clear_gently(shards);
         }
@@ -331,16 +351,46 @@ class load_balancer {
         return double(max_tablet_size / 2) * 0.5;
     }
 
+    // Traffic works like size, with split and merge thresholds derived from a target rate,
+    // except that it only calls for a split while the table has less tablet replicas than there
+    // are shards in the cluster. Past that point, splitting doesn't spread the traffic any further.
+    // Traffic must also stay past a threshold for a while before it's acted upon.
+    static constexpr double target_max_tablet_traffic(uint64_t target_tablet_traffic) {
+        return target_tablet_traffic * 2;
+    }
+
     struct table_size_desc {
         uint64_t target_max_tablet_size;
         uint64_t avg_tablet_size;
         locator::resize_decision resize_decision;
         size_t tablet_count;
         size_t shard_count;
+        // Average request rate of a tablet replica. Ignored if target_max_tablet_traffic is 0.
+        double target_max_tablet_traffic = 0;
+        double avg_tablet_traffic = 0;
+        // Whether traffic stayed hot, or cold, for long enough to resize the table on account of it.
+        bool traffic_sustained = false;
+        // Whether a split would let the table's traffic spread over more shards.
+        bool can_spread_traffic = false;
 
         uint64_t target_min_tablet_size() const noexcept {
             return load_balancer::target_min_tablet_size(target_max_tablet_size);
         }
+
+        // A quarter of the target rate, i.e. an eighth of the split threshold.
+        double target_min_tablet_traffic() const noexcept {
+            return target_max_tablet_traffic / 8;
+        }
+
+        table_traffic_state::kind traffic_state() const noexcept {
+            if (target_max_tablet_traffic && avg_tablet_traffic > target_max_tablet_traffic) {
+                return table_traffic_state::kind::hot;
+            }
+            if (!target_max_tablet_traffic || avg_tablet_traffic < target_min_tablet_traffic()) {
+                return table_traffic_state::kind::cold;
+            }
+            return table_traffic_state::kind::normal;
+        }
     };
 
     struct cluster_resize_load {
@@ -350,10 +400,14 @@ class load_balancer {
 
         static bool table_needs_merge(const table_size_desc& d) {
             // FIXME: ignore merge request if tablet_count == initial_tablets.
-            return d.tablet_count > 1 && d.avg_tablet_size < d.target_min_tablet_size();
+            return d.tablet_count > 1 && d.avg_tablet_size < d.target_min_tablet_size()
+                && d.traffic_state() == table_traffic_state::kind::cold && d.traffic_sustained;
+        }
+        static bool table_needs_split_for_traffic(const table_size_desc& d) {
+            return d.traffic_state() == table_traffic_state::kind::hot && d.traffic_sustained && d.can_spread_traffic;
         }
         static bool table_needs_split(const table_size_desc& d) {
-            return d.avg_tablet_size > d.target_max_tablet_size;
+            return d.avg_tablet_size > d.target_max_tablet_size || table_needs_split_for_traffic(d);
         }
 
         bool table_needs_resize(const table_size_desc& d) const {
@@ -365,12 +419,15 @@ class load_balancer {
         // average size is past the point it would be if either split or merge had completed.
         // If we cancel a split, that's because average size dropped so much a merge would be
         // required post completion, and vice-versa.
+        // The same applies to traffic, which must drop (or grow) past where it would be after the resize.
         bool table_needs_resize_cancellation(const table_size_desc& d) const {
             auto& way = d.resize_decision.way;
             if (std::holds_alternative<locator::resize_decision::split>(way)) {
-                return d.avg_tablet_size < d.target_max_tablet_size / 2;
+                return d.avg_tablet_size < d.target_max_tablet_size / 2
+                    && (!d.target_max_tablet_traffic || d.avg_tablet_traffic < d.target_max_tablet_traffic / 2);
             } else if (std::holds_alternative<locator::resize_decision::merge>(way)) {
-                return d.avg_tablet_size > d.target_min_tablet_size() * 2;
+                return d.avg_tablet_size > d.target_min_tablet_size() * 2
+                    || (d.target_max_tablet_traffic && d.avg_tablet_traffic > d.target_min_tablet_traffic() * 2);
             }
             return false;
         }
@@ -397,7 +454,11 @@ class load_balancer {
             return [] (const table_id_and_size_desc& a, const table_id_and_size_desc& b) {
                 auto urgency = [] (const table_size_desc& d) -> double {
                     // FIXME: only takes into account split today.
-                    return double(d.avg_tablet_size) / d.target_max_tablet_size;
+                    auto size_urgency = double(d.avg_tablet_size) / d.target_max_tablet_size;
+                    if (!table_needs_split_for_traffic(d)) {
+                        return size_urgency;
+                    }
+                    return std::max(size_urgency, d.avg_tablet_traffic / d.target_max_tablet_traffic);
                 };
                 return urgency(a.second) < urgency(b.second);
             };
@@ -449,9 +510,21 @@ class load_balancer {
     const size_t max_write_streaming_load = 2;
     const size_t max_read_streaming_load = 4;
 
+    // Request rates reported in load stats are turned into a single traffic measure, in requests per second,
+    // by charging data transfer as one request per this many bytes.
+    static constexpr double traffic_bytes_per_request = 4096;
+
+    // Shards of nodes which serve less traffic than this per shard on average, in requests per second,
+    // are balanced by tablet count only. Lower rates are noise which is not worth migrating tablets for.
+    static constexpr double min_shard_traffic_for_balancing = 100;
+
+    const uint64_t _target_tablet_traffic;
+    const lowres_clock::duration _traffic_resize_delay;
+
     token_metadata_ptr _tm;
     locator::load_stats_ptr _table_load_stats;
     load_balancer_stats_manager& _stats;
+    table_traffic_history& _traffic_history;
     std::unordered_set<host_id> _skiplist;
     bool _use_table_aware_balancing = true;
 private:
@@ -491,11 +564,16 @@ class load_balancer {
     }
 
 public:
-    load_balancer(token_metadata_ptr tm, locator::load_stats_ptr table_load_stats, load_balancer_stats_manager& stats, uint64_t target_tablet_size, std::unordered_set<host_id> skiplist)
+    load_balancer(token_metadata_ptr tm, locator::load_stats_ptr table_load_stats, load_balancer_stats_manager& stats,
+                  uint64_t target_tablet_size, uint64_t target_tablet_traffic, lowres_clock::duration traffic_resize_delay,
+                  table_traffic_history& traffic_history, std::unordered_set<host_id> skiplist)
         : _target_tablet_size(target_tablet_size)
+        , _target_tablet_traffic(target_tablet_traffic)
+        , _traffic_resize_delay(traffic_resize_delay)
         , _tm(std::move(tm))
         , _table_load_stats(std::move(table_load_stats))
         , _stats(stats)
+        , _traffic_history(traffic_history)
         , _skiplist(std::move(skiplist))
     { }
 
@@ -528,6 +606,23 @@ class load_balancer {
         return (it != _table_load_stats->tables.end()) ? &it->second : nullptr;
     }
 
+    static load_type traffic_of(const locator::tablet_load_stats& s) {
+        return s.reads + s.writes + (s.read_bytes + s.write_bytes) / traffic_bytes_per_request;
+    }
+
+    // Returns the rate of requests served by a single replica of the tablet, or 0 if unknown.
+    load_type tablet_traffic(global_tablet_id tablet) const {
+        const auto* table_stats = load_stats_for_table(tablet.table);
+        if (!table_stats) {
+            return 0;
+        }
+        auto it = table_stats->tablets.find(tablet.tablet);
+        if (it == table_stats->tablets.end()) {
+            return 0;
+        }
+        return traffic_of(it->second);
+    }
+
     future<table_resize_plan> make_resize_plan() {
         table_resize_plan resize_plan;
 
@@ -537,6 +632,17 @@ class load_balancer {
 
         cluster_resize_load resize_load;
 
+        size_t total_shard_count = std::invoke([&topo = _tm->get_topology()] {
+            size_t shard_count = 0;
+            topo.for_each_node([&] (const locator::node* node_ptr) {
+                shard_count += node_ptr->get_shard_count();
+            });
+            return shard_count;
+        });
+
+        const auto now = lowres_clock::now();
+        table_traffic_history traffic_history;
+
         for (auto&& [table, tmap_] : _tm->tablets().all_tables()) {
             auto& tmap = tmap_;
 
@@ -551,19 +657,38 @@ class load_balancer {
                 [] (size_t shard_count, const locator::tablet_info& info) {
                     return shard_count + info.replicas.size();
                 });
+            double total_traffic = 0;
+            for (auto&& [tid, stats] : table_stats->tablets) {
+                total_traffic += traffic_of(stats);
+            }
 
             table_size_desc size_desc {
                 .target_max_tablet_size = target_max_tablet_size(_target_tablet_size),
                 .avg_tablet_size = avg_tablet_size,
                 .resize_decision = tmap.resize_decision(),
                 .tablet_count = tmap.tablet_count(),
-                .shard_count = shard_count
+                .shard_count = shard_count,
+                .target_max_tablet_traffic = target_max_tablet_traffic(_target_tablet_traffic),
+                .avg_tablet_traffic = total_traffic / std::max(tmap.tablet_count(), size_t(1)),
+                .can_spread_traffic = shard_count < total_shard_count,
             };
 
+            // Tables seen for the first time are assumed to have been cold all along,
+            // so that merges aren't delayed when the coordinator changes.
+            auto state = size_desc.traffic_state();
+            auto since = state == table_traffic_state::kind::cold ? lowres_clock::time_point::min() : now;
+            if (auto it = _traffic_history.find(table); it != _traffic_history.end() && it->second.state == state) {
+                since = it->second.since;
+            }
+            traffic_history[table] = table_traffic_state{state, since};
+            size_desc.traffic_sustained = since == lowres_clock::time_point::min() || now - since >= _traffic_resize_delay;
+
             resize_load.update(table, std::move(size_desc));
-            lblogger.info("Table {} with tablet_count={} has an average tablet size of {}", table, tmap.tablet_count(), avg_tablet_size);
+            lblogger.info("Table {} with tablet_count={} has an average tablet size of {} and traffic of {}",
+                          table, tmap.tablet_count(), avg_tablet_size, total_traffic / std::max(tmap.tablet_count(), size_t(1)));
             co_await coroutine::maybe_yield();
         }
+        _traffic_history = std::move(traffic_history);
 
         // Emit new resize decisions
 
@@ -571,13 +696,6 @@ class load_balancer {
         // If tables still have a low tablet count, the concurrency must be high in order to saturate the cluster.
         // If a table covers the entire cluster, and needs split, concurrency will be reduced to 1.
 
-        size_t total_shard_count = std::invoke([&topo = _tm->get_topology()] {
-            size_t shard_count = 0;
-            topo.for_each_node([&] (const locator::node* node_ptr) {
-                shard_count += node_ptr->get_shard_count();
-            });
-            return shard_count;
-        });
         size_t resizing_shard_count = std::accumulate(resize_load.tables_being_resized.begin(), resize_load.tables_being_resized.end(), size_t(0),
              [] (size_t shard_count, const auto& table_desc) {
                  return shard_count + table_desc.second.shard_count;
@@ -596,8 +714,8 @@ class load_balancer {
             }
 
             auto resize_decision = cluster_resize_load::to_resize_decision(size_desc);
-            lblogger.info("Emitting resize decision of type {} for table {} due to avg tablet size of {}",
-                          resize_decision.type_name(), table, size_desc.avg_tablet_size);
+            lblogger.info("Emitting resize decision of type {} for table {} due to avg tablet size of {} and traffic of {}",
+                          resize_decision.type_name(), table, size_desc.avg_tablet_size, size_desc.avg_tablet_traffic);
             resize_plan.resize[table] = std::move(resize_decision);
             _stats.for_cluster().resizes_emitted++;
 
@@ -614,7 +732,8 @@ class load_balancer {
             if (resize_load.table_needs_resize_cancellation(size_desc)) {
                 resize_plan.resize[table] = cluster_resize_load::revoke_resize_decision();
                 _stats.for_cluster().resizes_revoked++;
-                lblogger.info("Revoking resize decision for table {} due to avg tablet size of {}", table, size_desc.avg_tablet_size);
+                lblogger.info("Revoking resize decision for table {} due to avg tablet size of {} and traffic of {}",
+                              table, size_desc.avg_tablet_size, size_desc.avg_tablet_traffic);
                 continue;
             }
 
@@ -735,6 +854,137 @@ class load_balancer {
         }
     }
 
+    template <typename Func>
+    void for_each_candidate(const shard_load& shard_info, Func&& func) {
+        for (auto&& [table, tablets] : shard_info.candidates) {
+            for (auto&& tablet : tablets) {
+                func(tablet);
+            }
+        }
+        for (auto&& tablet : shard_info.candidates_all_tables) {
+            func(tablet);
+        }
+    }
+
+    bool has_significant_traffic(const node_load& node_load) const {
+        return node_load.traffic() / node_load.shard_count >= min_shard_traffic_for_balancing;
+    }
+
+    // Balances shards of a node by the load which requests put on them, so that a few hot tablets
+    // don't saturate a shard while other shards of the node are idle.
+    //
+    // The load of a tablet is 1 plus its traffic relative to the average traffic of tablets on the node.
+    // So cold tablets are still spread evenly, and with uniform traffic this is the same as balancing
+    // tablet count. Each step moves a tablet from the most-loaded shard to the least-loaded one, picking
+    // the tablet which minimizes the higher of the two resulting loads, so the maximum shard load never grows.
+    // A move must lower the load of the source shard below its old value by at least the load of a cold tablet,
+    // which keeps fluctuations of request rates from moving tablets back and forth between plans.
+    future<migration_plan> make_node_traffic_plan(node_load_map& nodes, host_id host, node_load& node_load) {
+        migration_plan plan;
+        const tablet_metadata& tmeta = _tm->tablets();
+
+        size_t tablet_count = 0;
+        for (auto&& shard_info : node_load.shards) {
+            tablet_count += shard_info.tablet_count;
+        }
+        const load_type avg_tablet_traffic = node_load.traffic() / std::max(tablet_count, size_t(1));
+
+        auto get_load = [&] (shard_id shard) {
+            auto& shard_info = node_load.shards[shard];
+            return shard_info.tablet_count + shard_info.traffic / avg_tablet_traffic;
+        };
+
+        // Shards which may still have a tablet worth moving.
+        std::vector<shard_id> src_shards;
+        src_shards.reserve(node_load.shard_count);
+        for (shard_id shard = 0; shard < node_load.shard_count; shard++) {
+            src_shards.push_back(shard);
+        }
+
+        while (true) {
+            co_await coroutine::maybe_yield();
+
+            if (src_shards.empty()) {
+                lblogger.debug("Unable to balance traffic of node {}: ran out of candidates", host);
+                break;
+            }
+
+            auto src_it = std::ranges::max_element(src_shards, std::less<load_type>(), get_load);
+            shard_id src = *src_it;
+            shard_id dst = 0;
+            for (shard_id shard = 1; shard < node_load.shard_count; shard++) {
+                if (get_load(shard) < get_load(dst)) {
+                    dst = shard;
+                }
+            }
+
+            auto src_load = get_load(src);
+            auto dst_load = get_load(dst);
+
+            // Convergence check
+            if (src == dst || src_load - dst_load < 2) {
+                lblogger.debug("Node {} is balanced, shard load: max={}, min={}", host, src_load, dst_load);
+                break;
+            }
+
+            auto& src_info = node_load.shards[src];
+            auto& dst_info = node_load.shards[dst];
+
+            std::optional<global_tablet_id> best;
+            load_type best_max_load = src_load;
+            for_each_candidate(src_info, [&] (global_tablet_id tablet) {
+                auto load = 1 + tablet_traffic(tablet) / avg_tablet_traffic;
+                auto max_load = std::max(src_load - load, dst_load + load);
+                if (dst_load + load <= src_load - 1 && max_load < best_max_load) {
+                    best = tablet;
+                    best_max_load = max_load;
+                }
+            });
+
+            if (!best) {
+                lblogger.debug("No more candidates on shard {} of {} which would lower its load of {}", src, host, src_load);
+                src_shards.erase(src_it);
+                continue;
+            }
+
+            global_tablet_id tablet = *best;
+
+            // Emit migration.
+
+            auto mig = tablet_migration_info {tablet_transition_kind::intranode_migration, tablet,
+                                              tablet_replica{host, src}, tablet_replica{host, dst}};
+            auto& tmap = tmeta.get_tablet_map(tablet.table);
+            auto& src_tinfo = tmap.get_tablet_info(tablet.tablet);
+            auto mig_streaming_info = get_migration_streaming_info(_tm->get_topology(), src_tinfo, mig);
+
+            if (!can_accept_load(nodes, mig_streaming_info)) {
+                _stats.for_dc(node_load.dc()).migrations_skipped++;
+                lblogger.debug("Unable to balance traffic of {}: load limit reached", host);
+                break;
+            }
+
+            apply_load(nodes, mig_streaming_info);
+            lblogger.debug("Adding migration: {} (traffic={}, shard load: src={}, dst={})", mig, tablet_traffic(tablet), src_load, dst_load);
+            _stats.for_dc(node_load.dc()).migrations_produced++;
+            _stats.for_dc(node_load.dc()).intranode_migrations_produced++;
+            plan.add(std::move(mig));
+
+            for (auto&& r : src_tinfo.replicas) {
+                if (nodes.contains(r.host)) {
+                    erase_candidate(nodes[r.host].shards[r.shard], tablet);
+                }
+            }
+
+            auto traffic = tablet_traffic(tablet);
+            dst_info.tablet_count++;
+            dst_info.traffic += traffic;
+            src_info.tablet_count--;
+            src_info.traffic -= traffic;
+        }
+
+        co_return plan;
+    }
+
     future<migration_plan> make_node_plan(node_load_map& nodes, host_id host, node_load& node_load) {
         migration_plan plan;
         const tablet_metadata& tmeta = _tm->tablets();
@@ -745,6 +995,10 @@ class load_balancer {
             co_return plan;
         }
 
+        if (!shuffle && has_significant_traffic(node_load)) {
+            co_return co_await make_node_traffic_plan(nodes, host, node_load);
+        }
+
         auto& sketch = co_await node_load.get_load_sketch(_tm);
 
         // Keeps candidate source shards in a heap which yields highest-loaded shard first.
@@ -890,8 +1144,8 @@ class load_balancer {
             if (lblogger.is_enabled(seastar::log_level::debug)) {
                 shard_id shard = 0;
                 for (auto&& shard_load : node_load.shards) {
-                    lblogger.debug("shard {}: all tablets: {}, candidates: {}", tablet_replica {host, shard},
-                                   shard_load.tablet_count, shard_load.candidate_count());
+                    lblogger.debug("shard {}: all tablets: {}, candidates: {}, traffic: {}", tablet_replica {host, shard},
+                                   shard_load.tablet_count, shard_load.candidate_count(), shard_load.traffic);
                     shard++;
                 }
             }
@@ -1147,11 +1401,14 @@ class load_balancer {
                 }
             }
 
+            auto traffic = tablet_traffic(source_tablet);
             target_info.shards[dst.shard].tablet_count++;
+            target_info.shards[dst.shard].traffic += traffic;
             target_info.tablet_count += 1;
             target_info.update();
 
             src_shard_info.tablet_count -= 1;
+            src_shard_info.traffic -= traffic;
             if (src_shard_info.tablet_count == 0) {
                 push_back_shard_candidate.cancel();
                 src_node_info.shards_by_load.pop_back();
@@ -1364,6 +1621,7 @@ class load_balancer {
                         node_load_info.shards_by_load.push_back(replica.shard);
                     }
                     shard_load_info.tablet_count += 1;
+                    shard_load_info.traffic += tablet_traffic(global_tablet_id {table, tid});
                     if (!trinfo) { // migrating tablets are not candidates
                         add_candidate(shard_load_info, global_tablet_id {table, tid});
                     }
@@ -1396,6 +1654,7 @@ class tablet_allocator_impl : public tablet_allocator::impl
     service::migration_notifier& _migration_notifier;
     replica::database& _db;
     load_balancer_stats_manager _load_balancer_stats;
+    table_traffic_history _traffic_history;
     bool _stopped = false;
     bool _use_tablet_aware_balancing = true;
 public:
@@ -1424,7 +1683,10 @@ class tablet_allocator_impl : public tablet_allocator::impl
     }
 
     future<migration_plan> balance_tablets(token_metadata_ptr tm, locator::load_stats_ptr table_load_stats, std::unordered_set<host_id> skiplist) {
-        load_balancer lb(tm, std::move(table_load_stats), _load_balancer_stats, _db.get_config().target_tablet_size_in_bytes(), std::move(skiplist));
+        auto& cfg = _db.get_config();
+        load_balancer lb(tm, std::move(table_load_stats), _load_balancer_stats, cfg.target_tablet_size_in_bytes(),
+                         cfg.target_tablet_request_rate(), std::chrono::seconds(cfg.tablet_request_rate_resize_delay_in_seconds()),
+                         _traffic_history, std::move(skiplist));
         lb.set_use_table_aware_balancing(_use_tablet_aware_balancing);
         co_return co_await lb.make_plan();
     }
@@ -2544,6 +2544,10 @@ future<locator::load_stats> topology_coordinator::refresh_tablet_load_stats() {
         // for a single table replica. This allows the load balancer to compute, in turn,
         // the average tablet size by dividing total size by tablet count.
         table_load_stats.size_in_bytes /= table_total_replicas;
+        // Likewise, request rates are turned into the average rate served by a single tablet replica.
+        for (auto& [tid, tablet_stats] : table_load_stats.tablets) {
+            tablet_stats /= table_total_replicas;
+        }
     }
     rtlogger.debug("raft topology: Refreshed table load stats for all DC(s).");
 
@@ -326,14 +326,17 @@ class index_consume_entry_context : public data_consumer::continuous_data_consum
     {}
 };
 
+// Reads of the file are accounted to trace_state as reads from disk, unless
+// they are cached, or go through a cached_file which accounts them itself.
 inline file make_tracked_index_file(sstable& sst, reader_permit permit, tracing::trace_state_ptr trace_state,
-                                    use_caching caching) {
+                                    use_caching caching, bool under_cached_file = false) {
     auto f = caching ? sst.index_file() : sst.uncached_index_file();
     f = make_tracked_file(std::move(f), std::move(permit));
     if (!trace_state) {
         return f;
     }
-    return tracing::make_traced_file(std::move(f), std::move(trace_state), format("{}:", sst.index_filename()));
+    auto component = caching || under_cached_file ? tracing::read_io_component::none : tracing::read_io_component::index;
+    return tracing::make_traced_file(std::move(f), std::move(trace_state), format("{}:", sst.index_filename()), component);
 }
 
 inline
@@ -352,7 +355,7 @@ std::unique_ptr<clustered_index_cursor> promoted_index::make_cursor(shared_sstab
     if (sst->get_version() >= sstable_version_types::mc) {
         seastar::shared_ptr<cached_file> cached_file_ptr = caching
                 ? sst->_cached_index_file
-                : seastar::make_shared<cached_file>(make_tracked_index_file(*sst, permit, trace_state, caching),
+                : seastar::make_shared<cached_file>(make_tracked_index_file(*sst, permit, trace_state, caching, true),
                                                     sst->manager().get_cache_tracker().get_index_cached_file_stats(),
                                                     sst->manager().get_cache_tracker().get_lru(),
                                                     sst->manager().get_cache_tracker().region(),
@@ -525,7 +528,10 @@ class index_reader {
             sstlog.trace("index {}: eof", fmt::ptr(this));
             return advance_to_end(bound);
         }
-        auto loader = [this, &bound] (uint64_t summary_idx) -> future<index_list> {
+        // The loader is only invoked, synchronously, when the page isn't cached.
+        bool loaded = false;
+        auto loader = [this, &bound, &loaded] (uint64_t summary_idx) -> future<index_list> {
+            loaded = true;
             auto& summary = _sstable->get_summary();
             uint64_t position = summary.entries[summary_idx].position;
             uint64_t quantity = downsampling::get_effective_index_interval_after_index(summary_idx, summary.header.sampling_level,
@@ -559,7 +565,12 @@ class index_reader {
             });
         };
 
-        return _index_cache.get_or_load(summary_idx, loader).then([this, &bound, summary_idx] (partition_index_cache::entry_ptr ref) {
+        auto f = _index_cache.get_or_load(summary_idx, loader);
+        // Without loading it, the page is only available right away if it
+        // was already in the cache, otherwise another read is loading it.
+        tracing::account_index_page_read(_trace_state, loaded ? tracing::index_page_lookup::miss
+                : f.available() ? tracing::index_page_lookup::hit : tracing::index_page_lookup::wait);
+        return f.then([this, &bound, summary_idx] (partition_index_cache::entry_ptr ref) {
             bound.current_list = std::move(ref);
             bound.current_summary_idx = summary_idx;
             bound.current_index_idx = 0;
@@ -416,6 +416,9 @@ class mp_row_consumer_k_l {
         auto pk = key.to_partition_key(*_schema);
         setup_for_partition(pk);
         auto dk = dht::decorate_key(*_schema, pk);
+        if (!deltime.live()) {
+            tracing::account_tombstone_read(_trace_state);
+        }
         _reader->on_next_partition(std::move(dk), tombstone(deltime));
         return proceed::yes;
     }
@@ -689,6 +692,7 @@ class mp_row_consumer_k_l {
                 cr.apply(shadowable_tombstone(tombstone(deltime)));
                 if (!was_dead && cr.tomb()) {
                     _sst->get_stats().on_row_tombstone_read();
+                    tracing::account_tombstone_read(_trace_state);
                 }
             });
         }
@@ -750,6 +754,7 @@ class mp_row_consumer_k_l {
                         cr.apply(tombstone(deltime));
                         if (!was_dead && cr.tomb()) {
                             _sst->get_stats().on_row_tombstone_read();
+                            tracing::account_tombstone_read(_trace_state);
                         }
                     });
                 }
@@ -1023,6 +1028,7 @@ class data_consume_rows_context : public data_consumer::continuous_data_consumer
                     co_yield read_32(*_processing_data);
                     co_yield read_64(*_processing_data);
                     _sst->get_stats().on_range_tombstone_read();
+                    tracing::account_tombstone_read(_consumer.trace_state());
                     deletion_time del;
                     del.local_deletion_time = _u32;
                     del.marked_for_delete_at = _u64;
@@ -1324,12 +1330,15 @@ class sstable_mutation_reader : public mp_row_consumer_reader_k_l {
 
             if (!present) {
                 _sst->get_filter_tracker().add_false_positive();
+                tracing::account_sstable_read(_consumer.trace_state(), true);
                 co_return;
             }
 
             _sst->get_filter_tracker().add_true_positive();
+            tracing::account_sstable_read(_consumer.trace_state());
         } else {
             _sst->get_stats().on_range_partition_read();
+            tracing::account_sstable_read(_consumer.trace_state());
             co_await get_index_reader().advance_to(_pr);
         }
 
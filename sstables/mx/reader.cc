@@ -313,6 +313,9 @@ class mp_row_consumer_m {
         auto pk = key.to_partition_key(*_schema);
         setup_for_partition(pk);
         auto dk = dht::decorate_key(*_schema, pk);
+        if (!deltime.live()) {
+            tracing::account_tombstone_read(_trace_state);
+        }
         _reader->on_next_partition(std::move(dk), tombstone(deltime));
         return data_consumer::proceed(!_reader->is_buffer_full() && !need_preempt());
     }
@@ -372,6 +375,7 @@ class mp_row_consumer_m {
         }
         if (_in_progress_row->tomb()) {
             _sst->get_stats().on_row_tombstone_read();
+            tracing::account_tombstone_read(_trace_state);
         }
         return data_consumer::proceed::yes;
     }
@@ -1168,6 +1172,7 @@ class data_consume_rows_context_m : public data_consumer::continuous_data_consum
                         format("Corrupted range tombstone: invalid boundary type {}", _range_tombstone_kind));
                 }
                 _sst->get_stats().on_range_tombstone_read();
+                tracing::account_tombstone_read(_consumer.trace_state());
                 _state = state::FLAGS;
                 if (_consumer.consume_range_tombstone(_row_key,
                                                       to_bound_kind(_range_tombstone_kind),
@@ -1182,6 +1187,7 @@ class data_consume_rows_context_m : public data_consumer::continuous_data_consum
             _right_range_tombstone.timestamp = parse_timestamp(_header, this->_u64);
             co_yield this->read_unsigned_vint(*_processing_data);
             _sst->get_stats().on_range_tombstone_read();
+            tracing::account_tombstone_read(_consumer.trace_state());
             _right_range_tombstone.deletion_time = parse_expiry(_header, this->_u64);
             _state = state::FLAGS;
             if (_consumer.consume_range_tombstone(_row_key,
@@ -1529,15 +1535,18 @@ class mx_sstable_mutation_reader : public mp_row_consumer_reader_mx {
 
             if (!present) {
                 _sst->get_filter_tracker().add_false_positive();
+                tracing::account_sstable_read(_consumer.trace_state(), true);
                 co_return false;
             }
 
             _sst->get_filter_tracker().add_true_positive();
+            tracing::account_sstable_read(_consumer.trace_state());
             if (reversed()) {
                 co_await _index_reader->advance_reverse_to_next_partition();
             }
         } else {
             _sst->get_stats().on_range_partition_read();
+            tracing::account_sstable_read(_consumer.trace_state());
             co_await get_index_reader().advance_to(_pr);
         }
 
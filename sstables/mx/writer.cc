@@ -18,8 +18,10 @@
 #include "mutation/atomic_cell.hh"
 #include "utils/exceptions.hh"
 #include "db/large_data_handler.hh"
+#include "db/sstable_index_options.hh"
 
 #include <functional>
+#include <map>
 #include <boost/iterator/iterator_facade.hpp>
 #include <boost/container/static_vector.hpp>
 #include <boost/range/adaptor/indexed.hpp>
@@ -600,7 +602,24 @@ class writer : public sstable_writer::writer_impl {
     large_data_stats_entry _cell_size_entry;
     large_data_stats_entry _elements_in_collection_entry;
 
+    // Builds the ColumnIndex component, if the table has an sstable index.
+    struct {
+        std::vector<const column_definition*> columns;
+        std::unique_ptr<file_writer> writer;
+        dht::token token;
+        // The clustering keys of the rows of the current partition, by
+        // column position and value. Written out as a block whenever they
+        // take as much as a promoted index block, so that large partitions
+        // don't have to be held in memory.
+        std::map<std::pair<uint16_t, bytes>, utils::chunked_vector<disk_string<uint16_t>>> rows;
+        size_t rows_size = 0;
+        utils::chunked_vector<column_index_partition_offset> partitions;
+    } _column_index;
+
     void init_file_writers();
+    void index_column_values(const clustering_row& cr);
+    void write_column_index_partition();
+    void write_column_index_footer();
 
     // Returns the closed writer
     std::unique_ptr<file_writer> close_writer(std::unique_ptr<file_writer>& w);
@@ -832,6 +851,7 @@ writer::~writer() {
     };
     close_writer(_index_writer);
     close_writer(_data_writer);
+    close_writer(_column_index.writer);
 }
 
 void writer::maybe_set_pi_first_clustering(const writer::clustering_info& info) {
@@ -896,6 +916,72 @@ void writer::init_file_writers() {
 
     out = _sst._storage->make_data_or_index_sink(_sst, component_type::Index).get();
     _index_writer = std::make_unique<file_writer>(output_stream<char>(std::move(out)), _sst.filename(component_type::Index));
+
+    if (_sst.has_component(component_type::ColumnIndex)) {
+        _column_index.columns = db::get_sstable_indexed_columns(_schema);
+        file_output_stream_options options;
+        options.buffer_size = _sst.sstable_buffer_size;
+        _column_index.writer = std::make_unique<file_writer>(_sst.make_component_file_writer(component_type::ColumnIndex, std::move(options)).get());
+    }
+}
+
+void writer::index_column_values(const clustering_row& cr) {
+    for (uint16_t i = 0; i < _column_index.columns.size(); ++i) {
+        const auto& cdef = *_column_index.columns[i];
+        auto cell = cr.cells().find_cell(cdef.id);
+        if (!cell) {
+            continue;
+        }
+        auto ac = cell->as_atomic_cell(cdef);
+        // Expiring cells are indexed until compaction drops them, so the
+        // index may point at rows which no longer have the value, but never
+        // misses one which does.
+        if (!ac.is_live()) {
+            continue;
+        }
+        auto value = to_bytes(ac.value());
+        auto key = to_bytes(cr.key().representation());
+        _column_index.rows_size += value.size() + key.size();
+        _column_index.rows[{i, std::move(value)}].push_back(disk_string<uint16_t>{std::move(key)});
+    }
+    if (_column_index.rows_size >= _pi_write_m.promoted_index_block_size) {
+        write_column_index_partition();
+    }
+}
+
+void writer::write_column_index_partition() {
+    if (_column_index.rows.empty()) {
+        return;
+    }
+    column_index_partition p;
+    p.key.value = _partition_key->get_bytes();
+    for (auto& [column_and_value, keys] : _column_index.rows) {
+        p.entries.elements.push_back(column_index_entry{
+            .column = column_and_value.first,
+            .value = disk_string<uint32_t>{std::move(column_and_value.second)},
+            .clustering_keys = {std::move(keys)},
+        });
+    }
+    _column_index.rows.clear();
+    _column_index.rows_size = 0;
+    _column_index.partitions.push_back(column_index_partition_offset{
+        .token = dht::token::to_int64(_column_index.token),
+        .offset = _column_index.writer->offset(),
+    });
+    write(_sst.get_version(), *_column_index.writer, p);
+}
+
+void writer::write_column_index_footer() {
+    column_index_footer footer;
+    for (auto cdef : _column_index.columns) {
+        footer.columns.elements.push_back(disk_string<uint16_t>{cdef->name()});
+    }
+    footer.partitions.elements = std::move(_column_index.partitions);
+    uint64_t offset = _column_index.writer->offset();
+    write(_sst.get_version(), *_column_index.writer, footer);
+    write(_sst.get_version(), *_column_index.writer, offset);
+    _sst._metadata_size_on_disk += _column_index.writer->offset();
+    close_writer(_column_index.writer);
 }
 
 std::unique_ptr<file_writer> writer::close_writer(std::unique_ptr<file_writer>& w) {
@@ -924,6 +1010,7 @@ void writer::consume_new_partition(const dht::decorated_key& dk) {
 
     _sst._components->filter->add(bytes_view(*_partition_key));
     _collector.add_key(bytes_view(*_partition_key));
+    _column_index.token = dk.token();
 
     auto p_key = disk_string_view<uint16_t>();
     p_key.value = bytes_view(*_partition_key);
@@ -1304,6 +1391,9 @@ stop_iteration writer::consume(clustering_row&& cr) {
     ensure_tombstone_is_written();
     ensure_static_row_is_written_if_needed();
     write_clustered(cr);
+    if (_column_index.writer) {
+        index_column_values(cr);
+    }
 
     auto can_split_partition_at_clustering_boundary = [this] {
         // will allow size limit to be exceeded for 10%, so we won't perform unnecessary split
@@ -1438,6 +1528,10 @@ stop_iteration writer::consume_end_of_partition() {
 
     maybe_record_large_partitions(_sst, *_partition_key, _c_stats.partition_size, _c_stats.rows_count, _c_stats.range_tombstones_count, _c_stats.dead_rows_count);
 
+    if (_column_index.writer) {
+        write_column_index_partition();
+    }
+
     // update is about merging column_stats with the data being stored by collector.
     _collector.update(std::move(_c_stats));
     _c_stats.reset();
@@ -1460,6 +1554,9 @@ void writer::consume_end_of_stream() {
     }
 
     close_writer(_index_writer);
+    if (_column_index.writer) {
+        write_column_index_footer();
+    }
     _sst.set_first_and_last_keys();
 
     _sst._components->statistics.contents[metadata_type::Serialization] = std::make_unique<serialization_header>(std::move(_sst_schema.header));
@@ -8,7 +8,6 @@
 
 #include <seastar/util/defer.hh>
 
-#include <boost/icl/interval_map.hpp>
 #include <boost/range/adaptor/map.hpp>
 #include <boost/range/algorithm/remove_if.hpp>
 #include <boost/range/algorithm/sort.hpp>
@@ -220,77 +219,55 @@ sstable_set::make_incremental_selector() const {
     return incremental_selector(std::get<0>(std::move(selector)), std::get<1>(selector));
 }
 
-partitioned_sstable_set::interval_type partitioned_sstable_set::make_interval(const schema& s, const dht::partition_range& range) {
-    return interval_type::closed(
-            dht::compatible_ring_position_or_view(s, dht::ring_position_view(range.start()->value())),
-            dht::compatible_ring_position_or_view(s, dht::ring_position_view(range.end()->value())));
-}
-
-partitioned_sstable_set::interval_type partitioned_sstable_set::make_interval(const dht::partition_range& range) const {
-    return make_interval(*_schema, range);
-}
-
-partitioned_sstable_set::interval_type partitioned_sstable_set::make_interval(const schema_ptr& s, const sstable& sst) {
-    return interval_type::closed(
-            dht::compatible_ring_position_or_view(s, dht::ring_position(sst.get_first_decorated_key())),
-            dht::compatible_ring_position_or_view(s, dht::ring_position(sst.get_last_decorated_key())));
-}
-
-partitioned_sstable_set::interval_type partitioned_sstable_set::make_interval(const sstable& sst) {
-    return make_interval(_schema, sst);
-}
-
-partitioned_sstable_set::interval_type partitioned_sstable_set::singular(const dht::ring_position& rp) const {
-    // We should use the view here, since this is used for queries.
-    auto rpv = dht::ring_position_view(rp);
-    auto crp = dht::compatible_ring_position_or_view(*_schema, std::move(rpv));
-    return interval_type::closed(crp, crp);
-}
-
-std::pair<partitioned_sstable_set::map_iterator, partitioned_sstable_set::map_iterator>
-partitioned_sstable_set::query(const dht::partition_range& range) const {
-    if (range.start() && range.end()) {
-        return _leveled_sstables.equal_range(make_interval(range));
-    }
-    else if (range.start() && !range.end()) {
-        auto start = singular(range.start()->value());
-        return { _leveled_sstables.lower_bound(start), _leveled_sstables.end() };
-    } else if (!range.start() && range.end()) {
-        auto end = singular(range.end()->value());
-        return { _leveled_sstables.begin(), _leveled_sstables.upper_bound(end) };
-    } else {
-        return { _leveled_sstables.begin(), _leveled_sstables.end() };
-    }
-}
-
 bool partitioned_sstable_set::store_as_unleveled(const shared_sstable& sst) const {
     return _use_level_metadata && sst->get_sstable_level() == 0;
 }
 
-dht::ring_position partitioned_sstable_set::to_ring_position(const dht::compatible_ring_position_or_view& crp) {
-    // Ring position views, representing bounds of sstable intervals are
-    // guaranteed to have key() != nullptr;
-    const auto& pos = crp.position();
-    return dht::ring_position(pos.token(), *pos.key());
+partitioned_sstable_set::lane::const_iterator
+partitioned_sstable_set::lower_bound(const schema& s, const lane& l, dht::ring_position_view pos) {
+    dht::ring_position_comparator cmp(s);
+    return std::partition_point(l.begin(), l.end(), [&] (const shared_sstable& sst) {
+        return cmp(dht::ring_position_view(sst->get_last_decorated_key()), pos) < 0;
+    });
 }
 
-dht::partition_range partitioned_sstable_set::to_partition_range(const interval_type& i) {
-    return dht::partition_range::make(
-            {to_ring_position(i.lower()), boost::icl::is_left_closed(i.bounds())},
-            {to_ring_position(i.upper()), boost::icl::is_right_closed(i.bounds())});
+void partitioned_sstable_set::insert_leveled(const shared_sstable& sst) {
+    dht::ring_position_comparator cmp(*_schema);
+    const auto first = dht::ring_position_view(sst->get_first_decorated_key());
+    const auto last = dht::ring_position_view(sst->get_last_decorated_key());
+    for (auto& l : _lanes) {
+        auto it = lower_bound(*_schema, *l, first);
+        if (it != l->end() && cmp(dht::ring_position_view((*it)->get_first_decorated_key()), last) <= 0) {
+            continue;
+        }
+        const auto idx = it - l->begin();
+        if (l.use_count() > 1) {
+            l = make_lw_shared<lane>(*l);
+        }
+        l->insert(l->begin() + idx, sst);
+        return;
+    }
+    _lanes.push_back(make_lw_shared<lane>(lane{sst}));
 }
 
-dht::partition_range partitioned_sstable_set::to_partition_range(const dht::ring_position_view& pos, const interval_type& i) {
-    auto lower_bound = [&] {
-        if (pos.key()) {
-            return dht::partition_range::bound(dht::ring_position(pos.token(), *pos.key()),
-                    pos.is_after_key() == dht::ring_position_view::after_key::no);
-        } else {
-            return dht::partition_range::bound(dht::ring_position(pos.token(), pos.get_token_bound()), true);
+void partitioned_sstable_set::erase_leveled(const shared_sstable& sst) {
+    for (auto lane_it = _lanes.begin(); lane_it != _lanes.end(); ++lane_it) {
+        auto& l = *lane_it;
+        auto it = lower_bound(*_schema, *l, dht::ring_position_view(sst->get_first_decorated_key()));
+        if (it == l->end() || *it != sst) {
+            continue;
+        }
+        if (l->size() == 1) {
+            _lanes.erase(lane_it);
+            return;
         }
-    }();
-    auto upper_bound = dht::partition_range::bound(to_ring_position(i.lower()), !boost::icl::is_left_closed(i.bounds()));
-    return dht::partition_range::make(std::move(lower_bound), std::move(upper_bound));
+        const auto idx = it - l->begin();
+        if (l.use_count() > 1) {
+            l = make_lw_shared<lane>(*l);
+        }
+        l->erase(l->begin() + idx);
+        return;
+    }
 }
 
 partitioned_sstable_set::partitioned_sstable_set(schema_ptr schema, bool use_level_metadata)
@@ -305,31 +282,31 @@ static std::unordered_map<run_id, shared_sstable_run> clone_runs(const std::unor
     }));
 }
 
-partitioned_sstable_set::partitioned_sstable_set(schema_ptr schema, const std::vector<shared_sstable>& unleveled_sstables, const interval_map_type& leveled_sstables,
+partitioned_sstable_set::partitioned_sstable_set(schema_ptr schema, const std::vector<shared_sstable>& unleveled_sstables, const std::vector<lw_shared_ptr<lane>>& lanes,
         const lw_shared_ptr<sstable_list>& all, const std::unordered_map<run_id, shared_sstable_run>& all_runs, bool use_level_metadata, uint64_t bytes_on_disk)
         : sstable_set_impl(bytes_on_disk)
         , _schema(schema)
         , _unleveled_sstables(unleveled_sstables)
-        , _leveled_sstables(leveled_sstables)
+        , _lanes(lanes)
         , _all(make_lw_shared<sstable_list>(*all))
         , _all_runs(clone_runs(all_runs))
         , _use_level_metadata(use_level_metadata) {
 }
 
 std::unique_ptr<sstable_set_impl> partitioned_sstable_set::clone() const {
-    return std::make_unique<partitioned_sstable_set>(_schema, _unleveled_sstables, _leveled_sstables, _all, _all_runs, _use_level_metadata, _bytes_on_disk);
+    return std::make_unique<partitioned_sstable_set>(_schema, _unleveled_sstables, _lanes, _all, _all_runs, _use_level_metadata, _bytes_on_disk);
 }
 
 std::vector<shared_sstable> partitioned_sstable_set::select(const dht::partition_range& range) const {
-    auto ipair = query(range);
-    auto b = std::move(ipair.first);
-    auto e = std::move(ipair.second);
-    value_set result;
-    while (b != e) {
-        boost::copy(b++->second, std::inserter(result, result.end()));
-    }
+    dht::ring_position_comparator cmp(*_schema);
+    const auto start = dht::ring_position_view::for_range_start(range);
+    const auto end = dht::ring_position_view::for_range_end(range);
     auto r = _unleveled_sstables;
-    r.insert(r.end(), result.begin(), result.end());
+    for (auto& l : _lanes) {
+        for (auto it = lower_bound(*_schema, *l, start); it != l->end() && cmp(dht::ring_position_view((*it)->get_first_decorated_key()), end) < 0; ++it) {
+            r.push_back(*it);
+        }
+    }
     return r;
 }
 
@@ -389,8 +366,7 @@ bool partitioned_sstable_set::insert(shared_sstable sst) {
     if (store_as_unleveled(sst)) {
         _unleveled_sstables.push_back(sst);
     } else {
-        _leveled_sstables_change_cnt++;
-        _leveled_sstables.add({make_interval(*sst), value_set({sst})});
+        insert_leveled(sst);
     }
     undo_all_insert.cancel();
     undo_all_runs_insert.cancel();
@@ -411,8 +387,7 @@ bool partitioned_sstable_set::erase(shared_sstable sst) {
     if (store_as_unleveled(sst)) {
         _unleveled_sstables.erase(std::remove(_unleveled_sstables.begin(), _unleveled_sstables.end(), sst), _unleveled_sstables.end());
     } else {
-        _leveled_sstables_change_cnt++;
-        _leveled_sstables.subtract({make_interval(*sst), value_set({sst})});
+        erase_leveled(sst);
     }
     return ret;
 }
@@ -425,62 +400,59 @@ partitioned_sstable_set::size() const noexcept {
 class partitioned_sstable_set::incremental_selector : public incremental_selector_impl {
     schema_ptr _schema;
     const std::vector<shared_sstable>& _unleveled_sstables;
-    const interval_map_type& _leveled_sstables;
-    const uint64_t& _leveled_sstables_change_cnt;
-    uint64_t _last_known_leveled_sstables_change_cnt;
-    map_iterator _it;
+    const std::vector<lw_shared_ptr<lane>>& _lanes;
 private:
-    dht::ring_position_ext next_position(map_iterator it) {
-        if (it == _leveled_sstables.end()) {
-            return dht::ring_position_view::max();
-        } else {
-            auto&& next_position = partitioned_sstable_set::to_ring_position(it->first.lower());
-            return dht::ring_position_ext(next_position, dht::ring_position_ext::after_key(!boost::icl::is_left_closed(it->first.bounds())));
-        }
-    }
-    static bool is_before_interval(const dht::compatible_ring_position_or_view& crp, const interval_type& interval) {
-        if (boost::icl::is_left_closed(interval.bounds())) {
-            return crp < interval.lower();
+    static dht::partition_range::bound lower_bound_of(const dht::ring_position_view& pos) {
+        if (pos.key()) {
+            return dht::partition_range::bound(dht::ring_position(pos.token(), *pos.key()),
+                    pos.is_after_key() == dht::ring_position_view::after_key::no);
         } else {
-            return crp <= interval.lower();
-        }
-    }
-    void maybe_invalidate_iterator(const dht::compatible_ring_position_or_view& crp) {
-        if (_last_known_leveled_sstables_change_cnt != _leveled_sstables_change_cnt) {
-            _it = _leveled_sstables.lower_bound(interval_type::closed(crp, crp));
-            _last_known_leveled_sstables_change_cnt = _leveled_sstables_change_cnt;
+            return dht::partition_range::bound(dht::ring_position(pos.token(), pos.get_token_bound()), true);
         }
     }
 public:
-    incremental_selector(schema_ptr schema, const std::vector<shared_sstable>& unleveled_sstables, const interval_map_type& leveled_sstables,
-                         const uint64_t& leveled_sstables_change_cnt)
+    incremental_selector(schema_ptr schema, const std::vector<shared_sstable>& unleveled_sstables, const std::vector<lw_shared_ptr<lane>>& lanes)
         : _schema(std::move(schema))
         , _unleveled_sstables(unleveled_sstables)
-        , _leveled_sstables(leveled_sstables)
-        , _leveled_sstables_change_cnt(leveled_sstables_change_cnt)
-        , _last_known_leveled_sstables_change_cnt(leveled_sstables_change_cnt)
-        , _it(leveled_sstables.begin()) {
+        , _lanes(lanes) {
     }
+    // Lanes are searched afresh on each call, so there are no iterators to
+    // invalidate when the set changes.
     virtual std::tuple<dht::partition_range, std::vector<shared_sstable>, dht::ring_position_ext> select(const selector_pos& s) override {
         const dht::ring_position_view& pos = s.pos;
-        auto crp = dht::compatible_ring_position_or_view(*_schema, pos);
+        dht::ring_position_comparator cmp(*_schema);
         auto ssts = _unleveled_sstables;
-        using namespace dht;
 
-        maybe_invalidate_iterator(crp);
+        // The selection changes at the closest of: the position after the
+        // last key of a selected sstable, or the first key of a following one.
+        const dht::decorated_key* next_key = nullptr;
+        auto next_after_key = dht::ring_position_view::after_key::no;
+        auto maybe_move_next = [&] (const dht::decorated_key& key, dht::ring_position_view::after_key after) {
+            if (!next_key || cmp(dht::ring_position_view(key, after), dht::ring_position_view(*next_key, next_after_key)) < 0) {
+                next_key = &key;
+                next_after_key = after;
+            }
+        };
 
-        while (_it != _leveled_sstables.end()) {
-            if (boost::icl::contains(_it->first, crp)) {
-                ssts.insert(ssts.end(), _it->second.begin(), _it->second.end());
-                return std::make_tuple(partitioned_sstable_set::to_partition_range(_it->first), std::move(ssts), next_position(std::next(_it)));
+        for (auto& l : _lanes) {
+            auto it = partitioned_sstable_set::lower_bound(*_schema, *l, pos);
+            if (it == l->end()) {
+                continue;
             }
-            // We don't want to skip current interval if pos lies before it.
-            if (is_before_interval(crp, _it->first)) {
-                return std::make_tuple(partitioned_sstable_set::to_partition_range(pos, _it->first), std::move(ssts), next_position(_it));
+            const auto& sst = *it;
+            if (cmp(dht::ring_position_view(sst->get_first_decorated_key()), pos) <= 0) {
+                ssts.push_back(sst);
+                maybe_move_next(sst->get_last_decorated_key(), dht::ring_position_view::after_key::yes);
+            } else {
+                maybe_move_next(sst->get_first_decorated_key(), dht::ring_position_view::after_key::no);
             }
-            _it++;
         }
-        return std::make_tuple(partition_range::make_open_ended_both_sides(), std::move(ssts), ring_position_view::max());
+
+        if (!next_key) {
+            return std::make_tuple(dht::partition_range::make_starting_with(lower_bound_of(pos)), std::move(ssts), dht::ring_position_view::max());
+        }
+        auto range = dht::partition_range::make(lower_bound_of(pos), {dht::ring_position(*next_key), bool(next_after_key)});
+        return std::make_tuple(std::move(range), std::move(ssts), dht::ring_position_ext(dht::ring_position_view(*next_key, next_after_key)));
     }
 };
 
@@ -744,11 +716,11 @@ std::unique_ptr<position_reader_queue> time_series_sstable_set::make_position_re
 }
 
 sstable_set_impl::selector_and_schema_t partitioned_sstable_set::make_incremental_selector() const {
-    return std::make_tuple(std::make_unique<incremental_selector>(_schema, _unleveled_sstables, _leveled_sstables, _leveled_sstables_change_cnt), std::cref(*_schema));
+    return std::make_tuple(std::make_unique<incremental_selector>(_schema, _unleveled_sstables, _lanes), std::cref(*_schema));
 }
 
 std::unique_ptr<sstable_set_impl> compaction_strategy_impl::make_sstable_set(schema_ptr schema) const {
-    // with use_level_metadata enabled, L0 sstables will not go to interval map, which suits well STCS.
+    // with use_level_metadata enabled, L0 sstables will not go to the lanes, which suits well STCS.
     return std::make_unique<partitioned_sstable_set>(schema, true);
 }
 
@@ -787,6 +759,7 @@ class incremental_reader_selector : public reader_selector {
 
     flat_mutation_reader_v2 create_reader(shared_sstable sst) {
         tracing::trace(_trace_state, "Reading partition range {} from sstable {}", *_pr, seastar::value_of([&sst] { return sst->get_filename(); }));
+        tracing::mark(_trace_state, tracing::request_stage::sstable_read);
         return _fn(sst, *_pr);
     }
 public:
@@ -948,6 +921,7 @@ sstable_set_impl::create_single_key_sstable_reader(
     if (!num_sstables) {
         return make_empty_flat_reader_v2(schema, permit);
     }
+    tracing::mark(trace_state, tracing::request_stage::sstable_read);
     auto readers = boost::copy_range<std::vector<flat_mutation_reader_v2>>(
         filter_sstable_for_reader_by_ck(std::move(selected_sstables), *cf, schema, slice)
         | boost::adaptors::transformed([&] (const shared_sstable& sstable) {
@@ -8,8 +8,6 @@
 
 #pragma once
 
-#include <boost/icl/interval_map.hpp>
-
 #include "dht/ring_position.hh"
 #include "sstable_set.hh"
 #include "readers/clustering_combined.hh"
@@ -20,41 +18,39 @@ namespace sstables {
 // specialized when sstables are partitioned in the token range space
 // e.g. leveled compaction strategy
 class partitioned_sstable_set : public sstable_set_impl {
-    using value_set = std::unordered_set<shared_sstable>;
-    using interval_map_type = boost::icl::interval_map<dht::compatible_ring_position_or_view, value_set>;
-    using interval_type = interval_map_type::interval_type;
-    using map_iterator = interval_map_type::const_iterator;
+public:
+    // Disjoint leveled sstables, sorted by first (and hence also by last) key.
+    using lane = std::vector<shared_sstable>;
 private:
     schema_ptr _schema;
     std::vector<shared_sstable> _unleveled_sstables;
-    interval_map_type _leveled_sstables;
+    // Leveled sstables are spread over lanes, each sstable goes to the first
+    // lane it doesn't overlap with. So there is about one lane per level and
+    // finding the sstables overlapping with a position takes a binary search
+    // per lane.
+    // Lanes are shared between clones of the set and copied on write, so
+    // cloning the set is cheap and an update copies only the lane it modifies.
+    std::vector<lw_shared_ptr<lane>> _lanes;
     lw_shared_ptr<sstable_list> _all;
     std::unordered_map<run_id, shared_sstable_run> _all_runs;
-    // Change counter on interval map for leveled sstables which is used by
-    // incremental selector to determine whether or not to invalidate iterators.
-    uint64_t _leveled_sstables_change_cnt = 0;
     bool _use_level_metadata = false;
 private:
-    static interval_type make_interval(const schema& s, const dht::partition_range& range);
-    interval_type make_interval(const dht::partition_range& range) const;
-    static interval_type make_interval(const schema_ptr& s, const sstable& sst);
-    interval_type make_interval(const sstable& sst);
-    interval_type singular(const dht::ring_position& rp) const;
-    std::pair<map_iterator, map_iterator> query(const dht::partition_range& range) const;
-    // SSTables are stored separately to avoid interval map's fragmentation issue when level 0 falls behind.
+    // SSTables are stored separately to avoid a lot of lanes when level 0 falls behind.
     bool store_as_unleveled(const shared_sstable& sst) const;
+    void insert_leveled(const shared_sstable& sst);
+    void erase_leveled(const shared_sstable& sst);
 public:
-    static dht::ring_position to_ring_position(const dht::compatible_ring_position_or_view& crp);
-    static dht::partition_range to_partition_range(const interval_type& i);
-    static dht::partition_range to_partition_range(const dht::ring_position_view& pos, const interval_type& i);
+    // Returns the first sstable of the lane, whose last key is not before pos.
+    static lane::const_iterator lower_bound(const schema& s, const lane& l, dht::ring_position_view pos);
 
     partitioned_sstable_set(const partitioned_sstable_set&) = delete;
     explicit partitioned_sstable_set(schema_ptr schema, bool use_level_metadata = true);
-    // For cloning the partitioned_sstable_set (makes a deep copy, including *_all)
+    // For cloning the partitioned_sstable_set (makes a deep copy, including *_all,
+    // but shares the lanes until they are modified)
     explicit partitioned_sstable_set(
         schema_ptr schema,
         const std::vector<shared_sstable>& unleveled_sstables,
-        const interval_map_type& leveled_sstables,
+        const std::vector<lw_shared_ptr<lane>>& lanes,
         const lw_shared_ptr<sstable_list>& all,
         const std::unordered_map<run_id, shared_sstable_run>& all_runs,
         bool use_level_metadata,
@@ -65,6 +65,7 @@
 #include "sstables/partition_index_cache.hh"
 #include "db/large_data_handler.hh"
 #include "db/config.hh"
+#include "db/sstable_index_options.hh"
 #include "sstables/random_access_reader.hh"
 #include "sstables/sstables_manager.hh"
 #include "sstables/partition_index_cache.hh"
@@ -843,6 +844,9 @@ void sstable::generate_toc() {
         _recognized_components.insert(component_type::CompressionInfo);
     }
     _recognized_components.insert(component_type::Scylla);
+    if (!db::get_sstable_indexed_columns(*_schema).empty()) {
+        _recognized_components.insert(component_type::ColumnIndex);
+    }
 }
 
 future<std::unordered_map<component_type, file>> sstable::readable_file_for_all_components() const {
@@ -1408,7 +1412,7 @@ void sstable::write_filter() {
 
 size_t sstable::total_reclaimable_memory_size() const {
     if (!_total_reclaimable_memory) {
-        _total_reclaimable_memory = _components->filter ? _components->filter->memory_size() : 0;
+        _total_reclaimable_memory = (_components->filter ? _components->filter->memory_size() : 0) + _column_index_footer_memory;
     }
 
     return _total_reclaimable_memory.value();
@@ -1426,9 +1430,16 @@ size_t sstable::reclaim_memory_from_components() {
             memory_reclaimed_this_iteration += filter_memory_size;
         }
     }
+    // Only the bloom filter is reloaded by the manager, so the footer isn't
+    // counted as reclaimed.
+    _total_memory_reclaimed += memory_reclaimed_this_iteration;
+
+    if (_column_index_footer) {
+        _column_index_footer = {};
+        memory_reclaimed_this_iteration += std::exchange(_column_index_footer_memory, 0);
+    }
 
     _total_reclaimable_memory.reset();
-    _total_memory_reclaimed += memory_reclaimed_this_iteration;
     return memory_reclaimed_this_iteration;
 }
 
@@ -2322,7 +2333,7 @@ input_stream<char> sstable::data_stream(uint64_t pos, size_t len,
 
     file f = make_tracked_file(_data_file, permit);
     if (trace_state) {
-        f = tracing::make_traced_file(std::move(f), std::move(trace_state), format("{}:", get_filename()));
+        f = tracing::make_traced_file(std::move(f), std::move(trace_state), format("{}:", get_filename()), tracing::read_io_component::data);
     }
 
     input_stream<char> stream;
@@ -2634,6 +2645,32 @@ future<> sstable::mutate_sstable_level(uint32_t new_level) {
     });
 }
 
+future<> sstable::mutate_repaired_at(uint64_t repaired_at) {
+    if (!has_component(component_type::Statistics)) {
+        return make_ready_future<>();
+    }
+
+    auto entry = _components->statistics.contents.find(metadata_type::Stats);
+    if (entry == _components->statistics.contents.end()) {
+        return make_ready_future<>();
+    }
+
+    auto& p = entry->second;
+    if (!p) {
+        return make_exception_future<>(std::runtime_error("Statistics is malformed"));
+    }
+    stats_metadata& s = *static_cast<stats_metadata *>(p.get());
+    if (s.repaired_at == repaired_at) {
+        return make_ready_future<>();
+    }
+
+    sstlog.debug("set repaired_at of {} from {} to {}", get_filename(), s.repaired_at, repaired_at);
+    s.repaired_at = repaired_at;
+    return seastar::async([this] {
+        rewrite_statistics();
+    });
+}
+
 int sstable::compare_by_max_timestamp(const sstable& other) const {
     auto ts1 = get_stats_metadata().max_timestamp;
     auto ts2 = other.get_stats_metadata().max_timestamp;
@@ -2877,6 +2914,101 @@ future<bool> sstable::has_partition_key(const utils::hashed_key& hk, const dht::
     co_return present;
 }
 
+future<lw_shared_ptr<const column_index_footer>> sstable::read_column_index_footer() {
+    if (_column_index_footer) {
+        co_return _column_index_footer;
+    }
+    auto footer = make_lw_shared<column_index_footer>();
+    file f = co_await new_sstable_component_file(_read_error_handler, component_type::ColumnIndex, open_flags::ro);
+    uint64_t size = co_await f.size();
+    auto r = file_random_access_reader(std::move(f), size, sstable_buffer_size);
+    std::exception_ptr ex;
+    try {
+        if (size < sizeof(uint64_t)) {
+            throw malformed_sstable_exception("ColumnIndex is too short", filename(component_type::ColumnIndex));
+        }
+        uint64_t offset;
+        co_await r.seek(size - sizeof(uint64_t));
+        co_await parse(*_schema, _version, r, offset);
+        co_await r.seek(offset);
+        co_await parse(*_schema, _version, r, *footer);
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    co_await r.close();
+    maybe_rethrow_exception(std::move(ex));
+    // Concurrent callers may have read it too, in which case the first one
+    // is kept.
+    if (_column_index_footer) {
+        co_return _column_index_footer;
+    }
+    // The footer is accounted with the bloom filter, and dropped along with
+    // it when sstable components take too much memory. It is read again by
+    // the next lookup then.
+    _column_index_footer = footer;
+    _column_index_footer_memory = footer->partitions.elements.size() * sizeof(column_index_partition_offset);
+    for (auto& name : footer->columns.elements) {
+        _column_index_footer_memory += name.value.size();
+    }
+    _total_reclaimable_memory.reset();
+    _manager.increment_total_reclaimable_memory_and_maybe_reclaim(_column_index_footer_memory);
+    co_return footer;
+}
+
+future<std::optional<std::vector<clustering_key_prefix>>>
+sstable::find_rows_by_column_value(const dht::decorated_key& dk, const column_definition& cdef, bytes_view value) {
+    if (!has_component(component_type::ColumnIndex)) {
+        co_return std::nullopt;
+    }
+    auto footer = co_await read_column_index_footer();
+    auto& columns = footer->columns.elements;
+    auto column = std::find_if(columns.begin(), columns.end(), [&] (const disk_string<uint16_t>& name) { return name.value == cdef.name(); });
+    if (column == columns.end()) {
+        co_return std::nullopt;
+    }
+    const uint16_t column_pos = column - columns.begin();
+
+    std::vector<clustering_key_prefix> rows;
+    struct token_less {
+        bool operator()(const column_index_partition_offset& p, int64_t t) const { return p.token < t; }
+        bool operator()(int64_t t, const column_index_partition_offset& p) const { return t < p.token; }
+    };
+    auto& partitions = footer->partitions.elements;
+    auto [first, last] = std::equal_range(partitions.begin(), partitions.end(), dht::token::to_int64(dk.token()), token_less{});
+    if (first == last) {
+        co_return rows;
+    }
+    auto pk = key::from_partition_key(*_schema, dk.key());
+    file f = co_await new_sstable_component_file(_read_error_handler, component_type::ColumnIndex, open_flags::ro);
+    uint64_t size = co_await f.size();
+    auto r = file_random_access_reader(std::move(f), size, sstable_buffer_size);
+    std::exception_ptr ex;
+    try {
+        // Partitions with the same token are told apart by their key. A
+        // partition may span several blocks.
+        for (auto it = first; it != last; ++it) {
+            co_await r.seek(it->offset);
+            column_index_partition p;
+            co_await parse(*_schema, _version, r, p);
+            if (bytes_view(p.key.value) != bytes_view(pk)) {
+                continue;
+            }
+            for (auto& e : p.entries.elements) {
+                if (e.column == column_pos && bytes_view(e.value.value) == value) {
+                    for (auto& ck : e.clustering_keys.elements) {
+                        rows.push_back(clustering_key_prefix::from_bytes(bytes_view(ck.value)));
+                    }
+                }
+            }
+        }
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    co_await r.close();
+    maybe_rethrow_exception(std::move(ex));
+    co_return rows;
+}
+
 utils::hashed_key sstable::make_hashed_key(const schema& s, const partition_key& key) {
     return utils::make_hashed_key(static_cast<bytes_view>(key::from_partition_key(s, key)));
 }
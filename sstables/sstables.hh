@@ -46,6 +46,7 @@
 
 class sstable_assertions;
 class cached_file;
+class column_definition;
 
 namespace data_dictionary {
 class storage_options;
@@ -108,6 +109,9 @@ struct sstable_writer_config {
     mutation_fragment_stream_validation_level validation_level;
     std::optional<db::replay_position> replay_position;
     std::optional<int> sstable_level;
+    // When engaged, the sstable is written as repaired at the given time (see
+    // sstable::get_repaired_at()).
+    std::optional<uint64_t> repaired_at;
     write_monitor* monitor = &default_write_monitor();
     run_id run_identifier = run_id::create_random_id();
     size_t summary_byte_cost;
@@ -612,6 +616,11 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     void unused(); // Called when reference count drops to zero
     future<file> open_file(component_type, open_flags, file_open_options = {}) const noexcept;
 
+    // Loaded on the first lookup in the ColumnIndex component.
+    lw_shared_ptr<const column_index_footer> _column_index_footer;
+    size_t _column_index_footer_memory = 0;
+    future<lw_shared_ptr<const column_index_footer>> read_column_index_footer();
+
     template <component_type Type, typename T>
     future<> read_simple(T& comp);
     future<> do_read_simple(component_type type,
@@ -693,7 +702,9 @@ class sstable : public enable_lw_shared_from_this<sstable> {
 
     future<> create_data() noexcept;
 
-    // Note that only bloom filters are reclaimable by the following methods.
+    // Note that only bloom filters, and the footer of the ColumnIndex component
+    // once it's loaded, are reclaimable by the following methods. The footer
+    // isn't reloaded by them, but by its next lookup.
     // Return the total reclaimable memory in this SSTable
     size_t total_reclaimable_memory_size() const;
     // Reclaim memory from the components back to the system.
@@ -835,6 +846,13 @@ class sstable : public enable_lw_shared_from_this<sstable> {
 
     static utils::hashed_key make_hashed_key(const schema& s, const partition_key& key);
 
+    // Returns the clustering keys of the rows of the partition which have, or
+    // had, a live cell with the value in the column, according to the
+    // ColumnIndex component. Returns std::nullopt if the sstable doesn't
+    // index the column, in which case all rows are candidates.
+    future<std::optional<std::vector<clustering_key_prefix>>> find_rows_by_column_value(const dht::decorated_key& dk,
+            const column_definition& cdef, bytes_view value);
+
     filter_tracker& get_filter_tracker() { return _filter_tracker; }
 
     uint64_t filter_get_false_positive() const {
@@ -903,6 +921,16 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     // This will change sstable level only in memory.
     void set_sstable_level(uint32_t);
 
+    // Time, in seconds since the epoch, of the incremental repair which
+    // repaired all of the data of this sstable, or 0 if it is unrepaired.
+    uint64_t get_repaired_at() const {
+        return get_stats_metadata().repaired_at;
+    }
+
+    bool is_repaired() const {
+        return get_repaired_at() != 0;
+    }
+
     void generate_new_run_identifier() {
         _run_identifier = run_id::create_random_id();
     }
@@ -915,6 +943,9 @@ class sstable : public enable_lw_shared_from_this<sstable> {
 
     future<> mutate_sstable_level(uint32_t);
 
+    // Marks the sstable as repaired at the given time, rewriting its Statistics.
+    future<> mutate_repaired_at(uint64_t);
+
     const summary& get_summary() const {
         return _components->summary;
     }
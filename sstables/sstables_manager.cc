@@ -151,7 +151,11 @@ sstable_writer_config sstables_manager::configure_writer(sstring origin) const {
 }
 
 void sstables_manager::increment_total_reclaimable_memory_and_maybe_reclaim(sstable* sst) {
-    _total_reclaimable_memory += sst->total_reclaimable_memory_size();
+    increment_total_reclaimable_memory_and_maybe_reclaim(sst->total_reclaimable_memory_size());
+}
+
+void sstables_manager::increment_total_reclaimable_memory_and_maybe_reclaim(size_t memory) {
+    _total_reclaimable_memory += memory;
 
     size_t memory_reclaim_threshold = _available_memory * _db_config.components_memory_reclaim_threshold();
     if (_total_reclaimable_memory <= memory_reclaim_threshold) {
@@ -165,10 +169,15 @@ void sstables_manager::increment_total_reclaimable_memory_and_maybe_reclaim(ssta
         return sst1.total_reclaimable_memory_size() < sst2.total_reclaimable_memory_size();
     });
 
+    const auto reclaimed_before = sst_with_max_memory->total_memory_reclaimed();
     auto memory_reclaimed = sst_with_max_memory->reclaim_memory_from_components();
-    _total_memory_reclaimed += memory_reclaimed;
     _total_reclaimable_memory -= memory_reclaimed;
-    _reclaimed.insert(*sst_with_max_memory);
+    // What is reclaimed from the ColumnIndex component isn't reloaded by
+    // components_reloader_fiber(), so it isn't tracked in _reclaimed.
+    if (sst_with_max_memory->total_memory_reclaimed() > reclaimed_before) {
+        _total_memory_reclaimed += sst_with_max_memory->total_memory_reclaimed() - reclaimed_before;
+        _reclaimed.insert(*sst_with_max_memory);
+    }
     smlogger.info("Reclaimed {} bytes of memory from SSTable components. Total memory reclaimed so far is {} bytes", memory_reclaimed, _total_memory_reclaimed);
 }
 
@@ -205,6 +205,9 @@ class sstables_manager {
     // memory and if the total memory usage exceeds the pre-defined threshold,
     // reclaim it from the SSTable that has the most reclaimable memory.
     void increment_total_reclaimable_memory_and_maybe_reclaim(sstable* sst);
+    // Same as above, for a component of an SSTable loaded after it was
+    // opened, which takes the given memory.
+    void increment_total_reclaimable_memory_and_maybe_reclaim(size_t memory);
     // Fiber to reload reclaimed components back into memory when memory becomes available.
     future<> components_reloader_fiber();
     size_t get_memory_available_for_reclaimable_components();
@@ -106,6 +106,48 @@ struct filter_ref {
     explicit filter_ref(int hashes, const utils::chunked_vector<uint64_t>& buckets) : hashes(hashes), buckets(buckets) {}
 };
 
+// The ColumnIndex component indexes the values of the columns of the table's
+// sstable index (see db::sstable_index_options). For each partition with rows
+// having a live cell in one of those columns, it holds one or more
+// column_index_partition blocks listing, for each value, the clustering keys
+// of the rows having it. A large partition is split into several blocks, each
+// covering consecutive rows. Those are followed by a column_index_footer, and
+// by the offset of the footer as a uint64_t.
+struct column_index_entry {
+    // The position of the column in column_index_footer::columns.
+    uint16_t column;
+    disk_string<uint32_t> value;
+    disk_array<uint32_t, disk_string<uint16_t>> clustering_keys;
+
+    template <typename Describer>
+    auto describe_type(sstable_version_types v, Describer f) { return f(column, value, clustering_keys); }
+};
+
+struct column_index_partition {
+    disk_string<uint16_t> key;
+    disk_array<uint32_t, column_index_entry> entries;
+
+    template <typename Describer>
+    auto describe_type(sstable_version_types v, Describer f) { return f(key, entries); }
+};
+
+struct column_index_partition_offset {
+    int64_t token;
+    uint64_t offset;
+
+    template <typename Describer>
+    auto describe_type(sstable_version_types v, Describer f) { return f(token, offset); }
+};
+
+struct column_index_footer {
+    disk_array<uint16_t, disk_string<uint16_t>> columns;
+    // The blocks, in token order, as the partitions are in the data file.
+    disk_array<uint32_t, column_index_partition_offset> partitions;
+
+    template <typename Describer>
+    auto describe_type(sstable_version_types v, Describer f) { return f(columns, partitions); }
+};
+
 enum class indexable_element {
     partition,
     cell
@@ -308,8 +350,8 @@ struct stats_metadata : public metadata_base<stats_metadata> {
     double compression_ratio;
     utils::streaming_histogram estimated_tombstone_drop_time;
     uint32_t sstable_level;
-    // There is not meaningful value to put in this field, since we have no
-    // incremental repair. Before we have it, let's set it to 0.
+    // Set by incremental repair, in seconds since the epoch, once all the data
+    // of the sstable was repaired. 0 means unrepaired.
     uint64_t repaired_at = 0;
     disk_array<uint32_t, disk_string<uint16_t>> min_column_names;
     disk_array<uint32_t, disk_string<uint16_t>> max_column_names;
@@ -24,8 +24,9 @@ std::function<future<> (flat_mutation_reader_v2)> make_streaming_consumer(sstrin
         uint64_t estimated_partitions,
         stream_reason reason,
         sstables::offstrategy offstrategy,
-        service::frozen_topology_guard frozen_guard) {
-    return [&db, &vb, estimated_partitions, reason, offstrategy, origin = std::move(origin), frozen_guard] (flat_mutation_reader_v2 reader) -> future<> {
+        service::frozen_topology_guard frozen_guard,
+        std::function<future<>(sstables::shared_sstable)> on_sstable_added) {
+    return [&db, &vb, estimated_partitions, reason, offstrategy, origin = std::move(origin), frozen_guard, on_sstable_added = std::move(on_sstable_added)] (flat_mutation_reader_v2 reader) -> future<> {
         std::exception_ptr ex;
         try {
             if (current_scheduling_group() != db.local().get_streaming_scheduling_group()) {
@@ -43,7 +44,7 @@ std::function<future<> (flat_mutation_reader_v2)> make_streaming_consumer(sstrin
             // means partition estimation shouldn't be adjusted.
             const auto adjusted_estimated_partitions = (offstrategy) ? estimated_partitions : cs.adjust_partition_estimate(metadata, estimated_partitions, cf->schema());
             reader_consumer_v2 consumer =
-                    [cf = std::move(cf), adjusted_estimated_partitions, use_view_update_path, &vb, origin = std::move(origin), offstrategy] (flat_mutation_reader_v2 reader) {
+                    [cf = std::move(cf), adjusted_estimated_partitions, use_view_update_path, &vb, origin = std::move(origin), offstrategy, on_sstable_added] (flat_mutation_reader_v2 reader) {
                 sstables::shared_sstable sst;
                 try {
                     sst = use_view_update_path ? cf->make_streaming_staging_sstable() : cf->make_streaming_sstable_for_write();
@@ -65,6 +66,8 @@ std::function<future<> (flat_mutation_reader_v2)> make_streaming_consumer(sstrin
                         cf->enable_off_strategy_trigger();
                     }
                     return cf->add_sstable_and_update_cache(sst, offstrategy);
+                }).then([sst, on_sstable_added] {
+                    return on_sstable_added ? on_sstable_added(sst) : make_ready_future<>();
                 }).then([cf, s, sst, use_view_update_path, &vb]() mutable -> future<> {
                     if (!use_view_update_path) {
                         return make_ready_future<>();
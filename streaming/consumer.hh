@@ -28,6 +28,9 @@ std::function<future<>(flat_mutation_reader_v2)> make_streaming_consumer(sstring
     uint64_t estimated_partitions,
     stream_reason reason,
     sstables::offstrategy offstrategy,
-    service::frozen_topology_guard);
+    service::frozen_topology_guard,
+    // When engaged, called with each sstable once it is added to the table,
+    // on the shard which wrote it.
+    std::function<future<>(sstables::shared_sstable)> on_sstable_added = {});
 
 }
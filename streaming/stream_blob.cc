@@ -0,0 +1,377 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <seastar/core/fstream.hh>
+#include <seastar/core/seastar.hh>
+#include <seastar/core/coroutine.hh>
+#include <seastar/coroutine/maybe_yield.hh>
+#include <seastar/coroutine/as_future.hh>
+#include <seastar/core/loop.hh>
+#include <seastar/core/sleep.hh>
+
+#include "log.hh"
+#include "message/messaging_service.hh"
+#include "streaming/stream_blob.hh"
+#include "streaming/stream_manager.hh"
+#include "dht/auto_refreshing_sharder.hh"
+#include "replica/database.hh"
+#include "sstables/sstables.hh"
+#include "sstables/sstables_manager.hh"
+#include "utils/crc.hh"
+#include "utils/error_injection.hh"
+
+namespace streaming {
+
+extern logging::logger sslog;
+
+// Size of the buffers files are read and sent in.
+static constexpr size_t file_stream_buffer_size = 128 * 1024;
+// How many sstables of a range are sent in parallel.
+static constexpr size_t file_stream_sstable_concurrency = 4;
+
+static future<> close_files(utils::chunked_vector<sstables::sstable_files_snapshot>& snapshot) {
+    for (auto& ssf : snapshot) {
+        for (auto& [_, f] : ssf.files) {
+            co_await f.close();
+        }
+        ssf.files.clear();
+    }
+}
+
+future<uint64_t> stream_manager::send_file(const stream_blob_meta& meta, file f, gms::inet_address peer) {
+    auto sink_and_source = co_await coroutine::as_future(_ms.local().make_sink_and_source_for_stream_blob(meta, netw::messaging_service::msg_addr(peer)));
+    if (sink_and_source.failed()) {
+        auto ex = sink_and_source.get_exception();
+        co_await f.close();
+        std::rethrow_exception(std::move(ex));
+    }
+    auto [sink, source] = sink_and_source.get();
+    uint64_t bytes = 0;
+    std::exception_ptr ex;
+    try {
+        auto in = make_file_input_stream(std::move(f), file_input_stream_options{
+            .buffer_size = file_stream_buffer_size,
+            .read_ahead = 2,
+        });
+        utils::crc32 crc;
+        try {
+            for (;;) {
+                auto buf = co_await in.read();
+                if (buf.empty()) {
+                    break;
+                }
+                crc.process(reinterpret_cast<const uint8_t*>(buf.get()), buf.size());
+                bytes += buf.size();
+                co_await sink(stream_blob_cmd_data(stream_blob_cmd::data, std::move(buf), std::nullopt));
+            }
+        } catch (...) {
+            ex = std::current_exception();
+        }
+        co_await in.close();
+        if (ex) {
+            std::rethrow_exception(std::move(ex));
+        }
+        co_await sink(stream_blob_cmd_data(stream_blob_cmd::end_of_stream, std::nullopt, crc.get()));
+        co_await sink.flush();
+        auto status = co_await source();
+        if (!status || std::get<0>(*status).cmd != stream_blob_cmd::ok) {
+            throw std::runtime_error(format("Peer {} failed to receive file {}", peer, meta.filename));
+        }
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    if (ex) {
+        try {
+            co_await sink(stream_blob_cmd_data(stream_blob_cmd::error));
+        } catch (...) {
+            // The peer learns about the failure from the closed stream as well.
+        }
+    }
+    co_await sink.close();
+    if (ex) {
+        std::rethrow_exception(std::move(ex));
+    }
+    update_progress(meta.ops_id, peer, progress_info::direction::OUT, bytes);
+    co_return bytes;
+}
+
+future<stream_files_response> stream_manager::stream_files(stream_files_request req, gms::inet_address peer) {
+    stream_files_response resp;
+    auto& table = _db.local().find_column_family(req.table);
+    auto s = table.schema();
+    if (!table.get_storage_options().is_local_type()) {
+        sslog.info("[Stream #{}] Cannot stream files of {}.{}: storage is not local", req.ops_id, s->ks_name(), s->cf_name());
+        co_return resp;
+    }
+    auto op = table.stream_in_progress();
+    auto snapshot = co_await table.take_storage_snapshot(req.range);
+
+    // Files are sent only if the receiver can attach them as they are, that is
+    // when each sstable holds data of the range alone.
+    auto sendable = [&] (const sstables::sstable_files_snapshot& ssf) {
+        auto cmp = dht::token_comparator();
+        return ssf.files.contains(sstables::component_type::TOC)
+            && req.range.contains(ssf.sst->get_first_decorated_key().token(), cmp)
+            && req.range.contains(ssf.sst->get_last_decorated_key().token(), cmp);
+    };
+    if (!std::all_of(snapshot.begin(), snapshot.end(), sendable)) {
+        sslog.info("[Stream #{}] Cannot stream files of {}.{} range {}: sstables span other ranges", req.ops_id, s->ks_name(), s->cf_name(), req.range);
+        co_await close_files(snapshot);
+        co_return resp;
+    }
+
+    sslog.info("[Stream #{}] Streaming files of {} sstables of {}.{} range {} to {}", req.ops_id, snapshot.size(), s->ks_name(), s->cf_name(), req.range, peer);
+    std::exception_ptr ex;
+    try {
+        co_await max_concurrent_for_each(snapshot, file_stream_sstable_concurrency, [&] (sstables::sstable_files_snapshot& ssf) -> future<> {
+            // The TOC is sent last, so the receiver sees the sstable as complete
+            // only once all its other components are written.
+            auto toc = std::move(ssf.files.at(sstables::component_type::TOC));
+            ssf.files.erase(sstables::component_type::TOC);
+            std::vector<std::pair<sstables::component_type, file>> files(std::make_move_iterator(ssf.files.begin()), std::make_move_iterator(ssf.files.end()));
+            files.emplace_back(sstables::component_type::TOC, std::move(toc));
+            ssf.files.clear();
+
+            std::exception_ptr send_ex;
+            size_t i = 0;
+            try {
+                for (; i < files.size(); ++i) {
+                    auto meta = stream_blob_meta{
+                        .ops_id = req.ops_id,
+                        .table = req.table,
+                        .filename = ssf.sst->component_basename(files[i].first),
+                        .dst_shard_id = req.dst_shard_id,
+                        .topo_guard = req.topo_guard,
+                    };
+                    resp.stream_bytes += co_await send_file(meta, std::move(files[i].second), peer);
+                }
+                ++resp.sstables;
+            } catch (...) {
+                send_ex = std::current_exception();
+            }
+            if (send_ex) {
+                for (++i; i < files.size(); ++i) {
+                    co_await files[i].second.close();
+                }
+                std::rethrow_exception(std::move(send_ex));
+            }
+        });
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    co_await close_files(snapshot);
+    if (ex) {
+        sslog.warn("[Stream #{}] Failed to stream files of {}.{} range {} to {}: {}", req.ops_id, s->ks_name(), s->cf_name(), req.range, peer, ex);
+        std::rethrow_exception(std::move(ex));
+    }
+    sslog.info("[Stream #{}] Finished streaming files of {} sstables of {}.{} range {} to {}, {} bytes", req.ops_id, resp.sstables, s->ks_name(), s->cf_name(), req.range, peer, resp.stream_bytes);
+    resp.streamed = true;
+    co_return resp;
+}
+
+stream_manager::received_file stream_manager::add_received_file(plan_id ops_id, table_id id, const sstables::entry_descriptor& desc) {
+    auto& table = _db.local().find_column_family(id);
+    auto s = table.schema();
+    auto& r = _received_sstables[ops_id];
+    // Throws if the received files are already being attached or discarded.
+    r.receiving.enter();
+    r.table = id;
+    auto it = r.sstables.find(desc.generation);
+    bool new_sstable = it == r.sstables.end();
+    if (new_sstable) {
+        it = r.sstables.emplace(desc.generation, sstables::entry_descriptor(table.calculate_generation_for_new_table(),
+                desc.version, desc.format, sstables::component_type::TOC)).first;
+    }
+    auto filename = [&] (sstables::component_type c) {
+        return sstables::sstable::filename(table.dir(), s->ks_name(), s->cf_name(), it->second.version, it->second.generation, it->second.format, c);
+    };
+    auto ret = received_file{
+        .path = filename(desc.component),
+        .temporary_toc = filename(sstables::component_type::TemporaryTOC),
+        .new_sstable = new_sstable,
+    };
+    if (new_sstable) {
+        r.files.push_back(ret.temporary_toc);
+    }
+    r.files.push_back(ret.path);
+    return ret;
+}
+
+void stream_manager::release_received_file(plan_id ops_id) noexcept {
+    _received_sstables.at(ops_id).receiving.leave();
+}
+
+future<> stream_manager::receive_file(gms::inet_address from, stream_blob_meta meta, rpc::source<stream_blob_cmd_data> source, rpc::sink<stream_blob_cmd_data> sink) {
+    std::exception_ptr ex;
+    bool added = false;
+    try {
+        auto guard = service::topology_guard(meta.topo_guard);
+        auto& table = _db.local().find_column_family(meta.table);
+        auto s = table.schema();
+        auto desc = sstables::parse_path(std::filesystem::path(meta.filename), s->ks_name(), s->cf_name());
+        auto target = co_await container().invoke_on(meta.dst_shard_id, [&meta, &desc] (stream_manager& sm) {
+            return sm.add_received_file(meta.ops_id, meta.table, desc);
+        });
+        added = true;
+
+        // Like when an sstable is written, a temporary TOC marks the sstable
+        // as incomplete until the TOC is in place, so that it's removed
+        // if the node restarts before that.
+        if (target.new_sstable) {
+            auto f = co_await open_file_dma(target.temporary_toc, open_flags::wo | open_flags::create | open_flags::truncate);
+            co_await f.close();
+            co_await sync_directory(table.dir());
+        }
+
+        const bool is_toc = desc.component == sstables::component_type::TOC;
+        auto f = co_await open_file_dma(is_toc ? target.temporary_toc : target.path, open_flags::wo | open_flags::create | open_flags::truncate);
+        auto out = co_await make_file_output_stream(std::move(f), file_output_stream_options{
+            .buffer_size = file_stream_buffer_size,
+            .write_behind = 2,
+        });
+        uint64_t bytes = 0;
+        try {
+            utils::crc32 crc;
+            for (bool eos = false; !eos;) {
+                auto opt = co_await source();
+                if (!opt) {
+                    throw std::runtime_error("Sender closed the stream before end_of_stream");
+                }
+                auto& cmd = std::get<0>(*opt);
+                switch (cmd.cmd) {
+                case stream_blob_cmd::data:
+                    guard.check();
+                    co_await utils::get_local_injector().inject("stream_blob_receive_file", [&guard] (auto& handler) -> future<> {
+                        auto& guard_ = guard;
+                        sslog.info("stream_blob_receive_file: waiting");
+                        while (!handler.poll_for_message()) {
+                            guard_.check();
+                            co_await sleep(std::chrono::milliseconds(5));
+                        }
+                        sslog.info("stream_blob_receive_file: released");
+                    });
+                    utils::get_local_injector().inject("stream_blob_receive_file_fail", [] {
+                        throw std::runtime_error("stream_blob_receive_file_fail");
+                    });
+                    if (cmd.data) {
+                        crc.process(reinterpret_cast<const uint8_t*>(cmd.data->get()), cmd.data->size());
+                        bytes += cmd.data->size();
+                        co_await out.write(std::move(*cmd.data));
+                    }
+                    break;
+                case stream_blob_cmd::end_of_stream:
+                    if (!cmd.checksum) {
+                        throw std::runtime_error("Sender sent no checksum");
+                    }
+                    if (*cmd.checksum != crc.get()) {
+                        throw std::runtime_error(format("Checksum mismatch, sent {:#x} received {:#x}", *cmd.checksum, crc.get()));
+                    }
+                    eos = true;
+                    break;
+                case stream_blob_cmd::error:
+                    throw std::runtime_error("Sender failed");
+                default:
+                    throw std::runtime_error("Sender sent wrong cmd");
+                }
+            }
+            co_await out.flush();
+        } catch (...) {
+            ex = std::current_exception();
+        }
+        co_await out.close();
+        if (ex) {
+            std::rethrow_exception(std::move(ex));
+        }
+        if (is_toc) {
+            co_await rename_file(target.temporary_toc, target.path);
+            co_await sync_directory(table.dir());
+        }
+        update_progress(meta.ops_id, from, progress_info::direction::IN, bytes);
+        sslog.debug("[Stream #{}] Received file {} from {} as {}, {} bytes", meta.ops_id, meta.filename, from, target.path, bytes);
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    if (ex) {
+        sslog.warn("[Stream #{}] Failed to receive file {} from {}: {}", meta.ops_id, meta.filename, from, ex);
+    }
+    if (added) {
+        co_await container().invoke_on(meta.dst_shard_id, [ops_id = meta.ops_id] (stream_manager& sm) {
+            sm.release_received_file(ops_id);
+        });
+    }
+    try {
+        co_await sink(stream_blob_cmd_data(ex ? stream_blob_cmd::error : stream_blob_cmd::ok));
+        co_await sink.flush();
+    } catch (...) {
+        sslog.debug("[Stream #{}] Failed to respond to {} for file {}: {}", meta.ops_id, from, meta.filename, std::current_exception());
+    }
+    co_await sink.close();
+}
+
+future<rpc::sink<stream_blob_cmd_data>> stream_manager::handle_stream_blob(gms::inet_address from, stream_blob_meta meta, rpc::source<stream_blob_cmd_data> source) {
+    auto holder = _file_stream_gate.hold();
+    auto sink = _ms.local().make_sink_for_stream_blob(source);
+    // The file is received in the background, the sender waits for the status on the stream.
+    (void)receive_file(from, std::move(meta), std::move(source), sink).finally([holder = std::move(holder)] {});
+    return make_ready_future<rpc::sink<stream_blob_cmd_data>>(std::move(sink));
+}
+
+future<> stream_manager::attach_received_sstables(plan_id ops_id) {
+    auto it = _received_sstables.find(ops_id);
+    if (it == _received_sstables.end()) {
+        co_return;
+    }
+    auto& received = it->second;
+    co_await received.receiving.close();
+    auto& table = _db.local().find_column_family(received.table);
+    auto op = table.stream_in_progress();
+    dht::auto_refreshing_sharder sharder(table.shared_from_this());
+    auto& mng = table.get_sstables_manager();
+
+    std::vector<sstables::shared_sstable> ssts;
+    ssts.reserve(received.sstables.size());
+    for (auto& [_, d] : received.sstables) {
+        auto sst = mng.make_sstable(table.schema(), table.dir(), table.get_storage_options(), d.generation, sstables::sstable_state::normal,
+                                    d.version, d.format, gc_clock::now(), default_io_error_handler_gen());
+        // As for intra-node migration, the pending shard owns the sstables
+        // although the tablet sharder still points at the leaving replica.
+        auto cfg = sstables::sstable_open_config{ .current_shard_as_sstable_owner = true };
+        co_await sst->load(sharder, cfg);
+        ssts.push_back(std::move(sst));
+    }
+    co_await table.add_sstables_and_update_cache(ssts);
+    sslog.info("[Stream #{}] Attached {} sstables received for {}.{}", ops_id, ssts.size(), table.schema()->ks_name(), table.schema()->cf_name());
+    _received_sstables.erase(ops_id);
+}
+
+future<> stream_manager::discard_received_sstables(plan_id ops_id) {
+    auto it = _received_sstables.find(ops_id);
+    if (it == _received_sstables.end()) {
+        co_return;
+    }
+    // Files still being received would be written after being removed.
+    // Files arriving from now on are refused. The gate is closed already if
+    // attaching the sstables failed.
+    if (!it->second.receiving.is_closed()) {
+        co_await it->second.receiving.close();
+    }
+    auto nh = _received_sstables.extract(ops_id);
+    for (auto& path : nh.mapped().files) {
+        try {
+            co_await remove_file(path);
+        } catch (const std::system_error& e) {
+            if (e.code() != std::error_code(ENOENT, std::system_category())) {
+                sslog.warn("[Stream #{}] Failed to remove received file {}: {}", ops_id, path, e);
+            }
+        }
+        co_await coroutine::maybe_yield();
+    }
+    sslog.info("[Stream #{}] Discarded {} received files", ops_id, nh.mapped().files.size());
+}
+
+} // namespace streaming
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <seastar/core/temporary_buffer.hh>
+#include <seastar/core/sstring.hh>
+#include <optional>
+
+#include "dht/i_partitioner_fwd.hh"
+#include "dht/token.hh"
+#include "schema/schema_fwd.hh"
+#include "service/topology_guard.hh"
+#include "streaming/stream_fwd.hh"
+
+// File-based streaming.
+//
+// When all the sstables of a tablet belong to that tablet alone, migrating it
+// doesn't need to decode the sstables into mutations on the leaving replica
+// and write them out again on the pending one. The pending replica asks the
+// leaving one (TABLET_STREAM_FILES) to send it the component files of the
+// tablet's sstables, which are then transferred as byte streams (STREAM_BLOB),
+// checksummed end to end, and attached as they are on the pending shard.
+namespace streaming {
+
+// Commands of the STREAM_BLOB rpc stream. The sender of a file sends data
+// commands followed by end_of_stream, which carries the checksum of the whole
+// file, or by error. The receiver answers with a single ok or error once the
+// file is safely written.
+enum class stream_blob_cmd : uint8_t {
+    ok,
+    error,
+    data,
+    end_of_stream,
+};
+
+using stream_blob_data = temporary_buffer<char>;
+
+struct stream_blob_cmd_data {
+    stream_blob_cmd cmd;
+    std::optional<stream_blob_data> data;
+    // crc32 of the whole file, set by end_of_stream.
+    std::optional<uint32_t> checksum;
+
+    stream_blob_cmd_data() = default;
+    explicit stream_blob_cmd_data(stream_blob_cmd c) : cmd(c) {}
+    stream_blob_cmd_data(stream_blob_cmd c, std::optional<stream_blob_data> d, std::optional<uint32_t> crc)
+        : cmd(c), data(std::move(d)), checksum(crc) {}
+};
+
+// Describes the file sent over a STREAM_BLOB rpc stream.
+struct stream_blob_meta {
+    plan_id ops_id;
+    table_id table;
+    // Name of the sstable component file on the sender.
+    sstring filename;
+    // The shard which will own the sstable on the receiver.
+    uint32_t dst_shard_id;
+    service::frozen_topology_guard topo_guard;
+};
+
+struct stream_files_request {
+    plan_id ops_id;
+    table_id table;
+    dht::token_range range;
+    // The shard owning the range on the sender, and the one which will own it
+    // on the receiver.
+    uint32_t src_shard_id;
+    uint32_t dst_shard_id;
+    service::frozen_topology_guard topo_guard;
+};
+
+struct stream_files_response {
+    // False if the range cannot be streamed as whole files, in which case
+    // nothing was sent and the caller should stream mutations instead.
+    bool streamed = false;
+    uint64_t sstables = 0;
+    uint64_t stream_bytes = 0;
+};
+
+} // namespace streaming
@@ -87,6 +87,7 @@ future<> stream_manager::start(abort_source& as) {
 future<> stream_manager::stop() {
     co_await _gossiper.unregister_(shared_from_this());
     co_await uninit_messaging_service_handler();
+    co_await _file_stream_gate.close();
     co_await _io_throughput_updater.join();
 }
 
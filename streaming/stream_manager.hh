@@ -12,6 +12,7 @@
 #include "streaming/stream_fwd.hh"
 #include "streaming/progress_info.hh"
 #include "streaming/stream_reason.hh"
+#include "streaming/stream_blob.hh"
 #include <seastar/core/shared_ptr.hh>
 #include <seastar/core/distributed.hh>
 #include "utils/updateable_value.hh"
@@ -22,7 +23,10 @@
 #include "gms/application_state.hh"
 #include "service/topology_guard.hh"
 #include "readers/flat_mutation_reader_v2.hh"
+#include "sstables/open_info.hh"
 #include <seastar/core/semaphore.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/rpc/rpc_types.hh>
 #include <seastar/core/metrics_registration.hh>
 
 namespace db {
@@ -102,6 +106,25 @@ class stream_manager : public gms::i_endpoint_state_change_subscriber, public en
     serialized_action _io_throughput_updater = serialized_action([this] { return update_io_throughput(_io_throughput_mbs()); });
     std::optional<utils::observer<uint32_t>> _io_throughput_option_observer;
 
+    // Sstables received by file-based streaming on this shard, which are not
+    // attached to their table yet.
+    struct received_sstables {
+        table_id table;
+        // Generation on the sender -> the sstable written here.
+        std::unordered_map<sstables::generation_type, sstables::entry_descriptor> sstables;
+        // All files written so far, removed if the operation fails.
+        std::vector<sstring> files;
+        // Entered while a file is being received.
+        gate receiving;
+    };
+    struct received_file {
+        sstring path;
+        sstring temporary_toc;
+        bool new_sstable;
+    };
+    std::unordered_map<plan_id, received_sstables> _received_sstables;
+    gate _file_stream_gate;
+
 public:
     stream_manager(db::config& cfg, sharded<replica::database>& db,
             sharded<db::view::view_builder>& view_builder,
@@ -170,6 +193,22 @@ class stream_manager : public gms::i_endpoint_state_change_subscriber, public en
 
     std::function<future<>(flat_mutation_reader_v2)> make_streaming_consumer(
             uint64_t estimated_partitions, stream_reason, service::frozen_topology_guard);
+
+    // File-based streaming, see stream_blob.hh.
+    //
+    // Sends the sstables of req.range on this shard to the peer as whole
+    // files, if they belong to that range alone.
+    future<stream_files_response> stream_files(stream_files_request req, gms::inet_address peer);
+    // Attaches the sstables received by ops_id on this shard to their table.
+    future<> attach_received_sstables(plan_id ops_id);
+    // Removes the files received by ops_id on this shard, once those still
+    // being received are written. Files arriving afterwards are refused.
+    future<> discard_received_sstables(plan_id ops_id);
+    // Registers a file received by ops_id for this shard, and returns where
+    // to write it. release_received_file() must be called once it's written,
+    // or failed to.
+    received_file add_received_file(plan_id ops_id, table_id table, const sstables::entry_descriptor& desc);
+    void release_received_file(plan_id ops_id) noexcept;
 public:
     virtual future<> on_join(inet_address endpoint, endpoint_state_ptr ep_state, gms::permit_id) override { return make_ready_future(); }
     virtual future<> on_change(gms::inet_address, const gms::application_state_map& states, gms::permit_id) override  { return make_ready_future(); }
@@ -184,6 +223,9 @@ class stream_manager : public gms::i_endpoint_state_change_subscriber, public en
     bool has_peer(inet_address endpoint) const;
 
     void init_messaging_service_handler(abort_source& as);
+    future<rpc::sink<stream_blob_cmd_data>> handle_stream_blob(gms::inet_address from, stream_blob_meta meta, rpc::source<stream_blob_cmd_data> source);
+    future<> receive_file(gms::inet_address from, stream_blob_meta meta, rpc::source<stream_blob_cmd_data> source, rpc::sink<stream_blob_cmd_data> sink);
+    future<uint64_t> send_file(const stream_blob_meta& meta, file f, gms::inet_address peer);
     future<> uninit_messaging_service_handler();
     future<> update_io_throughput(uint32_t value_mbs);
 
@@ -31,6 +31,7 @@
 #include "readers/generating_v2.hh"
 #include "service/topology_guard.hh"
 #include "utils/error_injection.hh"
+#include "idl/streaming.dist.hh"
 
 namespace streaming {
 
@@ -251,6 +252,17 @@ void stream_manager::init_messaging_service_handler(abort_source& as) {
         });
       });
     });
+    ms.register_stream_blob([this] (const rpc::client_info& cinfo, stream_blob_meta meta, rpc::source<stream_blob_cmd_data> source) {
+        const auto& from = cinfo.retrieve_auxiliary<gms::inet_address>("baddr");
+        return handle_stream_blob(from, std::move(meta), std::move(source));
+    });
+    ser::streaming_rpc_verbs::register_tablet_stream_files(&ms, [this] (const rpc::client_info& cinfo, stream_files_request req) {
+        const auto& from = cinfo.retrieve_auxiliary<gms::inet_address>("baddr");
+        auto shard = req.src_shard_id;
+        return container().invoke_on(shard, [req = std::move(req), from] (stream_manager& sm) mutable {
+            return sm.stream_files(std::move(req), from);
+        });
+    });
     ms.register_stream_mutation_done([this] (const rpc::client_info& cinfo, streaming::plan_id plan_id, dht::token_range_vector ranges, table_id cf_id, unsigned dst_cpu_id) {
         const auto& from = cinfo.retrieve_auxiliary<gms::inet_address>("baddr");
         return container().invoke_on(dst_cpu_id, [ranges = std::move(ranges), plan_id, cf_id, from] (auto& sm) mutable {
@@ -281,6 +293,8 @@ future<> stream_manager::uninit_messaging_service_handler() {
         ms.unregister_prepare_message(),
         ms.unregister_prepare_done_message(),
         ms.unregister_stream_mutation_fragments(),
+        ms.unregister_stream_blob(),
+        ser::streaming_rpc_verbs::unregister_tablet_stream_files(&ms),
         ms.unregister_stream_mutation_done(),
         ms.unregister_complete_message()).discard_result();
 }
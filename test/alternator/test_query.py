@@ -17,7 +17,7 @@ import pytest
 from boto3.dynamodb.conditions import Attr
 from botocore.exceptions import ClientError
 
-from test.alternator.util import random_string, random_bytes, full_query, multiset
+from test.alternator.util import random_string, random_bytes, full_query, full_query_and_counts, multiset
 
 
 def test_query_nonexistent_table(dynamodb):
@@ -626,3 +626,101 @@ def test_query_large_page_small_rows(test_table_sn):
         ConsistentRead=True)['Items']
     n = len(got_items)
     assert n == N
+
+# Test that a page of a Query is not resumed with the read of a different
+# Query which stopped at the same key. Scylla keeps the readers of the last
+# page on the replicas, and remembers how to find them by the key where the
+# page ended - which is the ExclusiveStartKey of the next page, but could as
+# well be given to any other Query.
+def test_query_paging_different_queries_same_key(test_table_sn):
+    p = random_string()
+    numbers = list(range(10))
+    with test_table_sn.batch_writer() as batch:
+        for i in numbers:
+            batch.put_item({'p': p, 'c': i})
+    key_conditions = {'p': {'AttributeValueList': [p], 'ComparisonOperator': 'EQ'}}
+    # A forward Query stopping after c=4, then a reverse Query starting
+    # after the same key, which should return the items before it.
+    got = test_table_sn.query(ConsistentRead=True, KeyConditions=key_conditions, Limit=5)
+    assert [x['c'] for x in got['Items']] == numbers[:5]
+    assert got['LastEvaluatedKey'] == {'p': p, 'c': 4}
+    got = test_table_sn.query(ConsistentRead=True, KeyConditions=key_conditions, ScanIndexForward=False,
+        ExclusiveStartKey={'p': p, 'c': 4})
+    assert [x['c'] for x in got['Items']] == [3, 2, 1, 0]
+    # A Query over some of the items stopping after c=4, then a Query over
+    # all of them starting after the same key, which shouldn't stop where
+    # the first one's range ends.
+    got = test_table_sn.query(ConsistentRead=True, KeyConditions={**key_conditions,
+        'c': {'AttributeValueList': [2, 6], 'ComparisonOperator': 'BETWEEN'}}, Limit=3)
+    assert [x['c'] for x in got['Items']] == [2, 3, 4]
+    assert got['LastEvaluatedKey'] == {'p': p, 'c': 4}
+    got = test_table_sn.query(ConsistentRead=True, KeyConditions=key_conditions,
+        ExclusiveStartKey={'p': p, 'c': 4})
+    assert [x['c'] for x in got['Items']] == numbers[5:]
+
+# Test that items of all attribute types are returned as they were written,
+# by Query without a filter, and with a projection of whole attributes.
+# Such responses are written straight from the rows read, rather than from
+# items built to be filtered or projected, so this checks that both ways
+# agree.
+def test_query_items_of_all_types(test_table_sn):
+    p = random_string()
+    items = [{'p': p, 'c': i,
+              'str': random_string(),
+              'num': Decimal(i) / 3,
+              'bin': random_bytes(),
+              'flag': i % 2 == 0,
+              'nothing': None,
+              'list': ['dog', Decimal(i), [random_string()]],
+              'map': {'a': Decimal(i), 'b': {'c': random_string()}},
+              'strset': {random_string(), random_string()},
+              'numset': {Decimal(i), Decimal(i + 1)},
+              'binset': {random_bytes(), random_bytes()}} for i in range(5)]
+    # An item with only its key.
+    items.append({'p': p, 'c': 5})
+    with test_table_sn.batch_writer() as batch:
+        for item in items:
+            batch.put_item(item)
+    key_conditions = {'p': {'AttributeValueList': [p], 'ComparisonOperator': 'EQ'}}
+    for limit in [None, 1, 4]:
+        kwargs = {'Limit': limit} if limit else {}
+        assert full_query(test_table_sn, KeyConditions=key_conditions, **kwargs) == items
+    # Whole top-level attributes, including a key attribute, one missing from
+    # some items and one missing from all of them.
+    wanted = ['c', 'str', 'map', 'binset', 'missing']
+    expected_items = [{k: x[k] for k in wanted if k in x} for x in items]
+    assert full_query(test_table_sn, KeyConditions=key_conditions, AttributesToGet=wanted) == expected_items
+    assert full_query(test_table_sn, KeyConditions=key_conditions,
+        ProjectionExpression=', '.join(f'#{k}' for k in wanted),
+        ExpressionAttributeNames={f'#{k}': k for k in wanted}) == expected_items
+    # Projecting a part of an attribute goes the other way, and agrees.
+    expected_items = [{'c': x['c'], 'map': {'b': x['map']['b']}} if 'map' in x else {'c': x['c']} for x in items]
+    assert full_query(test_table_sn, KeyConditions=key_conditions,
+        ProjectionExpression='c, #map.b', ExpressionAttributeNames={'#map': 'map'}) == expected_items
+
+# Test that a Query with Select=COUNT counts the items which pass the
+# filter, and the items it read, without returning any item. Without a
+# filter, the items are only counted, and with one they are built to be
+# filtered, so both are checked.
+def test_query_select_count(test_table_sn):
+    p = random_string()
+    numbers = [Decimal(i) for i in range(10)]
+    with test_table_sn.batch_writer() as batch:
+        for i in numbers:
+            batch.put_item({'p': p, 'c': i, 'x': i, 's': random_string()})
+    key_conditions = {'p': {'AttributeValueList': [p], 'ComparisonOperator': 'EQ'}}
+    for limit in [None, 1, 3]:
+        kwargs = {'Limit': limit} if limit else {}
+        (prefilter_count, postfilter_count, pages, items) = full_query_and_counts(test_table_sn,
+            KeyConditions=key_conditions, Select='COUNT', **kwargs)
+        assert prefilter_count == len(numbers)
+        assert postfilter_count == len(numbers)
+        assert pages == 0
+        assert items == []
+        (prefilter_count, postfilter_count, pages, items) = full_query_and_counts(test_table_sn,
+            KeyConditions=key_conditions, Select='COUNT', FilterExpression='x >= :x',
+            ExpressionAttributeValues={':x': 3}, **kwargs)
+        assert prefilter_count == len(numbers)
+        assert postfilter_count == len(numbers) - 3
+        assert pages == 0
+        assert items == []
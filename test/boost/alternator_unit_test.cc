@@ -9,6 +9,7 @@
 #define BOOST_TEST_MODULE alternator
 #include <boost/test/included/unit_test.hpp>
 
+#include <fmt/format.h>
 #include <seastar/util/defer.hh>
 #include <seastar/core/memory.hh>
 #include "utils/base64.hh"
@@ -165,4 +166,40 @@ BOOST_AUTO_TEST_CASE(test_magnitude_and_precision) {
     BOOST_CHECK(res.magnitude > 1000);
     res = alternator::internal::get_magnitude_and_precision("1e-1000000000000");
     BOOST_CHECK(res.magnitude < -1000);
-}
\ No newline at end of file
+}
+
+// Test that rjson::chunked_writer, which Query and Scan responses are written
+// with, writes the same JSON as rjson::print(), in chunks of a bounded size.
+BOOST_AUTO_TEST_CASE(test_chunked_writer) {
+    rjson::value items = rjson::empty_array();
+    rjson::chunked_writer writer;
+    writer.StartObject();
+    writer.Key("Items");
+    writer.StartArray();
+    for (int i = 0; i < 10000; ++i) {
+        rjson::value item = rjson::empty_object();
+        rjson::add(item, "p", rjson::from_string(fmt::format("item \"{}\"", i)));
+        rjson::add(item, "n", rjson::value(i));
+        writer.Value(item);
+        rjson::push_back(items, std::move(item));
+    }
+    writer.EndArray();
+    writer.Key("Count");
+    writer.Uint64(items.Size());
+    writer.EndObject();
+    rjson::value expected = rjson::empty_object();
+    rjson::add(expected, "Items", std::move(items));
+    rjson::add(expected, "Count", rjson::value(10000));
+
+    auto size = writer.size();
+    auto chunks = std::move(writer).release();
+    BOOST_REQUIRE_GT(chunks.size(), 1);
+    std::string json;
+    for (auto& chunk : chunks) {
+        BOOST_REQUIRE_GT(chunk.size(), 0);
+        BOOST_REQUIRE_LE(chunk.size(), rjson::chunked_writer::chunk_size);
+        json.append(chunk.get(), chunk.size());
+    }
+    BOOST_REQUIRE_EQUAL(json.size(), size);
+    BOOST_REQUIRE_EQUAL(json, rjson::print(expected));
+}
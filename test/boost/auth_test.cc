@@ -170,6 +170,29 @@ SEASTAR_TEST_CASE(test_password_authenticator_operations) {
     }, auth_on(false));
 }
 
+SEASTAR_TEST_CASE(test_password_authenticator_remembers_verified_credentials) {
+    return do_with_cql_env_thread([] (cql_test_env& env) {
+        cquery_nofail(env, "CREATE ROLE fisk WITH PASSWORD = 'notter' AND LOGIN = true");
+
+        // Logins with the same credentials at the same time share the check.
+        auto logins = boost::copy_range<std::vector<future<auth::authenticated_user>>>(boost::irange(0, 10) | boost::adaptors::transformed([&] (int) {
+            return authenticate(env, "fisk", "notter");
+        }));
+        for (auto& f : logins) {
+            BOOST_REQUIRE_EQUAL(*f.get().name, "fisk");
+        }
+
+        // A remembered password doesn't let in other ones.
+        require_throws<exceptions::authentication_exception>(authenticate(env, "fisk", "hejkotte")).get();
+        authenticate(env, "fisk", "notter").get();
+
+        // Changing the password forgets the old one right away.
+        cquery_nofail(env, "ALTER ROLE fisk WITH PASSWORD = 'hejkotte'");
+        require_throws<exceptions::authentication_exception>(authenticate(env, "fisk", "notter")).get();
+        authenticate(env, "fisk", "hejkotte").get();
+    }, auth_on(false));
+}
+
 namespace {
 
 /// Asserts that table is protected from alterations that can brick a node.
@@ -10,10 +10,14 @@
 
 #include "test/lib/scylla_test_case.hh"
 #include "test/lib/cql_test_env.hh"
+#include "test/lib/cql_assertions.hh"
 #include "test/lib/log.hh"
 #include "readers/filtering.hh"
 
 #include "db/data_listeners.hh"
+#include "db/heavy_hitters.hh"
+#include "db/config.hh"
+#include "replica/database.hh"
 
 using namespace std::chrono_literals;
 
@@ -111,3 +115,91 @@ SEASTAR_TEST_CASE(test_dlistener_t2) {
         BOOST_REQUIRE_EQUAL(0, res.write);
     });
 }
+
+SEASTAR_TEST_CASE(test_heavy_hitters) {
+    cql_test_config cfg;
+    // Count every operation, to get exact counts
+    cfg.db_config->heavy_hitters_sample_every.set(1);
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("CREATE TABLE ks.hh (k int PRIMARY KEY, v int);").get();
+        for (int i = 0; i < 100; ++i) {
+            e.execute_cql("INSERT INTO ks.hh (k, v) VALUES (1, 1);").get();
+        }
+        for (int k = 2; k < 20; ++k) {
+            e.execute_cql(format("INSERT INTO ks.hh (k, v) VALUES ({}, 1);", k)).get();
+        }
+        for (int i = 0; i < 10; ++i) {
+            e.execute_cql("SELECT v FROM ks.hh WHERE k = 2;").get();
+        }
+
+        // Nothing is listed until the window ends
+        assert_that(e.execute_cql("SELECT * FROM system.heavy_hitters WHERE keyspace_name = 'ks';").get())
+            .is_rows().is_empty();
+
+        e.db().invoke_on_all([] (replica::database& db) {
+            db.heavy_hitters().roll_window();
+        }).get();
+
+        assert_that(e.execute_cql("SELECT partition_key, count, error FROM system.heavy_hitters "
+                    "WHERE keyspace_name = 'ks' AND table_name = 'hh' AND operation = 'writes' AND rank = 1;").get())
+            .is_rows().with_rows({{utf8_type->decompose("1"), long_type->decompose(int64_t(100)), long_type->decompose(int64_t(0))}});
+        assert_that(e.execute_cql("SELECT partition_key FROM system.heavy_hitters "
+                    "WHERE keyspace_name = 'ks' AND table_name = 'hh' AND operation = 'written_kib' AND rank = 1;").get())
+            .is_rows().with_rows({{utf8_type->decompose("1")}});
+        assert_that(e.execute_cql("SELECT partition_key FROM system.heavy_hitters "
+                    "WHERE keyspace_name = 'ks' AND table_name = 'hh' AND operation = 'reads' AND rank = 1;").get())
+            .is_rows().with_rows({{utf8_type->decompose("2")}});
+        // Only the top partitions are listed
+        assert_that(e.execute_cql("SELECT rank FROM system.heavy_hitters "
+                    "WHERE keyspace_name = 'ks' AND table_name = 'hh' AND operation = 'writes';").get())
+            .is_rows().with_size(db::heavy_hitters::max_results);
+
+        // The next window starts from scratch
+        e.db().invoke_on_all([] (replica::database& db) {
+            db.heavy_hitters().roll_window();
+        }).get();
+        assert_that(e.execute_cql("SELECT * FROM system.heavy_hitters WHERE keyspace_name = 'ks';").get())
+            .is_rows().is_empty();
+    }, std::move(cfg));
+}
+
+SEASTAR_TEST_CASE(test_heavy_hitters_disabled) {
+    cql_test_config cfg;
+    cfg.db_config->heavy_hitters_sample_every.set(0);
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        auto check_enabled = [&] (bool enabled) {
+            e.db().invoke_on_all([enabled] (replica::database& db) {
+                BOOST_REQUIRE_EQUAL(db.heavy_hitters().enabled(), enabled);
+                BOOST_REQUIRE_EQUAL(db.data_listeners().exists(&db.heavy_hitters()), enabled);
+            }).get();
+        };
+        auto roll_window = [&] {
+            e.db().invoke_on_all([] (replica::database& db) {
+                db.heavy_hitters().roll_window();
+            }).get();
+        };
+        auto top_writes = [&] {
+            return e.execute_cql("SELECT partition_key FROM system.heavy_hitters "
+                    "WHERE keyspace_name = 'ks' AND table_name = 'hh' AND operation = 'writes' AND rank = 1;").get();
+        };
+
+        // Disabled, the listener isn't installed, and nothing is counted
+        check_enabled(false);
+        e.execute_cql("CREATE TABLE ks.hh (k int PRIMARY KEY, v int);").get();
+        e.execute_cql("INSERT INTO ks.hh (k, v) VALUES (1, 1);").get();
+        roll_window();
+        assert_that(top_writes()).is_rows().is_empty();
+
+        // Enabling it installs the listener
+        e.execute_cql("UPDATE system.config SET value = '1' WHERE name = 'heavy_hitters_sample_every';").get();
+        check_enabled(true);
+        e.execute_cql("INSERT INTO ks.hh (k, v) VALUES (1, 1);").get();
+        roll_window();
+        assert_that(top_writes()).is_rows().with_rows({{utf8_type->decompose("1")}});
+
+        // Disabling it again uninstalls it, and forgets the results
+        e.execute_cql("UPDATE system.config SET value = '0' WHERE name = 'heavy_hitters_sample_every';").get();
+        check_enabled(false);
+        assert_that(top_writes()).is_rows().is_empty();
+    }, std::move(cfg));
+}
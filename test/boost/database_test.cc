@@ -1450,3 +1450,26 @@ SEASTAR_TEST_CASE(mutation_dump_generated_schema_deterministic_id_version) {
 
     return make_ready_future<>();
 }
+
+SEASTAR_TEST_CASE(pending_compactions_stat_follows_flushes) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("CREATE TABLE ks.tbl (pk int PRIMARY KEY, v int) WITH compaction = {'class': 'SizeTieredCompactionStrategy', 'min_threshold': 2};").get();
+        e.db().invoke_on_all([] (replica::database& db) {
+            return db.find_column_family("ks", "tbl").disable_auto_compaction();
+        }).get();
+
+        // Enough partitions per flush for every shard to get an sstable.
+        for (int flush = 0; flush < 4; ++flush) {
+            for (int pk = 0; pk < 64; ++pk) {
+                e.execute_cql(format("INSERT INTO ks.tbl (pk, v) VALUES ({}, {});", pk, flush)).get();
+            }
+            replica::database::flush_table_on_all_shards(e.db(), "ks", "tbl").get();
+        }
+
+        e.db().invoke_on_all([] (replica::database& db) {
+            auto& t = db.find_column_family("ks", "tbl");
+            BOOST_REQUIRE_GT(t.get_stats().pending_compactions, 0);
+            BOOST_REQUIRE_EQUAL(t.get_stats().pending_compactions, t.estimate_pending_compactions());
+        }).get();
+    });
+}
@@ -638,3 +638,39 @@ SEASTAR_THREAD_TEST_CASE(test_size_tracked_region_move_assign) {
     r1 = std::move(r0);
     r1.allocator().free(std::exchange(p, nullptr));
 }
+
+SEASTAR_THREAD_TEST_CASE(test_flush_candidate_score) {
+    using namespace std::chrono_literals;
+    using candidate = dirty_memory_manager::flush_candidate;
+    const std::chrono::duration<double> horizon = 1s;
+
+    auto score = [&] (size_t size, std::chrono::duration<double> age, int64_t pending_compactions = 0) {
+        return dirty_memory_manager::flush_candidate_score(candidate{
+            .size = size,
+            .age = age,
+            .pending_compactions = pending_compactions,
+        }, horizon);
+    };
+
+    // With equal age, larger memtables are preferred.
+    BOOST_REQUIRE_GT(score(2 << 20, 10s), score(1 << 20, 10s));
+
+    // A memtable which is only slightly larger, but fills up much faster,
+    // is expected to grow further and shouldn't be flushed first.
+    BOOST_REQUIRE_GT(score(1 << 20, 100s), score(3 << 19, 100ms));
+
+    // But a much larger memtable still wins regardless of its write rate.
+    BOOST_REQUIRE_GT(score(64 << 20, 100ms), score(1 << 20, 100s));
+
+    // Compaction backlog boosts the score, by at most twice.
+    BOOST_REQUIRE_GT(score(1 << 20, 10s, 4), score(1 << 20, 10s));
+    BOOST_REQUIRE_EQUAL(score(1 << 20, 10s, 16), score(1 << 20, 10s, 1000));
+    BOOST_REQUIRE_EQUAL(score(1 << 20, 10s, 16), score(1 << 20, 10s) * 2);
+
+    // So a table with compaction debt is flushed before a slightly larger
+    // table without any.
+    BOOST_REQUIRE_GT(score(1 << 20, 10s, 8), score(9 << 17, 10s));
+
+    // Empty memtables are never worth flushing.
+    BOOST_REQUIRE_EQUAL(score(0, 10s), 0);
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+
+#define BOOST_TEST_MODULE core
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <random>
+
+#include "utils/iblt.hh"
+
+namespace {
+
+std::vector<uint64_t> random_keys(std::mt19937_64& rng, size_t n) {
+    std::vector<uint64_t> keys(n);
+    for (auto& k : keys) {
+        k = rng();
+    }
+    return keys;
+}
+
+utils::iblt make_iblt(size_t nr_cells, const std::vector<uint64_t>& keys) {
+    utils::iblt t(nr_cells);
+    for (auto k : keys) {
+        t.insert(k);
+    }
+    return t;
+}
+
+std::vector<uint64_t> sorted(std::vector<uint64_t> v) {
+    std::sort(v.begin(), v.end());
+    return v;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(test_size_is_rounded_up) {
+    BOOST_REQUIRE_EQUAL(utils::iblt(0).size(), utils::iblt::nr_hashes);
+    BOOST_REQUIRE_EQUAL(utils::iblt(100).size(), 102);
+    BOOST_REQUIRE_THROW(utils::iblt(std::vector<utils::iblt_cell>(100)), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(test_identical_sets) {
+    std::mt19937_64 rng(0);
+    auto keys = random_keys(rng, 10000);
+    auto a = make_iblt(30, keys);
+    a.subtract(make_iblt(30, keys));
+    auto diff = std::move(a).decode();
+    BOOST_REQUIRE(diff);
+    BOOST_REQUIRE(diff->added.empty());
+    BOOST_REQUIRE(diff->removed.empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_small_difference_of_large_sets) {
+    std::mt19937_64 rng(1);
+    auto common = random_keys(rng, 100000);
+    auto only_a = random_keys(rng, 40);
+    auto only_b = random_keys(rng, 20);
+
+    auto a = make_iblt(600, common);
+    auto b = make_iblt(600, common);
+    for (auto k : only_a) {
+        a.insert(k);
+    }
+    for (auto k : only_b) {
+        b.insert(k);
+    }
+    // Tables travel over the wire as their cells.
+    utils::iblt received(b.cells());
+    a.subtract(received);
+
+    auto diff = std::move(a).decode();
+    BOOST_REQUIRE(diff);
+    BOOST_REQUIRE(sorted(diff->added) == sorted(only_a));
+    BOOST_REQUIRE(sorted(diff->removed) == sorted(only_b));
+}
+
+BOOST_AUTO_TEST_CASE(test_too_large_difference) {
+    std::mt19937_64 rng(2);
+    auto a = make_iblt(30, random_keys(rng, 1000));
+    a.subtract(make_iblt(30, random_keys(rng, 1000)));
+    BOOST_REQUIRE(!std::move(a).decode());
+
+    utils::iblt b(30);
+    BOOST_REQUIRE_THROW(b.subtract(utils::iblt(60)), std::invalid_argument);
+}
@@ -1140,4 +1140,73 @@ SEASTAR_THREAD_TEST_CASE(test_buf_alloc_compaction) {
     }
 }
 
+SEASTAR_THREAD_TEST_CASE(test_segment_placement_keeps_memory_reclaimable) {
+    prime_segment_pool(memory::stats().total_memory(), memory::min_free_memory()).get();
+
+    region reg1;
+    region reg2;
+    std::vector<managed_bytes> allocated1;
+    std::vector<managed_bytes> allocated2;
+
+    auto clean_up = defer([&] () noexcept {
+        with_allocator(reg1.allocator(), [&] {
+            allocated1.clear();
+        });
+        with_allocator(reg2.allocator(), [&] {
+            allocated2.clear();
+        });
+    });
+
+    const size_t object_size = 4096;
+    const size_t objects_per_segment = segment_size / object_size;
+    const size_t segments = 256;
+
+    // Interleave the segments of the two regions, then free those of the
+    // second one, so that free segments are spread among those of the first.
+    for (size_t i = 0; i < segments; ++i) {
+        auto& reg = i % 2 ? reg2 : reg1;
+        auto& allocated = i % 2 ? allocated2 : allocated1;
+        with_allocator(reg.allocator(), [&] {
+            for (size_t j = 0; j < objects_per_segment; ++j) {
+                allocated.emplace_back(managed_bytes(managed_bytes::initialized_later(), object_size));
+            }
+        });
+    }
+    with_allocator(reg2.allocator(), [&] {
+        allocated2.clear();
+    });
+
+    // New segments of the first region are placed near its previous ones
+    // where allowed, or at the highest address otherwise.
+    auto before = shard_tracker().statistics();
+    with_allocator(reg1.allocator(), [&] {
+        for (size_t i = 0; i < segments / 2 * objects_per_segment; ++i) {
+            allocated1.emplace_back(managed_bytes(managed_bytes::initialized_later(), object_size));
+        }
+    });
+    auto after = shard_tracker().statistics();
+    auto local = after.huge_page_local_segment_allocations - before.huge_page_local_segment_allocations;
+    testlog.info("huge page local segment allocations: {}, remote: {}", local,
+            after.huge_page_remote_segment_allocations - before.huge_page_remote_segment_allocations);
+    // The free segments of the second region share huge pages with those of
+    // the first one, so some new segments must have been placed next to them.
+    BOOST_REQUIRE_GT(local, 0);
+
+    // Placement doesn't prevent reclaiming memory freed by the region: its
+    // sparse segments, including the placed ones, are compacted and released
+    // to the standard allocator.
+    size_t quarter = shard_tracker().region_occupancy().total_space() / 4;
+    shard_tracker().reclaim_all_free_segments();
+    auto& random = seastar::testing::local_random_engine;
+    std::shuffle(allocated1.begin(), allocated1.end(), random);
+    with_allocator(reg1.allocator(), [&] {
+        allocated1.resize(allocated1.size() * 0.35);
+    });
+    auto total_space_before_reclaim = reg1.occupancy().total_space();
+    auto free_memory_before_reclaim = memory::stats().free_memory();
+    BOOST_REQUIRE(shard_tracker().reclaim(quarter) >= quarter);
+    BOOST_REQUIRE_LE(reg1.occupancy().total_space() + quarter, total_space_before_reclaim);
+    BOOST_REQUIRE_GE(memory::stats().free_memory(), free_memory_before_reclaim + quarter);
+}
+
 #endif
@@ -2540,6 +2540,75 @@ SEASTAR_THREAD_TEST_CASE(test_cell_equals) {
     BOOST_REQUIRE(!c4.equals(*bytes_type, c1));
 }
 
+SEASTAR_THREAD_TEST_CASE(test_compact_cell_layout) {
+    auto now = gc_clock::now();
+    auto value = long_type->decompose(int64_t(0x0102030405060708));
+    auto check = [&] (api::timestamp_type ts) {
+        auto c = atomic_cell::make_live(*long_type, ts, value);
+        BOOST_REQUIRE(c.is_live());
+        BOOST_REQUIRE(!c.is_live_and_has_ttl());
+        BOOST_REQUIRE(!c.is_counter_update());
+        BOOST_REQUIRE_EQUAL(c.timestamp(), ts);
+        BOOST_REQUIRE(atomic_cell_view(c).value() == managed_bytes_view(bytes_view(value)));
+        BOOST_REQUIRE_EQUAL(c.value_size(), value.size());
+
+        // Copies preserve the layout.
+        auto expiring = atomic_cell::make_live(*long_type, ts, value, now, gc_clock::duration(1));
+        BOOST_REQUIRE(compare_atomic_cell_for_merge(c, expiring) < 0);
+        auto copy = atomic_cell_or_collection(*long_type, c);
+        BOOST_REQUIRE(copy.equals(*long_type, atomic_cell_or_collection(atomic_cell(*long_type, c))));
+        return c;
+    };
+
+    check(0);
+    check(1);
+    check(api::new_timestamp());
+    check((api::timestamp_type(1) << 48) - 1);
+    check(api::timestamp_type(1) << 48);
+    check((api::timestamp_type(1) << 51) - 1);
+    // Timestamps which don't fit use the regular layout.
+    check(api::timestamp_type(1) << 51);
+    check(-1);
+    check(api::min_timestamp);
+    check(api::max_timestamp);
+
+    auto c = check(api::timestamp_type(0x0006112233445566));
+    c.set_timestamp(0x0001aabbccddeeff);
+    BOOST_REQUIRE_EQUAL(c.timestamp(), 0x0001aabbccddeeff);
+    BOOST_REQUIRE(atomic_cell_view(c).value() == managed_bytes_view(bytes_view(value)));
+
+    // Timestamps which don't fit the compact layout re-encode the cell.
+    auto s = schema_builder("ks", "cf")
+            .with_column("pk", int32_type, column_kind::partition_key)
+            .with_column("v", long_type)
+            .build();
+    auto& v_def = *s->get_column_definition("v");
+    BOOST_REQUIRE(!c.can_set_timestamp(api::min_timestamp));
+    auto acoc = atomic_cell_or_collection(std::move(c));
+    acoc.set_timestamp(v_def, api::min_timestamp);
+    auto reencoded = acoc.as_atomic_cell(v_def);
+    BOOST_REQUIRE_EQUAL(reencoded.timestamp(), api::min_timestamp);
+    BOOST_REQUIRE(reencoded.is_live());
+    BOOST_REQUIRE(reencoded.value() == managed_bytes_view(bytes_view(value)));
+    acoc.set_timestamp(v_def, 1);
+    BOOST_REQUIRE_EQUAL(acoc.as_atomic_cell(v_def).timestamp(), 1);
+
+    // Empty values, like counter cells without shards, can take any timestamp in place.
+    auto empty = atomic_cell::make_live(*counter_type, 1, bytes_view());
+    BOOST_REQUIRE(empty.can_set_timestamp(api::min_timestamp));
+    empty.set_timestamp(api::min_timestamp);
+    BOOST_REQUIRE_EQUAL(empty.timestamp(), api::min_timestamp);
+
+    // 8-byte values with a regular timestamp fit in managed_bytes' inline storage.
+    measuring_allocator alloc;
+    with_allocator(alloc, [&] {
+        auto before = alloc.allocated_bytes();
+        auto ac = atomic_cell_or_collection(atomic_cell::make_live(*long_type, api::new_timestamp(), value));
+        BOOST_REQUIRE_EQUAL(alloc.allocated_bytes(), before);
+        BOOST_REQUIRE_EQUAL(ac.external_memory_usage(*long_type), size_t(0));
+    });
+}
+
 // Global to avoid elimination by the compiler; see below for use
 thread_local data_type force_type_thread_local_init_evaluation [[gnu::used]];
 
@@ -2009,3 +2009,88 @@ SEASTAR_THREAD_TEST_CASE(test_reader_concurrency_semaphore_live_update_count) {
 
     BOOST_REQUIRE_EQUAL(semaphore.initial_resources(), reader_resources(count(), initial_memory));
 }
+
+// Check that cheap reads overtake queued expensive ones and that a zero aging
+// period restores FIFO admission.
+SEASTAR_THREAD_TEST_CASE(test_reader_concurrency_semaphore_admission_classes) {
+    using admission_class = reader_concurrency_semaphore::admission_class;
+    using read_kind = reader_cost_estimate::read_kind;
+
+    const auto cheap_cost = reader_cost_estimate{.kind = read_kind::single_partition, .sstables = 1};
+    const auto range_cost = reader_cost_estimate{.kind = read_kind::range_scan, .sstables = 1};
+
+    BOOST_REQUIRE(reader_concurrency_semaphore::classify_read(cheap_cost, 1024) == admission_class::cheap);
+    BOOST_REQUIRE(reader_concurrency_semaphore::classify_read({}, 1024) == admission_class::normal);
+    BOOST_REQUIRE(reader_concurrency_semaphore::classify_read(range_cost, 1024) == admission_class::expensive);
+    BOOST_REQUIRE(reader_concurrency_semaphore::classify_read({.kind = read_kind::single_partition, .sstables = 100}, 1024) == admission_class::normal);
+    BOOST_REQUIRE(reader_concurrency_semaphore::classify_read(cheap_cost, reader_concurrency_semaphore::min_expensive_read_memory) == admission_class::expensive);
+    BOOST_REQUIRE(reader_concurrency_semaphore::classify_read({.kind = read_kind::single_partition, .sstables = 1,
+            .memory = reader_concurrency_semaphore::min_expensive_read_memory}, 1024) == admission_class::expensive);
+
+    reader_concurrency_semaphore semaphore(reader_concurrency_semaphore::for_tests{}, get_name(), 1);
+    auto stop_sem = deferred_stop(semaphore);
+    semaphore.set_admission_aging_period(std::chrono::hours(1));
+
+    {
+        auto permit = std::optional(semaphore.obtain_permit(nullptr, get_name(), 1024, db::no_timeout, {}).get());
+
+        auto expensive_fut = semaphore.obtain_permit(nullptr, get_name(), 1024, db::no_timeout, {}, [&] { return range_cost; });
+        auto normal_fut = semaphore.obtain_permit(nullptr, get_name(), 1024, db::no_timeout, {});
+        auto cheap_fut = semaphore.obtain_permit(nullptr, get_name(), 1024, db::no_timeout, {}, [&] { return cheap_cost; });
+        BOOST_REQUIRE_EQUAL(semaphore.get_stats().waiters, 3);
+
+        permit.reset();
+        BOOST_REQUIRE(cheap_fut.available());
+        BOOST_REQUIRE(!normal_fut.available());
+        BOOST_REQUIRE(!expensive_fut.available());
+
+        cheap_fut.get();
+        BOOST_REQUIRE(normal_fut.available());
+        BOOST_REQUIRE(!expensive_fut.available());
+
+        normal_fut.get();
+        BOOST_REQUIRE(expensive_fut.available());
+        expensive_fut.get();
+
+        const auto& stats = semaphore.get_stats();
+        BOOST_REQUIRE_EQUAL(stats.reads_admitted_from_queue[size_t(admission_class::cheap)], 1);
+        BOOST_REQUIRE_EQUAL(stats.reads_admitted_from_queue[size_t(admission_class::normal)], 1);
+        BOOST_REQUIRE_EQUAL(stats.reads_admitted_from_queue[size_t(admission_class::expensive)], 1);
+    }
+
+    semaphore.set_admission_aging_period(db::timeout_clock::duration::zero());
+
+    {
+        auto permit = std::optional(semaphore.obtain_permit(nullptr, get_name(), 1024, db::no_timeout, {}).get());
+
+        auto expensive_fut = semaphore.obtain_permit(nullptr, get_name(), 1024, db::no_timeout, {}, [&] { return range_cost; });
+        auto cheap_fut = semaphore.obtain_permit(nullptr, get_name(), 1024, db::no_timeout, {}, [&] { return cheap_cost; });
+
+        permit.reset();
+        BOOST_REQUIRE(expensive_fut.available());
+        BOOST_REQUIRE(!cheap_fut.available());
+
+        expensive_fut.get();
+        BOOST_REQUIRE(cheap_fut.available());
+        cheap_fut.get();
+    }
+
+    // The cost is only estimated for reads which have to wait for admission.
+    {
+        unsigned estimates = 0;
+        auto estimator = [&] {
+            ++estimates;
+            return cheap_cost;
+        };
+
+        auto permit = std::optional(semaphore.obtain_permit(nullptr, get_name(), 1024, db::no_timeout, {}, estimator).get());
+        BOOST_REQUIRE_EQUAL(estimates, 0);
+
+        auto queued_fut = semaphore.obtain_permit(nullptr, get_name(), 1024, db::no_timeout, {}, estimator);
+        BOOST_REQUIRE_EQUAL(estimates, 1);
+
+        permit.reset();
+        queued_fut.get();
+        BOOST_REQUIRE_EQUAL(estimates, 1);
+    }
+}
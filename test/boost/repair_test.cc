@@ -13,6 +13,8 @@
 #include "repair/writer.hh"
 #include "repair/reader.hh"
 #include "repair/row_level.hh"
+#include "repair/background_repair.hh"
+#include "compaction/compaction_manager.hh"
 #include "test/lib/mutation_source_test.hh"
 #include "test/lib/random_utils.hh"
 #include "test/lib/cql_test_env.hh"
@@ -267,3 +269,73 @@ SEASTAR_TEST_CASE(repair_rows_size_considers_external_memory) {
         BOOST_REQUIRE_EQUAL(row_with_boundary.size(), fmf_size + boundary.pk.external_memory_usage() + boundary.position.external_memory_usage() + sizeof(repair_row));
     });
 }
+
+SEASTAR_THREAD_TEST_CASE(test_background_repair_duty_cycle) {
+    using scheduler = repair::background_repair_scheduler;
+    const auto target = std::chrono::milliseconds(10);
+
+    // Foreground latency above the target halves the duty cycle, down to a floor.
+    BOOST_REQUIRE_EQUAL(scheduler::next_duty_cycle(0.5, std::chrono::milliseconds(20), target, false), 0.25);
+    BOOST_REQUIRE_EQUAL(scheduler::next_duty_cycle(0.02, std::chrono::milliseconds(20), target, false), 0.02);
+
+    // Latency within the target increases it, up to 1.
+    BOOST_REQUIRE_CLOSE(scheduler::next_duty_cycle(0.5, std::chrono::milliseconds(5), target, false), 0.55, 1e-6);
+    BOOST_REQUIRE_EQUAL(scheduler::next_duty_cycle(0.98, std::chrono::milliseconds(5), target, false), 1);
+
+    // Urgent tablets, and no target at all, run repair without pausing.
+    BOOST_REQUIRE_EQUAL(scheduler::next_duty_cycle(0.1, std::chrono::milliseconds(20), target, true), 1);
+    BOOST_REQUIRE_EQUAL(scheduler::next_duty_cycle(0.1, std::chrono::milliseconds(20), std::chrono::milliseconds::zero(), false), 1);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_background_repair_schedule_tablet) {
+    using scheduler = repair::background_repair_scheduler;
+    const auto gc_grace = gc_clock::duration(std::chrono::hours(8));
+    const auto now = gc_clock::now();
+
+    // Never repaired tablets are due right away.
+    auto sched = scheduler::schedule_tablet(std::nullopt, gc_grace, now, std::nullopt);
+    BOOST_REQUIRE(sched.due == now);
+    BOOST_REQUIRE(!sched.urgent);
+
+    // Repaired tablets are due half of gc_grace after their last repair.
+    sched = scheduler::schedule_tablet(now - std::chrono::hours(1), gc_grace, now, std::nullopt);
+    BOOST_REQUIRE(sched.due == now + std::chrono::hours(3));
+    BOOST_REQUIRE(!sched.urgent);
+
+    // Overdue tablets come before the ones which were never repaired.
+    sched = scheduler::schedule_tablet(now - std::chrono::hours(5), gc_grace, now, std::nullopt);
+    BOOST_REQUIRE(sched.due < now);
+    BOOST_REQUIRE(!sched.urgent);
+
+    // Tablets past three quarters of gc_grace are urgent.
+    sched = scheduler::schedule_tablet(now - std::chrono::hours(7), gc_grace, now, std::nullopt);
+    BOOST_REQUIRE(sched.urgent);
+
+    // A failed repair pushes the tablet back, but it stays urgent.
+    sched = scheduler::schedule_tablet(now - std::chrono::hours(7), gc_grace, now, now + std::chrono::minutes(10));
+    BOOST_REQUIRE(sched.due == now + std::chrono::minutes(10));
+    BOOST_REQUIRE(sched.urgent);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_repair_time_for_range) {
+    per_table_history_maps maps;
+    tombstone_gc_state gc_state(&maps);
+    auto id = table_id::create_random_id();
+    auto range = [] (int64_t start, int64_t end) {
+        return dht::token_range::make({dht::token::from_int64(start), false}, {dht::token::from_int64(end), true});
+    };
+    const auto t1 = gc_clock::now() - std::chrono::hours(2);
+    const auto t2 = gc_clock::now() - std::chrono::hours(1);
+
+    BOOST_REQUIRE(!gc_state.get_repair_time_for_range(id, range(0, 200)));
+
+    gc_state.update_repair_time(id, range(0, 100), t1);
+    BOOST_REQUIRE(gc_state.get_repair_time_for_range(id, range(0, 100)) == t1);
+    BOOST_REQUIRE(gc_state.get_repair_time_for_range(id, range(50, 100)) == t1);
+    // Half of the range was never repaired.
+    BOOST_REQUIRE(!gc_state.get_repair_time_for_range(id, range(0, 200)));
+
+    gc_state.update_repair_time(id, range(100, 200), t2);
+    BOOST_REQUIRE(gc_state.get_repair_time_for_range(id, range(0, 200)) == t1);
+    BOOST_REQUIRE(gc_state.get_repair_time_for_range(id, range(100, 200)) == t2);
+}
@@ -4629,8 +4629,7 @@ SEASTAR_TEST_CASE(test_compact_range_tombstones_on_read) {
             row.cells().for_each_cell([&] (column_id id, atomic_cell_or_collection& cell) {
                 const column_definition& def = s.schema()->column_at(column_kind::clustering_key, id);
 
-                auto cell_view = cell.as_mutable_atomic_cell(def);
-                cell_view.set_timestamp(api::min_timestamp);
+                cell.set_timestamp(def, api::min_timestamp);
             });
         };
 
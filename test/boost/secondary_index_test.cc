@@ -7,6 +7,7 @@
  */
 
 #include <seastar/core/coroutine.hh>
+#include "db/config.hh"
 #include "test/lib/cql_test_env.hh"
 #include "test/lib/cql_assertions.hh"
 #include "test/lib/eventually.hh"
@@ -1984,3 +1985,64 @@ SEASTAR_TEST_CASE(test_returning_failure_from_ghost_rows_deletion) {
         }
     });
 }
+
+SEASTAR_TEST_CASE(test_sstable_index_is_experimental) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        BOOST_REQUIRE_THROW(e.execute_cql("CREATE TABLE t (p int PRIMARY KEY, v int) WITH sstable_index = {'columns': 'v'}").get(),
+                exceptions::configuration_exception);
+    });
+}
+
+SEASTAR_TEST_CASE(test_sstable_index) {
+    auto db_cfg_ptr = make_shared<db::config>();
+    db_cfg_ptr->experimental_features({db::experimental_features_t::feature::SSTABLE_INDEX}, db::config::config_source::CommandLine);
+    // Small blocks, so that a partition of a few hundred rows is indexed in
+    // several of them.
+    db_cfg_ptr->column_index_size_in_kb(1);
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        cquery_nofail(e, "CREATE TABLE t (p int, c int, v int, w int, PRIMARY KEY (p, c)) WITH sstable_index = {'columns': 'v'}");
+        for (int c = 0; c < 10; ++c) {
+            cquery_nofail(e, format("INSERT INTO t (p, c, v, w) VALUES (1, {}, {}, {})", c, c % 3, c));
+        }
+        for (int c = 0; c < 300; ++c) {
+            cquery_nofail(e, format("INSERT INTO t (p, c, v, w) VALUES (2, {}, {}, {})", c, c % 3, c));
+        }
+        auto& t = e.local_db().find_column_family("ks", "t");
+        t.flush().get();
+        // Writes newer than the sstable aren't in its index.
+        cquery_nofail(e, "INSERT INTO t (p, c, v, w) VALUES (1, 10, 1, 0)");
+        cquery_nofail(e, "UPDATE t SET v = 2 WHERE p = 1 AND c = 1");
+        cquery_nofail(e, "DELETE FROM t WHERE p = 1 AND c = 4");
+
+        auto s = t.schema();
+        auto find = [&] (const char* column, int32_t value, int32_t p = 1) -> std::optional<std::vector<int32_t>> {
+            auto dk = dht::decorate_key(*s, partition_key::from_singular(*s, p));
+            auto permit = e.local_db().get_reader_concurrency_semaphore().make_tracking_only_permit(s, "test", db::no_timeout, {});
+            auto rows = t.find_rows_by_column_value(permit, dk, *s->get_column_definition(to_bytes(column)), int32_type->decompose(value)).get();
+            if (!rows) {
+                return std::nullopt;
+            }
+            std::vector<int32_t> cs;
+            for (auto& ck : *rows) {
+                cs.push_back(value_cast<int32_t>(int32_type->deserialize(ck.explode(*s).front())));
+            }
+            return cs;
+        };
+        BOOST_REQUIRE(find("v", 0) == std::vector<int32_t>({0, 3, 6, 9}));
+        BOOST_REQUIRE(find("v", 1) == std::vector<int32_t>({7, 10}));
+        BOOST_REQUIRE(find("v", 2) == std::vector<int32_t>({1, 2, 5, 8}));
+        BOOST_REQUIRE(find("v", 3) == std::vector<int32_t>());
+        BOOST_REQUIRE(!find("w", 0));
+
+        std::vector<int32_t> expected;
+        for (int c = 1; c < 300; c += 3) {
+            expected.push_back(c);
+        }
+        BOOST_REQUIRE(find("v", 1, 2) == expected);
+
+        BOOST_REQUIRE_THROW(e.execute_cql("CREATE TABLE t2 (p int PRIMARY KEY, v int) WITH sstable_index = {'columns': 'x'}").get(),
+                exceptions::invalid_request_exception);
+        BOOST_REQUIRE_THROW(e.execute_cql("CREATE TABLE t2 (p int PRIMARY KEY, v int) WITH sstable_index = {'rows': 'v'}").get(),
+                exceptions::configuration_exception);
+    }, db_cfg_ptr);
+}
@@ -1674,6 +1674,53 @@ SEASTAR_TEST_CASE(size_tiered_beyond_max_threshold_test) {
   });
 }
 
+SEASTAR_TEST_CASE(repaired_and_unrepaired_sstables_are_compacted_apart) {
+  return test_env::do_with_async([] (test_env& env) {
+    simple_schema ss;
+    auto s = ss.schema();
+    auto cf = env.make_table_for_tests(s);
+    auto close_cf = deferred_stop(cf);
+    cf->set_compaction_strategy(sstables::compaction_strategy_type::size_tiered);
+    auto sst_gen = cf.make_sst_factory();
+    auto cs = sstables::make_compaction_strategy(sstables::compaction_strategy_type::size_tiered, s->compaction_strategy_options());
+
+    // Enough sstables of similar size for size-tiered to compact them all
+    // together, if it weren't for half of them being repaired.
+    const auto keys = tests::generate_partition_keys(2 * s->min_compaction_threshold(), s);
+    std::vector<shared_sstable> repaired, unrepaired;
+    for (size_t i = 0; i < keys.size(); i++) {
+        mutation m(s, keys[i]);
+        ss.add_row(m, ss.make_ckey(0), "v");
+        auto sst = make_sstable_containing(sst_gen, {std::move(m)});
+        if (i % 2) {
+            sst->mutate_repaired_at(i).get();
+            repaired.push_back(sst);
+        } else {
+            unrepaired.push_back(sst);
+        }
+        column_family_test(cf).add_sstable(sst).get();
+    }
+
+    auto control = make_strategy_control_for_test(false);
+    auto desc = cs.get_sstables_for_compaction(cf.as_table_state(), *control);
+    BOOST_REQUIRE_EQUAL(desc.sstables.size(), unrepaired.size());
+    BOOST_REQUIRE(std::ranges::none_of(desc.sstables, std::mem_fn(&sstable::is_repaired)));
+
+    // Without unrepaired candidates, the repaired ones are compacted.
+    control = make_strategy_control_for_test(false, repaired);
+    desc = cs.get_sstables_for_compaction(cf.as_table_state(), *control);
+    BOOST_REQUIRE_EQUAL(desc.sstables.size(), repaired.size());
+
+    // The output of compaction is as repaired as its least repaired input.
+    auto ret = compact_sstables(env, sstables::compaction_descriptor(repaired), cf, sst_gen).get();
+    BOOST_REQUIRE_EQUAL(ret.new_sstables.size(), 1);
+    BOOST_REQUIRE_EQUAL(ret.new_sstables.front()->get_repaired_at(), 1);
+    ret = compact_sstables(env, sstables::compaction_descriptor({repaired.front(), unrepaired.front()}), cf, sst_gen).get();
+    BOOST_REQUIRE_EQUAL(ret.new_sstables.size(), 1);
+    BOOST_REQUIRE(!ret.new_sstables.front()->is_repaired());
+  });
+}
+
 SEASTAR_TEST_CASE(sstable_expired_data_ratio) {
     return test_env::do_with_async([] (test_env& env) {
         auto make_schema = [&] (std::string_view cf, sstables::compaction_strategy_type cst) {
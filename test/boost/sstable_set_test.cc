@@ -167,3 +167,60 @@ SEASTAR_TEST_CASE(test_partitioned_sstable_set_bytes_on_disk) {
         BOOST_REQUIRE_EQUAL(sst_set->bytes_on_disk(), ss1->bytes_on_disk() + ss2->bytes_on_disk());
     });
 }
+
+SEASTAR_TEST_CASE(test_partitioned_sstable_set_leveled_select) {
+    return test_env::do_with_async([] (test_env& env) {
+        simple_schema ss;
+        auto s = ss.schema();
+        auto keys = tests::generate_partition_keys(10, s);
+
+        auto make_sst = [&] (size_t first, size_t last, uint32_t level) {
+            auto sst = env.make_sstable(s);
+            sstables::test(sst).set_values_for_leveled_strategy(1 /* data_size */, level, 0 /* max_timestamp */, keys[first].key(), keys[last].key());
+            return sst;
+        };
+
+        auto l0 = make_sst(0, 9, 0);
+        auto a = make_sst(0, 2, 1);
+        auto b = make_sst(3, 5, 1);
+        auto c = make_sst(6, 9, 1);
+        auto d = make_sst(1, 4, 2);
+
+        auto ss1 = make_lw_shared<sstable_set>(std::make_unique<partitioned_sstable_set>(s, true));
+        for (auto& sst : {l0, a, b, c, d}) {
+            ss1->insert(sst);
+        }
+
+        auto check = [] (const sstable_set& set, const dht::partition_range& pr, std::unordered_set<shared_sstable> expected) {
+            auto ssts = set.select(pr);
+            BOOST_REQUIRE_EQUAL(ssts.size(), expected.size());
+            for (auto& sst : ssts) {
+                BOOST_REQUIRE(expected.erase(sst));
+            }
+        };
+
+        check(*ss1, dht::partition_range::make_singular(keys[1]), {l0, a, d});
+        check(*ss1, dht::partition_range::make_singular(keys[5]), {l0, b});
+        check(*ss1, dht::partition_range::make({keys[2], true}, {keys[3], true}), {l0, a, b, d});
+        check(*ss1, dht::partition_range::make({keys[2], false}, {keys[3], false}), {l0, d});
+        check(*ss1, dht::partition_range::make_open_ended_both_sides(), {l0, a, b, c, d});
+
+        // Clones share lanes until they are modified.
+        auto ss2 = make_lw_shared<sstable_set>(*ss1);
+        ss2->erase(b);
+        check(*ss1, dht::partition_range::make_singular(keys[5]), {l0, b});
+        check(*ss2, dht::partition_range::make_singular(keys[5]), {l0});
+
+        auto sel = ss1->make_incremental_selector();
+        {
+            auto selection = sel.select(dht::ring_position_view(keys[0]));
+            BOOST_REQUIRE_EQUAL(selection.sstables.size(), 2);
+            BOOST_REQUIRE(dht::ring_position_tri_compare(*s, selection.next_position, dht::ring_position_view(keys[1])) == 0);
+        }
+        {
+            auto selection = sel.select(dht::ring_position_view(keys[5]));
+            BOOST_REQUIRE_EQUAL(selection.sstables.size(), 2);
+            BOOST_REQUIRE(dht::ring_position_tri_compare(*s, selection.next_position, dht::ring_position_view::for_after_key(keys[5])) == 0);
+        }
+    });
+}
@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <seastar/core/fstream.hh>
+#include <seastar/core/seastar.hh>
+#include <seastar/util/closeable.hh>
+#include <seastar/util/defer.hh>
+
+#include "test/lib/scylla_test_case.hh"
+#include "test/lib/cql_test_env.hh"
+#include "test/lib/cql_assertions.hh"
+#include "streaming/stream_manager.hh"
+#include "replica/database.hh"
+#include "sstables/sstables.hh"
+#include "utils/UUID_gen.hh"
+#include "utils/lister.hh"
+
+static void copy_file(file from, sstring to) {
+    auto in = make_file_input_stream(std::move(from));
+    auto close_in = deferred_close(in);
+    auto out = make_file_output_stream(open_file_dma(to, open_flags::wo | open_flags::create | open_flags::truncate).get()).get();
+    std::exception_ptr ex;
+    try {
+        copy(in, out).get();
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    out.close().get();
+    if (ex) {
+        std::rethrow_exception(std::move(ex));
+    }
+}
+
+// Writes the sstables of `from` as the files of `to` received by ops_id,
+// the way stream_manager::receive_file() does, without going through rpc.
+static void receive_sstables(streaming::stream_manager& sm, replica::table& from, replica::table& to, streaming::plan_id ops_id) {
+    auto snapshot = from.take_storage_snapshot(dht::token_range::make_open_ended_both_sides()).get();
+    auto s = from.schema();
+    for (auto& ssf : snapshot) {
+        // The TOC goes last.
+        auto toc = std::move(ssf.files.at(sstables::component_type::TOC));
+        ssf.files.erase(sstables::component_type::TOC);
+        std::vector<std::pair<sstables::component_type, file>> files(std::make_move_iterator(ssf.files.begin()), std::make_move_iterator(ssf.files.end()));
+        files.emplace_back(sstables::component_type::TOC, std::move(toc));
+        ssf.files.clear();
+
+        for (auto& [component, f] : files) {
+            auto desc = sstables::parse_path(std::filesystem::path(ssf.sst->component_basename(component)), s->ks_name(), s->cf_name());
+            auto target = sm.add_received_file(ops_id, to.schema()->id(), desc);
+            auto release = defer([&] { sm.release_received_file(ops_id); });
+            if (target.new_sstable) {
+                open_file_dma(target.temporary_toc, open_flags::wo | open_flags::create | open_flags::truncate).get().close().get();
+            }
+            const bool is_toc = component == sstables::component_type::TOC;
+            copy_file(std::move(f), is_toc ? target.temporary_toc : target.path);
+            if (is_toc) {
+                rename_file(target.temporary_toc, target.path).get();
+            }
+        }
+    }
+}
+
+SEASTAR_TEST_CASE(test_attach_received_sstables) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("create table src (p int primary key, v int)").get();
+        e.execute_cql("create table dst (p int primary key, v int)").get();
+        for (int i = 0; i < 100; ++i) {
+            e.execute_cql(format("insert into src (p, v) values ({}, {})", i, i)).get();
+        }
+        auto& src = e.local_db().find_column_family("ks", "src");
+        auto& dst = e.local_db().find_column_family("ks", "dst");
+        src.flush().get();
+
+        auto& sm = e.get_stream_manager().local();
+        auto ops_id = streaming::plan_id{utils::make_random_uuid()};
+        receive_sstables(sm, src, dst, ops_id);
+        BOOST_REQUIRE_EQUAL(dst.sstables_count(), 0);
+
+        sm.attach_received_sstables(ops_id).get();
+        BOOST_REQUIRE_EQUAL(dst.sstables_count(), src.sstables_count());
+        auto msg = e.execute_cql("select count(*) from dst").get();
+        assert_that(msg).is_rows().with_rows({{{long_type->decompose(int64_t(100))}}});
+    });
+}
+
+SEASTAR_TEST_CASE(test_discard_received_sstables) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("create table src (p int primary key, v int)").get();
+        e.execute_cql("create table dst (p int primary key, v int)").get();
+        for (int i = 0; i < 100; ++i) {
+            e.execute_cql(format("insert into src (p, v) values ({}, {})", i, i)).get();
+        }
+        auto& src = e.local_db().find_column_family("ks", "src");
+        auto& dst = e.local_db().find_column_family("ks", "dst");
+        src.flush().get();
+
+        auto& sm = e.get_stream_manager().local();
+        auto ops_id = streaming::plan_id{utils::make_random_uuid()};
+        receive_sstables(sm, src, dst, ops_id);
+
+        // A file which is still being received when the operation fails.
+        auto desc = sstables::entry_descriptor(dst.calculate_generation_for_new_table(), sstables::sstable_version_types::me,
+                sstables::sstable_format_types::big, sstables::component_type::Data);
+        auto target = sm.add_received_file(ops_id, dst.schema()->id(), desc);
+
+        // Discarding waits for it to be written before removing it, and
+        // refuses files arriving in the meantime.
+        auto discarded = sm.discard_received_sstables(ops_id);
+        BOOST_REQUIRE_THROW(sm.add_received_file(ops_id, dst.schema()->id(), desc), seastar::gate_closed_exception);
+        open_file_dma(target.path, open_flags::wo | open_flags::create | open_flags::truncate).get().close().get();
+        BOOST_REQUIRE(!discarded.available());
+        sm.release_received_file(ops_id);
+        discarded.get();
+
+        BOOST_REQUIRE(!file_exists(target.path).get());
+        BOOST_REQUIRE(!file_exists(target.temporary_toc).get());
+        auto files = 0;
+        lister::scan_dir(fs::path(dst.dir()), lister::dir_entry_types::of<directory_entry_type::regular>(), [&files] (fs::path, directory_entry) {
+            ++files;
+            return make_ready_future<>();
+        }).get();
+        BOOST_REQUIRE_EQUAL(files, 0);
+
+        // Nothing is left to attach.
+        sm.attach_received_sstables(ops_id).get();
+        BOOST_REQUIRE_EQUAL(dst.sstables_count(), 0);
+    });
+}
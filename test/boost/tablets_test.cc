@@ -1889,6 +1889,78 @@ SEASTAR_THREAD_TEST_CASE(test_drained_node_is_not_balanced_internally) {
   }).get();
 }
 
+SEASTAR_THREAD_TEST_CASE(test_load_balancing_spreads_hot_tablets_across_shards) {
+    do_with_cql_env_thread([] (auto& e) {
+        inet_address ip1("192.168.0.1");
+
+        auto host1 = host_id(next_uuid());
+
+        auto table1 = table_id(next_uuid());
+
+        unsigned shard_count = 4;
+        const size_t tablet_count = 8;
+
+        semaphore sem(1);
+        shared_token_metadata stm([&sem] () noexcept { return get_units(sem, 1); }, locator::token_metadata::config{
+            locator::topology::config{
+                .this_endpoint = ip1,
+                .local_dc_rack = locator::endpoint_dc_rack::default_location
+            }
+        });
+
+        // Tablets are balanced by count, but the two hot ones share shard 0.
+        stm.mutate_token_metadata([&] (locator::token_metadata& tm) {
+            tm.update_host_id(host1, ip1);
+            tm.update_topology(host1, locator::endpoint_dc_rack::default_location, std::nullopt, shard_count);
+
+            tablet_map tmap(tablet_count);
+            for (auto tid : tmap.tablet_ids()) {
+                tmap.set_tablet(tid, tablet_info {
+                    tablet_replica_set {
+                        tablet_replica {host1, shard_id(tid.value() % shard_count)},
+                    }
+                });
+            }
+            tablet_metadata tmeta;
+            tmeta.set_tablet_map(table1, std::move(tmap));
+            tm.set_tablets(std::move(tmeta));
+            return make_ready_future<>();
+        }).get();
+
+        const auto hot1 = tablet_id(0);
+        const auto hot2 = tablet_id(shard_count);
+        locator::load_stats load_stats = {
+            .tables = {
+                { table1, table_load_stats{
+                    .size_in_bytes = service::default_target_tablet_size * tablet_count,
+                    .tablets = {
+                        { hot1, tablet_load_stats{ .reads = 1000 } },
+                        { hot2, tablet_load_stats{ .writes = 1000 } },
+                    }
+                }},
+            }
+        };
+
+        rebalance_tablets(e.get_tablet_allocator().local(), stm, make_lw_shared(std::move(load_stats)));
+
+        auto& tmap = stm.get()->tablets().get_tablet_map(table1);
+        auto shard_of = [&] (tablet_id tid) {
+            return tmap.get_tablet_info(tid).replicas[0].shard;
+        };
+        std::vector<size_t> tablets_per_shard(shard_count);
+        for (auto tid : tmap.tablet_ids()) {
+            tablets_per_shard[shard_of(tid)]++;
+        }
+
+        // Each hot tablet ends up with a shard to itself, and cold tablets are spread evenly over the rest.
+        BOOST_REQUIRE_NE(shard_of(hot1), shard_of(hot2));
+        for (shard_id shard = 0; shard < shard_count; ++shard) {
+            auto expected = shard == shard_of(hot1) || shard == shard_of(hot2) ? 1 : 3;
+            BOOST_REQUIRE_EQUAL(tablets_per_shard[shard], expected);
+        }
+  }).get();
+}
+
 static
 void check_tablet_invariants(const tablet_metadata& tmeta) {
     for (auto&& [table, tmap] : tmeta.all_tables()) {
@@ -2200,6 +2272,155 @@ SEASTAR_THREAD_TEST_CASE(test_load_balancing_resize_requests) {
     }).get();
 }
 
+SEASTAR_THREAD_TEST_CASE(test_load_balancing_resize_requests_by_traffic) {
+    auto cfg = tablet_cql_test_config();
+    auto db_cfg = cfg.db_config;
+    db_cfg->tablet_request_rate_resize_delay_in_seconds.set(3600);
+
+    do_with_cql_env_thread([db_cfg] (auto& e) {
+        inet_address ip1("192.168.0.1");
+        inet_address ip2("192.168.0.2");
+
+        auto host1 = host_id(next_uuid());
+        auto host2 = host_id(next_uuid());
+
+        auto table1 = table_id(next_uuid());
+
+        unsigned shard_count = 2;
+
+        semaphore sem(1);
+        shared_token_metadata stm([&sem] () noexcept { return get_units(sem, 1); }, locator::token_metadata::config{
+                locator::topology::config{
+                        .this_endpoint = ip1,
+                        .local_dc_rack = locator::endpoint_dc_rack::default_location
+                }
+        });
+
+        // 2 tablet replicas and 4 shards, so splitting would spread the traffic.
+        stm.mutate_token_metadata([&] (token_metadata& tm) {
+            tm.update_host_id(host1, ip1);
+            tm.update_host_id(host2, ip2);
+            tm.update_topology(host1, locator::endpoint_dc_rack::default_location, std::nullopt, shard_count);
+            tm.update_topology(host2, locator::endpoint_dc_rack::default_location, std::nullopt, shard_count);
+
+            tablet_map tmap(2);
+            for (auto tid : tmap.tablet_ids()) {
+                tmap.set_tablet(tid, tablet_info {
+                        tablet_replica_set {
+                                tablet_replica {host1, shard_id(tid.value())},
+                        }
+                });
+            }
+            tablet_metadata tmeta;
+            tmeta.set_tablet_map(table1, std::move(tmap));
+            tm.set_tablets(std::move(tmeta));
+            return make_ready_future<>();
+        }).get();
+
+        auto resize_decision = [&] {
+            return stm.get()->tablets().get_tablet_map(table1).resize_decision();
+        };
+
+        // The average tablet size is half the target, which calls for neither split nor merge.
+        const uint64_t max_tablet_traffic = db_cfg->target_tablet_request_rate() * 2;
+        auto do_rebalance_tablets = [&] (double max_tablet_traffic_pctg) {
+            table_load_stats stats{ .size_in_bytes = service::default_target_tablet_size };
+            for (auto tid : stm.get()->tablets().get_tablet_map(table1).tablet_ids()) {
+                stats.tablets[tid] = tablet_load_stats{ .reads = max_tablet_traffic * max_tablet_traffic_pctg };
+            }
+            locator::load_stats load_stats = { .tables = { { table1, std::move(stats) } } };
+            rebalance_tablets(e.get_tablet_allocator().local(), stm, make_lw_shared(std::move(load_stats)));
+        };
+
+        // Traffic which didn't last long enough doesn't cause a split.
+        do_rebalance_tablets(1.5);
+        BOOST_REQUIRE(std::holds_alternative<locator::resize_decision::none>(resize_decision().way));
+
+        // Sustained traffic does.
+        db_cfg->tablet_request_rate_resize_delay_in_seconds.set(0);
+        do_rebalance_tablets(1.5);
+        BOOST_REQUIRE(std::holds_alternative<locator::resize_decision::split>(resize_decision().way));
+
+        // Split is not cancelled while traffic is above what it would be after the split.
+        do_rebalance_tablets(0.75);
+        BOOST_REQUIRE(std::holds_alternative<locator::resize_decision::split>(resize_decision().way));
+
+        do_rebalance_tablets(0.25);
+        BOOST_REQUIRE(std::holds_alternative<locator::resize_decision::none>(resize_decision().way));
+    }, cfg).get();
+}
+
+SEASTAR_THREAD_TEST_CASE(test_load_balancing_merge_requests_by_traffic) {
+    auto cfg = tablet_cql_test_config();
+    auto db_cfg = cfg.db_config;
+    db_cfg->tablet_request_rate_resize_delay_in_seconds.set(0);
+
+    do_with_cql_env_thread([db_cfg] (auto& e) {
+        inet_address ip1("192.168.0.1");
+
+        auto host1 = host_id(next_uuid());
+
+        auto table1 = table_id(next_uuid());
+
+        unsigned shard_count = 2;
+
+        semaphore sem(1);
+        shared_token_metadata stm([&sem] () noexcept { return get_units(sem, 1); }, locator::token_metadata::config{
+                locator::topology::config{
+                        .this_endpoint = ip1,
+                        .local_dc_rack = locator::endpoint_dc_rack::default_location
+                }
+        });
+
+        stm.mutate_token_metadata([&] (token_metadata& tm) {
+            tm.update_host_id(host1, ip1);
+            tm.update_topology(host1, locator::endpoint_dc_rack::default_location, std::nullopt, shard_count);
+
+            tablet_map tmap(4);
+            for (auto tid : tmap.tablet_ids()) {
+                tmap.set_tablet(tid, tablet_info {
+                        tablet_replica_set {
+                                tablet_replica {host1, shard_id(tid.value() % shard_count)},
+                        }
+                });
+            }
+            tablet_metadata tmeta;
+            tmeta.set_tablet_map(table1, std::move(tmap));
+            tm.set_tablets(std::move(tmeta));
+            return make_ready_future<>();
+        }).get();
+
+        auto resize_decision = [&] {
+            return stm.get()->tablets().get_tablet_map(table1).resize_decision();
+        };
+
+        // The table is empty, so only its traffic keeps it from being merged.
+        const uint64_t target_tablet_traffic = db_cfg->target_tablet_request_rate();
+        auto do_rebalance_tablets = [&] (double target_tablet_traffic_pctg) {
+            table_load_stats stats{ .size_in_bytes = 0 };
+            for (auto tid : stm.get()->tablets().get_tablet_map(table1).tablet_ids()) {
+                stats.tablets[tid] = tablet_load_stats{ .reads = target_tablet_traffic * target_tablet_traffic_pctg };
+            }
+            locator::load_stats load_stats = { .tables = { { table1, std::move(stats) } } };
+            rebalance_tablets(e.get_tablet_allocator().local(), stm, make_lw_shared(std::move(load_stats)));
+        };
+
+        // Tables are not merged while their tablets serve more than a quarter of the target.
+        do_rebalance_tablets(0.3);
+        BOOST_REQUIRE(std::holds_alternative<locator::resize_decision::none>(resize_decision().way));
+
+        do_rebalance_tablets(0.2);
+        BOOST_REQUIRE(std::holds_alternative<locator::resize_decision::merge>(resize_decision().way));
+
+        // Merge is not cancelled while traffic is below what it would be after the merge.
+        do_rebalance_tablets(0.4);
+        BOOST_REQUIRE(std::holds_alternative<locator::resize_decision::merge>(resize_decision().way));
+
+        do_rebalance_tablets(0.6);
+        BOOST_REQUIRE(std::holds_alternative<locator::resize_decision::none>(resize_decision().way));
+    }, cfg).get();
+}
+
 SEASTAR_THREAD_TEST_CASE(test_tablet_range_splitter) {
     simple_schema ss;
 
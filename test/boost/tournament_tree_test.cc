@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+
+#define BOOST_TEST_MODULE core
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <random>
+
+#include "utils/tournament_tree.hh"
+
+namespace {
+
+struct counting_compare {
+    size_t* comparisons;
+
+    std::strong_ordering operator()(int a, int b) const {
+        ++*comparisons;
+        return a <=> b;
+    }
+};
+
+using tree_type = utils::tournament_tree<int, counting_compare>;
+
+}
+
+BOOST_AUTO_TEST_CASE(test_pops_in_order) {
+    size_t comparisons = 0;
+    tree_type tree(counting_compare{&comparisons});
+    BOOST_REQUIRE(tree.empty());
+
+    std::mt19937 rng(0);
+    std::vector<int> values(1000);
+    for (auto& v : values) {
+        v = std::uniform_int_distribution<int>(0, 100)(rng);
+        tree.push(v);
+    }
+    BOOST_REQUIRE_EQUAL(tree.size(), values.size());
+
+    std::sort(values.begin(), values.end());
+    for (auto v : values) {
+        BOOST_REQUIRE_EQUAL(tree.top(), v);
+        BOOST_REQUIRE_EQUAL(tree.pop(), v);
+    }
+    BOOST_REQUIRE(tree.empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_merge) {
+    constexpr int streams = 37;
+    constexpr int per_stream = 100;
+    size_t comparisons = 0;
+    tree_type tree(counting_compare{&comparisons});
+
+    // Stream i produces i, i + streams, i + 2 * streams, ...
+    for (int i = 0; i < streams; ++i) {
+        tree.push(i);
+    }
+    comparisons = 0;
+    for (int expected = 0; expected < streams * per_stream; ++expected) {
+        BOOST_REQUIRE(!tree.top_may_have_equal());
+        auto v = tree.pop();
+        BOOST_REQUIRE_EQUAL(v, expected);
+        if (v + streams < streams * per_stream) {
+            tree.push(v + streams);
+        }
+    }
+    BOOST_REQUIRE(tree.empty());
+
+    // Replacing the top takes one comparison per level (6 levels for 64 leaves).
+    BOOST_REQUIRE_LE(comparisons, size_t(streams * per_stream * 6));
+}
+
+BOOST_AUTO_TEST_CASE(test_ties) {
+    size_t comparisons = 0;
+    tree_type tree(counting_compare{&comparisons});
+
+    for (int v : {5, 3, 8, 3, 1, 9, 3}) {
+        tree.push(v);
+    }
+    BOOST_REQUIRE_EQUAL(tree.pop(), 1);
+    BOOST_REQUIRE(tree.top_may_have_equal());
+    BOOST_REQUIRE_EQUAL(tree.pop(), 3);
+    BOOST_REQUIRE(tree.top_may_have_equal());
+    BOOST_REQUIRE_EQUAL(tree.pop(), 3);
+    BOOST_REQUIRE(!tree.top_may_have_equal());
+    BOOST_REQUIRE_EQUAL(tree.pop(), 3);
+    BOOST_REQUIRE(!tree.top_may_have_equal());
+    BOOST_REQUIRE_EQUAL(tree.top(), 5);
+}
+
+BOOST_AUTO_TEST_CASE(test_for_each_and_clear) {
+    size_t comparisons = 0;
+    tree_type tree(counting_compare{&comparisons});
+
+    for (int v : {4, 2, 7}) {
+        tree.push(v);
+    }
+    tree.pop();
+
+    std::vector<int> seen;
+    tree.for_each([&] (int v) { seen.push_back(v); });
+    std::sort(seen.begin(), seen.end());
+    BOOST_REQUIRE(seen == std::vector<int>({4, 7}));
+
+    tree.clear();
+    BOOST_REQUIRE(tree.empty());
+    tree.push(10);
+    tree.push(6);
+    BOOST_REQUIRE_EQUAL(tree.pop(), 6);
+    BOOST_REQUIRE_EQUAL(tree.pop(), 10);
+    BOOST_REQUIRE(tree.empty());
+}
@@ -10,6 +10,11 @@
 
 #include "tracing/tracing.hh"
 #include "tracing/trace_state.hh"
+#include "replica/database.hh"
+#include "sstables/index_reader.hh"
+#include "sstables/sstables.hh"
+#include "readers/flat_mutation_reader_v2.hh"
+#include "db/timeout_clock.hh"
 
 #include "test/lib/cql_test_env.hh"
 
@@ -80,3 +85,193 @@ SEASTAR_TEST_CASE(tracing_slow_query_fast_mode) {
         return make_ready_future<>();
     });
 }
+
+SEASTAR_TEST_CASE(tracing_fast_mode_records_stages) {
+    return do_with_tracing_env([](auto &e) {
+        tracing::tracing &t = tracing::tracing::get_local_tracing_instance();
+
+        // disable tracing events
+        t.set_ignore_trace_events(true);
+
+        tracing::trace_state_props_set trace_props;
+        trace_props.set(tracing::trace_state_props::log_slow_query);
+
+        tracing::trace_state_ptr trace_state = t.create_session(tracing::trace_type::QUERY, trace_props);
+        const auto session_id = trace_state->session_id();
+        // Stages may precede the session
+        tracing::mark(trace_state, tracing::request_stage::received);
+        tracing::begin(trace_state, "begin", gms::inet_address());
+        tracing::mark(trace_state, tracing::request_stage::cache_read);
+        tracing::mark(trace_state, tracing::request_stage::response_ready);
+
+        // stages are not events
+        BOOST_CHECK_EQUAL(trace_state->events_size(), 0);
+
+        tracing::stop_foreground(trace_state);
+        // stages are not recorded after the response
+        tracing::mark(trace_state, tracing::request_stage::replica_response_received);
+
+        std::optional<tracing::latency_breakdown> breakdown;
+        t.latency_breakdowns().for_each([&] (const tracing::latency_breakdown& b) {
+            if (b.session_id == session_id) {
+                breakdown = b;
+            }
+        });
+        BOOST_REQUIRE(breakdown);
+        BOOST_REQUIRE_EQUAL(breakdown->size, 3);
+        BOOST_CHECK(breakdown->stages[0].stage == tracing::request_stage::received);
+        BOOST_CHECK_LE(breakdown->stages[0].offset_us, 0);
+        BOOST_CHECK(breakdown->stages[1].stage == tracing::request_stage::cache_read);
+        BOOST_CHECK_GE(breakdown->stages[1].offset_us, 0);
+        BOOST_CHECK(breakdown->stages[2].stage == tracing::request_stage::response_ready);
+        BOOST_CHECK_LE(breakdown->stages[2].offset_us, int64_t(breakdown->duration_us));
+
+        return make_ready_future<>();
+    });
+}
+
+// Reading many sstables, or getting the responses of many replicas, marks the
+// same stage over and over; the stages which follow must still be kept.
+SEASTAR_TEST_CASE(stage_marks_keep_first_and_last_of_repeated_stages) {
+    using tracing::request_stage;
+    tracing::stage_marks marks;
+    const auto start = tracing::elapsed_clock::now();
+    auto at = [&] (int i) {
+        return start + std::chrono::microseconds(i);
+    };
+
+    marks.add(request_stage::received, at(0));
+    for (int i = 1; i <= 2 * int(tracing::stage_marks::max_marks); ++i) {
+        marks.add(request_stage::sstable_read, at(i));
+    }
+    marks.add(request_stage::replica_response_received, at(100));
+    marks.add(request_stage::replica_response_received, at(101));
+    marks.add(request_stage::replica_response_received, at(102));
+    marks.add(request_stage::response_ready, at(103));
+
+    const std::vector<tracing::stage_marks::mark> expected = {
+        {request_stage::received, at(0)},
+        {request_stage::sstable_read, at(1)},
+        {request_stage::sstable_read, at(2 * tracing::stage_marks::max_marks)},
+        {request_stage::replica_response_received, at(100)},
+        {request_stage::replica_response_received, at(102)},
+        {request_stage::response_ready, at(103)},
+    };
+    BOOST_REQUIRE_EQUAL(marks.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        const auto& m = marks.begin()[i];
+        BOOST_CHECK(m.stage == expected[i].stage);
+        BOOST_CHECK(m.at == expected[i].at);
+    }
+
+    return make_ready_future<>();
+}
+
+SEASTAR_TEST_CASE(tracing_accounts_read_io) {
+    return do_with_tracing_env([](cql_test_env& e) {
+        e.execute_cql("CREATE TABLE ks.t (pk int, ck int, v int, PRIMARY KEY (pk, ck))").get();
+        e.execute_cql("INSERT INTO ks.t (pk, ck, v) VALUES (0, 0, 0)").get();
+        e.execute_cql("DELETE FROM ks.t WHERE pk = 0 AND ck = 1").get();
+        e.db().invoke_on_all([] (replica::database& db) {
+            return db.find_column_family("ks", "t").flush();
+        }).get();
+
+        auto s = e.local_db().find_schema("ks", "t");
+        auto shard = dht::static_shard_of(*s, dht::decorate_key(*s, partition_key::from_singular(*s, 0)).token());
+
+        auto stats = e.db().invoke_on(shard, [] (replica::database& db) {
+            return seastar::async([&db] {
+                auto& tbl = db.find_column_family("ks", "t");
+                auto s = tbl.schema();
+                // Make the read go to the sstable
+                tbl.get_row_cache().evict();
+
+                tracing::trace_state_props_set trace_props;
+                trace_props.set(tracing::trace_state_props::full_tracing);
+                tracing::trace_state_ptr trace_state = tracing::tracing::get_local_tracing_instance().create_session(tracing::trace_type::QUERY, trace_props);
+                tracing::begin(trace_state, "begin", gms::inet_address());
+
+                auto pr = dht::partition_range::make_singular(dht::decorate_key(*s, partition_key::from_singular(*s, 0)));
+                auto permit = db.get_reader_concurrency_semaphore().make_tracking_only_permit(s, "test", db::no_timeout, {});
+                auto rd = tbl.make_reader_v2(s, permit, pr, s->full_slice(), trace_state);
+                auto close_rd = deferred_close(rd);
+                BOOST_REQUIRE(read_mutation_from_flat_mutation_reader(rd).get());
+
+                return trace_state->read_io();
+            });
+        }).get();
+
+        BOOST_CHECK_EQUAL(stats.row_cache_hits, 0);
+        BOOST_CHECK_EQUAL(stats.row_cache_misses, 1);
+        BOOST_CHECK_GE(stats.sstables_read, 1);
+        BOOST_CHECK_EQUAL(stats.filter_false_positives, 0);
+        BOOST_CHECK_GE(stats.index_page_hits + stats.index_page_misses + stats.index_page_waits, 1);
+        BOOST_CHECK_GT(stats.data_bytes_from_disk, 0);
+        // The deleted row
+        BOOST_CHECK_GE(stats.tombstones_read, 1);
+
+        return make_ready_future<>();
+    });
+}
+
+// A read which finds the index page it needs being loaded by another read
+// waits for it; it must not count it as found in the cache.
+SEASTAR_TEST_CASE(tracing_counts_index_page_waits) {
+    return do_with_tracing_env([](cql_test_env& e) {
+        e.execute_cql("CREATE TABLE ks.t (pk int PRIMARY KEY, v int)").get();
+        e.execute_cql("INSERT INTO ks.t (pk, v) VALUES (0, 0)").get();
+        e.db().invoke_on_all([] (replica::database& db) {
+            return db.find_column_family("ks", "t").flush();
+        }).get();
+
+        auto s = e.local_db().find_schema("ks", "t");
+        auto shard = dht::static_shard_of(*s, dht::decorate_key(*s, partition_key::from_singular(*s, 0)).token());
+
+        e.db().invoke_on(shard, [] (replica::database& db) {
+            return seastar::async([&db] {
+                auto& tbl = db.find_column_family("ks", "t");
+                auto s = tbl.schema();
+                auto sstables = tbl.get_sstables();
+                BOOST_REQUIRE_EQUAL(sstables->size(), 1);
+                auto sst = *sstables->begin();
+                // Make the first read load the index page from disk.
+                sst->drop_caches().get();
+
+                auto read_index = [&] {
+                    tracing::trace_state_props_set trace_props;
+                    trace_props.set(tracing::trace_state_props::full_tracing);
+                    auto trace_state = tracing::tracing::get_local_tracing_instance().create_session(tracing::trace_type::QUERY, trace_props);
+                    tracing::begin(trace_state, "begin", gms::inet_address());
+                    auto permit = db.get_reader_concurrency_semaphore().make_tracking_only_permit(s, "test", db::no_timeout, {});
+                    auto ir = std::make_unique<sstables::index_reader>(sst, std::move(permit), trace_state);
+                    auto f = ir->read_partition_data();
+                    return std::tuple(std::move(ir), std::move(f), std::move(trace_state));
+                };
+
+                auto [ir1, f1, ts1] = read_index();
+                auto [ir2, f2, ts2] = read_index();
+                f1.get();
+                f2.get();
+                auto [ir3, f3, ts3] = read_index();
+                f3.get();
+                for (auto* ir : {ir1.get(), ir2.get(), ir3.get()}) {
+                    ir->close().get();
+                }
+
+                BOOST_CHECK_EQUAL(ts1->read_io().index_page_misses, 1);
+                BOOST_CHECK_EQUAL(ts1->read_io().index_page_waits, 0);
+                BOOST_CHECK_EQUAL(ts1->read_io().index_page_hits, 0);
+
+                BOOST_CHECK_EQUAL(ts2->read_io().index_page_misses, 0);
+                BOOST_CHECK_EQUAL(ts2->read_io().index_page_waits, 1);
+                BOOST_CHECK_EQUAL(ts2->read_io().index_page_hits, 0);
+
+                BOOST_CHECK_EQUAL(ts3->read_io().index_page_misses, 0);
+                BOOST_CHECK_EQUAL(ts3->read_io().index_page_waits, 0);
+                BOOST_CHECK_EQUAL(ts3->read_io().index_page_hits, 1);
+            });
+        }).get();
+
+        return make_ready_future<>();
+    });
+}
@@ -10,6 +10,7 @@
 
 #include <fmt/ranges.h>
 
+#include "generic_server.hh"
 #include "transport/request.hh"
 #include "transport/response.hh"
 
@@ -159,3 +160,24 @@ SEASTAR_THREAD_TEST_CASE(test_response_request_reader) {
     BOOST_CHECK_EQUAL(req.read_short(), 1);
     BOOST_CHECK_EQUAL(req.read_string(), "zed");
 }
+
+SEASTAR_THREAD_TEST_CASE(test_pick_less_loaded_shard) {
+    using generic_server::shard_load;
+    using generic_server::pick_less_loaded_shard;
+
+    // Idle shards are compared by connections, and one more is no imbalance.
+    std::vector<shard_load> loads{{10, 1}, {9, 0}, {2, 0}};
+    BOOST_REQUIRE(pick_less_loaded_shard(loads, 0) == 2u);
+    BOOST_REQUIRE(!pick_less_loaded_shard(loads, 2));
+    loads = {{3, 0}, {2, 0}};
+    BOOST_REQUIRE(!pick_less_loaded_shard(loads, 0));
+
+    // Busy shards are compared by request rate, whatever their connections.
+    loads = {{1, 5000}, {10, 1000}, {1, 4000}};
+    BOOST_REQUIRE(pick_less_loaded_shard(loads, 0) == 1u);
+    BOOST_REQUIRE(!pick_less_loaded_shard(loads, 1));
+    loads = {{1, 1200}, {1, 1000}};
+    BOOST_REQUIRE(!pick_less_loaded_shard(loads, 0));
+
+    BOOST_REQUIRE(!pick_less_loaded_shard(loads, 5));
+}
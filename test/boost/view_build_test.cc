@@ -34,6 +34,7 @@
 #include "test/lib/mutation_assertions.hh"
 #include "test/lib/test_utils.hh"
 #include "utils/ranges.hh"
+#include "utils/error_injection.hh"
 
 #include "readers/from_mutations_v2.hh"
 #include "readers/evictable.hh"
@@ -170,6 +171,58 @@ SEASTAR_TEST_CASE(test_builder_with_multiple_partitions_of_batch_size_rows) {
     });
 }
 
+SEASTAR_TEST_CASE(test_builder_with_more_batches_than_in_flight) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("create table cf (p int, c int, v int, primary key (p, c))").get();
+
+        // Each partition is a batch of its own, so a build step has more
+        // batches than can be in flight at once.
+        const auto partitions = db::view::view_builder::batch_size * 4;
+        static_assert(db::view::view_builder::batch_size > db::view::view_builder::max_batches_in_flight);
+        for (size_t i = 0; i < partitions; ++i) {
+            e.execute_cql(format("insert into cf (p, c, v) values ({:d}, 0, 0)", i)).get();
+        }
+
+        auto f = e.local_view_builder().wait_until_built("ks", "vcf");
+        e.execute_cql("create materialized view vcf as select * from cf "
+                      "where p is not null and c is not null and v is not null "
+                      "primary key (v, c, p)").get();
+
+        f.get();
+        auto msg = e.execute_cql("select count(*) from vcf where v = 0").get();
+        assert_that(msg).is_rows().with_rows({{{long_type->decompose(int64_t(partitions))}}});
+    });
+}
+
+SEASTAR_TEST_CASE(test_builder_retries_step_with_failed_batch) {
+#ifndef SCYLLA_ENABLE_ERROR_INJECTION
+    std::cerr << "Skipping test as it depends on error injection. Please run in mode where it's enabled (debug,dev).\n";
+    return make_ready_future<>();
+#else
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("create table cf (p int, c int, v int, primary key (p, c))").get();
+
+        const auto partitions = db::view::view_builder::batch_size * 2;
+        for (size_t i = 0; i < partitions; ++i) {
+            e.execute_cql(format("insert into cf (p, c, v) values ({:d}, 0, 0)", i)).get();
+        }
+
+        // The step whose batch fails is rolled back, and retried from where
+        // it started, so that none of its rows is missing from the view.
+        utils::get_local_injector().enable("view_builder_populate_views", true /* oneshot */);
+        auto f = e.local_view_builder().wait_until_built("ks", "vcf");
+        e.execute_cql("create materialized view vcf as select * from cf "
+                      "where p is not null and c is not null and v is not null "
+                      "primary key (v, c, p)").get();
+
+        f.get();
+        BOOST_REQUIRE(!utils::get_local_injector().is_enabled("view_builder_populate_views"));
+        auto msg = e.execute_cql("select count(*) from vcf where v = 0").get();
+        assert_that(msg).is_rows().with_rows({{{long_type->decompose(int64_t(partitions))}}});
+    });
+#endif
+}
+
 SEASTAR_TEST_CASE(test_builder_view_added_during_ongoing_build) {
     return do_with_cql_env_thread([] (cql_test_env& e) {
         e.execute_cql("create table cf (p int, c int, v int, primary key (p, c))").get();
@@ -15,11 +15,14 @@
 #include "types/user.hh"
 #include "db/view/node_view_update_backlog.hh"
 #include "db/view/view_builder.hh"
+#include "db/view/view_update_coalescer.hh"
 
 #include "test/lib/scylla_test_case.hh"
 #include <seastar/testing/thread_test_case.hh>
 #include "test/lib/cql_test_env.hh"
 #include "test/lib/cql_assertions.hh"
+#include "test/lib/mutation_assertions.hh"
+#include "test/lib/simple_schema.hh"
 #include "test/lib/eventually.hh"
 #include "exceptions/unrecognized_entity_exception.hh"
 #include "db/config.hh"
@@ -3172,3 +3175,75 @@ SEASTAR_TEST_CASE(test_mv_allow_some_column_drops) {
         BOOST_REQUIRE_THROW(e.execute_cql("alter table cf2 drop d").get(), exceptions::invalid_request_exception);
     });
 }
+
+SEASTAR_THREAD_TEST_CASE(test_view_update_coalescer) {
+    simple_schema ss;
+    auto s = ss.schema();
+    db::timeout_semaphore sem(100);
+    auto make_update = [&] (const mutation& m, gms::inet_address target) {
+        return db::view::remote_view_update{
+            .mut = {freeze(m), s},
+            .target = target,
+            .allow_hints = service::allow_hints::yes,
+            .units = make_lw_shared(consume_units(sem, 1)),
+        };
+    };
+    auto replica1 = gms::inet_address("127.0.0.1");
+    auto replica2 = gms::inet_address("127.0.0.2");
+
+    mutation m1(s, ss.make_pkey(0));
+    ss.add_row(m1, ss.make_ckey(0), "v0");
+    mutation m2(s, ss.make_pkey(0));
+    ss.add_row(m2, ss.make_ckey(1), "v1");
+    mutation m3(s, ss.make_pkey(1));
+    ss.add_row(m3, ss.make_ckey(0), "v0");
+
+    db::view::view_update_coalescer coalescer;
+    BOOST_REQUIRE(coalescer.empty());
+    BOOST_REQUIRE(!coalescer.add(make_update(m1, replica1)));
+    BOOST_REQUIRE(!coalescer.empty());
+    // Updates of the same partition to the same replica are merged, the
+    // other ones are kept apart.
+    BOOST_REQUIRE(!coalescer.add(make_update(m2, replica1)));
+    BOOST_REQUIRE(!coalescer.add(make_update(m2, replica2)));
+    BOOST_REQUIRE(!coalescer.add(make_update(m3, replica1)));
+    BOOST_REQUIRE_EQUAL(sem.available_units(), 96);
+
+    auto updates = coalescer.take_all();
+    BOOST_REQUIRE(coalescer.empty());
+    BOOST_REQUIRE(coalescer.take_all().empty());
+    BOOST_REQUIRE_EQUAL(updates.size(), 3);
+    std::ranges::sort(updates, [] (const auto& a, const auto& b) { return a.count > b.count; });
+    BOOST_REQUIRE_EQUAL(updates[0].count, 2);
+    BOOST_REQUIRE(updates[0].target == replica1);
+    BOOST_REQUIRE_EQUAL(updates[0].units->count(), 2);
+    assert_that(updates[0].mut.fm.unfreeze(s)).is_equal_to(m1 + m2);
+    for (auto& u : updates | std::views::drop(1)) {
+        BOOST_REQUIRE_EQUAL(u.count, 1);
+        BOOST_REQUIRE_EQUAL(u.units->count(), 1);
+        auto m = u.mut.fm.unfreeze(s);
+        if (u.target == replica2) {
+            assert_that(m).is_equal_to(m2);
+        } else {
+            assert_that(m).is_equal_to(m3);
+        }
+    }
+    updates.clear();
+    BOOST_REQUIRE_EQUAL(sem.available_units(), 100);
+
+    // Updates which would make the merged one too large are not merged, the
+    // pending one is returned to be sent right away.
+    const auto large_value = sstring(db::view::view_update_coalescer::max_update_size * 3 / 4, 'x');
+    mutation large1(s, ss.make_pkey(0));
+    ss.add_row(large1, ss.make_ckey(0), large_value);
+    mutation large2(s, ss.make_pkey(0));
+    ss.add_row(large2, ss.make_ckey(1), large_value);
+    BOOST_REQUIRE(!coalescer.add(make_update(large1, replica1)));
+    auto ready = coalescer.add(make_update(large2, replica1));
+    BOOST_REQUIRE(ready);
+    BOOST_REQUIRE_EQUAL(ready->count, 1);
+    assert_that(ready->mut.fm.unfreeze(s)).is_equal_to(large1);
+    updates = coalescer.take_all();
+    BOOST_REQUIRE_EQUAL(updates.size(), 1);
+    assert_that(updates[0].mut.fm.unfreeze(s)).is_equal_to(large2);
+}
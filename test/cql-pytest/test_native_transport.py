@@ -3,9 +3,13 @@
 # SPDX-License-Identifier: AGPL-3.0-or-later
 
 import pytest
+import requests
+import socket
+import struct
 import time
 import nodetool
 from util import new_test_table
+from rest_api import scylla_inject_error
 from cassandra.cluster import NoHostAvailable
 
 def test_enable_disable_binary(cql, test_keyspace):
@@ -29,3 +33,83 @@ def test_enable_disable_binary(cql, test_keyspace):
                 pause += pause
         else:
             assert False
+
+
+# Sum of a transport metric over all shards.
+def get_transport_metric(cql, name):
+    url = f'http://{cql.cluster.contact_points[0]}:9180/metrics'
+    total = 0
+    for line in requests.get(url).text.split('\n'):
+        if line.startswith(f'scylla_transport_{name}{{'):
+            total += float(line.split(' ')[-1])
+    return total
+
+# Opens a plain connection to the CQL port, for tests which send frames
+# themselves, without the driver waiting for each response.
+def raw_cql_connection(cql):
+    if cql.cluster.ssl_context:
+        pytest.skip("raw CQL connections don't support SSL")
+    return socket.create_connection((cql.cluster.contact_points[0], cql.cluster.port))
+
+OPCODE_OPTIONS = 0x05
+OPCODE_SUPPORTED = 0x06
+
+def send_options(sock, count):
+    # OPTIONS frames of protocol v4, with an empty body.
+    sock.sendall(b''.join(struct.pack('>BBhBi', 0x04, 0, stream, OPCODE_OPTIONS, 0) for stream in range(count)))
+
+def receive_responses(sock, count):
+    responses = []
+    buf = b''
+    while len(responses) < count:
+        while len(buf) < 9:
+            data = sock.recv(65536)
+            assert data, "connection closed"
+            buf += data
+        _, _, stream, opcode, length = struct.unpack('>BBhBi', buf[:9])
+        while len(buf) < 9 + length:
+            data = sock.recv(65536)
+            assert data, "connection closed"
+            buf += data
+        responses.append((stream, opcode))
+        buf = buf[9 + length:]
+    return responses
+
+# Responses which complete while the previous ones are being written to the
+# client are written together, in one batch. Pipelining many requests on one
+# connection should therefore take fewer batches than responses, and every
+# request must still get its response.
+def test_responses_are_batched(cql, scylla_only):
+    count = 200
+    with raw_cql_connection(cql) as sock:
+        batches_before = get_transport_metric(cql, 'response_batches')
+        send_options(sock, count)
+        responses = receive_responses(sock, count)
+        batches = get_transport_metric(cql, 'response_batches') - batches_before
+    assert sorted(responses) == [(stream, OPCODE_SUPPORTED) for stream in range(count)]
+    assert 0 < batches < count
+
+# When writing responses to the client fails, the responses still queued on
+# the connection, and the ones which complete afterwards, are dropped. They
+# must release the memory their requests were admitted with, without waiting
+# for the client to close the connection.
+def test_responses_released_on_write_failure(cql, scylla_only):
+    count = 200
+    memory_before = get_transport_metric(cql, 'requests_memory_available')
+    served_before = get_transport_metric(cql, 'requests_served')
+    with raw_cql_connection(cql) as sock:
+        with scylla_inject_error(cql, "transport_write_responses_failure", one_shot=True):
+            send_options(sock, count)
+            deadline = time.time() + 60
+            while get_transport_metric(cql, 'requests_served') - served_before < count:
+                assert time.time() < deadline, "requests weren't served"
+                time.sleep(0.1)
+            while get_transport_metric(cql, 'requests_memory_available') != memory_before:
+                assert time.time() < deadline, "queued responses didn't release their memory"
+                time.sleep(0.1)
+        # Nothing is written to the connection after the failure.
+        sock.settimeout(1)
+        try:
+            assert sock.recv(65536) == b''
+        except socket.timeout:
+            pass
@@ -78,6 +78,25 @@ def test_validate_service_level_timeouts(scylla_only, cql):
             with pytest.raises(Exception):
                 cql.execute(f"ALTER SERVICE LEVEL {sl} WITH timeout = {incorrect}")
 
+# Test that setting service level shares correctly sets the shares parameter
+def test_set_service_level_shares(scylla_only, cql):
+    with new_service_level(cql) as sl:
+        assert not cql.execute(f"LIST SERVICE LEVEL {sl}").one().shares
+        cql.execute(f"ALTER SERVICE LEVEL {sl} WITH shares = 300")
+        assert cql.execute(f"LIST SERVICE LEVEL {sl}").one().shares == 300
+        cql.execute(f"ALTER SERVICE LEVEL {sl} WITH timeout = 2s")
+        assert cql.execute(f"LIST SERVICE LEVEL {sl}").one().shares == 300
+        cql.execute(f"ALTER SERVICE LEVEL {sl} WITH shares = null")
+        assert not cql.execute(f"LIST SERVICE LEVEL {sl}").one().shares
+
+# Test that incorrect service level shares values result in an error
+def test_validate_service_level_shares(scylla_only, cql):
+    with new_service_level(cql) as sl:
+        for incorrect in ['0', '-5', '1001', 'lots']:
+            print(f"Checking {incorrect}")
+            with pytest.raises(Exception):
+                cql.execute(f"ALTER SERVICE LEVEL {sl} WITH shares = {incorrect}")
+
 # Test that the service level is correctly attached to the user's role
 def test_attached_service_level(scylla_only, cql):
     with new_service_level(cql) as sl:
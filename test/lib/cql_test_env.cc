@@ -103,6 +103,7 @@ cql_test_config::cql_test_config(shared_ptr<db::config> cfg)
 
     db_config->add_cdc_extension();
     db_config->add_per_partition_rate_limit_extension();
+    db_config->add_sstable_index_extension();
     db_config->add_tags_extension();
     db_config->add_tombstone_gc_extension();
 
@@ -389,6 +390,10 @@ class single_node_cql_env : public cql_test_env {
         return _sstm;
     }
 
+    virtual sharded<streaming::stream_manager>& get_stream_manager() override {
+        return _stream_manager;
+    }
+
     virtual future<> refresh_client_state() override {
         return _core_local.invoke_on_all([] (core_local_state& state) {
             return state.client_state.maybe_update_per_service_level_params();
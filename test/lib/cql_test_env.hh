@@ -39,6 +39,10 @@ class view_builder;
 class view_update_generator;
 }
 
+namespace streaming {
+class stream_manager;
+}
+
 namespace auth {
 class service;
 }
@@ -179,6 +183,8 @@ class cql_test_env {
 
     virtual sharded<sstables::storage_manager>& get_sstorage_manager() = 0;
 
+    virtual sharded<streaming::stream_manager>& get_stream_manager() = 0;
+
     data_dictionary::database data_dictionary();
 };
 
@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <seastar/core/app-template.hh>
+#include <seastar/core/thread.hh>
+#include <fmt/core.h>
+#include <random>
+
+#include "sstables/sstable_set.hh"
+#include "sstables/sstable_set_impl.hh"
+#include "sstables/sstables.hh"
+#include "test/lib/key_utils.hh"
+#include "test/lib/simple_schema.hh"
+#include "test/lib/sstable_test_env.hh"
+#include "test/lib/sstable_utils.hh"
+
+/// Measures the cost of maintaining and querying a leveled sstable set.
+///
+/// SSTables are synthetic (no data on disk), laid out like a leveled
+/// compaction strategy would: each level is a run of disjoint sstables,
+/// covering the whole key space, and every level has 10 times more sstables
+/// than the previous one.
+///
+/// Example run:
+///
+///    $ build/release/test/perf/perf_sstable_set -c1 -m1G --sstables 10000
+
+using namespace sstables;
+
+namespace {
+
+using clk = std::chrono::steady_clock;
+
+double to_us(clk::duration d) {
+    return std::chrono::duration<double, std::micro>(d).count();
+}
+
+struct layout {
+    std::vector<dht::decorated_key> keys;
+    // sstables of level i are at levels[i - 1], sorted by first key.
+    std::vector<std::vector<shared_sstable>> levels;
+};
+
+layout make_layout(test_env& env, schema_ptr s, size_t sstables) {
+    layout l;
+    size_t level_size = 10;
+    size_t total = 0;
+    std::vector<size_t> level_sizes;
+    while (total < sstables) {
+        level_sizes.push_back(std::min(level_size, sstables - total));
+        total += level_sizes.back();
+        level_size *= 10;
+    }
+    // Two keys per sstable of the largest level, so sstables never share keys.
+    l.keys = tests::generate_partition_keys(2 * level_sizes.back(), s);
+    for (size_t level = 0; level < level_sizes.size(); ++level) {
+        auto& ssts = l.levels.emplace_back();
+        const auto keys_per_sstable = l.keys.size() / level_sizes[level];
+        for (size_t i = 0; i < level_sizes[level]; ++i) {
+            auto sst = env.make_sstable(s);
+            sstables::test(sst).set_values_for_leveled_strategy(1 /* data_size */, level + 1, 0 /* max_timestamp */,
+                    l.keys[i * keys_per_sstable].key(), l.keys[(i + 1) * keys_per_sstable - 1].key());
+            ssts.push_back(std::move(sst));
+        }
+    }
+    return l;
+}
+
+void run(test_env& env, size_t sstables, size_t iterations) {
+    simple_schema ss;
+    auto s = ss.schema();
+    auto l = make_layout(env, s, sstables);
+    std::mt19937 rng(std::random_device{}());
+
+    auto set = make_partitioned_sstable_set(s);
+    auto start = clk::now();
+    for (auto& level : l.levels) {
+        for (auto& sst : level) {
+            set.insert(sst);
+        }
+    }
+    fmt::print("build: {} sstables in {:.3f} [ms]\n", set.size(), to_us(clk::now() - start) / 1000);
+
+    // A compaction replaces an sstable of one level and the sstables it
+    // overlaps with in the next one with as many new ones. Model it by
+    // re-inserting the same sstables, into a clone of the set, which is how
+    // the table updates its sstable set.
+    clk::duration clone_time{}, update_time{};
+    for (size_t i = 0; i < iterations; ++i) {
+        auto level = std::uniform_int_distribution<size_t>(0, l.levels.size() - 1)(rng);
+        auto& ssts = l.levels[level];
+        auto idx = std::uniform_int_distribution<size_t>(0, ssts.size() - 1)(rng);
+
+        start = clk::now();
+        auto new_set = set;
+        auto cloned = clk::now();
+        clone_time += cloned - start;
+
+        new_set.erase(ssts[idx]);
+        new_set.insert(ssts[idx]);
+        if (level + 1 < l.levels.size()) {
+            auto& next = l.levels[level + 1];
+            const auto fan_out = next.size() / ssts.size();
+            for (size_t j = idx * fan_out; j < (idx + 1) * fan_out; ++j) {
+                new_set.erase(next[j]);
+            }
+            for (size_t j = idx * fan_out; j < (idx + 1) * fan_out; ++j) {
+                new_set.insert(next[j]);
+            }
+        }
+        update_time += clk::now() - cloned;
+        set = std::move(new_set);
+    }
+    fmt::print("rebuild: clone {:.3f} [us], update {:.3f} [us] (avg of {})\n",
+            to_us(clone_time) / iterations, to_us(update_time) / iterations, iterations);
+
+    size_t selected = 0;
+    start = clk::now();
+    for (size_t i = 0; i < iterations; ++i) {
+        auto& key = l.keys[std::uniform_int_distribution<size_t>(0, l.keys.size() - 1)(rng)];
+        selected += set.select(dht::partition_range::make_singular(key)).size();
+    }
+    fmt::print("select (single partition): {:.3f} [us], {:.1f} sstables (avg of {})\n",
+            to_us(clk::now() - start) / iterations, double(selected) / iterations, iterations);
+
+    size_t steps = 0;
+    start = clk::now();
+    {
+        auto sel = set.make_incremental_selector();
+        dht::ring_position_ext pos = dht::ring_position_view::min();
+        while (!pos.is_max()) {
+            pos = sel.select(dht::ring_position_view(pos)).next_position;
+            ++steps;
+        }
+    }
+    fmt::print("incremental selector walk: {:.3f} [ms], {} steps\n", to_us(clk::now() - start) / 1000, steps);
+
+    start = clk::now();
+    for (auto& level : l.levels) {
+        for (auto& sst : level) {
+            set.erase(sst);
+        }
+    }
+    fmt::print("teardown: {:.3f} [ms]\n", to_us(clk::now() - start) / 1000);
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    namespace bpo = boost::program_options;
+    app_template app;
+    app.add_options()
+        ("sstables", bpo::value<size_t>()->default_value(10000), "number of leveled sstables")
+        ("iterations", bpo::value<size_t>()->default_value(1000), "number of rebuilds and selects to average over");
+    return app.run(argc, argv, [&app] {
+        return test_env::do_with_async([&app] (test_env& env) {
+            run(env, app.configuration()["sstables"].as<size_t>(), app.configuration()["iterations"].as<size_t>());
+        });
+    });
+}
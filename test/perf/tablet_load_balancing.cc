@@ -124,6 +124,8 @@ struct params {
     int shards;
     int scale1 = 1;
     int scale2 = 1;
+    // Number of tablets of table1 which take most of the traffic.
+    int hot_tablets = 0;
 };
 
 struct table_balance {
@@ -135,6 +137,8 @@ constexpr auto nr_tables = 2;
 
 struct cluster_balance {
     table_balance tables[nr_tables];
+    // Max shard traffic relative to the average shard traffic of its node, over all nodes.
+    double traffic_overcommit = 0;
 };
 
 struct results {
@@ -155,7 +159,7 @@ template<>
 struct fmt::formatter<cluster_balance> : fmt::formatter<string_view> {
     template <typename FormatContext>
     auto format(const cluster_balance& r, FormatContext& ctx) const {
-        return fmt::format_to(ctx.out(), "{{table1={}, table2={}}}", r.tables[0], r.tables[1]);
+        return fmt::format_to(ctx.out(), "{{table1={}, table2={}, traffic={:.2f}}}", r.tables[0], r.tables[1], r.traffic_overcommit);
     }
 };
 
@@ -165,11 +169,11 @@ struct fmt::formatter<params> : fmt::formatter<string_view> {
     auto format(const params& p, FormatContext& ctx) const {
         auto tablets1_per_shard = double(p.tablets1.value_or(0)) * p.rf1 / (p.nodes * p.shards);
         auto tablets2_per_shard = double(p.tablets2.value_or(0)) * p.rf2 / (p.nodes * p.shards);
-        return fmt::format_to(ctx.out(), "{{iterations={}, nodes={}, tablets1={} ({:0.1f}/sh), tablets2={} ({:0.1f}/sh), rf1={}, rf2={}, shards={}}}",
+        return fmt::format_to(ctx.out(), "{{iterations={}, nodes={}, tablets1={} ({:0.1f}/sh), tablets2={} ({:0.1f}/sh), rf1={}, rf2={}, shards={}, hot_tablets={}}}",
                          p.iterations, p.nodes,
                          p.tablets1.value_or(0), tablets1_per_shard,
                          p.tablets2.value_or(0), tablets2_per_shard,
-                         p.rf1, p.rf2, p.shards);
+                         p.rf1, p.rf2, p.shards, p.hot_tablets);
     }
 };
 
@@ -202,6 +206,9 @@ future<results> test_load_balancing_with_many_tables(params p, bool tablet_aware
             add_host();
         }
 
+        // Traffic reported to the load balancer, if any.
+        locator::load_stats_ptr load_stats;
+
         semaphore sem(1);
         auto stm = shared_token_metadata([&sem]() noexcept { return get_units(sem, 1); }, locator::token_metadata::config {
                 locator::topology::config {
@@ -228,7 +235,7 @@ future<results> test_load_balancing_with_many_tables(params p, bool tablet_aware
                 tm.update_topology(hosts[i], rack1, locator::node::state::being_decommissioned, shard_count);
                 return make_ready_future<>();
             }).get();
-            rebalance_tablets(e.get_tablet_allocator().local(), stm);
+            rebalance_tablets(e.get_tablet_allocator().local(), stm, load_stats);
             stm.mutate_token_metadata([&] (token_metadata& tm) {
                 tm.remove_endpoint(host);
                 return make_ready_future<>();
@@ -262,6 +269,29 @@ future<results> test_load_balancing_with_many_tables(params p, bool tablet_aware
         allocate(s1, p.rf1, p.tablets1);
         allocate(s2, p.rf2, p.tablets2);
 
+        // Skewed traffic: hot tablets of table1 serve hot_rate requests per second, all other tablets serve
+        // cold_rate. Sizes are reported such that no resize is triggered.
+        constexpr double hot_rate = 10000;
+        constexpr double cold_rate = 10;
+        auto make_load_stats = [&] () -> locator::load_stats_ptr {
+            if (!p.hot_tablets) {
+                return {};
+            }
+            locator::load_stats stats;
+            for (auto s : {s1, s2}) {
+                auto& tmap = stm.get()->tablets().get_tablet_map(s->id());
+                auto& table_stats = stats.tables[s->id()];
+                table_stats.size_in_bytes = service::default_target_tablet_size * tmap.tablet_count();
+                const size_t hot_stride = s == s1 ? std::max<size_t>(tmap.tablet_count() / p.hot_tablets, 1) : 0;
+                for (auto tid : tmap.tablet_ids()) {
+                    bool hot = hot_stride && tid.value() % hot_stride == 0 && tid.value() / hot_stride < size_t(p.hot_tablets);
+                    table_stats.tablets[tid] = tablet_load_stats{ .reads = hot ? hot_rate : cold_rate };
+                }
+            }
+            return make_lw_shared<const locator::load_stats>(std::move(stats));
+        };
+        load_stats = make_load_stats();
+
         auto check_balance = [&] () -> cluster_balance {
             cluster_balance res;
 
@@ -302,6 +332,29 @@ future<results> test_load_balancing_with_many_tables(params p, bool tablet_aware
                 };
             }
 
+            if (load_stats) {
+                std::unordered_map<host_id, std::vector<double>> shard_traffic;
+                for (auto h : hosts) {
+                    shard_traffic[h].resize(shard_count);
+                }
+                for (auto s : {s1, s2}) {
+                    auto& table_stats = load_stats->tables.at(s->id());
+                    stm.get()->tablets().get_tablet_map(s->id()).for_each_tablet([&] (tablet_id tid, const tablet_info& ti) {
+                        for (auto&& r : ti.replicas) {
+                            shard_traffic[r.host][r.shard] += table_stats.tablets.at(tid).reads;
+                        }
+                        return make_ready_future<>();
+                    }).get();
+                }
+                for (auto& [h, traffic] : shard_traffic) {
+                    auto avg = std::accumulate(traffic.begin(), traffic.end(), 0.0) / traffic.size();
+                    auto overcommit = avg ? *std::ranges::max_element(traffic) / avg : 1;
+                    testlog.info("Traffic on host {}: max={:.0f}, avg={:.0f}, overcommit={:.2f}", h, *std::ranges::max_element(traffic), avg, overcommit);
+                    res.traffic_overcommit = std::max(res.traffic_overcommit, overcommit);
+                }
+            }
+            global_res.worst.traffic_overcommit = std::max(global_res.worst.traffic_overcommit, res.traffic_overcommit);
+
             for (int i = 0; i < nr_tables; i++) {
                 auto t = res.tables[i];
                 global_res.worst.tables[i].shard_overcommit = std::max(global_res.worst.tables[i].shard_overcommit, t.shard_overcommit);
@@ -318,13 +371,13 @@ future<results> test_load_balancing_with_many_tables(params p, bool tablet_aware
 
         check_balance();
 
-        rebalance_tablets(e.get_tablet_allocator().local(), stm);
+        rebalance_tablets(e.get_tablet_allocator().local(), stm, load_stats);
 
         global_res.init = global_res.worst = check_balance();
 
         for (int i = 0; i < cycles; i++) {
             bootstrap();
-            rebalance_tablets(e.get_tablet_allocator().local(), stm);
+            rebalance_tablets(e.get_tablet_allocator().local(), stm, load_stats);
             check_balance();
 
             decommission(hosts[0]);
@@ -365,6 +418,13 @@ future<> run_simulations(const boost::program_options::variables_map& app_cfg) {
         testlog.info("[run] Overcommit (old) : init : {}", res.init);
         testlog.info("[run] Overcommit (old) : worst: {}", res.worst);
         testlog.info("[run] Overcommit (old) : last : {}", res.last);
+
+        // Skewed traffic, where a few tablets of table1 take most of the requests.
+        p.hot_tablets = std::max(1, app_cfg["hot-tablets"].as<int>());
+        res = co_await test_load_balancing_with_many_tables(p, true);
+        testlog.info("[run] Overcommit (skew): init : {}", res.init);
+        testlog.info("[run] Overcommit (skew): worst: {}", res.worst);
+        testlog.info("[run] Overcommit (skew): last : {}", res.last);
     }
 }
 
@@ -376,6 +436,7 @@ int scylla_tablet_load_balancing_main(int argc, char** argv) {
     app.add_options()
             ("runs", bpo::value<int>()->default_value(1), "Number of simulation runs.")
             ("iterations", bpo::value<int>()->default_value(8), "Number of topology-changing cycles in each run.")
+            ("hot-tablets", bpo::value<int>()->default_value(4), "Number of hot tablets in skewed-traffic runs.")
             ("verbose", "Enables standard logging")
             ;
     return app.run(argc, argv, [&] {
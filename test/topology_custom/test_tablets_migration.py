@@ -93,18 +93,23 @@ async def test_tablet_transition_sanity(manager: ManagerClient, action):
             assert res[0].count == 0
 
 
+@pytest.mark.parametrize("file_stream", [True, False])
 @pytest.mark.parametrize("fail_replica", ["source", "destination"])
 @pytest.mark.parametrize("fail_stage", ["streaming", "allow_write_both_read_old", "write_both_read_old", "write_both_read_new", "use_new", "cleanup", "cleanup_target", "end_migration", "revert_migration"])
 @pytest.mark.asyncio
 @skip_mode('release', 'error injections are not supported in release mode')
-async def test_node_failure_during_tablet_migration(manager: ManagerClient, fail_replica, fail_stage):
+async def test_node_failure_during_tablet_migration(manager: ManagerClient, fail_replica, fail_stage, file_stream):
     if fail_stage == 'cleanup' and fail_replica == 'destination':
         pytest.skip('Failing destination during cleanup is pointless')
     if fail_stage == 'cleanup_target' and fail_replica == 'source':
         pytest.skip('Failing source during target cleanup is pointless')
+    if not file_stream and fail_stage not in ['streaming', 'cleanup_target']:
+        pytest.skip('Only streaming depends on how the tablet is streamed')
 
     logger.info("Bootstrapping cluster")
-    cfg = {'enable_user_defined_functions': False, 'enable_tablets': True, 'failure_detector_timeout_in_ms': 2000}
+    cfg = {'enable_user_defined_functions': False, 'enable_tablets': True, 'failure_detector_timeout_in_ms': 2000, 'enable_file_stream': file_stream}
+    # Streaming is held on the receiving side, which depends on how the tablet is streamed.
+    stream_injection = 'stream_blob_receive_file' if file_stream else 'stream_mutation_fragments'
     host_ids = []
     servers = []
 
@@ -165,7 +170,7 @@ async def test_node_failure_during_tablet_migration(manager: ManagerClient, fail
         async def setup(self):
             logger.info(f"Will fail {self.stage}")
             if self.stage == "streaming":
-                await manager.api.enable_injection(servers[2].ip_addr, "stream_mutation_fragments", one_shot=True)
+                await manager.api.enable_injection(servers[2].ip_addr, stream_injection, one_shot=True)
                 self.log = await manager.server_open_log(servers[2].server_id)
                 self.mark = await self.log.mark()
             elif self.stage in [ "allow_write_both_read_old", "write_both_read_old", "write_both_read_new", "use_new", "end_migration", "do_revert_migration" ]:
@@ -194,7 +199,7 @@ async def test_node_failure_during_tablet_migration(manager: ManagerClient, fail
         async def wait(self):
             logger.info(f"Wait for {self.stage} to happen")
             if self.stage == "streaming":
-                await self.log.wait_for('stream_mutation_fragments: waiting', from_mark=self.mark)
+                await self.log.wait_for(f'{stream_injection}: waiting', from_mark=self.mark)
             elif self.stage in [ "allow_write_both_read_old", "write_both_read_old", "write_both_read_new", "use_new", "end_migration", "do_revert_migration" ]:
                 await self.log.wait_for('raft_topology_cmd: barrier handler waits', from_mark=self.mark);
             elif self.stage == "cleanup":
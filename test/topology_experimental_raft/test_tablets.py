@@ -24,6 +24,8 @@ import time
 import random
 import os
 import glob
+import json
+import subprocess
 from typing import NamedTuple
 
 
@@ -249,6 +251,7 @@ async def test_streaming_is_guarded_by_topology_guard(manager: ManagerClient):
     cmdline = [
         '--logger-log-level', 'storage_service=trace',
         '--logger-log-level', 'raft_topology=trace',
+        '--enable-file-stream', 'false',
     ]
     servers = [await manager.server_add(cmdline=cmdline)]
 
@@ -325,7 +328,8 @@ async def test_table_dropped_during_streaming(manager: ManagerClient):
     """
 
     logger.info("Bootstrapping cluster")
-    servers = [await manager.server_add()]
+    cfg = {'enable_file_stream': False}
+    servers = [await manager.server_add(config=cfg)]
 
     await manager.api.disable_tablet_balancing(servers[0].ip_addr)
 
@@ -334,7 +338,7 @@ async def test_table_dropped_during_streaming(manager: ManagerClient):
     await cql.run_async("CREATE TABLE test.test (pk int PRIMARY KEY, c int);")
     await cql.run_async("CREATE TABLE test.test2 (pk int PRIMARY KEY, c int);")
 
-    servers.append(await manager.server_add())
+    servers.append(await manager.server_add(config=cfg))
 
     logger.info("Populating tables")
     key = 7 # Whatever
@@ -518,6 +522,48 @@ async def test_tablet_repair_history(manager: ManagerClient):
 
     await cql.run_async("DROP KEYSPACE test;")
 
+@pytest.mark.repair
+@pytest.mark.asyncio
+async def test_tablet_incremental_repair_marks_sstables_repaired(manager: ManagerClient, tmp_path):
+    """Incremental repair marks the sstables of the repaired ranges as
+    repaired on all the replicas, including the repair master, and
+    including the sstables written from the rows a replica missed."""
+    cmdline = ['--hinted-handoff-enabled', 'false', '--enable-incremental-repair', 'true']
+    servers = await manager.servers_add(3, cmdline=cmdline)
+
+    cql = manager.get_cql()
+    await cql.run_async("CREATE KEYSPACE test WITH replication = {'class': 'NetworkTopologyStrategy', "
+                  "'replication_factor': 3} AND tablets = {'initial': 4};")
+    schema = "CREATE TABLE test.test (pk int PRIMARY KEY, c int)"
+    await cql.run_async(schema)
+    for s in servers:
+        await manager.api.disable_autocompaction(s.ip_addr, "test", "test")
+
+    await asyncio.gather(*[cql.run_async(f"INSERT INTO test.test (pk, c) VALUES ({k}, {k});") for k in range(100)])
+
+    # Let the last node miss some rows, for repair to send them to it.
+    await manager.server_stop_gracefully(servers[-1].server_id)
+    stmt = SimpleStatement("INSERT INTO test.test (pk, c) VALUES (%s, %s)", consistency_level=ConsistencyLevel.ONE)
+    await asyncio.gather(*[cql.run_async(stmt, [k, k]) for k in range(100, 200)])
+    await manager.server_start(servers[-1].server_id)
+    await manager.api.disable_autocompaction(servers[-1].ip_addr, "test", "test")
+    cql = await reconnect_driver(manager)
+
+    await repair_on_node(manager, servers[0], servers)
+
+    schema_file = tmp_path / "schema.cql"
+    schema_file.write_text(schema)
+    for s in servers:
+        scylla_exe = await manager.server_get_exe(s.server_id)
+        workdir = await manager.server_get_workdir(s.server_id)
+        sstables = glob.glob(os.path.join(workdir, "data", "test", "test-*", "*-Data.db"))
+        assert sstables, f"No sstables on {s.ip_addr}"
+        out = subprocess.check_output([scylla_exe, "sstable", "dump-statistics",
+                                       "--schema-file", str(schema_file), *sstables])
+        for sst, stats in json.loads(out)["sstables"].items():
+            logger.info(f"{s.ip_addr}: {sst} repaired_at={stats['stats']['repaired_at']}")
+            assert stats["stats"]["repaired_at"] != 0, f"{sst} of {s.ip_addr} is not marked as repaired"
+
 @pytest.mark.repair
 @pytest.mark.asyncio
 async def test_tablet_repair_ranges_selection(manager: ManagerClient):
@@ -1055,3 +1101,82 @@ async def test_tablet_storage_freeing(manager: ManagerClient):
     logger.info("Verify that the table's disk usage on first node shrunk by about half.")
     size_after = await manager.server_get_sstables_disk_usage(servers[0].server_id, "test", "test")
     assert size_before * 0.33 < size_after < size_before * 0.66
+
+@pytest.mark.asyncio
+async def test_tablet_migration_streams_files(manager: ManagerClient):
+    logger.info("Bootstrapping cluster")
+    cmdline = ['--logger-log-level', 'stream_session=debug']
+    servers = [await manager.server_add(cmdline=cmdline)]
+    await manager.api.disable_tablet_balancing(servers[0].ip_addr)
+
+    cql = manager.get_cql()
+    await cql.run_async("CREATE KEYSPACE test WITH replication = {'class': 'NetworkTopologyStrategy', 'replication_factor': 1} AND tablets = {'initial': 1};")
+    await cql.run_async("CREATE TABLE test.test (pk int PRIMARY KEY, c int);")
+    insert_stmt = cql.prepare("INSERT INTO test.test (pk, c) VALUES (?, ?);")
+    keys = range(1000)
+    await asyncio.gather(*[cql.run_async(insert_stmt, [k, k]) for k in keys])
+    await manager.api.keyspace_flush(servers[0].ip_addr, "test")
+
+    servers.append(await manager.server_add(cmdline=cmdline))
+    s1_host_id = await manager.get_host_id(servers[1].server_id)
+    s1_log = await manager.server_open_log(servers[1].server_id)
+    s1_mark = await s1_log.mark()
+
+    logger.info("Migrating the tablet to the second node")
+    tablet_token = 0 # Doesn't matter since there is one tablet
+    replica = await get_tablet_replica(manager, servers[0], 'test', 'test', tablet_token)
+    await manager.api.move_tablet(servers[0].ip_addr, "test", "test", replica[0], replica[1], s1_host_id, 0, tablet_token)
+    await s1_log.wait_for('Attached [1-9][0-9]* sstables received for test.test', from_mark=s1_mark)
+
+    rows = await cql.run_async("SELECT * FROM test.test;")
+    assert len(rows) == len(keys)
+    for r in rows:
+        assert r.c == r.pk
+
+    logger.info("Restarting the second node to check the received sstables are complete")
+    await manager.server_restart(servers[1].server_id)
+    cql = await reconnect_driver(manager)
+    await wait_for_cql_and_get_hosts(cql, servers, time.time() + 60)
+    rows = await cql.run_async("SELECT * FROM test.test;")
+    assert len(rows) == len(keys)
+
+@pytest.mark.asyncio
+@skip_mode('release', 'error injections are not supported in release mode')
+async def test_tablet_migration_discards_files_of_failed_file_stream(manager: ManagerClient):
+    logger.info("Bootstrapping cluster")
+    cmdline = ['--logger-log-level', 'stream_session=debug']
+    servers = [await manager.server_add(cmdline=cmdline)]
+    await manager.api.disable_tablet_balancing(servers[0].ip_addr)
+
+    cql = manager.get_cql()
+    await cql.run_async("CREATE KEYSPACE test WITH replication = {'class': 'NetworkTopologyStrategy', 'replication_factor': 1} AND tablets = {'initial': 1};")
+    await cql.run_async("CREATE TABLE test.test (pk int PRIMARY KEY, c int);")
+    insert_stmt = cql.prepare("INSERT INTO test.test (pk, c) VALUES (?, ?);")
+    keys = range(1000)
+    await asyncio.gather(*[cql.run_async(insert_stmt, [k, k]) for k in keys])
+    await manager.api.keyspace_flush(servers[0].ip_addr, "test")
+
+    servers.append(await manager.server_add(cmdline=cmdline))
+    s1_host_id = await manager.get_host_id(servers[1].server_id)
+    s1_log = await manager.server_open_log(servers[1].server_id)
+    s1_mark = await s1_log.mark()
+
+    # Fail a file received, while other files may be in flight.
+    await manager.api.enable_injection(servers[1].ip_addr, "stream_blob_receive_file_fail", one_shot=True)
+
+    logger.info("Migrating the tablet to the second node")
+    tablet_token = 0 # Doesn't matter since there is one tablet
+    replica = await get_tablet_replica(manager, servers[0], 'test', 'test', tablet_token)
+    migration_task = asyncio.create_task(
+        manager.api.move_tablet(servers[0].ip_addr, "test", "test", replica[0], replica[1], s1_host_id, 0, tablet_token))
+    await s1_log.wait_for('Failed to receive file', from_mark=s1_mark)
+    await s1_log.wait_for('Discarded [0-9]+ received files', from_mark=s1_mark)
+
+    # Streaming is retried, and succeeds.
+    await migration_task
+    await s1_log.wait_for('Attached [1-9][0-9]* sstables received for test.test', from_mark=s1_mark)
+
+    rows = await cql.run_async("SELECT * FROM test.test;")
+    assert len(rows) == len(keys)
+    for r in rows:
+        assert r.c == r.pk
@@ -69,6 +69,11 @@ class tombstone_gc_state {
     gc_clock::time_point get_gc_before_for_key(schema_ptr s, const dht::decorated_key& dk, const gc_clock::time_point& query_time) const;
 
     void update_repair_time(table_id id, const dht::token_range& range, gc_clock::time_point repair_time);
+
+    // Returns the time of the least recent repair of the parts of the range,
+    // whatever the tombstone_gc mode, or std::nullopt if some part of the
+    // range is missing from the repair history.
+    std::optional<gc_clock::time_point> get_repair_time_for_range(const table_id& id, const dht::token_range& range) const;
 };
 
 std::map<sstring, sstring> get_default_tombstonesonte_gc_mode(data_dictionary::database db, sstring ks_name);
@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include <fmt/core.h>
+
+#include "utils/UUID.hh"
+
+namespace tracing {
+
+using elapsed_clock = std::chrono::steady_clock;
+
+// The stages of a request which are timed in every tracing session, including
+// the lightweight ones of the slow query log which don't record trace events.
+//
+// Unlike trace events, stages are recorded without formatting nor allocating
+// anything, so that recording them for every request costs next to nothing.
+enum class request_stage : uint8_t {
+    // The coordinator started reading the request from the client connection.
+    received,
+    // The coordinator had memory for the request and started to process it.
+    admitted,
+    // A read got past the reader concurrency semaphore.
+    read_admitted,
+    // A read found the partition in the cache, or started to scan it.
+    cache_read,
+    // A read didn't find the partition in the cache.
+    cache_miss,
+    // A read started to read an sstable.
+    sstable_read,
+    // A mutation was applied locally.
+    local_write,
+    // The coordinator sent a request to a replica.
+    replica_request_sent,
+    // The coordinator got a response from a replica.
+    replica_response_received,
+    // The coordinator is done and is about to send the response.
+    response_ready,
+};
+
+// The stages a request went through, with when, in the order they happened.
+// Stages which repeat, like reading one sstable after the other or getting
+// the response of each replica, only keep their first and last marks, so
+// that every stage fits and the last ones, like response_ready, are never
+// crowded out.
+class stage_marks {
+public:
+    static constexpr size_t stage_count = size_t(request_stage::response_ready) + 1;
+    static constexpr size_t max_marks = 2 * stage_count;
+
+    struct mark {
+        request_stage stage;
+        elapsed_clock::time_point at;
+    };
+private:
+    std::array<mark, max_marks> _marks;
+    uint8_t _size = 0;
+public:
+    void add(request_stage stage, elapsed_clock::time_point at = elapsed_clock::now()) noexcept {
+        size_t seen = 0;
+        size_t last = 0;
+        for (size_t i = 0; i < _size; ++i) {
+            if (_marks[i].stage == stage) {
+                ++seen;
+                last = i;
+            }
+        }
+        // The new mark replaces the previous last one of the stage.
+        if (seen == 2) {
+            std::copy(_marks.begin() + last + 1, _marks.begin() + _size, _marks.begin() + last);
+            --_size;
+        }
+        _marks[_size++] = mark{stage, at};
+    }
+
+    const mark* begin() const noexcept {
+        return _marks.data();
+    }
+
+    const mark* end() const noexcept {
+        return _marks.data() + _size;
+    }
+
+    size_t size() const noexcept {
+        return _size;
+    }
+};
+
+// The stages of a request which is done, relative to the beginning of its
+// tracing session. Stages which preceded the session, like receiving the
+// request, have negative offsets.
+struct latency_breakdown {
+    struct stage_offset {
+        request_stage stage;
+        int32_t offset_us;
+    };
+
+    utils::UUID session_id;
+    std::chrono::system_clock::time_point started_at;
+    uint32_t duration_us = 0;
+    uint8_t size = 0;
+    std::array<stage_offset, stage_marks::max_marks> stages;
+};
+
+// Keeps the latency breakdowns of the last requests of a shard, overwriting
+// the oldest ones. Like everything in a shard, it is only accessed by the
+// shard, so it needs no synchronization.
+class latency_breakdown_ring {
+    std::vector<latency_breakdown> _entries;
+    size_t _next = 0;
+    bool _full = false;
+public:
+    explicit latency_breakdown_ring(size_t capacity)
+        : _entries(capacity)
+    { }
+
+    latency_breakdown& next() noexcept {
+        auto& e = _entries[_next];
+        if (++_next == _entries.size()) {
+            _next = 0;
+            _full = true;
+        }
+        return e;
+    }
+
+    // Oldest first.
+    template <typename Func>
+    void for_each(Func&& func) const {
+        if (_full) {
+            for (size_t i = _next; i < _entries.size(); ++i) {
+                func(_entries[i]);
+            }
+        }
+        for (size_t i = 0; i < _next; ++i) {
+            func(_entries[i]);
+        }
+    }
+};
+
+std::string_view to_string(request_stage stage) noexcept;
+
+}
+
+template <> struct fmt::formatter<tracing::request_stage> : fmt::formatter<std::string_view> {
+    auto format(tracing::request_stage stage, fmt::format_context& ctx) const {
+        return fmt::formatter<std::string_view>::format(tracing::to_string(stage), ctx);
+    }
+};
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+#include <fmt/core.h>
+
+namespace tracing {
+
+// What the reads of a tracing session did with the caches and the sstables,
+// to tell why a read was slow: reading many sstables, bloom filter false
+// positives, index pages missing from the caches, or plenty of tombstones.
+//
+// Like the request stages, they are counted in every tracing session,
+// including the lightweight ones of the slow query log.
+struct read_io_stats {
+    // Partitions read from the row cache, or missing from it.
+    uint64_t row_cache_hits = 0;
+    uint64_t row_cache_misses = 0;
+    // Sstables read, including the ones which didn't have the partition.
+    uint64_t sstables_read = 0;
+    // Sstables whose bloom filter had the partition, but not the sstable.
+    uint64_t filter_false_positives = 0;
+    // Index pages found in the partition index cache, parsed anew, or
+    // waited for while another read was parsing them.
+    uint64_t index_page_hits = 0;
+    uint64_t index_page_misses = 0;
+    uint64_t index_page_waits = 0;
+    // Pages of the index file found in its page cache, or read from disk.
+    uint64_t index_file_page_hits = 0;
+    uint64_t index_file_page_misses = 0;
+    uint64_t index_bytes_from_cache = 0;
+    uint64_t index_bytes_from_disk = 0;
+    // Bytes of the data file read from disk, compressed if it is.
+    uint64_t data_bytes_from_disk = 0;
+    // Partition, row and range tombstones read from sstables.
+    uint64_t tombstones_read = 0;
+
+    bool empty() const noexcept {
+        bool ret = true;
+        for_each([&ret] (std::string_view, uint64_t v) { ret &= !v; });
+        return ret;
+    }
+
+    template <typename Func>
+    void for_each(Func&& func) const {
+        func("row_cache_hits", row_cache_hits);
+        func("row_cache_misses", row_cache_misses);
+        func("sstables_read", sstables_read);
+        func("filter_false_positives", filter_false_positives);
+        func("index_page_hits", index_page_hits);
+        func("index_page_misses", index_page_misses);
+        func("index_page_waits", index_page_waits);
+        func("index_file_page_hits", index_file_page_hits);
+        func("index_file_page_misses", index_file_page_misses);
+        func("index_bytes_from_cache", index_bytes_from_cache);
+        func("index_bytes_from_disk", index_bytes_from_disk);
+        func("data_bytes_from_disk", data_bytes_from_disk);
+        func("tombstones_read", tombstones_read);
+    }
+};
+
+// How a page of the partition index was found by a read.
+enum class index_page_lookup : uint8_t {
+    // The page was in the cache.
+    hit,
+    // The page was read and parsed by this read.
+    miss,
+    // Another read was loading the page, this one waited for it.
+    wait,
+};
+
+// The sstable component read through a traced file, whose reads are
+// accounted as reads from disk.
+enum class read_io_component : uint8_t {
+    none,
+    index,
+    data,
+};
+
+}
+
+template <> struct fmt::formatter<tracing::read_io_stats> : fmt::formatter<std::string_view> {
+    auto format(const tracing::read_io_stats& s, fmt::format_context& ctx) const {
+        auto out = ctx.out();
+        const char* sep = "";
+        s.for_each([&] (std::string_view name, uint64_t v) {
+            out = fmt::format_to(out, "{}{}={}", sep, name, v);
+            sep = " ";
+        });
+        return out;
+    }
+};
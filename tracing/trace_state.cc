@@ -206,6 +206,12 @@ void trace_state::stop_foreground_and_write() noexcept {
     }
 
     if (is_in_state(state::foreground)) {
+        // Secondary sessions have no parameters, so this is the only way
+        // to see what the reads of a replica did.
+        if (!ignore_events() && !_read_io_stats.empty()) {
+            trace("Read I/O: {}", _read_io_stats);
+        }
+
         auto e = elapsed();
         _records->do_log_slow_query = should_log_slow_query(e);
 
@@ -222,6 +228,7 @@ void trace_state::stop_foreground_and_write() noexcept {
             _records->consume_from_budget();
 
             _records->session_rec.elapsed = e;
+            record_latency_breakdown(e);
 
             // build_parameters_map() may throw. We don't want to record the
             // session's record in this case since its data may be incomplete.
@@ -231,6 +238,10 @@ void trace_state::stop_foreground_and_write() noexcept {
             if (should_write_records()) {
                 try {
                     build_parameters_map();
+                    add_read_io_parameters();
+                    if (ignore_events()) {
+                        add_stage_events();
+                    }
                 } catch (...) {
                     // Bump up an error counter, drop any pending records and
                     // continue
@@ -252,6 +263,40 @@ void trace_state::stop_foreground_and_write() noexcept {
     }
 }
 
+void trace_state::record_latency_breakdown(elapsed_clock::duration e) noexcept {
+    using namespace std::chrono;
+    auto& b = _local_tracing_ptr->next_latency_breakdown();
+    b.session_id = session_id();
+    b.started_at = _records->session_rec.started_at;
+    b.duration_us = duration_cast<microseconds>(e).count();
+    b.size = 0;
+    for (auto& m : _stage_marks) {
+        b.stages[b.size++] = {m.stage, int32_t(duration_cast<microseconds>(m.at - _start).count())};
+    }
+}
+
+void trace_state::add_stage_events() {
+    if (!_local_tracing_ptr->have_records_budget(_stage_marks.size())) {
+        return;
+    }
+    for (auto& m : _stage_marks) {
+        auto e = m.at - _start;
+        _records->events_recs.emplace_back(format("Reached stage {}", m.stage), e,
+                _records->session_rec.started_at + std::chrono::duration_cast<i_tracing_backend_helper::wall_clock::duration>(e));
+        _records->consume_from_budget();
+    }
+}
+
+void trace_state::add_read_io_parameters() {
+    if (_read_io_stats.empty()) {
+        return;
+    }
+    auto& params_map = _records->session_rec.parameters;
+    _read_io_stats.for_each([&params_map] (std::string_view name, uint64_t v) {
+        params_map.emplace(format("read_io.{}", name), seastar::format("{:d}", v));
+    });
+}
+
 sstring trace_state::raw_value_to_sstring(const cql3::raw_value_view& v, bool is_unset, const data_type& t) {
     static constexpr int max_val_bytes = 64;
 
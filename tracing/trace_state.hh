@@ -14,6 +14,7 @@
 #include <seastar/core/weak_ptr.hh>
 #include <seastar/core/checked_ptr.hh>
 #include "tracing/tracing.hh"
+#include "tracing/read_io_stats.hh"
 #include "gms/inet_address.hh"
 #include "auth/authenticated_user.hh"
 #include "db/consistency_level_type.hh"
@@ -71,6 +72,8 @@ class trace_state final {
     std::optional<uint64_t> _supplied_start_ts_us; // Parent's `_start`, as microseconds from POSIX epoch.
     std::chrono::microseconds _slow_query_threshold;
     state _state = state::inactive;
+    stage_marks _stage_marks;
+    read_io_stats _read_io_stats;
 
     struct params_values;
     struct params_values_deleter {
@@ -241,6 +244,54 @@ class trace_state final {
         return full_tracing() || _records->do_log_slow_query;
     }
 
+    /**
+     * Records that the request reached a stage.
+     *
+     * Stages may be recorded before the session begins, for the ones which
+     * precede it, like receiving the request.
+     *
+     * @param stage the stage
+     * @param at when the request reached it
+     */
+    void mark(request_stage stage, elapsed_clock::time_point at) noexcept {
+        if (!is_in_state(state::background)) {
+            _stage_marks.add(stage, at);
+        }
+    }
+
+    /**
+     * What the reads of this session did with the caches and the sstables so
+     * far. Meant to be updated by the account_*() helpers.
+     */
+    read_io_stats& read_io() noexcept {
+        return _read_io_stats;
+    }
+
+    const read_io_stats& read_io() const noexcept {
+        return _read_io_stats;
+    }
+
+    /**
+     * Fills in the latency breakdown of a primary session which is done.
+     *
+     * @param e the session's duration
+     */
+    void record_latency_breakdown(elapsed_clock::duration e) noexcept;
+
+    /**
+     * Adds the recorded stages to the session's events.
+     *
+     * Sessions which ignore events would otherwise be written without a clue
+     * about where their time went.
+     */
+    void add_stage_events();
+
+    /**
+     * Adds the read I/O counters to the session's parameters, which end up in
+     * the slow query log.
+     */
+    void add_read_io_parameters();
+
     /**
      * Returns the amount of time passed since the beginning of this tracing session.
      *
@@ -493,6 +544,7 @@ class trace_state final {
     friend void add_table_name(const trace_state_ptr& p, const sstring& ks_name, const sstring& cf_name);
     friend void add_prepared_query_options(const trace_state_ptr& state, const cql3::query_options& prepared_options_ptr);
     friend void stop_foreground(const trace_state_ptr& state) noexcept;
+    friend void mark(const trace_state_ptr& p, request_stage stage, elapsed_clock::time_point at) noexcept;
 };
 
 class trace_state_ptr final {
@@ -657,6 +709,129 @@ inline void add_table_name(const trace_state_ptr& p, const sstring& ks_name, con
     }
 }
 
+/**
+ * Records that a request reached a stage at a given time, if it's traced.
+ *
+ * Unlike trace(), this is done for all the sessions, including the ones which
+ * ignore events, and costs next to nothing.
+ *
+ * @param p trace state handle
+ * @param stage the stage
+ * @param at when the request reached it
+ */
+inline void mark(const trace_state_ptr& p, request_stage stage, elapsed_clock::time_point at) noexcept {
+    if (p) {
+        p->mark(stage, at);
+    }
+}
+
+/**
+ * Records that a request reached a stage now, if it's traced.
+ *
+ * The clock is only read for traced requests.
+ *
+ * @param p trace state handle
+ * @param stage the stage
+ */
+inline void mark(const trace_state_ptr& p, request_stage stage) noexcept {
+    if (p) {
+        p->mark(stage, elapsed_clock::now());
+    }
+}
+
+/**
+ * Accounts a partition looked up in the row cache by a traced read.
+ *
+ * @param p trace state handle
+ * @param hit whether the partition was in the cache
+ */
+inline void account_row_cache_read(const trace_state_ptr& p, bool hit) noexcept {
+    if (p) {
+        ++(hit ? p->read_io().row_cache_hits : p->read_io().row_cache_misses);
+    }
+}
+
+/**
+ * Accounts an sstable read by a traced read, and whether its bloom filter
+ * lied about having the partition.
+ *
+ * @param p trace state handle
+ * @param filter_false_positive whether the sstable turned out not to have
+ *                              the partition its filter claimed it had
+ */
+inline void account_sstable_read(const trace_state_ptr& p, bool filter_false_positive = false) noexcept {
+    if (p) {
+        ++p->read_io().sstables_read;
+        p->read_io().filter_false_positives += filter_false_positive;
+    }
+}
+
+/**
+ * Accounts a page of the partition index looked up by a traced read.
+ *
+ * @param p trace state handle
+ * @param lookup how the page was found in the partition index cache
+ */
+inline void account_index_page_read(const trace_state_ptr& p, index_page_lookup lookup) noexcept {
+    if (p) {
+        auto& s = p->read_io();
+        switch (lookup) {
+        case index_page_lookup::hit: ++s.index_page_hits; break;
+        case index_page_lookup::miss: ++s.index_page_misses; break;
+        case index_page_lookup::wait: ++s.index_page_waits; break;
+        }
+    }
+}
+
+/**
+ * Accounts pages of the index file read by a traced read, through its page
+ * cache.
+ *
+ * @param p trace state handle
+ * @param hit whether the page was in the cache
+ * @param bytes how much was read from the cache or from disk
+ */
+inline void account_index_file_read(const trace_state_ptr& p, bool hit, size_t bytes) noexcept {
+    if (p) {
+        auto& s = p->read_io();
+        if (hit) {
+            ++s.index_file_page_hits;
+            s.index_bytes_from_cache += bytes;
+        } else {
+            ++s.index_file_page_misses;
+            s.index_bytes_from_disk += bytes;
+        }
+    }
+}
+
+/**
+ * Accounts bytes of an sstable component read from disk by a traced read.
+ *
+ * @param p trace state handle
+ * @param component the component read
+ * @param bytes how much was read
+ */
+inline void account_disk_read(const trace_state_ptr& p, read_io_component component, size_t bytes) noexcept {
+    if (p) {
+        switch (component) {
+        case read_io_component::index: p->read_io().index_bytes_from_disk += bytes; break;
+        case read_io_component::data: p->read_io().data_bytes_from_disk += bytes; break;
+        case read_io_component::none: break;
+        }
+    }
+}
+
+/**
+ * Accounts a tombstone read from an sstable by a traced read.
+ *
+ * @param p trace state handle
+ */
+inline void account_tombstone_read(const trace_state_ptr& p) noexcept {
+    if (p) {
+        ++p->read_io().tombstones_read;
+    }
+}
+
 inline bool should_return_id_in_response(const trace_state_ptr& p) {
     if (p) {
         return p->write_on_close();
@@ -19,9 +19,10 @@ class traced_file_impl : public file_impl {
 
     tracing::trace_state_ptr _trace_state;
     sstring _trace_prefix;
+    tracing::read_io_component _component;
 
 public:
-    traced_file_impl(file, tracing::trace_state_ptr, sstring);
+    traced_file_impl(file, tracing::trace_state_ptr, sstring, tracing::read_io_component);
 
     virtual future<size_t> write_dma(uint64_t pos, const void* buf, size_t len, io_intent*) override;
     virtual future<size_t> write_dma(uint64_t pos, std::vector<iovec> iov, io_intent*) override;
@@ -39,8 +40,8 @@ class traced_file_impl : public file_impl {
     virtual future<temporary_buffer<uint8_t>> dma_read_bulk(uint64_t offset, size_t range_size, io_intent*) override;
 };
 
-traced_file_impl::traced_file_impl(file f, tracing::trace_state_ptr trace_state, sstring trace_prefix)
-        : file_impl(*get_file_impl(f)), _f(std::move(f)), _trace_state(std::move(trace_state)), _trace_prefix(std::move(trace_prefix)) {
+traced_file_impl::traced_file_impl(file f, tracing::trace_state_ptr trace_state, sstring trace_prefix, tracing::read_io_component component)
+        : file_impl(*get_file_impl(f)), _f(std::move(f)), _trace_state(std::move(trace_state)), _trace_prefix(std::move(trace_prefix)), _component(component) {
 }
 
 future<size_t>
@@ -80,6 +81,7 @@ traced_file_impl::read_dma(uint64_t pos, void* buf, size_t len, io_intent* inten
         try {
             auto ret = f.get();
             tracing::trace(_trace_state, "{} finished DMA read of {} bytes at position {}, successfully read {} bytes", _trace_prefix, len, pos, ret);
+            tracing::account_disk_read(_trace_state, _component, ret);
             return ret;
         } catch (...) {
             tracing::trace(_trace_state, "{} failed DMA read of {} bytes at position {}: {}", _trace_prefix, len, pos, std::current_exception());
@@ -95,6 +97,7 @@ traced_file_impl::read_dma(uint64_t pos, std::vector<iovec> iov, io_intent* inte
         try {
             auto ret = f.get();
             tracing::trace(_trace_state, "{} finished DMA read at position {}, successfully read {} bytes", _trace_prefix, pos, ret);
+            tracing::account_disk_read(_trace_state, _component, ret);
             return ret;
         } catch (...) {
             tracing::trace(_trace_state, "{} failed DMA read at position {}: {}", _trace_prefix, pos, std::current_exception());
@@ -221,6 +224,7 @@ traced_file_impl::dma_read_bulk(uint64_t offset, size_t range_size, io_intent* i
             auto ret = f.get();
             tracing::trace(_trace_state, "{} finished bulk DMA read of size {} at offset {}, successfully read {} bytes",
                     _trace_prefix, range_size, offset, ret.size());
+            tracing::account_disk_read(_trace_state, _component, ret.size());
             return ret;
         } catch (...) {
             tracing::trace(_trace_state, "{} failed a bulk DMA read of size {} at offset {}: {}",
@@ -232,8 +236,8 @@ traced_file_impl::dma_read_bulk(uint64_t offset, size_t range_size, io_intent* i
 
 namespace tracing {
 
-file make_traced_file(file f, trace_state_ptr trace_state, sstring trace_prefix) {
-    return file(::make_shared<traced_file_impl>(std::move(f), std::move(trace_state), std::move(trace_prefix)));
+file make_traced_file(file f, trace_state_ptr trace_state, sstring trace_prefix, read_io_component component) {
+    return file(::make_shared<traced_file_impl>(std::move(f), std::move(trace_state), std::move(trace_prefix), component));
 }
 
 } // namespace tracing
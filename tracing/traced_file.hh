@@ -19,7 +19,11 @@ namespace tracing {
 
 // To identify messages for this particular file, `trace_prefix` is prepended to every such message.
 
+// Reads are accounted to `trace_state` as reads of `component` from disk, unless
+// it is read_io_component::none.
+
 // Note: calling dup() on the wrapper returns a handle to the underlying file.
-seastar::file make_traced_file(seastar::file f, trace_state_ptr trace_state, seastar::sstring trace_prefix);
+seastar::file make_traced_file(seastar::file f, trace_state_ptr trace_state, seastar::sstring trace_prefix,
+        read_io_component component = read_io_component::none);
 
 } // namespace tracing
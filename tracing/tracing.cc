@@ -27,13 +27,30 @@ std::vector<sstring> trace_type_names = {
     "REPAIR"
 };
 
+std::string_view to_string(request_stage stage) noexcept {
+    switch (stage) {
+    case request_stage::received: return "received";
+    case request_stage::admitted: return "admitted";
+    case request_stage::read_admitted: return "read_admitted";
+    case request_stage::cache_read: return "cache_read";
+    case request_stage::cache_miss: return "cache_miss";
+    case request_stage::sstable_read: return "sstable_read";
+    case request_stage::local_write: return "local_write";
+    case request_stage::replica_request_sent: return "replica_request_sent";
+    case request_stage::replica_response_received: return "replica_response_received";
+    case request_stage::response_ready: return "response_ready";
+    }
+    return "unknown";
+}
+
 tracing::tracing(sstring tracing_backend_helper_class_name)
         : _write_timer([this] { write_timer_callback(); })
         , _thread_name(seastar::format("shard {:d}", this_shard_id()))
         , _tracing_backend_helper_class_name(std::move(tracing_backend_helper_class_name))
         , _gen(std::random_device()())
         , _slow_query_duration_threshold(default_slow_query_duraion_threshold)
-        , _slow_query_record_ttl(default_slow_query_record_ttl) {
+        , _slow_query_record_ttl(default_slow_query_record_ttl)
+        , _latency_breakdowns(max_latency_breakdowns) {
     namespace sm = seastar::metrics;
 
     _metrics.add_group("tracing", {
@@ -20,6 +20,7 @@
 #include "enum_set.hh"
 #include "log.hh"
 #include "seastarx.hh"
+#include "tracing/latency_breakdown.hh"
 
 namespace service {
 class migration_manager;
@@ -29,8 +30,6 @@ namespace cql3 { class query_processor; }
 
 namespace tracing {
 
-using elapsed_clock = std::chrono::steady_clock;
-
 extern logging::logger tracing_logger;
 
 class trace_state_ptr;
@@ -302,6 +301,8 @@ class tracing : public seastar::async_sharded_service<tracing> {
     static constexpr int write_event_records_threshold = write_event_sessions_threshold * exp_trace_events_per_session;
     // Number of events when an info message is printed
     static constexpr int log_warning_period = 10000;
+    // number of latency breakdowns of the last requests kept per-shard
+    static constexpr size_t max_latency_breakdowns = 1000;
 
     static const std::chrono::microseconds default_slow_query_duraion_threshold;
     static const std::chrono::seconds default_slow_query_record_ttl;
@@ -388,6 +389,8 @@ class tracing : public seastar::async_sharded_service<tracing> {
     std::ranlux48_base _gen;
     std::chrono::microseconds _slow_query_duration_threshold;
     std::chrono::seconds _slow_query_record_ttl;
+    // The stages of the last primary sessions which were done.
+    latency_breakdown_ring _latency_breakdowns;
 
 public:
     uint64_t get_next_rand_uint64() {
@@ -629,6 +632,25 @@ class tracing : public seastar::async_sharded_service<tracing> {
         return _slow_query_record_ttl;
     }
 
+    /**
+     * Returns the entry of the latency breakdown ring to fill in for a session
+     * which is done, overwriting the oldest one.
+     */
+    latency_breakdown& next_latency_breakdown() noexcept {
+        return _latency_breakdowns.next();
+    }
+
+    /**
+     * The latency breakdowns of the last primary sessions of this shard.
+     *
+     * Sessions are created for every request when the slow query logging is
+     * enabled, so this is where to look for the stage a slow request spent its
+     * time in, including the ones which weren't slow enough to be logged.
+     */
+    const latency_breakdown_ring& latency_breakdowns() const noexcept {
+        return _latency_breakdowns;
+    }
+
 private:
     void write_timer_callback();
 
@@ -36,6 +36,8 @@
 #include <seastar/util/lazy.hh>
 #include <seastar/util/short_streams.hh>
 #include <seastar/core/execution_stage.hh>
+#include <seastar/core/with_scheduling_group.hh>
+#include "utils/error_injection.hh"
 #include "utils/result_try.hh"
 #include "utils/result_combinators.hh"
 #include "db/operation_type.hh"
@@ -201,6 +203,14 @@ cql_sg_stats::cql_sg_stats(maintenance_socket_enabled used_by_maintenance_socket
     register_metrics();
 }
 
+void cql_sg_stats::rename_metrics() {
+    auto& vector_ref = non_cql_scheduling_classes_names;
+    _metrics.clear();
+    if (std::find(vector_ref.begin(), vector_ref.end(), current_scheduling_group().name()) == vector_ref.end()) {
+        register_metrics();
+    }
+}
+
 void cql_sg_stats::register_metrics()
 {
     namespace sm = seastar::metrics;
@@ -264,6 +274,14 @@ cql_server::cql_server(distributed<cql3::query_processor>& qp, auth::service& au
         sm::make_counter("requests_served", _stats.requests_served,
                         sm::description("Counts a number of served requests.")),
 
+        sm::make_counter("response_batches", _stats.response_batches,
+                        sm::description("Counts the batches of responses written to the clients. Responses which complete while the previous ones "
+                                        "are being written are written and flushed together, so the ratio of requests_served to this shows how much they are batched.")),
+
+        sm::make_gauge("requests_rate", [this] { return load().request_rate; },
+                        sm::description("Holds the rate of requests per second, smoothed over the last few seconds. "
+                                        "Shard-aware drivers are pointed to the shards with a lower rate when they connect.")),
+
         sm::make_gauge("requests_serving", _stats.requests_serving,
                         sm::description("Holds a number of requests that are being processed right now.")),
 
@@ -406,7 +424,7 @@ cql_server::connection::read_frame() {
 }
 
 future<foreign_ptr<std::unique_ptr<cql_server::response>>>
-    cql_server::connection::process_request_one(fragmented_temporary_buffer::istream fbuf, uint8_t op, uint16_t stream, service::client_state& client_state, tracing_request_type tracing_request, service_permit permit) {
+    cql_server::connection::process_request_one(fragmented_temporary_buffer::istream fbuf, uint8_t op, uint16_t stream, service::client_state& client_state, tracing_request_type tracing_request, tracing::elapsed_clock::time_point received, service_permit permit) {
     using auth_state = service::client_state::auth_state;
 
     auto cqlop = static_cast<cql_binary_opcode>(op);
@@ -423,6 +441,8 @@ future<foreign_ptr<std::unique_ptr<cql_server::response>>>
             cqlop == cql_binary_opcode::BATCH) {
             trace_props.set_if<tracing::trace_state_props::write_on_close>(tracing_request == tracing_request_type::write_on_close);
             trace_state = tracing::tracing::get_local_tracing_instance().create_session(tracing::trace_type::QUERY, trace_props);
+            tracing::mark(trace_state, tracing::request_stage::received, received);
+            tracing::mark(trace_state, tracing::request_stage::admitted);
         }
     }
 
@@ -693,6 +713,7 @@ future<> cql_server::connection::process_request() {
 
         auto op = f.opcode;
         auto stream = f.stream;
+        const auto received = tracing::elapsed_clock::now();
         auto mem_estimate = f.length * 2 + 8000; // Allow for extra copies and bookkeeping
         if (mem_estimate > _server._max_request_size) {
             const auto message = format("request size too large (frame size {:d}; estimate {:d}; allowed {:d})",
@@ -740,14 +761,14 @@ future<> cql_server::connection::process_request() {
             ++_server._stats.requests_blocked_memory;
         }
 
-        return fut.then_wrapped([this, length = f.length, flags = f.flags, op, stream, tracing_requested] (auto mem_permit_fut) {
+        return fut.then_wrapped([this, length = f.length, flags = f.flags, op, stream, tracing_requested, received] (auto mem_permit_fut) {
           if (mem_permit_fut.failed()) {
               // Ignore semaphore errors - they are expected if load shedding took place
               mem_permit_fut.ignore_ready_future();
               return make_ready_future<>();
           }
           semaphore_units<> mem_permit = mem_permit_fut.get();
-          return this->read_and_decompress_frame(length, flags).then([this, op, stream, tracing_requested, mem_permit = make_service_permit(std::move(mem_permit))] (fragmented_temporary_buffer buf) mutable {
+          return this->read_and_decompress_frame(length, flags).then([this, op, stream, tracing_requested, received, mem_permit = make_service_permit(std::move(mem_permit))] (fragmented_temporary_buffer buf) mutable {
 
             ++_server._stats.requests_served;
             ++_server._stats.requests_serving;
@@ -768,9 +789,17 @@ future<> cql_server::connection::process_request() {
                     op == uint8_t (cql_binary_opcode::EXECUTE) ||
                     op == uint8_t(cql_binary_opcode::BATCH));
 
-            future<foreign_ptr<std::unique_ptr<cql_server::response>>> request_process_future = should_paralelize ?
-                    _process_request_stage(this, istream, op, stream, seastar::ref(_client_state), tracing_requested, mem_permit) :
-                    process_request_one(istream, op, stream, seastar::ref(_client_state), tracing_requested, mem_permit);
+            auto process = [this, istream, op, stream, tracing_requested, received, mem_permit, should_paralelize] () mutable {
+                return should_paralelize ?
+                        _process_request_stage(this, istream, op, stream, seastar::ref(_client_state), tracing_requested, received, mem_permit) :
+                        process_request_one(istream, op, stream, seastar::ref(_client_state), tracing_requested, received, mem_permit);
+            };
+            // Statements of service levels with shares run in the scheduling
+            // group of the service level, isolated from the others.
+            auto sg = _client_state.get_scheduling_group();
+            future<foreign_ptr<std::unique_ptr<cql_server::response>>> request_process_future = sg ?
+                    with_scheduling_group(*sg, std::move(process)) :
+                    process();
 
             future<> request_response_future = request_process_future.then_wrapped([this, buf = std::move(buf), mem_permit, leave = std::move(leave), stream] (future<foreign_ptr<std::unique_ptr<cql_server::response>>> response_f) mutable {
                 try {
@@ -951,7 +980,17 @@ future<std::unique_ptr<cql_server::response>> cql_server::connection::process_au
 
 future<std::unique_ptr<cql_server::response>> cql_server::connection::process_options(uint16_t stream, request_reader in, service::client_state& client_state,
         tracing::trace_state_ptr trace_state) {
-    return make_ready_future<std::unique_ptr<cql_server::response>>(make_supported(stream, std::move(trace_state)));
+    std::optional<unsigned> less_loaded_shard;
+    if (_server._config.allow_shard_aware_drivers && smp::count > 1) {
+        // The hint is optional, so failing to collect the loads, e.g. while
+        // shutting down, must not fail the OPTIONS request.
+        try {
+            less_loaded_shard = generic_server::pick_less_loaded_shard(co_await _server.get_shard_loads(), this_shard_id());
+        } catch (...) {
+            clogger.debug("{}: failed to get shard loads, not hinting a shard: {}", _client_state.get_remote_address(), std::current_exception());
+        }
+    }
+    co_return make_supported(stream, less_loaded_shard, trace_state);
 }
 
 std::unique_ptr<cql_server::response>
@@ -1040,6 +1079,7 @@ process_query_internal(service::client_state& client_state, distributed<cql3::qu
             return process_fn_return_type(convert_error_message_to_coordinator_result(msg.get()));
         } else {
             tracing::trace(q_state->query_state.get_trace_state(), "Done processing - preparing a result");
+            tracing::mark(q_state->query_state.get_trace_state(), tracing::request_stage::response_ready);
             return process_fn_return_type(make_foreign(make_result(stream, *msg, q_state->query_state.get_trace_state(), version, skip_metadata)));
         }
     });
@@ -1144,6 +1184,7 @@ process_execute_internal(service::client_state& client_state, distributed<cql3::
             return process_fn_return_type(convert_error_message_to_coordinator_result(msg.get()));
         } else {
             tracing::trace(q_state->query_state.get_trace_state(), "Done processing - preparing a result");
+            tracing::mark(q_state->query_state.get_trace_state(), tracing::request_stage::response_ready);
             return process_fn_return_type(make_foreign(make_result(stream, *msg, q_state->query_state.get_trace_state(), version, skip_metadata)));
         }
     });
@@ -1265,6 +1306,7 @@ process_batch_internal(service::client_state& client_state, distributed<cql3::qu
             return process_fn_return_type(convert_error_message_to_coordinator_result(msg.get()));
         } else {
             tracing::trace(q_state->query_state.get_trace_state(), "Done processing - preparing a result");
+            tracing::mark(q_state->query_state.get_trace_state(), tracing::request_stage::response_ready);
             return process_fn_return_type(make_foreign(make_result(stream, *msg, trace_state, version)));
         }
     });
@@ -1432,7 +1474,7 @@ std::unique_ptr<cql_server::response> cql_server::connection::make_auth_challeng
     return response;
 }
 
-std::unique_ptr<cql_server::response> cql_server::connection::make_supported(int16_t stream, const tracing::trace_state_ptr& tr_state) const
+std::unique_ptr<cql_server::response> cql_server::connection::make_supported(int16_t stream, std::optional<unsigned> less_loaded_shard, const tracing::trace_state_ptr& tr_state) const
 {
     std::multimap<sstring, sstring> opts;
     opts.insert({"CQL_VERSION", cql3::query_processor::CQL_VERSION});
@@ -1450,6 +1492,9 @@ std::unique_ptr<cql_server::response> cql_server::connection::make_supported(int
         }
         opts.insert({"SCYLLA_SHARDING_IGNORE_MSB", format("{:d}", _server._config.sharding_ignore_msb)});
         opts.insert({"SCYLLA_PARTITIONER", _server._config.partitioner_name});
+        if (less_loaded_shard) {
+            opts.insert({"SCYLLA_LESS_LOADED_SHARD", format("{:d}", *less_loaded_shard)});
+        }
     }
     for (cql_protocol_extension ext : supported_cql_protocol_extensions()) {
         const sstring ext_key_name = protocol_extension_name(ext);
@@ -1586,13 +1631,34 @@ cql_server::connection::make_schema_change_event(const event::schema_change& eve
 
 void cql_server::connection::write_response(foreign_ptr<std::unique_ptr<cql_server::response>>&& response, service_permit permit, cql_compression compression)
 {
-    _ready_to_respond = _ready_to_respond.then([this, compression, response = std::move(response), permit = std::move(permit)] () mutable {
-        auto message = response->make_message(_version, compression);
-        message.on_delete([response = std::move(response)] { });
-        return _write_buf.write(std::move(message)).then([this] {
-            return _write_buf.flush();
+    // Responses completing while a batch is already scheduled, i.e. while
+    // the previous batch is being written, join it, instead of being written
+    // and flushed one by one.
+    bool schedule = _pending_responses.empty();
+    _pending_responses.push_back(pending_response{std::move(response), std::move(permit), compression});
+    if (schedule) {
+        _ready_to_respond = _ready_to_respond.then_wrapped([this] (future<> f) {
+            if (f.failed()) {
+                // Writing to the client failed, so nothing more will be
+                // written. Drop the responses, releasing their permits.
+                _pending_responses.clear();
+                return f;
+            }
+            return write_pending_responses();
         });
-    });
+    }
+}
+
+future<> cql_server::connection::write_pending_responses() {
+    auto responses = std::exchange(_pending_responses, {});
+    ++_server._stats.response_batches;
+    utils::get_local_injector().inject("transport_write_responses_failure", [] { throw std::runtime_error("Error injection: failing to write responses"); });
+    for (auto& r : responses) {
+        auto message = r.response->make_message(_version, r.compression);
+        message.on_delete([response = std::move(r.response)] { });
+        co_await _write_buf.write(std::move(message));
+    }
+    co_await _write_buf.flush();
 }
 
 scattered_message<char> cql_server::response::make_message(uint8_t version, cql_compression compression) {
@@ -2034,4 +2100,15 @@ future<utils::chunked_vector<client_data>> cql_server::get_client_data() {
     co_return ret;
 }
 
+future<std::vector<generic_server::shard_load>> cql_server::get_shard_loads() {
+    auto now = lowres_clock::now();
+    if (_shard_loads.empty() || now - _shard_loads_updated >= load_update_interval) {
+        _shard_loads = co_await container().map([] (cql_server& server) {
+            return server.load();
+        });
+        _shard_loads_updated = now;
+    }
+    co_return _shard_loads;
+}
+
 }
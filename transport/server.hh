@@ -127,6 +127,8 @@ struct cql_sg_stats {
     cql_sg_stats(maintenance_socket_enabled);
     request_kind_stats& get_cql_opcode_stats(cql_binary_opcode op) { return _cql_requests_stats[static_cast<uint8_t>(op)]; }
     void register_metrics();
+    // Registers the metrics again, with the new name of the scheduling group.
+    void rename_metrics();
 private:
     seastar::metrics::metric_groups _metrics;
     std::vector<request_kind_stats> _cql_requests_stats;
@@ -142,6 +144,7 @@ class cql_server : public seastar::peering_sharded_service<cql_server>, public g
         uint32_t requests_serving = 0;
         uint64_t requests_blocked_memory = 0;
         uint64_t requests_shed = 0;
+        uint64_t response_batches = 0;
 
         std::unordered_map<exceptions::exception_code, uint64_t> errors;
     };
@@ -159,6 +162,9 @@ class cql_server : public seastar::peering_sharded_service<cql_server>, public g
     std::unique_ptr<event_notifier> _notifier;
 private:
     transport_stats _stats;
+    // The loads of all shards, as of _shard_loads_updated.
+    std::vector<generic_server::shard_load> _shard_loads;
+    lowres_clock::time_point _shard_loads_updated;
     auth::service& _auth_service;
     qos::service_level_controller& _sl_controller;
     gms::gossiper& _gossiper;
@@ -182,6 +188,9 @@ class cql_server : public seastar::peering_sharded_service<cql_server>, public g
     }
 
     future<utils::chunked_vector<client_data>> get_client_data();
+    // The loads of the servers of all shards, indexed by shard, at most
+    // load_update_interval old.
+    future<std::vector<generic_server::shard_load>> get_shard_loads();
 private:
     class fmt_visitor;
     friend class connection;
@@ -201,6 +210,14 @@ class cql_server : public seastar::peering_sharded_service<cql_server>, public g
         bool _ready = false;
         bool _authenticating = false;
 
+        struct pending_response {
+            foreign_ptr<std::unique_ptr<cql_server::response>> response;
+            service_permit permit;
+            cql_compression compression;
+        };
+        // Responses waiting to be written in the next batch.
+        std::vector<pending_response> _pending_responses;
+
         enum class tracing_request_type : uint8_t {
             not_requested,
             no_write_on_close,
@@ -215,6 +232,7 @@ class cql_server : public seastar::peering_sharded_service<cql_server>, public g
                 uint16_t,
                 service::client_state&,
                 tracing_request_type,
+                tracing::elapsed_clock::time_point,
                 service_permit>;
         static thread_local execution_stage_type _process_request_stage;
     public:
@@ -228,7 +246,7 @@ class cql_server : public seastar::peering_sharded_service<cql_server>, public g
         const service::client_state& get_client_state() const { return _client_state; }
     private:
         friend class process_request_executor;
-        future<foreign_ptr<std::unique_ptr<cql_server::response>>> process_request_one(fragmented_temporary_buffer::istream buf, uint8_t op, uint16_t stream, service::client_state& client_state, tracing_request_type tracing_request, service_permit permit);
+        future<foreign_ptr<std::unique_ptr<cql_server::response>>> process_request_one(fragmented_temporary_buffer::istream buf, uint8_t op, uint16_t stream, service::client_state& client_state, tracing_request_type tracing_request, tracing::elapsed_clock::time_point received, service_permit permit);
         unsigned frame_size() const;
         unsigned pick_request_cpu();
         cql_binary_frame_v3 parse_frame(temporary_buffer<char> buf) const;
@@ -254,7 +272,7 @@ class cql_server : public seastar::peering_sharded_service<cql_server>, public g
         std::unique_ptr<cql_server::response> make_rate_limit_error(int16_t stream, exceptions::exception_code err, sstring msg, db::operation_type op_type, bool rejected_by_coordinator, const tracing::trace_state_ptr& tr_state, const service::client_state& client_state) const;
         std::unique_ptr<cql_server::response> make_error(int16_t stream, exceptions::exception_code err, sstring msg, const tracing::trace_state_ptr& tr_state) const;
         std::unique_ptr<cql_server::response> make_ready(int16_t stream, const tracing::trace_state_ptr& tr_state) const;
-        std::unique_ptr<cql_server::response> make_supported(int16_t stream, const tracing::trace_state_ptr& tr_state) const;
+        std::unique_ptr<cql_server::response> make_supported(int16_t stream, std::optional<unsigned> less_loaded_shard, const tracing::trace_state_ptr& tr_state) const;
         std::unique_ptr<cql_server::response> make_topology_change_event(const cql_transport::event::topology_change& event) const;
         std::unique_ptr<cql_server::response> make_status_change_event(const cql_transport::event::status_change& event) const;
         std::unique_ptr<cql_server::response> make_schema_change_event(const cql_transport::event::schema_change& event) const;
@@ -273,6 +291,7 @@ class cql_server : public seastar::peering_sharded_service<cql_server>, public g
                 service_permit permit, tracing::trace_state_ptr trace_state, Process process_fn);
 
         void write_response(foreign_ptr<std::unique_ptr<cql_server::response>>&& response, service_permit permit = empty_service_permit(), cql_compression compression = cql_compression::none);
+        future<> write_pending_responses();
 
         friend event_notifier;
     };
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include "utils/alien_worker.hh"
+
+#include <seastar/core/posix.hh>
+#include <unistd.h>
+
+namespace utils {
+
+std::optional<seastar::noncopyable_function<void()>> alien_worker::pop_front() {
+    std::unique_lock lock(_mut);
+    _cv.wait(lock, [this] { return !_pending.empty(); });
+    auto task = std::move(_pending.front());
+    _pending.pop();
+    return task;
+}
+
+void alien_worker::push_back(std::optional<seastar::noncopyable_function<void()>> task) {
+    std::unique_lock lock(_mut);
+    _pending.emplace(std::move(task));
+    lock.unlock();
+    _cv.notify_one();
+}
+
+alien_worker::alien_worker(unsigned nr_threads, seastar::logger& log, std::string name) {
+    _threads.reserve(nr_threads);
+    for (unsigned i = 0; i < nr_threads; ++i) {
+        _threads.emplace_back([this, &log, name] { run(log, name); });
+    }
+}
+
+alien_worker::~alien_worker() {
+    for (size_t i = 0; i < _threads.size(); ++i) {
+        push_back(std::nullopt);
+    }
+    for (auto& t : _threads) {
+        t.join();
+    }
+}
+
+void alien_worker::run(seastar::logger& log, const std::string& name) {
+    sigset_t mask;
+    sigfillset(&mask);
+    auto r = ::pthread_sigmask(SIG_BLOCK, &mask, nullptr);
+    seastar::throw_pthread_error(r);
+
+    errno = 0;
+    int nice_value = nice(10);
+    if (nice_value == -1 && errno != 0) {
+        log.warn("Unable to renice the {} thread (system error number {}); the thread will compete with reactor. Try adding CAP_SYS_NICE", name, errno);
+    }
+
+    for (;;) {
+        auto task = pop_front();
+        if (!task) {
+            break;
+        }
+        (*task)();
+    }
+}
+
+void alien_worker::submit(seastar::noncopyable_function<void()> task) {
+    push_back(std::move(task));
+}
+
+} // namespace utils
@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <seastar/util/log.hh>
+#include <seastar/util/noncopyable_function.hh>
+
+namespace utils {
+
+// OS threads, outside of the reactor, to run work which would stall it on.
+//
+// Tasks are run in the order they were submitted. They run on a foreign
+// thread, so they must send their results back to the shard with
+// seastar::alien::run_on(). The threads block all signals and are niced, so
+// that they don't compete with the reactors.
+class alien_worker {
+    std::mutex _mut;
+    std::condition_variable _cv;
+    std::queue<std::optional<seastar::noncopyable_function<void()>>> _pending;
+    std::vector<std::thread> _threads;
+private:
+    std::optional<seastar::noncopyable_function<void()>> pop_front();
+    void push_back(std::optional<seastar::noncopyable_function<void()>> task);
+    void run(seastar::logger& log, const std::string& name);
+public:
+    // Starts nr_threads threads. Failing to renice them is logged to log,
+    // naming them after name.
+    alien_worker(unsigned nr_threads, seastar::logger& log, std::string name);
+    // Waits for the submitted tasks to complete.
+    ~alien_worker();
+    alien_worker(const alien_worker&) = delete;
+    alien_worker& operator=(const alien_worker&) = delete;
+
+    void submit(seastar::noncopyable_function<void()> task);
+};
+
+} // namespace utils
@@ -157,6 +157,7 @@ class cached_file {
         if (i != _cache.end() && i->idx == idx) {
             ++_metrics.page_hits;
             tracing::trace(trace_state, "page cache hit: file={}, page={}", _file_name, idx);
+            tracing::account_index_file_read(trace_state, true, page_size);
             cached_page& cp = *i;
             return make_ready_future<cached_page::ptr_type>(cp.share());
         }
@@ -165,6 +166,7 @@ class cached_file {
         size_t size = (idx + read_ahead) > _last_page
                 ? (_last_page_size + (_last_page - idx) * page_size)
                 : read_ahead * page_size;
+        tracing::account_index_file_read(trace_state, false, size);
         return _file.dma_read_exactly<char>(idx * page_size, size)
             .then([this, idx] (temporary_buffer<char>&& buf) mutable {
                 cached_page::ptr_type first_page;
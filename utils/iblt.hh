@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+namespace utils {
+
+struct iblt_cell {
+    int32_t count = 0;
+    uint64_t key_sum = 0;
+    uint64_t hash_sum = 0;
+
+    bool empty() const noexcept {
+        return !count && !key_sum && !hash_sum;
+    }
+};
+
+// An invertible Bloom lookup table of 64-bit keys, used for set reconciliation.
+//
+// Every key is accounted for in one cell of each of nr_hashes equally sized
+// sub-tables. Subtracting the table of one set from the table of another one,
+// of the same size, leaves the table of their symmetric difference, which
+// decode() can list as long as it has no more than about 2/3 as many keys as
+// the table has cells, however large the sets themselves are.
+//
+// Keys are expected to be uniformly distributed already, like hashes are.
+class iblt {
+public:
+    static constexpr unsigned nr_hashes = 3;
+
+    struct difference {
+        // Keys of this table but not of the subtracted one.
+        std::vector<uint64_t> added;
+        // Keys of the subtracted table but not of this one.
+        std::vector<uint64_t> removed;
+    };
+private:
+    std::vector<iblt_cell> _cells;
+private:
+    static uint64_t mix(uint64_t x) noexcept {
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111eb;
+        x ^= x >> 31;
+        return x;
+    }
+
+    static uint64_t checksum(uint64_t key) noexcept {
+        return mix(key ^ 0x5851f42d4c957f2d);
+    }
+
+    size_t cell_index(uint64_t key, unsigned i) const noexcept {
+        const auto sub_table_size = _cells.size() / nr_hashes;
+        return i * sub_table_size + mix(key + (i + 1) * 0x9e3779b97f4a7c15) % sub_table_size;
+    }
+
+    void update(uint64_t key, int32_t count) noexcept {
+        const auto check = checksum(key);
+        for (unsigned i = 0; i < nr_hashes; ++i) {
+            auto& c = _cells[cell_index(key, i)];
+            c.count += count;
+            c.key_sum ^= key;
+            c.hash_sum ^= check;
+        }
+    }
+
+    static bool is_pure(const iblt_cell& c) noexcept {
+        return (c.count == 1 || c.count == -1) && c.hash_sum == checksum(c.key_sum);
+    }
+public:
+    // nr_cells is rounded up to a multiple of nr_hashes.
+    explicit iblt(size_t nr_cells)
+        : _cells(std::max<size_t>((nr_cells + nr_hashes - 1) / nr_hashes, 1) * nr_hashes)
+    { }
+
+    explicit iblt(std::vector<iblt_cell> cells)
+        : _cells(std::move(cells))
+    {
+        if (_cells.empty() || _cells.size() % nr_hashes) {
+            throw std::invalid_argument("iblt: the number of cells must be a non-zero multiple of the number of hashes");
+        }
+    }
+
+    size_t size() const noexcept {
+        return _cells.size();
+    }
+
+    const std::vector<iblt_cell>& cells() const noexcept {
+        return _cells;
+    }
+
+    std::vector<iblt_cell> release() && noexcept {
+        return std::move(_cells);
+    }
+
+    void insert(uint64_t key) noexcept {
+        update(key, 1);
+    }
+
+    void erase(uint64_t key) noexcept {
+        update(key, -1);
+    }
+
+    // Both tables must have the same size.
+    void subtract(const iblt& other) {
+        if (other.size() != size()) {
+            throw std::invalid_argument("iblt: cannot subtract tables of different sizes");
+        }
+        for (size_t i = 0; i < _cells.size(); ++i) {
+            _cells[i].count -= other._cells[i].count;
+            _cells[i].key_sum ^= other._cells[i].key_sum;
+            _cells[i].hash_sum ^= other._cells[i].hash_sum;
+        }
+    }
+
+    // Lists the keys of the table, telling apart the ones which were inserted
+    // from the ones which were subtracted. Returns std::nullopt if the table
+    // has too many keys to list all of them. Consumes the table.
+    std::optional<difference> decode() && {
+        difference diff;
+        std::vector<size_t> pure;
+        for (size_t i = 0; i < _cells.size(); ++i) {
+            if (is_pure(_cells[i])) {
+                pure.push_back(i);
+            }
+        }
+        while (!pure.empty()) {
+            auto& c = _cells[pure.back()];
+            pure.pop_back();
+            // The cell may have been peeled already via another one.
+            if (!is_pure(c)) {
+                continue;
+            }
+            const auto key = c.key_sum;
+            const auto count = c.count;
+            (count > 0 ? diff.added : diff.removed).push_back(key);
+            update(key, -count);
+            for (unsigned i = 0; i < nr_hashes; ++i) {
+                if (auto idx = cell_index(key, i); is_pure(_cells[idx])) {
+                    pure.push_back(idx);
+                }
+            }
+        }
+        for (auto& c : _cells) {
+            if (!c.empty()) {
+                return std::nullopt;
+            }
+        }
+        return diff;
+    }
+};
+
+} // namespace utils
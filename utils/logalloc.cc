@@ -648,6 +648,13 @@ struct alignas(segment_size) segment {
 };
 
 static constexpr size_t max_managed_object_size = segment_size * 0.1;
+
+// Size of a transparent huge page on the platforms we care about.
+// Segments of a region are kept within the same huge page where possible,
+// so that accesses to a region touch fewer TLB entries.
+static constexpr size_t huge_page_size = 2 * 1024 * 1024;
+static constexpr size_t segments_per_huge_page = huge_page_size / segment_size;
+static_assert(huge_page_size % segment_size == 0);
 static constexpr auto max_used_space_ratio_for_compaction = 0.85;
 static constexpr size_t max_used_space_for_compaction = segment_size * max_used_space_ratio_for_compaction;
 static constexpr size_t min_free_space_for_compaction = segment_size - max_used_space_for_compaction;
@@ -738,10 +745,11 @@ class segment_store_backend {
     uintptr_t _segments_base;
 
 public:
-    explicit segment_store_backend(memory::memory_layout layout, bool freed_segment_increases_general_memory_availability) noexcept
+    explicit segment_store_backend(memory::memory_layout layout, bool freed_segment_increases_general_memory_availability,
+            uintptr_t base_alignment = segment::size) noexcept
         : _layout(layout)
         , _freed_segment_increases_general_memory_availability(freed_segment_increases_general_memory_availability)
-        , _segments_base(align_up(_layout.start, static_cast<uintptr_t>(segment::size)))
+        , _segments_base(align_up(_layout.start, base_alignment))
     { }
     virtual ~segment_store_backend() = default;
     memory::memory_layout memory_layout() const noexcept { return _layout; }
@@ -780,6 +788,9 @@ class seastar_memory_segment_store_backend : public segment_store_backend {
 // Segments storage is allocated via `mmap()`.
 // This area cannot be shrunk or enlarged, so freeing segments doesn't increase
 // memory availability.
+// The first segment is aligned to a huge page boundary, so that every group
+// of segments_per_huge_page consecutive segments can be backed by a single
+// transparent huge page.
 class standard_memory_segment_store_backend : public segment_store_backend {
     struct free_segment {
         free_segment* next = nullptr;
@@ -792,7 +803,8 @@ class standard_memory_segment_store_backend : public segment_store_backend {
 
 private:
     static memory::memory_layout allocate_memory(size_t segments) {
-        const auto size = segments * segment_size;
+        // Over-allocate so that the segments can start at a huge page boundary.
+        const auto size = segments * segment_size + huge_page_size;
         auto p = mmap(nullptr, size,
                 PROT_READ | PROT_WRITE,
                 MAP_PRIVATE | MAP_ANONYMOUS,
@@ -806,7 +818,7 @@ class standard_memory_segment_store_backend : public segment_store_backend {
     }
 public:
     standard_memory_segment_store_backend(size_t segments)
-        : segment_store_backend(allocate_memory(segments), false)
+        : segment_store_backend(allocate_memory(segments), false, huge_page_size)
         , _available_segments((_layout.end - _segments_base) / segment_size)
     { }
     ~standard_memory_segment_store_backend() {
@@ -1039,12 +1051,13 @@ class segment_pool {
     //   Non-lsa:
     //     - clear everywhere
 private:
-    segment* allocate_segment(size_t reserve);
+    segment* allocate_segment(size_t reserve, const segment* near = nullptr);
     void deallocate_segment(segment* seg) noexcept;
+    size_t find_free_segment_near(const segment* near) noexcept;
     friend void* segment::operator new(size_t);
     friend void segment::operator delete(void*);
 
-    segment* allocate_or_fallback_to_reserve();
+    segment* allocate_or_fallback_to_reserve(const segment* near);
     const segment* segment_from_idx(size_t idx) const noexcept {
         return _store.segment_from_idx(idx);
     }
@@ -1066,7 +1079,9 @@ class segment_pool {
     logalloc::tracker::impl& tracker() { return _tracker; }
     void prime(size_t available_memory, size_t min_free_memory);
     void use_standard_allocator_segment_pool_backend(size_t available_memory);
-    segment* new_segment(region::impl* r);
+    // Allocates a segment for the region r.
+    // If near is given, prefers free segments in the same huge page as near.
+    segment* new_segment(region::impl* r, const segment* near = nullptr);
     const segment_descriptor& descriptor(const segment* seg) const noexcept {
         uintptr_t index = idx_from_segment(seg);
         return _segments[index];
@@ -1285,7 +1300,43 @@ size_t segment_pool::reclaim_segments(size_t target, is_preemptible preempt) {
     return reclaimed_segments;
 }
 
-segment* segment_pool::allocate_segment(size_t reserve)
+// Returns the index of the highest-address free segment which shares the huge
+// page with near, or the highest-address free segment if there is no such
+// segment.
+//
+// reclaim_segments() releases the lowest-address segments first, compacting
+// those in use, which is why free segments are otherwise allocated from the
+// top. The hint is not followed into the lower half of the LSA-owned
+// segments, where it would leave reclaim more segments to compact.
+size_t segment_pool::find_free_segment_near(const segment* near) noexcept {
+    if (near) {
+        auto near_idx = idx_from_segment(near);
+        auto low_idx = _lsa_owned_segments_bitmap.find_first_set();
+        auto mid_idx = low_idx + (_lsa_owned_segments_bitmap.find_last_set() - low_idx) / 2;
+        if (near_idx != segment_npos && near_idx >= mid_idx) {
+            auto near_addr = reinterpret_cast<uintptr_t>(near);
+            auto page = align_down(near_addr, uintptr_t(huge_page_size));
+            auto first = near_idx - std::min(near_idx, (near_addr - page) / segment::size);
+            auto last = std::min(first + segments_per_huge_page, max_segments());
+            first = std::max(first, mid_idx);
+            for (auto idx = last; idx-- > first;) {
+                if (!_lsa_free_segments_bitmap.test(idx)) {
+                    continue;
+                }
+                // Segment indexes don't have to reflect addresses with the
+                // standard allocator, so verify the candidate.
+                if (align_down(reinterpret_cast<uintptr_t>(segment_from_idx(idx)), uintptr_t(huge_page_size)) == page) {
+                    ++_stats.huge_page_local_segment_allocations;
+                    return idx;
+                }
+            }
+        }
+        ++_stats.huge_page_remote_segment_allocations;
+    }
+    return _lsa_free_segments_bitmap.find_last_set();
+}
+
+segment* segment_pool::allocate_segment(size_t reserve, const segment* near)
 {
     //
     // When allocating a segment we want to avoid:
@@ -1293,7 +1344,8 @@ segment* segment_pool::allocate_segment(size_t reserve)
     //    other for every last bit of memory
     //
     // allocate_segment() always works with LSA reclaimer disabled.
-    // 1. Firstly, the algorithm tries to allocate an lsa-owned but free segment
+    // 1. Firstly, the algorithm tries to allocate an lsa-owned but free segment,
+    //    preferring one in the same huge page as `near`.
     // 2. If no free segmented is available, a new segment is allocated from the
     //    system allocator. However, if the free memory is below set threshold
     //    this step is skipped.
@@ -1303,7 +1355,7 @@ segment* segment_pool::allocate_segment(size_t reserve)
     do {
         tracker_reclaimer_lock rl(_tracker);
         if (_free_segments > reserve) {
-            auto free_idx = _lsa_free_segments_bitmap.find_last_set();
+            auto free_idx = find_free_segment_near(near);
             _lsa_free_segments_bitmap.clear(free_idx);
             auto seg = segment_from_idx(free_idx);
             --_free_segments;
@@ -1365,8 +1417,8 @@ segment_pool::segment_from(const segment_descriptor& desc) noexcept {
 }
 
 segment*
-segment_pool::allocate_or_fallback_to_reserve() {
-    auto seg = allocate_segment(_current_emergency_reserve_goal);
+segment_pool::allocate_or_fallback_to_reserve(const segment* near) {
+    auto seg = allocate_segment(_current_emergency_reserve_goal, near);
     if (!seg) {
         _allocation_failure_flag = true;
         throw bad_alloc(format("failed to allocate segment (_current_emergency_reserve_goal={})", _current_emergency_reserve_goal));
@@ -1375,8 +1427,8 @@ segment_pool::allocate_or_fallback_to_reserve() {
 }
 
 segment*
-segment_pool::new_segment(region::impl* r) {
-    auto seg = allocate_or_fallback_to_reserve();
+segment_pool::new_segment(region::impl* r, const segment* near) {
+    auto seg = allocate_or_fallback_to_reserve(near);
     ++_segments_in_use;
     segment_descriptor& desc = descriptor(seg);
     desc.set_free_space(segment::size);
@@ -1692,6 +1744,9 @@ class region_impl final : public basic_region_impl {
     region_listener* _listener = nullptr;
     segment* _active = nullptr;
     size_t _active_offset;
+    // The most recently allocated segment. Only used as a placement hint,
+    // so it may point to a segment which is no longer owned by this region.
+    const segment* _last_segment = nullptr;
     segment_descriptor_hist _segment_descs; // Contains only closed segments
     occupancy_stats _closed_occupancy;
     occupancy_stats _non_lsa_occupancy;
@@ -1816,7 +1871,8 @@ class region_impl final : public basic_region_impl {
     }
 
     segment* new_segment() {
-        segment* seg = segment_pool().new_segment(this);
+        segment* seg = segment_pool().new_segment(this, _last_segment);
+        _last_segment = seg;
         if (_listener) {
             _evictable_space += segment_size;
             _listener->increase_usage(_region, segment::size);
@@ -2857,6 +2913,14 @@ tracker::impl::impl() : _segment_pool(std::make_unique<logalloc::segment_pool>(*
 
         sm::make_counter("memory_freed", [this] { return _segment_pool->statistics().memory_freed; },
                         sm::description("Counts number of bytes which were requested to be freed in LSA.")),
+
+        sm::make_counter("huge_page_local_segment_allocations", [this] { return _segment_pool->statistics().huge_page_local_segment_allocations; },
+                        sm::description("Counts segments given to a region from the same huge page as its previous segment. "
+                                        "Such segments don't need additional TLB entries when the region is accessed.")),
+
+        sm::make_counter("huge_page_remote_segment_allocations", [this] { return _segment_pool->statistics().huge_page_remote_segment_allocations; },
+                        sm::description("Counts free segments given to a region from a different huge page than its previous segment, "
+                                        "because no free segment was available in the same huge page.")),
     });
 }
 
@@ -74,6 +74,8 @@ class tracker {
         uint64_t memory_compacted;
         uint64_t memory_evicted;
         uint64_t num_allocations;
+        uint64_t huge_page_local_segment_allocations;
+        uint64_t huge_page_remote_segment_allocations;
 
         friend stats operator+(const stats& s1, const stats& s2) {
             stats result(s1);
@@ -93,6 +95,8 @@ class tracker {
             memory_compacted += other.memory_compacted;
             memory_evicted += other.memory_evicted;
             num_allocations += other.num_allocations;
+            huge_page_local_segment_allocations += other.huge_page_local_segment_allocations;
+            huge_page_remote_segment_allocations += other.huge_page_remote_segment_allocations;
             return *this;
         }
         stats& operator-=(const stats& other) {
@@ -103,6 +107,8 @@ class tracker {
             memory_compacted -= other.memory_compacted;
             memory_evicted -= other.memory_evicted;
             num_allocations -= other.num_allocations;
+            huge_page_local_segment_allocations -= other.huge_page_local_segment_allocations;
+            huge_page_remote_segment_allocations -= other.huge_page_remote_segment_allocations;
             return *this;
         }
     };
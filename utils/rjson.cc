@@ -279,6 +279,26 @@ future<> print(const rjson::value& value, seastar::output_stream<char>& os, size
   });
 }
 
+void chunked_writer::stream::add_chunk() {
+    _chunks.emplace_back(chunk_size);
+    _pos = _chunks.back().get_write();
+    _end = _pos + chunk_size;
+}
+
+chunked_content chunked_writer::stream::release() && {
+    if (!_chunks.empty()) {
+        // chunked_content can't hold empty buffers.
+        auto used = chunk_size - (_end - _pos);
+        if (used) {
+            _chunks.back().trim(used);
+        } else {
+            _chunks.pop_back();
+        }
+    }
+    _pos = _end = nullptr;
+    return std::move(_chunks);
+}
+
 rjson::malformed_value::malformed_value(std::string_view name, const rjson::value& value)
     : malformed_value(name, print(value))
 {}
@@ -416,6 +416,70 @@ class streaming_writer {
     }
 };
 
+// A writer which writes JSON into a chunked_content, in chunks of a bounded
+// size, so that writing a big document doesn't need a big contiguous buffer,
+// nor building a value holding the whole document first.
+//
+// It has the same API as streaming_writer, plus Value() to write a whole
+// value, e.g., a small part of the document which was easier to build as one.
+class chunked_writer {
+public:
+    static constexpr size_t chunk_size = 16 * 1024;
+private:
+    // The rapidjson output stream, which puts the characters in the last chunk.
+    class stream {
+        chunked_content _chunks;
+        char* _pos = nullptr;
+        char* _end = nullptr;
+        void add_chunk();
+    public:
+        using Ch = char; // Used by rjson internally
+        void Put(Ch c) {
+            if (_pos == _end) [[unlikely]] {
+                add_chunk();
+            }
+            *_pos++ = c;
+        }
+        void Flush() { }
+        size_t size() const noexcept {
+            return _chunks.size() * chunk_size - (_end - _pos);
+        }
+        chunked_content release() &&;
+    };
+    using writer = rapidjson::Writer<stream, rjson::encoding, rjson::encoding, rjson::allocator>;
+
+    stream _stream;
+    writer _writer;
+
+public:
+    chunked_writer() : _writer(_stream)
+    { }
+    chunked_writer(const chunked_writer&) = delete;
+    chunked_writer(chunked_writer&&) = delete;
+
+    // following the rapidjson method names here
+    bool Null() { return _writer.Null(); }
+    bool Bool(bool b) { return _writer.Bool(b); }
+    bool Int(int i) { return _writer.Int(i); }
+    bool Uint(unsigned i) { return _writer.Uint(i); }
+    bool Int64(int64_t i) { return _writer.Int64(i); }
+    bool Uint64(uint64_t i) { return _writer.Uint64(i); }
+    bool Double(double d) { return _writer.Double(d); }
+    bool RawNumber(std::string_view str) { return _writer.RawNumber(str.data(), str.size(), false); }
+    bool String(std::string_view str) { return _writer.String(str.data(), str.size(), false); }
+    bool StartObject() { return _writer.StartObject(); }
+    bool Key(std::string_view str) { return _writer.Key(str.data(), str.size(), false); }
+    bool EndObject(rapidjson::SizeType memberCount = 0) { return _writer.EndObject(memberCount); }
+    bool StartArray() { return _writer.StartArray(); }
+    bool EndArray(rapidjson::SizeType elementCount = 0) { return _writer.EndArray(elementCount); }
+    bool Value(const rjson::value& v) { return v.Accept(_writer); }
+
+    // The number of bytes written so far.
+    size_t size() const noexcept { return _stream.size(); }
+    // The JSON written, which should be complete by now.
+    chunked_content release() && { return std::move(_stream).release(); }
+};
+
 } // end namespace rjson
 
 template <> struct fmt::formatter<rjson::value> {
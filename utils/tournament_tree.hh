@@ -0,0 +1,203 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <cassert>
+#include <compare>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace utils {
+
+// A tournament tree priority queue, used for k-way merging.
+//
+// Elements live in the leaves of a complete binary tree, and every internal
+// node remembers the winner of the match played between its two children.
+// Replacing or inserting an element replays the matches on the path from its
+// leaf to the root, which takes exactly one comparison per level, versus up to
+// two per level when popping from and pushing to a binary heap.
+//
+// Every node also records whether its match was a tie. An element equal to the
+// top one must have met it on its way to the root (or have lost to an element
+// which did, and which is hence equal to the top too), so top_may_have_equal()
+// doesn't need to perform any comparisons.
+//
+// pop() doesn't replay the path of the emptied leaf right away. When the popped
+// element is replaced with push() before the tree is looked at again, which is
+// the common pattern when merging streams, the path is replayed only once.
+//
+// Compare is a three-way comparator returning std::strong_ordering or
+// std::weak_ordering. Smaller elements win.
+template <typename T, typename Compare>
+class tournament_tree {
+    using index_type = uint32_t;
+    static constexpr index_type npos = index_type(-1);
+
+    struct node {
+        index_type winner = npos;
+        bool tie = false;
+    };
+
+    Compare _cmp;
+    // Number of leaves, always a power of two (or zero).
+    index_type _capacity = 0;
+    std::vector<std::optional<T>> _leaves;
+    // Internal nodes, indexed from 1 like a binary heap: children of node n
+    // are 2n and 2n + 1, and leaf l is at the (virtual) position _capacity + l.
+    std::vector<node> _nodes;
+    std::vector<index_type> _free_leaves;
+    // Leaf emptied by pop(), whose path wasn't replayed yet.
+    index_type _pending = npos;
+    size_t _size = 0;
+private:
+    // Plays a match between leaves a and b, returns {winner, tie}.
+    // Empty leaves lose against everything.
+    std::pair<index_type, bool> play(index_type a, index_type b) const {
+        if (a == npos || !_leaves[a]) {
+            return {b, false};
+        }
+        if (b == npos || !_leaves[b]) {
+            return {a, false};
+        }
+        auto r = _cmp(*_leaves[a], *_leaves[b]);
+        if (r > 0) {
+            return {b, false};
+        }
+        return {a, r == 0};
+    }
+
+    index_type winner_of(index_type pos) const noexcept {
+        return pos >= _capacity ? pos - _capacity : _nodes[pos].winner;
+    }
+
+    index_type winner() const noexcept {
+        return _capacity > 1 ? _nodes[1].winner : 0;
+    }
+
+    void replay(index_type leaf) {
+        for (auto n = (_capacity + leaf) / 2; n > 0; n /= 2) {
+            auto [w, tie] = play(winner_of(2 * n), winner_of(2 * n + 1));
+            _nodes[n] = node{w, tie};
+        }
+    }
+
+    void rebuild() {
+        for (auto n = _capacity - 1; n > 0; --n) {
+            auto [w, tie] = play(winner_of(2 * n), winner_of(2 * n + 1));
+            _nodes[n] = node{w, tie};
+        }
+    }
+
+    void grow() {
+        auto old_capacity = _capacity;
+        _capacity = _capacity ? _capacity * 2 : 1;
+        _leaves.resize(_capacity);
+        _nodes.resize(_capacity);
+        for (auto l = _capacity; l > old_capacity; --l) {
+            _free_leaves.push_back(l - 1);
+        }
+        rebuild();
+    }
+
+    void settle() {
+        if (_pending != npos) {
+            replay(_pending);
+            _free_leaves.push_back(std::exchange(_pending, npos));
+        }
+    }
+public:
+    explicit tournament_tree(Compare cmp) : _cmp(std::move(cmp)) { }
+
+    bool empty() const noexcept {
+        return _size == 0;
+    }
+
+    size_t size() const noexcept {
+        return _size;
+    }
+
+    void push(T v) {
+        index_type leaf;
+        if (_pending != npos) {
+            leaf = std::exchange(_pending, npos);
+        } else {
+            if (_free_leaves.empty()) {
+                grow();
+            }
+            leaf = _free_leaves.back();
+            _free_leaves.pop_back();
+        }
+        _leaves[leaf].emplace(std::move(v));
+        ++_size;
+        replay(leaf);
+    }
+
+    // Must not be called on an empty tree.
+    T& top() {
+        settle();
+        assert(_size && _leaves[winner()]);
+        return *_leaves[winner()];
+    }
+
+    // Returns false if there is definitely no other element which compares
+    // equal to top(). Doesn't perform any comparisons.
+    // Must not be called on an empty tree.
+    bool top_may_have_equal() {
+        settle();
+        for (auto n = (_capacity + winner()) / 2; n > 0; n /= 2) {
+            if (_nodes[n].tie) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Removes and returns top().
+    // Must not be called on an empty tree.
+    T pop() {
+        settle();
+        auto w = winner();
+        assert(_size && _leaves[w]);
+        T v = std::move(*_leaves[w]);
+        _leaves[w].reset();
+        --_size;
+        _pending = w;
+        return v;
+    }
+
+    // Invokes func on each element, in no particular order.
+    template <typename Func>
+    void for_each(Func&& func) {
+        for (auto& leaf : _leaves) {
+            if (leaf) {
+                func(*leaf);
+            }
+        }
+    }
+
+    // Removes all elements, keeping the capacity.
+    void clear() {
+        for (auto& leaf : _leaves) {
+            leaf.reset();
+        }
+        _free_leaves.clear();
+        for (auto l = _capacity; l > 0; --l) {
+            _free_leaves.push_back(l - 1);
+        }
+        for (auto& n : _nodes) {
+            n = node{};
+        }
+        _pending = npos;
+        _size = 0;
+    }
+};
+
+} // namespace utils